@@ -96,6 +96,10 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use 12-byte vertices instead of 20: fixed-point positions relative to ImDrawList::VtxOrigin and 16-bit texture coordinates (see ImDrawVert).
+// Your renderer backend will need to decode them, with ImDrawList::GetVtxPos()/GetVtxUV() or in its vertex shader.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
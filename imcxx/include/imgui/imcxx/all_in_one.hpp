@@ -1,6 +1,7 @@
 #pragma once
 
 #include "frames.hpp"
+#include "label_id.hpp"
 #include "window.hpp"
 #include "text.hpp"
 #include "checkbox.hpp"
@@ -12,7 +13,10 @@
 #include "button.hpp"
 #include "colors.hpp"
 #include "override.hpp"
+#include "clipper.hpp"
 #include "tables.hpp"
+#include "table_sorter.hpp"
+#include "table_view.hpp"
 #include "tabitem.hpp"
 #include "menuitem.hpp"
 #include "drag_drop.hpp"
@@ -1,8 +1,15 @@
 #pragma once
 
 #include "scopes.hpp"
+#include "imgui/imgui_internal.h"
 #include <algorithm>
 
+// Instances of ImGui::CheckboxFlagsT() compiled in imgui_widgets.cpp
+extern template IMGUI_API bool ImGui::CheckboxFlagsT<int>(const char* label, int* flags, int flags_value);
+extern template IMGUI_API bool ImGui::CheckboxFlagsT<unsigned int>(const char* label, unsigned int* flags, unsigned int flags_value);
+extern template IMGUI_API bool ImGui::CheckboxFlagsT<ImS64>(const char* label, ImS64* flags, ImS64 flags_value);
+extern template IMGUI_API bool ImGui::CheckboxFlagsT<ImU64>(const char* label, ImU64* flags, ImU64 flags_value);
+
 namespace imcxx
 {
 	class checkbox : public scope_wrap<checkbox, scope_traits::no_dtor>
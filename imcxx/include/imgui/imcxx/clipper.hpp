@@ -0,0 +1,239 @@
+#pragma once
+
+#include <vector>
+#include "scopes.hpp"
+#include "imgui/imgui_internal.h"
+
+namespace imcxx
+{
+	/// <summary>
+	/// List clipper for items of different heights, ImGuiListClipper assumes they all have the same height.
+	/// - Heights are measured when items are submitted and kept in a Fenwick tree (prefix sums), so finding the first visible item is O(log n)
+	///   and only visible items are submitted.
+	/// - Items never submitted yet use 'estimated_height' (default: GetTextLineHeightWithSpacing()).
+	/// - Visible items are measured again every frame, 'invalidate(index)' is for items which changed while hidden (e.g. collapsed from elsewhere):
+	///   they go back to the estimated height until they are visible again.
+	/// - Works in windows and tables (each item being a row, submit the header row before).
+	/// - Like ImGuiListClipper, one more item is submitted in the direction of a keyboard/gamepad move request and everything is submitted while logging.
+	/// - Keep the clipper alive across frames, the heights are the whole point.
+	///
+	/// static imcxx::variable_clipper clipper;
+	/// clipper.render(alerts.size(), [](size_t i) { imcxx::text{ imcxx::text::wrapped{}, std::string_view{ alerts[i] } }; });
+	/// </summary>
+	class variable_clipper
+	{
+	public:
+		explicit variable_clipper(float estimated_height = -1.0f) noexcept :
+			m_EstimatedHeight(estimated_height)
+		{}
+
+		/// <summary>
+		/// Submit the visible items among 'count', 'fn(size_t index)' submits one item.
+		/// Items appended since last frame start with the estimated height, removing items drops their heights.
+		/// </summary>
+		template<typename _InvokeTy>
+		void render(size_t count, _InvokeTy&& fn)
+		{
+			ImGuiContext& g = *GImGui;
+			ImGuiWindow* window = g.CurrentWindow;
+			if (m_EstimatedHeight < 0.0f)
+				m_EstimatedHeight = ImGui::GetTextLineHeightWithSpacing();
+			resize(count);
+
+			m_Submitted = 0;
+			if (window->SkipItems)
+				return;
+
+			if (ImGuiTable* table = g.CurrentTable; table && table->IsInsideRow)
+				ImGui::TableEndRow(table);
+			const float start_y = window->DC.CursorPos.y;
+
+			float visible_min = window->ClipRect.Min.y;
+			float visible_max = window->ClipRect.Max.y;
+			size_t extra_before = 0, extra_after = 0;
+			if (g.LogEnabled)
+			{
+				visible_min = -FLT_MAX;
+				visible_max = FLT_MAX;
+			}
+			else if (g.NavMoveScoringItems && g.NavWindow && g.NavWindow->RootWindowForNav == window->RootWindowForNav)
+			{
+				extra_before = g.NavMoveClipDir == ImGuiDir_Up ? 1 : 0;
+				extra_after = g.NavMoveClipDir == ImGuiDir_Down ? 1 : 0;
+			}
+
+			size_t index = find(static_cast<double>(visible_min - start_y));
+			index -= ImMin(index, extra_before);
+			if (index > 0)
+				seek(start_y + static_cast<float>(prefix(index)), index);
+
+			for (; index < count; index++)
+			{
+				if (window->DC.CursorPos.y >= visible_max)
+				{
+					if (extra_after == 0)
+						break;
+					extra_after--;
+				}
+
+				const float item_y = window->DC.CursorPos.y;
+				fn(index);
+				if (ImGuiTable* table = g.CurrentTable; table && table->IsInsideRow)
+					ImGui::TableEndRow(table);
+
+				set_height(index, window->DC.CursorPos.y - item_y);
+				m_Submitted++;
+			}
+
+			if (index < count)
+				seek(start_y + static_cast<float>(prefix(count)), count - index);
+		}
+
+		/// <summary>
+		/// Reset an item to the estimated height, it will be measured again the next time it is visible.
+		/// </summary>
+		void invalidate(size_t index)
+		{
+			if (index < m_Heights.size())
+				set_height(index, m_EstimatedHeight);
+		}
+
+		/// <summary>
+		/// Reset every item to the estimated height (e.g. after a font or wrap width change).
+		/// </summary>
+		void invalidate_all()
+		{
+			m_Heights.assign(m_Heights.size(), m_EstimatedHeight);
+			rebuild();
+		}
+
+		/// <summary>
+		/// Offset of an item from the top of the list, with the heights known so far.
+		/// </summary>
+		[[nodiscard]] float offset(size_t index) const
+		{
+			return static_cast<float>(prefix(ImMin(index, m_Heights.size())));
+		}
+
+		/// <summary>
+		/// Height of the whole list, with the heights known so far.
+		/// </summary>
+		[[nodiscard]] float total_height() const
+		{
+			return offset(m_Heights.size());
+		}
+
+		/// <summary>
+		/// Number of items submitted by the last call to render()
+		/// </summary>
+		[[nodiscard]] size_t submitted() const noexcept
+		{
+			return m_Submitted;
+		}
+
+	private:
+		void resize(size_t count)
+		{
+			if (count < m_Heights.size())
+			{
+				m_Heights.resize(count);
+				rebuild();
+				return;
+			}
+
+			// Appending to a Fenwick tree: node i covers (i - lowbit(i), i]
+			m_Tree.reserve(count + 1);
+			for (size_t i = m_Heights.size(); i < count; i++)
+			{
+				m_Heights.push_back(m_EstimatedHeight);
+
+				const size_t node = i + 1;
+				m_Tree.push_back(0.0);
+				m_Tree[node] = m_EstimatedHeight + prefix(i) - prefix(node - (node & (~node + 1)));
+			}
+		}
+
+		void rebuild()
+		{
+			m_Tree.assign(m_Heights.size() + 1, 0.0);
+			for (size_t node = 1; node < m_Tree.size(); node++)
+			{
+				m_Tree[node] += m_Heights[node - 1];
+				const size_t parent = node + (node & (~node + 1));
+				if (parent < m_Tree.size())
+					m_Tree[parent] += m_Tree[node];
+			}
+		}
+
+		void set_height(size_t index, float height)
+		{
+			const double delta = static_cast<double>(height) - m_Heights[index];
+			if (delta == 0.0)
+				return;
+
+			m_Heights[index] = height;
+			for (size_t node = index + 1; node < m_Tree.size(); node += node & (~node + 1))
+				m_Tree[node] += delta;
+		}
+
+		/// <summary>
+		/// Sum of the heights of the items [0, count)
+		/// </summary>
+		[[nodiscard]] double prefix(size_t count) const
+		{
+			double sum = 0.0;
+			for (size_t node = count; node; node -= node & (~node + 1))
+				sum += m_Tree[node];
+			return sum;
+		}
+
+		/// <summary>
+		/// First item whose bottom is below 'y'
+		/// </summary>
+		[[nodiscard]] size_t find(double y) const
+		{
+			const size_t size = m_Tree.size() - 1;
+			size_t step = 1;
+			while (step * 2 <= size)
+				step *= 2;
+
+			size_t pos = 0;
+			for (; step; step /= 2)
+			{
+				if (pos + step <= size && m_Tree[pos + step] <= y)
+				{
+					pos += step;
+					y -= m_Tree[pos];
+				}
+			}
+			return pos;
+		}
+
+		/// <summary>
+		/// Same as ImGuiListClipper's cursor seeking, 'skipped' items are accounted for in table row colors.
+		/// </summary>
+		void seek(float pos_y, size_t skipped)
+		{
+			ImGuiContext& g = *GImGui;
+			ImGuiWindow* window = g.CurrentWindow;
+			window->DC.CursorPos.y = pos_y;
+			window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, pos_y - g.Style.ItemSpacing.y);
+			window->DC.CursorPosPrevLine.y = pos_y - m_EstimatedHeight;
+			window->DC.PrevLineSize.y = m_EstimatedHeight - g.Style.ItemSpacing.y;
+			if (ImGuiOldColumns* columns = window->DC.CurrentColumns)
+				columns->LineMinY = pos_y;
+			if (ImGuiTable* table = g.CurrentTable)
+			{
+				if (table->IsInsideRow)
+					ImGui::TableEndRow(table);
+				table->RowPosY2 = pos_y;
+				table->RowBgColorCounter += static_cast<int>(skipped);
+			}
+		}
+
+		std::vector<float> m_Heights;
+		std::vector<double> m_Tree{ 0.0 };
+		float m_EstimatedHeight;
+		size_t m_Submitted{ };
+	};
+}
@@ -2,6 +2,7 @@
 
 #include <type_traits>
 #include <numeric>
+#include <limits>
 #include "scopes.hpp"
 
 namespace imcxx
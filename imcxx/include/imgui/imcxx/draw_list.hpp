@@ -0,0 +1,195 @@
+#pragma once
+
+#include <climits>
+#include <cstring>
+#include "imgui/imgui_internal.h"
+
+namespace imcxx
+{
+	/// <summary>
+	/// Position of a vertex relative to the VtxOrigin of its draw list (the position itself without IMGUI_USE_COMPACT_DRAWVERT)
+	/// </summary>
+	inline ImVec2 vertex_pos(const ImDrawVert& vtx)
+	{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+		return { vtx.pos[0] * (1.f / IM_DRAWVERT_POS_SCALE), vtx.pos[1] * (1.f / IM_DRAWVERT_POS_SCALE) };
+#else
+		return vtx.pos;
+#endif
+	}
+
+	/// <summary>
+	/// Offset to pass to 'translate_vertices()' to move vertices relative to 'src_origin' by 'offset' pixels in 'dst'
+	/// </summary>
+	inline ImVec2 vertex_offset(const ImVec2& offset, const ImVec2& src_origin, const ImDrawList& dst)
+	{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+		return { offset.x + src_origin.x - dst.VtxOrigin.x, offset.y + src_origin.y - dst.VtxOrigin.y };
+#else
+		(void)src_origin;
+		(void)dst;
+		return offset;
+#endif
+	}
+
+	/// <summary>
+	/// Copy 'count' vertices from 'src' to 'dst', moved by 'offset' (from 'vertex_offset()').
+	/// Compact vertices are moved without decoding them, by the offset rounded to their precision.
+	/// </summary>
+	inline void translate_vertices(ImDrawVert* dst, const ImDrawVert* src, int count, const ImVec2& offset)
+	{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+		const int dx = static_cast<int>(offset.x * IM_DRAWVERT_POS_SCALE + (offset.x < 0.f ? -0.5f : 0.5f));
+		const int dy = static_cast<int>(offset.y * IM_DRAWVERT_POS_SCALE + (offset.y < 0.f ? -0.5f : 0.5f));
+		for (int i = 0; i < count; i++)
+		{
+			dst[i] = src[i];
+			dst[i].pos[0] = static_cast<ImS16>(ImClamp(src[i].pos[0] + dx, -32768, 32767));
+			dst[i].pos[1] = static_cast<ImS16>(ImClamp(src[i].pos[1] + dy, -32768, 32767));
+		}
+#else
+		for (int i = 0; i < count; i++)
+		{
+			dst[i] = src[i];
+			dst[i].pos.x += offset.x;
+			dst[i].pos.y += offset.y;
+		}
+#endif
+	}
+
+	/// <summary>
+	/// Shapes drawn from separate arrays of screen coordinates (heatmap cells, depth bars, scatter plot markers...) in one call,
+	/// see ImDrawList::AddRectsFilled(), AddCirclesFilled() and AddLines(): shapes outside of the clip rect are skipped, vertices are reserved once per group of shapes.
+	/// Draws in the draw list of the current window by default. 'colors' holds one color per shape, or pass a single color.
+	///
+	/// imcxx::window heatmap{ "Heatmap" };
+	/// imcxx::draw_batch{}.rects_filled(cells.x.data(), cells.y.data(), cells.w.data(), cells.h.data(), cells.colors.data(), cells.x.size());
+	/// </summary>
+	class draw_batch
+	{
+	public:
+		explicit draw_batch(ImDrawList* draw_list = ImGui::GetWindowDrawList()) noexcept :
+			m_DrawList(draw_list)
+		{}
+
+		template<typename _ColTy>
+		draw_batch& rects_filled(const float* x, const float* y, const float* w, const float* h, _ColTy colors, size_t count)
+		{
+			IM_ASSERT(count <= static_cast<size_t>(INT_MAX));
+			m_DrawList->AddRectsFilled(x, y, w, h, colors, static_cast<int>(count));
+			return *this;
+		}
+
+		template<typename _ColTy>
+		draw_batch& circles_filled(const float* x, const float* y, float radius, _ColTy colors, size_t count, int segments = 0)
+		{
+			IM_ASSERT(count <= static_cast<size_t>(INT_MAX));
+			m_DrawList->AddCirclesFilled(x, y, radius, colors, static_cast<int>(count), segments);
+			return *this;
+		}
+
+		template<typename _ColTy>
+		draw_batch& lines(const float* x1, const float* y1, const float* x2, const float* y2, _ColTy colors, size_t count, float thickness = 1.f)
+		{
+			IM_ASSERT(count <= static_cast<size_t>(INT_MAX));
+			m_DrawList->AddLines(x1, y1, x2, y2, colors, static_cast<int>(count), thickness);
+			return *this;
+		}
+
+		[[nodiscard]] ImDrawList* draw_list() const noexcept
+		{
+			return m_DrawList;
+		}
+
+	private:
+		ImDrawList* m_DrawList;
+	};
+
+	/// <summary>
+	/// Append the commands of 'src' to 'dst' at its current position, moved by 'offset' (vertices and clip rects).
+	/// 'dst' keeps its clip rect and texture for the next commands, 'src' is only read: it may be a private draw list of another context or a copy kept between frames.
+	/// </summary>
+	inline void append_draw_list(ImDrawList* dst, const ImDrawList& src, const ImVec2& offset = {})
+	{
+		if (src.CmdBuffer.empty())
+			return;
+
+		// Indices of 'src' are shifted after the vertices of 'dst' when they fit, else the commands start a new vertex offset
+		const unsigned vtx_count = static_cast<unsigned>(src.VtxBuffer.Size);
+		const bool rebase = sizeof(ImDrawIdx) == 4 || dst->_VtxCurrentIdx + vtx_count <= (1u << 16);
+		if (!rebase && !(dst->Flags & ImDrawListFlags_AllowVtxOffset))
+		{
+			IM_ASSERT(0 && "Too many vertices in ImDrawList using 16-bit indices, see ImGuiBackendFlags_RendererHasVtxOffset");
+			return;
+		}
+
+		// Vertices are only rewritten when they move in 'dst' (compact vertices are relative to the VtxOrigin of their draw list)
+		const bool moved = offset.x != 0.f || offset.y != 0.f;
+		const ImVec2 vtx_offset = vertex_offset(offset, src.VtxOrigin, *dst);
+		const unsigned vtx_start = static_cast<unsigned>(dst->VtxBuffer.Size);
+		const unsigned idx_start = static_cast<unsigned>(dst->IdxBuffer.Size);
+		dst->VtxBuffer.resize(dst->VtxBuffer.Size + src.VtxBuffer.Size);
+		ImDrawVert* vtx_write = dst->VtxBuffer.Data + vtx_start;
+		if (vtx_offset.x != 0.f || vtx_offset.y != 0.f)
+			translate_vertices(vtx_write, src.VtxBuffer.Data, src.VtxBuffer.Size, vtx_offset);
+		else if (vtx_count)
+			memcpy(vtx_write, src.VtxBuffer.Data, vtx_count * sizeof(ImDrawVert));
+
+		// Rebased indices also take the vertex offset of their command: the vertices of 'src' are contiguous, even when its commands start new vertex offsets
+		dst->IdxBuffer.resize(dst->IdxBuffer.Size + src.IdxBuffer.Size);
+		ImDrawIdx* idx_write = dst->IdxBuffer.Data + idx_start;
+		if (!src.IdxBuffer.empty())
+			memcpy(idx_write, src.IdxBuffer.Data, src.IdxBuffer.Size * sizeof(ImDrawIdx));
+		if (rebase)
+		{
+			for (const ImDrawCmd& src_cmd : src.CmdBuffer)
+			{
+				const unsigned base = dst->_VtxCurrentIdx + src_cmd.VtxOffset;
+				if (!base || src_cmd.UserCallback)
+					continue;
+				for (unsigned n = src_cmd.IdxOffset; n < src_cmd.IdxOffset + src_cmd.ElemCount; n++)
+					idx_write[n] = static_cast<ImDrawIdx>(idx_write[n] + base);
+			}
+		}
+
+		dst->_PopUnusedDrawCmd();
+		for (const ImDrawCmd& src_cmd : src.CmdBuffer)
+		{
+			if (!src_cmd.ElemCount && !src_cmd.UserCallback)
+				continue;
+
+			ImDrawCmd cmd = src_cmd;
+			cmd.IdxOffset += idx_start;
+			cmd.VtxOffset = rebase ? dst->_CmdHeader.VtxOffset : vtx_start + src_cmd.VtxOffset;
+			if (moved)
+			{
+				cmd.ClipRect.x += offset.x;
+				cmd.ClipRect.y += offset.y;
+				cmd.ClipRect.z += offset.x;
+				cmd.ClipRect.w += offset.y;
+			}
+
+			// Same clip rect, texture and vertex offset as the previous command: draw both at once
+			ImDrawCmd* prev = dst->CmdBuffer.empty() ? nullptr : &dst->CmdBuffer.back();
+			if (prev && !prev->UserCallback && !cmd.UserCallback &&
+				prev->IdxOffset + prev->ElemCount == cmd.IdxOffset &&
+				memcmp(prev, &cmd, IM_OFFSETOF(ImDrawCmd, VtxOffset) + sizeof(unsigned int)) == 0)
+				prev->ElemCount += cmd.ElemCount;
+			else
+				dst->CmdBuffer.push_back(cmd);
+		}
+
+		if (rebase)
+			dst->_VtxCurrentIdx += vtx_count;
+		else
+		{
+			dst->_CmdHeader.VtxOffset = static_cast<unsigned>(dst->VtxBuffer.Size);
+			dst->_VtxCurrentIdx = 0;
+		}
+		dst->_VtxWritePtr = dst->VtxBuffer.Data + dst->VtxBuffer.Size;
+		dst->_IdxWritePtr = dst->IdxBuffer.Data + dst->IdxBuffer.Size;
+
+		// Next commands of 'dst' use its own clip rect and texture again
+		dst->AddDrawCmd();
+	}
+}
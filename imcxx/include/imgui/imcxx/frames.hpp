@@ -1,6 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 #include "scopes.hpp"
+#include "imgui/imgui_internal.h"
 
 namespace imcxx
 {
@@ -34,4 +44,197 @@ namespace imcxx
 		ImGui::Render();
 		plat_render(ImGui::GetDrawData());
 	}
+
+	/// <summary>
+	/// Skips the frames where nothing changes: 'wait()' blocks in the platform's event wait until the next frame is needed, which is when
+	/// - input events were received, and for 'settle_frames' frames after them (hover states and window sizes take a few frames to settle),
+	/// - a mouse button or a key is held, a window is moved, a widget is active (a text input only needs a frame when its cursor blinks),
+	/// - a window is appearing or resizing to its contents, the modal or window switching background is fading,
+	/// - glyphs of a font with ImFontConfig::DynamicGlyphs were drawn before being rasterized (the next frame rasterizes and draws them),
+	/// - the delay of a 'request_redraw()' expired: widgets animating on their own (notifications, progress bars...) or data updated by another thread.
+	/// A scheduler drives the context current in its last 'wait()' (or at its construction): it only gets the redraws requested for that context.
+	/// 'imcxx::frame' and 'imcxx::render()' are used as usual after 'wait()', io.DeltaTime is the real time since the previous frame.
+	///
+	/// imcxx::frame_scheduler scheduler{ [hwnd]() { ::PostMessage(hwnd, WM_NULL, 0, 0); } };
+	/// while (!done)
+	/// {
+	///     scheduler.wait([](double timeout) { ::MsgWaitForMultipleObjects(0, nullptr, FALSE, timeout < 0.0 ? INFINITE : static_cast<DWORD>(timeout * 1000.0), QS_ALLINPUT); });
+	///     // PeekMessage() loop, imcxx::frame, imcxx::render()...
+	/// }
+	/// </summary>
+	class frame_scheduler
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		/// <summary>
+		/// 'wake' interrupts the wait of 'wait()' when 'request_redraw()' is called from another thread, for example by posting an empty message to the window.
+		/// It can be empty when redraws are only requested by the UI thread.
+		/// </summary>
+		explicit frame_scheduler(std::function<void()> wake = {}) :
+			m_Wake(std::move(wake)),
+			m_Context(GImGui)
+		{
+			std::lock_guard lock(s_Mutex);
+			s_Schedulers.push_back(this);
+		}
+
+		~frame_scheduler()
+		{
+			std::lock_guard lock(s_Mutex);
+			s_Schedulers.erase(std::find(s_Schedulers.begin(), s_Schedulers.end(), this));
+		}
+
+		frame_scheduler(const frame_scheduler&) = delete;
+		frame_scheduler& operator=(const frame_scheduler&) = delete;
+
+		/// <summary>
+		/// Wait until the next frame is needed, 'wait_fn(timeout)' must return on the next platform event or after 'timeout' seconds (no limit when negative).
+		/// Returns false when a frame was needed right away.
+		/// </summary>
+		template<typename _WaitFnTy, typename = std::enable_if_t<std::is_invocable_v<_WaitFnTy, double>>>
+		bool wait(_WaitFnTy&& wait_fn)
+		{
+			m_Context.store(GImGui);
+			double timeout = frame_timeout();
+			if (timeout == 0.0)
+			{
+				request_timeout();
+				return false;
+			}
+
+			// Requests made from now on wake the wait
+			m_Waiting.store(true);
+			const double requested = request_timeout();
+			if (requested >= 0.0 && (timeout < 0.0 || requested < timeout))
+				timeout = requested;
+			if (timeout != 0.0)
+				wait_fn(timeout);
+			m_Waiting.store(false);
+			request_timeout();
+			return timeout != 0.0;
+		}
+
+		/// <summary>
+		/// Render a frame of 'context' in 'delay' seconds at most, from any thread: the schedulers driving 'context' get the request, it is dropped when there is none.
+		/// Other threads pass the context they work for (GImGui is only theirs when it is thread local), e.g. the one current when their work was queued.
+		/// </summary>
+		static void request_redraw(double delay = 0.0, ImGuiContext* context = GImGui)
+		{
+			const int64_t deadline = (clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(delay))).time_since_epoch().count();
+			std::lock_guard lock(s_Mutex);
+			for (frame_scheduler* scheduler : s_Schedulers)
+			{
+				if (scheduler->m_Context.load() != context)
+					continue;
+
+				int64_t current = scheduler->m_Deadline.load();
+				while (deadline < current)
+				{
+					if (scheduler->m_Deadline.compare_exchange_weak(current, deadline))
+					{
+						if (scheduler->m_Waiting.load() && scheduler->m_Wake)
+							scheduler->m_Wake();
+						break;
+					}
+				}
+			}
+		}
+
+		/// <summary>
+		/// Frames rendered after the last input event
+		/// </summary>
+		int settle_frames{ 2 };
+
+		/// <summary>
+		/// Longest wait in seconds, e.g. 1.0 for a clock shown in seconds, no limit when negative
+		/// </summary>
+		double max_idle{ -1.0 };
+
+	private:
+		/// <summary>
+		/// Seconds until ImGui needs a frame: 0 for right now, negative when only an event can change something.
+		/// </summary>
+		double frame_timeout()
+		{
+			ImGuiContext& g = *GImGui;
+			if (g.FrameCount == 0 || !g.InputEventsQueue.empty() || !g.InputEventsTrail.empty())
+			{
+				m_SettleFrames = settle_frames;
+				return 0.0;
+			}
+			if (m_SettleFrames > 0)
+			{
+				m_SettleFrames--;
+				return 0.0;
+			}
+
+			const ImGuiIO& io = g.IO;
+			if (io.Fonts->HasDynamicGlyphRequests())
+				return 0.0;
+			for (const bool down : io.MouseDown)
+			{
+				if (down)
+					return 0.0;
+			}
+			for (const ImGuiKeyData& key : io.KeysData)
+			{
+				if (key.Down)
+					return 0.0;
+			}
+
+			const bool text_input = g.ActiveId && g.ActiveId == g.InputTextState.ID;
+			if ((g.ActiveId && !text_input) || g.MovingWindow || g.DragDropActive || g.NavWindowingTarget ||
+				(g.DimBgRatio > 0.f && g.DimBgRatio < 1.f) || (g.NavWindowingHighlightAlpha > 0.f && g.NavWindowingHighlightAlpha < 1.f))
+				return 0.0;
+
+			for (const ImGuiWindow* window : g.Windows)
+			{
+				if (window->WasActive &&
+					(window->HiddenFramesCanSkipItems > 0 || window->HiddenFramesCannotSkipItems > 0 || window->HiddenFramesForRenderOnly > 0 ||
+					 window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0))
+					return 0.0;
+			}
+
+			double timeout = max_idle;
+			if (text_input && io.ConfigInputTextCursorBlink)
+			{
+				// Same period as InputText(): visible for 0.8s, hidden for 0.4s
+				const float anim = g.InputTextState.CursorAnim;
+				const float phase = anim <= 0.f ? anim : ImFmod(anim, 1.20f);
+				const double blink = (phase <= 0.80f ? 0.80f - phase : 1.20f - phase) + 0.001;
+				if (timeout < 0.0 || blink < timeout)
+					timeout = blink;
+			}
+			return timeout;
+		}
+
+		/// <summary>
+		/// Seconds until the requested redraw, 0 when it expired (the request is consumed), negative when there is none
+		/// </summary>
+		double request_timeout()
+		{
+			int64_t deadline = m_Deadline.load();
+			if (deadline == no_deadline)
+				return -1.0;
+
+			const int64_t now = clock::now().time_since_epoch().count();
+			if (deadline > now)
+				return std::chrono::duration<double>(clock::duration(deadline - now)).count();
+
+			m_Deadline.compare_exchange_strong(deadline, no_deadline);
+			return 0.0;
+		}
+
+		static constexpr int64_t no_deadline = std::numeric_limits<int64_t>::max();
+		// Every scheduler, so that requests find the ones driving their context
+		inline static std::mutex s_Mutex;
+		inline static std::vector<frame_scheduler*> s_Schedulers;
+
+		std::function<void()> m_Wake;
+		std::atomic<ImGuiContext*> m_Context;
+		std::atomic<int64_t> m_Deadline{ no_deadline };
+		std::atomic<bool> m_Waiting{ };
+		int m_SettleFrames{ };
+	};
 }
@@ -13,14 +13,48 @@ namespace imcxx
 	/// </summary>
 	class input : public scope_wrap<input, scope_traits::no_dtor>
 	{
+		template<typename _StrTy>
 		struct input_reforward_data
 		{
-			std::string* Str;
+			_StrTy* Str;
 			ImGuiInputTextCallback  ChainCallback;
 			void* ChainCallbackUserData;
 		};
 
+		template<typename _Ty>
+		struct is_string : std::false_type {};
+		template<typename _TraitsTy, typename _AllocTy>
+		struct is_string<std::basic_string<char, _TraitsTy, _AllocTy>> : std::true_type {};
+		template<typename _Ty>
+		static constexpr bool is_string_v = is_string<_Ty>::value;
+
 	public:
+		/// <summary>
+		/// How strings edited by 'input' grow once the text no longer fits: the new capacity is at least 'factor' times the old one,
+		/// with 'slack' free bytes after the text, so typing in a field reallocates the string once in a while and not on each key.
+		/// Any 'std::basic_string<char, ...>' can be edited, a 'std::pmr::string' keeps the text in a memory resource owned by the caller (a fixed buffer, a frame arena...).
+		/// </summary>
+		struct string_growth
+		{
+			float factor{ 2.0f };
+			size_t slack{ 64 };
+
+			[[nodiscard]] constexpr size_t next_capacity(size_t capacity, size_t length) const noexcept
+			{
+				const size_t scaled = static_cast<size_t>(static_cast<float>(capacity) * factor);
+				return scaled > length + slack ? scaled : length + slack;
+			}
+		};
+
+		/// <summary>
+		/// Growth policy shared by every 'input' on a string
+		/// </summary>
+		[[nodiscard]] static string_growth& string_growth_policy() noexcept
+		{
+			static string_growth policy;
+			return policy;
+		}
+
 		struct text {};
 		struct multiline {};
 		struct hint {};
@@ -315,15 +349,16 @@ namespace imcxx
 			void* user_data = nullptr
 		)
 		{
-			if constexpr (std::is_same_v<std::remove_pointer_t<std::decay_t<_InputTy>>, std::string>)
+			if constexpr (is_string_v<std::remove_pointer_t<std::decay_t<_InputTy>>>)
 			{
-				std::string* p_input = nullptr;
+				using string_type = std::remove_pointer_t<std::decay_t<_InputTy>>;
+				string_type* p_input = nullptr;
 				if constexpr (std::is_pointer_v<_InputTy>)
 					p_input = input;
 				else
 					p_input = &input;
 
-				input_reforward_data data
+				input_reforward_data<string_type> data
 				{
 					p_input,
 					callback,
@@ -334,7 +369,7 @@ namespace imcxx
 					p_input->data(),
 					p_input->capacity() + 1, 
 					flags | ImGuiInputTextFlags_CallbackResize, 
-					&input_text_reforward, 
+					&input_text_reforward<string_type>, 
 					&data
 				);
 			}
@@ -380,15 +415,16 @@ namespace imcxx
 			void* user_data = nullptr
 		)
 		{
-			if constexpr (std::is_same_v<std::remove_pointer_t<std::decay_t<_InputTy>>, std::string>)
+			if constexpr (is_string_v<std::remove_pointer_t<std::decay_t<_InputTy>>>)
 			{
-				std::string* p_input = nullptr;
+				using string_type = std::remove_pointer_t<std::decay_t<_InputTy>>;
+				string_type* p_input = nullptr;
 				if constexpr (std::is_pointer_v<_InputTy>)
 					p_input = input;
 				else
 					p_input = &input;
 
-				input_reforward_data data
+				input_reforward_data<string_type> data
 				{
 					p_input,
 					callback,
@@ -396,11 +432,11 @@ namespace imcxx
 				};
 				m_Result._Value = ImGui::InputTextMultiline(
 					impl::get_string(label), 
-					input, 
-					size, p_input->data(),
+					p_input->data(),
 					p_input->capacity() + 1, 
-					size, flags | ImGuiInputTextFlags_CallbackResize,
-					&input_text_reforward, 
+					size,
+					flags | ImGuiInputTextFlags_CallbackResize,
+					&input_text_reforward<string_type>, 
 					&data
 				);
 			}
@@ -446,15 +482,16 @@ namespace imcxx
 			ImGuiInputTextCallback callback = nullptr, 
 			void* user_data = nullptr)
 		{
-			if constexpr (std::is_same_v<std::remove_pointer_t<std::decay_t<_InputTy>>, std::string>)
+			if constexpr (is_string_v<std::remove_pointer_t<std::decay_t<_InputTy>>>)
 			{
-				std::string* p_input = nullptr;
+				using string_type = std::remove_pointer_t<std::decay_t<_InputTy>>;
+				string_type* p_input = nullptr;
 				if constexpr (std::is_pointer_v<_InputTy>)
 					p_input = input;
 				else
 					p_input = &input;
 
-				input_reforward_data data
+				input_reforward_data<string_type> data
 				{
 					p_input,
 					callback,
@@ -466,7 +503,7 @@ namespace imcxx
 					p_input->data(),
 					p_input->capacity() + 1,
 					flags | ImGuiInputTextFlags_CallbackResize,
-					&input_text_reforward,
+					&input_text_reforward<string_type>,
 					&data
 				);
 			}
@@ -502,17 +539,22 @@ namespace imcxx
 
 
 	private:
+		template<typename _StrTy>
 		static constexpr int input_text_reforward(ImGuiInputTextCallbackData* data)
 		{
-			input_reforward_data* user_data = static_cast<input_reforward_data*>(data->UserData);
+			input_reforward_data<_StrTy>* user_data = static_cast<input_reforward_data<_StrTy>*>(data->UserData);
 			if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
 			{
 				// Resize string callback
 				// If for some reason we refuse the new length (BufTextLen) and/or capacity (BufSize) we need to set them back to what we want.
-				std::string* str = user_data->Str;
+				_StrTy* str = user_data->Str;
 				IM_ASSERT(data->Buf == str->c_str());
-				str->resize(data->BufTextLen);
+				const size_t length = static_cast<size_t>(data->BufTextLen);
+				if (length > str->capacity())
+					str->reserve(string_growth_policy().next_capacity(str->capacity(), length));
+				str->resize(length);
 				data->Buf = str->data();
+				data->BufSize = static_cast<int>(str->capacity() + 1);
 			}
 			else if (user_data->ChainCallback)
 			{
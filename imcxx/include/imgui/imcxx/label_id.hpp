@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include "scopes.hpp"
+#include "imgui/imgui_internal.h"
+
+namespace imcxx
+{
+	namespace impl
+	{
+		[[nodiscard]] constexpr std::array<ImU32, 256> make_crc32_table() noexcept
+		{
+			std::array<ImU32, 256> table{};
+			for (ImU32 i = 0; i < 256; i++)
+			{
+				ImU32 crc = i;
+				for (int bit = 0; bit < 8; bit++)
+					crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : (crc >> 1);
+				table[i] = crc;
+			}
+			return table;
+		}
+
+		/// <summary>
+		/// Same values as 'GCrc32LookupTable' in imgui.cpp (CRC32, reflected polynomial 0xEDB88320)
+		/// </summary>
+		inline constexpr std::array<ImU32, 256> crc32_table = make_crc32_table();
+
+		/// <summary>
+		/// Feeds a zero byte into a CRC32 register without the usual ~ pre/post conditioning.
+		/// </summary>
+		[[nodiscard]] constexpr ImU32 crc32_shift_zero(ImU32 crc) noexcept
+		{
+			return (crc >> 8) ^ crc32_table[crc & 0xFF];
+		}
+
+		/// <summary>
+		/// Length of the zero-terminated string in 'data', at most 'max_size' when no terminator is found before.
+		/// </summary>
+		[[nodiscard]] constexpr size_t str_length(const char* data, size_t max_size) noexcept
+		{
+			size_t size = 0;
+			while (size < max_size && data[size] != '\0')
+				size++;
+			return size;
+		}
+	}
+
+	/// <summary>
+	/// constexpr version of 'ImHashStr()', returns the same value for the same input, '###' handling included.
+	/// - 'size' == 0: 'data' is zero-terminated
+	/// </summary>
+	[[nodiscard]] constexpr ImGuiID hash_str(const char* data, size_t size = 0, ImU32 seed = 0) noexcept
+	{
+		seed = ~seed;
+		ImU32 crc = seed;
+		if (size != 0)
+		{
+			while (size-- != 0)
+			{
+				const unsigned char c = static_cast<unsigned char>(*data++);
+				if (c == '#' && size >= 2 && data[0] == '#' && data[1] == '#')
+					crc = seed;
+				crc = (crc >> 8) ^ impl::crc32_table[(crc & 0xFF) ^ c];
+			}
+		}
+		else
+		{
+			while (const unsigned char c = static_cast<unsigned char>(*data++))
+			{
+				if (c == '#' && data[0] == '#' && data[1] == '#')
+					crc = seed;
+				crc = (crc >> 8) ^ impl::crc32_table[(crc & 0xFF) ^ c];
+			}
+		}
+		return ~crc;
+	}
+
+	/// <summary>
+	/// A label with its hash precomputed, accepted by wrappers in place of a string to skip 'ImHashStr()' at runtime.
+	/// - The hash of a label depends on the ID stack (ImHashStr(label, 0, seed)), CRC32 being linear we store ImHashStr(label, 0, 0)
+	///   and the 32x32 bit matrix of the seed's contribution, resolving the final ID is 32 independent and/xor instead of a table lookup per character.
+	/// - C++17 has no consteval: declare it 'constexpr' (e.g. 'static constexpr auto node_id = "Node"_id;') to be sure the hash is computed at compile time.
+	/// - The label must outlive the object, which is always the case for string literals.
+	/// </summary>
+	class label_id
+	{
+	public:
+		constexpr label_id(const char* label, size_t size) noexcept :
+			m_Label(label)
+		{
+			// Mirrors hash_str(label, size, 0), while tracking how many bytes were hashed since the last '###' reset
+			ImU32 crc = ~0u;
+			size_t hashed = 0;
+			for (size_t i = 0; i < size; i++)
+			{
+				const unsigned char c = static_cast<unsigned char>(label[i]);
+				if (c == '#' && size - i - 1 >= 2 && label[i + 1] == '#' && label[i + 2] == '#')
+				{
+					crc = ~0u;
+					hashed = 0;
+				}
+				crc = (crc >> 8) ^ impl::crc32_table[(crc & 0xFF) ^ c];
+				hashed++;
+			}
+			m_Id = ~crc;
+
+			for (ImU32 bit = 0; bit < 32; bit++)
+			{
+				ImU32 column = 1u << bit;
+				for (size_t i = 0; i < hashed; i++)
+					column = impl::crc32_shift_zero(column);
+				m_SeedMatrix[bit] = column;
+			}
+		}
+
+		/// <summary>
+		/// Also chosen for character buffers (e.g. 'char buf[64]'): the label ends at the first '\0', the size of the array is only an upper bound.
+		/// </summary>
+		template<size_t _Size>
+		constexpr label_id(const char(&label)[_Size]) noexcept :
+			label_id(label, impl::str_length(label, _Size - 1))
+		{}
+
+		/// <summary>
+		/// Label to display, including the '##' or '###' suffix.
+		/// </summary>
+		[[nodiscard]] constexpr const char* label() const noexcept
+		{
+			return m_Label;
+		}
+
+		/// <summary>
+		/// Equivalent to ImHashStr(label, 0, seed).
+		/// </summary>
+		[[nodiscard]] constexpr ImGuiID get(ImGuiID seed = 0) const noexcept
+		{
+			ImGuiID id = m_Id;
+			for (ImU32 bit = 0; bit < 32; bit++)
+				id ^= m_SeedMatrix[bit] & (0u - ((seed >> bit) & 1));
+			return id;
+		}
+
+		/// <summary>
+		/// Equivalent to 'window->GetID(label)', the current window is used when 'window' is null.
+		/// </summary>
+		[[nodiscard]] ImGuiID get_id(ImGuiWindow* window = nullptr) const
+		{
+			ImGuiID id = get_id_no_keepalive(window);
+			ImGui::KeepAliveID(id);
+			return id;
+		}
+
+		/// <summary>
+		/// Equivalent to 'window->GetIDNoKeepAlive(label)', the current window is used when 'window' is null.
+		/// </summary>
+		[[nodiscard]] ImGuiID get_id_no_keepalive(ImGuiWindow* window = nullptr) const
+		{
+			ImGuiContext& g = *GImGui;
+			if (!window)
+				window = g.CurrentWindow;
+
+			ImGuiID id = get(window->IDStack.back());
+			if (g.DebugHookIdInfo == id)
+				ImGui::DebugHookIdInfo(id, ImGuiDataType_String, m_Label, nullptr);
+			return id;
+		}
+
+	private:
+		const char* m_Label;
+		ImGuiID m_Id{ };
+		std::array<ImU32, 32> m_SeedMatrix{ };
+	};
+
+	namespace literals
+	{
+		[[nodiscard]] constexpr label_id operator""_id(const char* label, size_t size) noexcept
+		{
+			return label_id{ label, size };
+		}
+	}
+}
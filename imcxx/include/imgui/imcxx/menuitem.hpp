@@ -39,7 +39,7 @@ namespace imcxx
 		/// create a sub-menu entry.
 		/// </summary>
 		template<typename _StrTy>
-		[[nodiscard]] item add_item(const _StrTy& label, bool enabled = true)
+		[[nodiscard]] auto add_item(const _StrTy& label, bool enabled = true)
 		{
 			return add_item_impl(impl::get_string(label), enabled);
 		}
@@ -48,7 +48,7 @@ namespace imcxx
 		/// return true when activated.
 		/// </summary>
 		template<typename _Str0Ty, typename _Str1Ty = const char*>
-		menuitem_entry add_entry(const _Str0Ty& label, const _Str1Ty& shortcut = nullptr, bool selected = false, bool enabled = true)
+		auto add_entry(const _Str0Ty& label, const _Str1Ty& shortcut = nullptr, bool selected = false, bool enabled = true)
 		{
 			return add_entry_impl(impl::get_string(label), impl::get_string(shortcut), selected, enabled);
 		}
@@ -57,7 +57,7 @@ namespace imcxx
 		/// return true when activated + toggle (*p_selected) if p_selected != nullptr
 		/// </summary>
 		template<typename _Str0Ty, typename _Str1Ty = const char*>
-		menuitem_entry add_entry(const _Str0Ty& label, const _Str1Ty& shortcut, bool* p_selected, bool enabled = true)
+		auto add_entry(const _Str0Ty& label, const _Str1Ty& shortcut, bool* p_selected, bool enabled = true)
 		{
 			return add_entry_impl(impl::get_string(label), impl::get_string(shortcut), p_selected, enabled);
 		}
@@ -98,7 +98,7 @@ namespace imcxx
 		/// return true when activated.
 		/// </summary>
 		template<typename _Str0Ty, typename _Str1Ty = const char*>
-		menuitem_entry add_entry(const _Str0Ty& label, const _Str1Ty& shortcut = nullptr, bool selected = false, bool enabled = true)
+		auto add_entry(const _Str0Ty& label, const _Str1Ty& shortcut = nullptr, bool selected = false, bool enabled = true)
 		{
 			return add_entry_impl(impl::get_string(label), impl::get_string(shortcut), selected, enabled);
 		}
@@ -107,7 +107,7 @@ namespace imcxx
 		/// return true when activated + toggle (*p_selected) if p_selected != nullptr
 		/// </summary>
 		template<typename _Str0Ty, typename _Str1Ty = const char*>
-		menuitem_entry add_entry(const _Str0Ty& label, const _Str1Ty& shortcut, bool* p_selected, bool enabled = true)
+		auto add_entry(const _Str0Ty& label, const _Str1Ty& shortcut, bool* p_selected, bool enabled = true)
 		{
 			return add_entry_impl(impl::get_string(label), impl::get_string(shortcut), p_selected, enabled);
 		}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Console fed from any thread, displayed by the UI thread
+	/// - Producers copy their message into a bounded lock-free ring (multi-producer, single consumer): no lock, no allocation,
+	///   a message which does not fit is dropped and counted in 'dropped()'.
+	/// - The UI thread drains the ring once per frame in 'render()' and keeps the last 'max_lines' lines, only visible lines are submitted.
+	///   A message with line breaks is split into one line per line break when drained, every line has the same height.
+	/// - A line can be made of colored spans, like 'notification::string_color' but referencing the text instead of owning it.
+	///
+	/// static imcxx::misc::console console;
+	/// console.push("worker started");                                        // from any thread
+	/// console.push({ { "[ERROR] ", 0xFF'40'40'FF }, { "connection lost" } });   // from any thread
+	/// console.render("##console");                                           // UI thread
+	/// </summary>
+	class console
+	{
+	public:
+		/// <summary>
+		/// Color of the text in the current style
+		/// </summary>
+		static constexpr uint32_t text_color = 0;
+
+		struct color_span
+		{
+			std::string_view string;
+			uint32_t color;
+
+			constexpr color_span(std::string_view str, uint32_t color = text_color) noexcept :
+				string(str), color(color)
+			{}
+		};
+
+		/// <summary>
+		/// 'capacity': size in bytes of the ring shared with producers, a message takes its size plus 8 bytes per span and 8 bytes of header.
+		/// 'max_lines': number of lines kept for display, 0 for no limit.
+		/// </summary>
+		IMGUI_API explicit console(size_t capacity = size_t{ 1 } << 20, size_t max_lines = 100000);
+		IMGUI_API ~console();
+
+		console(const console&) = delete;
+		console& operator=(const console&) = delete;
+
+		/// <summary>
+		/// Thread-safe, lock-free: queue a line, returns false if the ring is full.
+		/// </summary>
+		bool push(std::string_view text, uint32_t color = text_color)
+		{
+			const color_span span{ text, color };
+			return push(&span, 1);
+		}
+
+		/// <summary>
+		/// Thread-safe, lock-free: queue a line made of colored spans, returns false if the ring is full.
+		/// </summary>
+		bool push(std::initializer_list<color_span> spans)
+		{
+			return push(spans.begin(), spans.size());
+		}
+
+		/// <summary>
+		/// Thread-safe, lock-free: queue a line made of colored spans, returns false if the ring is full.
+		/// </summary>
+		IMGUI_API bool push(const color_span* spans, size_t count);
+
+		/// <summary>
+		/// Thread-safe, lock-free: queue a formatted line (up to 1024 characters), returns false if the ring is full.
+		/// </summary>
+		IMGUI_API bool pushf(uint32_t color, const char* fmt, ...) IM_FMTARGS(3);
+
+		/// <summary>
+		/// UI thread: move the queued lines to the display, 'render()' calls it.
+		/// </summary>
+		IMGUI_API void drain();
+
+		/// <summary>
+		/// UI thread: drain the queued lines and draw the visible ones in a child window, 'size' is the same as in ImGui::BeginChild().
+		/// While following, the view sticks to the last line unless the user scrolls up.
+		/// </summary>
+		IMGUI_API void render(const char* str_id, const ImVec2& size = {});
+
+		/// <summary>
+		/// UI thread: remove the displayed lines, queued lines are kept.
+		/// </summary>
+		IMGUI_API void clear();
+
+		/// <summary>
+		/// UI thread: number of lines displayed
+		/// </summary>
+		[[nodiscard]] size_t lines_count() const noexcept
+		{
+			return m_Lines.size();
+		}
+
+		/// <summary>
+		/// Number of lines dropped because the ring was full
+		/// </summary>
+		[[nodiscard]] size_t dropped() const noexcept
+		{
+			return m_Dropped.load(std::memory_order_relaxed);
+		}
+
+		void set_follow(bool follow) noexcept
+		{
+			m_Follow = follow;
+		}
+
+		[[nodiscard]] bool is_following() const noexcept
+		{
+			return m_Follow;
+		}
+
+	private:
+		struct line_info
+		{
+			size_t Text;
+			size_t Span;
+			size_t SpanCount;
+		};
+
+		struct span_info
+		{
+			size_t Offset;
+			size_t Size;
+			uint32_t Color;
+		};
+
+		void trim();
+
+		// Shared with producers
+		std::unique_ptr<std::byte[]> m_Ring;
+		size_t m_Capacity;
+		alignas(64) std::atomic<uint64_t> m_Write{ };
+		alignas(64) std::atomic<uint64_t> m_Read{ };
+		alignas(64) std::atomic<size_t> m_Dropped{ };
+
+		// UI thread only: drained lines, their spans point in 'm_Text'
+		std::vector<char> m_Text;
+		std::vector<span_info> m_Spans;
+		std::vector<line_info> m_Lines;
+		size_t m_MaxLines;
+		size_t m_Trimmed{ };
+		float m_ScrollY{ };
+		bool m_AtBottom{ true };
+		bool m_Follow{ true };
+	};
+}
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cstdarg>
+#include <cstring>
+
+#include "../console.hpp"
+
+#include "imgui/imgui_internal.h"
+
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Layout of a message in the ring, every message starts on 8 bytes:
+	/// [ record_header ][ record_span * SpanCount ][ text of the spans ][ padding to 8 bytes ]
+	/// A message which would cross the end of the ring is preceded by a padding record filling the end of the ring.
+	/// </summary>
+	struct record_header
+	{
+		/// <summary>
+		/// 0 while the producer is writing, then the size of the record (with 'padding_flag' for padding records)
+		/// </summary>
+		std::atomic<uint32_t> Commit;
+		uint32_t SpanCount;
+	};
+
+	struct record_span
+	{
+		uint32_t Color;
+		uint32_t Size;
+	};
+
+	static_assert(sizeof(record_header) == 8 && sizeof(record_span) == 8);
+
+	static constexpr uint32_t padding_flag = 1u << 31;
+
+	static constexpr size_t align_record(size_t size) noexcept
+	{
+		return (size + 7) & ~size_t{ 7 };
+	}
+
+
+	console::console(size_t capacity, size_t max_lines) :
+		m_Capacity(std::max(align_record(capacity), size_t{ 64 })),
+		m_MaxLines(max_lines)
+	{
+		// Zeroed: every header the consumer reaches reads 0 until a producer commits it
+		m_Ring = std::make_unique<std::byte[]>(m_Capacity);
+	}
+
+	console::~console() = default;
+
+	bool console::push(const color_span* spans, size_t count)
+	{
+		size_t text_size = 0;
+		for (size_t i = 0; i < count; i++)
+			text_size += spans[i].string.size();
+
+		const size_t size = align_record(sizeof(record_header) + count * sizeof(record_span) + text_size);
+		if (size > m_Capacity || size >= padding_flag)
+		{
+			m_Dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// Reserve [write, write + padding + size), the consumer frees space by moving 'm_Read'
+		uint64_t write = m_Write.load(std::memory_order_relaxed);
+		size_t offset, padding;
+		do
+		{
+			offset = static_cast<size_t>(write % m_Capacity);
+			padding = m_Capacity - offset < size ? m_Capacity - offset : 0;
+			if (write + padding + size - m_Read.load(std::memory_order_acquire) > m_Capacity)
+			{
+				m_Dropped.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		} while (!m_Write.compare_exchange_weak(write, write + padding + size, std::memory_order_relaxed));
+
+		if (padding)
+		{
+			auto header = reinterpret_cast<record_header*>(m_Ring.get() + offset);
+			header->Commit.store(static_cast<uint32_t>(padding) | padding_flag, std::memory_order_release);
+			offset = 0;
+		}
+
+		std::byte* record = m_Ring.get() + offset;
+		auto header = reinterpret_cast<record_header*>(record);
+		auto record_spans = reinterpret_cast<record_span*>(record + sizeof(record_header));
+		char* text = reinterpret_cast<char*>(record_spans + count);
+
+		header->SpanCount = static_cast<uint32_t>(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			record_spans[i] = { spans[i].color, static_cast<uint32_t>(spans[i].string.size()) };
+			std::memcpy(text, spans[i].string.data(), spans[i].string.size());
+			text += spans[i].string.size();
+		}
+		header->Commit.store(static_cast<uint32_t>(size), std::memory_order_release);
+		return true;
+	}
+
+	bool console::pushf(uint32_t color, const char* fmt, ...)
+	{
+		char buffer[1024];
+		va_list args;
+		va_start(args, fmt);
+		const int len = ImFormatStringV(buffer, sizeof(buffer), fmt, args);
+		va_end(args);
+		return push(std::string_view{ buffer, static_cast<size_t>(len) }, color);
+	}
+
+	void console::drain()
+	{
+		uint64_t read = m_Read.load(std::memory_order_relaxed);
+		const uint64_t write = m_Write.load(std::memory_order_acquire);
+
+		while (read < write)
+		{
+			std::byte* record = m_Ring.get() + static_cast<size_t>(read % m_Capacity);
+			auto header = reinterpret_cast<record_header*>(record);
+
+			// Messages are drained in order: stop at the first one still being written
+			const uint32_t commit = header->Commit.load(std::memory_order_acquire);
+			if (commit == 0)
+				break;
+
+			const size_t size = commit & ~padding_flag;
+			if (!(commit & padding_flag))
+			{
+				auto record_spans = reinterpret_cast<const record_span*>(record + sizeof(record_header));
+				const char* text = reinterpret_cast<const char*>(record_spans + header->SpanCount);
+
+				// One line per line break, lines are drawn at a uniform height (a line break ending the message adds no line)
+				m_Lines.push_back({ m_Text.size(), m_Spans.size(), 0 });
+				for (uint32_t i = 0; i < header->SpanCount; i++)
+				{
+					const char* span_end = text + record_spans[i].Size;
+					while (true)
+					{
+						const char* line_break = static_cast<const char*>(std::memchr(text, '\n', static_cast<size_t>(span_end - text)));
+						const char* text_end = line_break ? line_break : span_end;
+						if (text_end != text)
+						{
+							m_Spans.push_back({ m_Text.size(), static_cast<size_t>(text_end - text), record_spans[i].Color });
+							m_Text.insert(m_Text.end(), text, text_end);
+							m_Lines.back().SpanCount++;
+						}
+						text = line_break ? line_break + 1 : span_end;
+						if (!line_break || (text == span_end && i + 1 == header->SpanCount))
+							break;
+						m_Lines.push_back({ m_Text.size(), m_Spans.size(), 0 });
+					}
+				}
+			}
+
+			// Headers of the next laps can land anywhere in this record
+			header->Commit.store(0, std::memory_order_relaxed);
+			std::memset(record + sizeof(uint32_t), 0, size - sizeof(uint32_t));
+			read += size;
+		}
+
+		m_Read.store(read, std::memory_order_release);
+		trim();
+	}
+
+	void console::trim()
+	{
+		// Drop the oldest lines by batches, to keep it amortized O(1) per line
+		if (m_MaxLines == 0 || m_Lines.size() <= m_MaxLines + m_MaxLines / 4)
+			return;
+
+		const line_info& first = m_Lines[m_Lines.size() - m_MaxLines];
+		const size_t text = first.Text, span = first.Span;
+
+		m_Trimmed += m_Lines.size() - m_MaxLines;
+		m_Lines.erase(m_Lines.begin(), m_Lines.end() - m_MaxLines);
+		m_Spans.erase(m_Spans.begin(), m_Spans.begin() + span);
+		m_Text.erase(m_Text.begin(), m_Text.begin() + text);
+		for (line_info& line : m_Lines)
+		{
+			line.Text -= text;
+			line.Span -= span;
+		}
+		for (span_info& info : m_Spans)
+			info.Offset -= text;
+	}
+
+	void console::clear()
+	{
+		m_Trimmed = 0;
+		m_ScrollY = 0.f;
+		m_Lines.clear();
+		m_Spans.clear();
+		m_Text.clear();
+	}
+
+	void console::render(const char* str_id, const ImVec2& size)
+	{
+		drain();
+
+		// Lines can come by thousands per frame: size the content and scroll up front, so the clipper sees this frame's lines at the right place
+		const float line_height = ImGui::GetTextLineHeightWithSpacing();
+		const float content_height = std::max(0.f, static_cast<float>(m_Lines.size()) * line_height - ImGui::GetStyle().ItemSpacing.y);
+		ImGui::SetNextWindowContentSize({ 0.f, content_height });
+		if (m_Follow && m_AtBottom)
+			ImGui::SetNextWindowScroll({ -1.f, content_height });
+		else if (m_Trimmed)
+			ImGui::SetNextWindowScroll({ -1.f, std::max(0.f, m_ScrollY - static_cast<float>(m_Trimmed) * line_height) });
+		m_Trimmed = 0;
+
+		if (!ImGui::BeginChild(str_id, size, false, ImGuiWindowFlags_HorizontalScrollbar))
+		{
+			ImGui::EndChild();
+			return;
+		}
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(std::min(m_Lines.size(), static_cast<size_t>(INT_MAX))), line_height);
+		while (clipper.Step())
+		{
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				const line_info& line = m_Lines[i];
+				if (line.SpanCount == 0)
+				{
+					ImGui::NewLine();
+					continue;
+				}
+
+				for (size_t s = 0; s < line.SpanCount; s++)
+				{
+					const span_info& span = m_Spans[line.Span + s];
+					const char* text = m_Text.data() + span.Offset;
+					if (s != 0)
+						ImGui::SameLine(0.f, 0.f);
+					if (span.Color != text_color)
+						ImGui::PushStyleColor(ImGuiCol_Text, span.Color);
+					ImGui::TextUnformatted(text, text + span.Size);
+					if (span.Color != text_color)
+						ImGui::PopStyleColor();
+				}
+			}
+		}
+
+		// Follow again once the user scrolls back to the bottom
+		m_ScrollY = ImGui::GetScrollY();
+		m_AtBottom = m_ScrollY >= ImGui::GetScrollMaxY();
+
+		ImGui::EndChild();
+	}
+}
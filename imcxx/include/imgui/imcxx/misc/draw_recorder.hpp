@@ -0,0 +1,73 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Records draw list commands on worker threads (charts, maps, large polylines...), then appends them to a draw list of the frame on the UI thread.
+	/// - 'record()' takes a copy of the current font and draw list settings and queues the function, it runs on a worker with a private ImDrawList.
+	/// - 'splice()' waits for the recording and appends its commands where the draw list is at (a recording no worker took yet is drawn there directly),
+	///   so the result is the same as drawing on the UI thread at that point, whatever the number of threads.
+	/// - Recording functions must only use the ImDrawList they receive: no ImGui:: call, the font atlas must not be rebuilt before 'splice()'.
+	///   Glyphs of fonts with ImFontConfig::DynamicGlyphs are logged by the recording and 'splice()' marks them as used on the UI thread:
+	///   glyphs not rasterized yet are drawn with the fallback glyph, then requested like with ImGui::Text().
+	/// - Each ticket is spliced once, before the next frame. Private draw lists keep their memory between frames
+	///   (while they grow, io.MetricsActiveAllocations is updated from several threads and may be off).
+	///
+	/// static imcxx::misc::draw_recorder recorder;
+	/// const auto ticket = recorder.record([&points](ImDrawList& draw_list) { draw_list.AddPolyline(points.data(), points.size(), IM_COL32_WHITE, 0, 1.0f); });
+	/// // ... other widgets
+	/// recorder.splice(ticket);
+	/// </summary>
+	class draw_recorder
+	{
+	public:
+		using record_fn = std::function<void(ImDrawList&)>;
+
+		/// <summary>
+		/// 'threads' workers, by default one less than the number of cores.
+		/// With no worker, every recording runs in 'splice()'.
+		/// </summary>
+		IMGUI_API explicit draw_recorder(unsigned threads = default_threads());
+		IMGUI_API ~draw_recorder();
+
+		draw_recorder(const draw_recorder&) = delete;
+		draw_recorder& operator=(const draw_recorder&) = delete;
+
+		/// <summary>
+		/// Queue a recording clipped to the current clip rect of the window.
+		/// Returns the ticket to pass to 'splice()'.
+		/// </summary>
+		IMGUI_API size_t record(record_fn fn);
+
+		/// <summary>
+		/// Queue a recording clipped to [clip_min, clip_max]
+		/// </summary>
+		IMGUI_API size_t record(record_fn fn, const ImVec2& clip_min, const ImVec2& clip_max);
+
+		/// <summary>
+		/// Wait for a recording and append it to 'draw_list', the window draw list by default.
+		/// </summary>
+		IMGUI_API void splice(size_t ticket, ImDrawList* draw_list = nullptr);
+
+		/// <summary>
+		/// Wait for every recording of the frame
+		/// </summary>
+		IMGUI_API void wait();
+
+		/// <summary>
+		/// Append the commands of 'src' to 'dst' at its current position, same as 'imcxx::append_draw_list()'.
+		/// </summary>
+		IMGUI_API static void append(ImDrawList* dst, const ImDrawList& src);
+
+		[[nodiscard]] IMGUI_API static unsigned default_threads() noexcept;
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+	};
+}
@@ -0,0 +1,243 @@
+#include "../draw_recorder.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "imgui/imcxx/draw_list.hpp"
+
+namespace imcxx::misc
+{
+	struct draw_recorder::data
+	{
+		enum class job_state
+		{
+			queued,
+			running,
+			done
+		};
+
+		struct job
+		{
+			record_fn Fn;
+			// Snapshot of the font and tessellation settings, read by the private draw list
+			ImDrawListSharedData Shared;
+			// Glyphs rasterized on demand drawn by the recording, the fonts are updated on the UI thread by 'splice()'
+			ImFontGlyphUses GlyphUses;
+			ImDrawList DrawList{ &Shared };
+			ImVec4 ClipRect;
+			ImVec2 VtxOrigin;
+			ImTextureID TextureId;
+			job_state State;
+		};
+
+		std::mutex Mutex;
+		std::condition_variable Wakeup;
+		std::condition_variable Finished;
+
+		// Guarded by 'Mutex': Jobs[0, JobsCount) are the jobs of the frame, none of Jobs[0, NextJob) is queued
+		std::vector<std::unique_ptr<job>> Jobs;
+		size_t JobsCount{};
+		size_t NextJob{};
+		bool Quit{};
+
+		int Frame{ -1 };
+		std::vector<std::thread> Workers;
+
+		~data()
+		{
+			{
+				std::lock_guard lock(Mutex);
+				Quit = true;
+			}
+			Wakeup.notify_all();
+			for (std::thread& worker : Workers)
+				worker.join();
+		}
+
+		/// <summary>
+		/// Oldest queued job, marked as running, or nullptr
+		/// </summary>
+		job* take()
+		{
+			for (; NextJob < JobsCount; NextJob++)
+			{
+				job& j = *Jobs[NextJob];
+				if (j.State == job_state::queued)
+				{
+					j.State = job_state::running;
+					return &j;
+				}
+			}
+			return nullptr;
+		}
+
+		static void record_into(job& j, ImDrawList& draw_list)
+		{
+			draw_list.PushTextureID(j.TextureId);
+			draw_list.PushClipRect({ j.ClipRect.x, j.ClipRect.y }, { j.ClipRect.z, j.ClipRect.w });
+			j.Fn(draw_list);
+			draw_list.PopClipRect();
+			draw_list.PopTextureID();
+		}
+
+		static void run(job& j)
+		{
+			j.DrawList._ResetForNewFrame();
+			j.DrawList.VtxOrigin = j.VtxOrigin;
+			record_into(j, j.DrawList);
+			j.DrawList._PopUnusedDrawCmd();
+		}
+
+		void work()
+		{
+			std::unique_lock lock(Mutex);
+			for (;;)
+			{
+				job* j = nullptr;
+				Wakeup.wait(lock, [&]() { return Quit || (j = take()) != nullptr; });
+				if (Quit)
+					return;
+
+				lock.unlock();
+				run(*j);
+				lock.lock();
+				j->State = job_state::done;
+				Finished.notify_all();
+			}
+		}
+
+		/// <summary>
+		/// Wait for a job taken by a worker, the calling thread runs the queued jobs in the meantime
+		/// </summary>
+		void wait(const job& target, std::unique_lock<std::mutex>& lock)
+		{
+			while (target.State != job_state::done)
+			{
+				if (job* j = take())
+				{
+					lock.unlock();
+					run(*j);
+					lock.lock();
+					j->State = job_state::done;
+					Finished.notify_all();
+				}
+				else
+					Finished.wait(lock);
+			}
+		}
+	};
+
+
+	draw_recorder::draw_recorder(unsigned threads) :
+		m_Data(std::make_unique<data>())
+	{
+		m_Data->Workers.reserve(threads);
+		for (unsigned i = 0; i < threads; i++)
+			m_Data->Workers.emplace_back(&data::work, m_Data.get());
+	}
+
+	draw_recorder::~draw_recorder() = default;
+
+	unsigned draw_recorder::default_threads() noexcept
+	{
+		const unsigned cores = std::thread::hardware_concurrency();
+		return cores > 1 ? cores - 1 : 0;
+	}
+
+	size_t draw_recorder::record(record_fn fn)
+	{
+		const ImVec4& clip_rect = ImGui::GetWindowDrawList()->_CmdHeader.ClipRect;
+		return record(std::move(fn), { clip_rect.x, clip_rect.y }, { clip_rect.z, clip_rect.w });
+	}
+
+	size_t draw_recorder::record(record_fn fn, const ImVec2& clip_min, const ImVec2& clip_max)
+	{
+		data& d = *m_Data;
+
+		// Tickets of the previous frame are dropped, their draw lists are reused
+		if (d.Frame != ImGui::GetFrameCount())
+		{
+			std::unique_lock lock(d.Mutex);
+			for (size_t i = 0; i < d.JobsCount; i++)
+			{
+				if (d.Jobs[i]->State == data::job_state::queued)
+					d.Jobs[i]->State = data::job_state::done;
+				else
+					d.wait(*d.Jobs[i], lock);
+			}
+			d.JobsCount = d.NextJob = 0;
+			d.Frame = ImGui::GetFrameCount();
+		}
+
+		size_t ticket;
+		{
+			std::lock_guard lock(d.Mutex);
+			ticket = d.JobsCount;
+			if (ticket == d.Jobs.size())
+				d.Jobs.push_back(std::make_unique<data::job>());
+
+			data::job& j = *d.Jobs[ticket];
+			j.Fn = std::move(fn);
+			j.Shared = *ImGui::GetDrawListSharedData();
+			j.Shared.ArcCache = nullptr; // Owned by the context, not thread-safe
+			j.Shared.GlyphUses = &j.GlyphUses; // Fonts are not thread-safe either
+			j.GlyphUses.Clear();
+			j.ClipRect = { clip_min.x, clip_min.y, clip_max.x, clip_max.y };
+			j.VtxOrigin = ImGui::GetWindowDrawList()->VtxOrigin;
+			j.TextureId = ImGui::GetWindowDrawList()->_CmdHeader.TextureId;
+			j.State = data::job_state::queued;
+			d.JobsCount++;
+		}
+		d.Wakeup.notify_one();
+		return ticket;
+	}
+
+	void draw_recorder::splice(size_t ticket, ImDrawList* draw_list)
+	{
+		data& d = *m_Data;
+		IM_ASSERT(d.Frame == ImGui::GetFrameCount() && ticket < d.JobsCount && "Ticket of a previous frame");
+		if (d.Frame != ImGui::GetFrameCount() || ticket >= d.JobsCount)
+			return;
+
+		if (!draw_list)
+			draw_list = ImGui::GetWindowDrawList();
+
+		data::job& j = *d.Jobs[ticket];
+		std::unique_lock lock(d.Mutex);
+		if (j.State == data::job_state::queued)
+		{
+			// No worker took it yet: record straight into the destination, with the settings of the snapshot
+			j.State = data::job_state::running;
+			lock.unlock();
+			const ImDrawListSharedData* shared = draw_list->_Data;
+			draw_list->_Data = &j.Shared;
+			data::record_into(j, *draw_list);
+			draw_list->_Data = shared;
+			ImFontMarkGlyphsUsed(draw_list->_Data, j.GlyphUses);
+			lock.lock();
+			j.State = data::job_state::done;
+			d.Finished.notify_all();
+			return;
+		}
+
+		d.wait(j, lock);
+		lock.unlock();
+		append(draw_list, j.DrawList);
+		ImFontMarkGlyphsUsed(draw_list->_Data, j.GlyphUses);
+	}
+
+	void draw_recorder::wait()
+	{
+		data& d = *m_Data;
+		std::unique_lock lock(d.Mutex);
+		for (size_t i = 0; i < d.JobsCount; i++)
+			d.wait(*d.Jobs[i], lock);
+	}
+
+	void draw_recorder::append(ImDrawList* dst, const ImDrawList& src)
+	{
+		append_draw_list(dst, src);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Builds font atlases on a worker thread (large glyph ranges, DPI changes) while the current atlas keeps rendering.
+	/// - 'build()' queues a setup function: it runs on the worker with a new ImFontAtlas, which is then built (and converted to RGBA32 if the current atlas is).
+	///   Setup functions must only use the atlas they receive: no ImGui:: call, glyph ranges and font data must outlive the atlas
+	///   (while it builds, io.MetricsActiveAllocations is updated from the worker and may be off).
+	/// - 'apply()', between two frames (before ImGui::NewFrame()), swaps the built atlas into io.Fonts and calls 'upload' so the backend replaces the font texture,
+	///   then deletes the previous atlas if the context owned it. The new atlas is owned by the context.
+	/// - The ImFont* of the previous atlas are invalid after the swap: io.FontDefault is reset, fonts kept elsewhere must be taken again from io.Fonts->Fonts.
+	///   Text size caches are cleared and io.Fonts->BuildCount keeps increasing, so retained text and cached children are rebuilt.
+	/// - A build requested while another is running replaces it: only the latest one is applied.
+	///
+	/// static imcxx::misc::font_loader loader{ []() { ImGui_ImplDX9_InvalidateDeviceObjects(); ImGui_ImplDX9_CreateDeviceObjects(); } };
+	/// loader.build([scale](ImFontAtlas& atlas) { atlas.AddFontFromFileTTF("NotoSansJP.ttf", 18.f * scale, nullptr, atlas.GetGlyphRangesJapanese()); });
+	/// imcxx::frame frame{ []() { loader.apply(); ImGui_ImplDX9_NewFrame(); ImGui_ImplWin32_NewFrame(); } };
+	/// </summary>
+	class font_loader
+	{
+	public:
+		using setup_fn = std::function<void(ImFontAtlas&)>;
+		using upload_fn = std::function<void()>;
+
+		/// <summary>
+		/// 'upload' is called on the UI thread after io.Fonts was swapped: it must release the backend texture of the previous atlas and create the one of io.Fonts,
+		/// for most backends with 'ImGui_ImplXXX_InvalidateDeviceObjects()' then 'ImGui_ImplXXX_CreateDeviceObjects()'.
+		/// </summary>
+		IMGUI_API explicit font_loader(upload_fn upload);
+
+		/// <summary>
+		/// Waits for the running build, a built atlas which was not applied is deleted.
+		/// </summary>
+		IMGUI_API ~font_loader();
+
+		font_loader(const font_loader&) = delete;
+		font_loader& operator=(const font_loader&) = delete;
+
+		/// <summary>
+		/// UI thread: queue the build of a new atlas. Flags, TexDesiredWidth, TexGlyphPadding and TexDynamicGlyphsHeight are copied from io.Fonts before 'setup' runs.
+		/// </summary>
+		IMGUI_API void build(setup_fn setup);
+
+		/// <summary>
+		/// UI thread, outside of a frame: swap in the last built atlas, returns true when it did.
+		/// A finished build requests a redraw of the context current in 'build()' from 'imcxx::frame_scheduler', so that an idle application applies it.
+		/// </summary>
+		IMGUI_API bool apply();
+
+		/// <summary>
+		/// A build is queued, running or waiting for 'apply()'
+		/// </summary>
+		[[nodiscard]] IMGUI_API bool is_pending() const;
+
+		/// <summary>
+		/// Duration of the last build on the worker, in seconds
+		/// </summary>
+		[[nodiscard]] IMGUI_API double last_build_time() const;
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+	};
+}
@@ -0,0 +1,183 @@
+#include "../font_loader.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "imgui/imcxx/frames.hpp"
+
+namespace imcxx::misc
+{
+	struct font_loader::data
+	{
+		/// <summary>
+		/// Settings of io.Fonts when the build was queued
+		/// </summary>
+		struct settings
+		{
+			ImFontAtlasFlags Flags;
+			int TexDesiredWidth;
+			int TexGlyphPadding;
+			int TexDynamicGlyphsHeight;
+			bool Rgba32;
+			ImGuiContext* Context;	// Gets the redraw request of the built atlas
+		};
+
+		upload_fn Upload;
+
+		std::mutex Mutex;
+		std::condition_variable Wakeup;
+
+		// Guarded by 'Mutex': the latest requested build, whether the worker is building, and the built atlas waiting for 'apply()'
+		setup_fn Pending;
+		settings PendingSettings{};
+		bool Building{};
+		ImFontAtlas* Built{};
+		double LastBuildTime{};
+		bool Quit{};
+
+		std::thread Worker;
+
+		~data()
+		{
+			{
+				std::lock_guard lock(Mutex);
+				Quit = true;
+			}
+			Wakeup.notify_all();
+			if (Worker.joinable())
+				Worker.join();
+			if (Built)
+				IM_DELETE(Built);
+		}
+
+		static ImFontAtlas* run(const setup_fn& setup, const settings& s)
+		{
+			ImFontAtlas* atlas = IM_NEW(ImFontAtlas)();
+			atlas->Flags = s.Flags;
+			atlas->TexDesiredWidth = s.TexDesiredWidth;
+			atlas->TexGlyphPadding = s.TexGlyphPadding;
+			atlas->TexDynamicGlyphsHeight = s.TexDynamicGlyphsHeight;
+			setup(*atlas);
+			if (!atlas->Build())
+			{
+				IM_DELETE(atlas);
+				return nullptr;
+			}
+
+			// The backend would otherwise convert the pixels on the UI thread when uploading them
+			if (s.Rgba32)
+			{
+				unsigned char* pixels;
+				int width, height;
+				atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+			}
+			return atlas;
+		}
+
+		void work()
+		{
+			std::unique_lock lock(Mutex);
+			for (;;)
+			{
+				Wakeup.wait(lock, [&]() { return Quit || Pending; });
+				if (Quit)
+					return;
+
+				const setup_fn setup = std::move(Pending);
+				const settings s = PendingSettings;
+				Pending = nullptr;
+				Building = true;
+
+				lock.unlock();
+				const auto start = std::chrono::steady_clock::now();
+				ImFontAtlas* atlas = run(setup, s);
+				const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+				lock.lock();
+
+				Building = false;
+				LastBuildTime = seconds;
+				if (!atlas)
+					continue;
+
+				// Superseded by a newer request
+				if (Pending)
+				{
+					IM_DELETE(atlas);
+					continue;
+				}
+
+				if (Built)
+					IM_DELETE(Built);
+				Built = atlas;
+				frame_scheduler::request_redraw(0.0, s.Context);
+			}
+		}
+	};
+
+
+	font_loader::font_loader(upload_fn upload) :
+		m_Data(std::make_unique<data>())
+	{
+		m_Data->Upload = std::move(upload);
+		m_Data->Worker = std::thread(&data::work, m_Data.get());
+	}
+
+	font_loader::~font_loader() = default;
+
+	void font_loader::build(setup_fn setup)
+	{
+		const ImFontAtlas* current = ImGui::GetIO().Fonts;
+		{
+			std::lock_guard lock(m_Data->Mutex);
+			m_Data->Pending = std::move(setup);
+			m_Data->PendingSettings = { current->Flags, current->TexDesiredWidth, current->TexGlyphPadding, current->TexDynamicGlyphsHeight, current->TexPixelsRGBA32 != nullptr, GImGui };
+		}
+		m_Data->Wakeup.notify_one();
+	}
+
+	bool font_loader::apply()
+	{
+		ImGuiContext& g = *GImGui;
+		IM_ASSERT(!g.WithinFrameScope && "Call apply() before ImGui::NewFrame()");
+
+		ImFontAtlas* atlas;
+		{
+			std::lock_guard lock(m_Data->Mutex);
+			atlas = m_Data->Built;
+			m_Data->Built = nullptr;
+		}
+		if (!atlas)
+			return false;
+
+		// Fonts of the new atlas can land at the addresses of the previous ones: caches keyed by ImFont* also check BuildCount
+		ImFontAtlas* previous = g.IO.Fonts;
+		atlas->BuildCount += previous->BuildCount;
+		g.IO.Fonts = atlas;
+		g.IO.FontDefault = nullptr;
+		if (m_Data->Upload)
+			m_Data->Upload();
+		ImGui::ClearTextSizeCache();
+
+		if (g.FontAtlasOwnedByContext)
+		{
+			previous->Locked = false;
+			IM_DELETE(previous);
+		}
+		g.FontAtlasOwnedByContext = true;
+		return true;
+	}
+
+	bool font_loader::is_pending() const
+	{
+		std::lock_guard lock(m_Data->Mutex);
+		return m_Data->Pending || m_Data->Building || m_Data->Built;
+	}
+
+	double font_loader::last_build_time() const
+	{
+		std::lock_guard lock(m_Data->Mutex);
+		return m_Data->LastBuildTime;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cfloat>
+#include <memory>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Line plot for series of millions of samples (telemetry, recordings) with pan and zoom.
+	/// - Samples are copied into the plot, which keeps a min/max pyramid over them: each level holds the min and max of blocks of 8 entries of the level below.
+	/// - Drawing picks the level with the largest blocks that fit in a pixel column, and draws a polyline with a vertical strip from the min to the max of each column
+	///   (2 points per column): no spike is lost, and the cost depends on the width of the plot, not on the number of samples.
+	/// - Appending samples only updates the last block of each level.
+	/// - Mouse wheel zooms around the mouse, dragging pans, double-click shows the whole series (and keeps showing it as samples are appended).
+	///
+	/// static imcxx::misc::line_plot plot;
+	/// plot.append(samples.data(), samples.size());
+	/// plot.render("##telemetry", { -FLT_MIN, 200.f });
+	/// </summary>
+	class line_plot
+	{
+	public:
+		IMGUI_API line_plot();
+		IMGUI_API ~line_plot();
+
+		line_plot(const line_plot&) = delete;
+		line_plot& operator=(const line_plot&) = delete;
+
+		/// <summary>
+		/// Replace the samples, the pyramid is built again
+		/// </summary>
+		IMGUI_API void assign(const float* values, size_t count);
+
+		/// <summary>
+		/// Add samples at the end of the series
+		/// </summary>
+		IMGUI_API void append(const float* values, size_t count);
+
+		void append(float value)
+		{
+			append(&value, 1);
+		}
+
+		IMGUI_API void clear();
+
+		[[nodiscard]] IMGUI_API size_t size() const;
+
+		/// <summary>
+		/// Draw the plot. A 'size' of 0 uses the item width and 4 frames of height, negative values are relative to the right/bottom edges (see ImGui::CalcItemSize()).
+		/// The vertical range is the min and max of the visible samples unless 'scale_min'/'scale_max' are set.
+		/// </summary>
+		IMGUI_API void render(const char* str_id, const ImVec2& size = {}, float scale_min = FLT_MAX, float scale_max = FLT_MAX);
+
+		/// <summary>
+		/// Show samples [first, last), fractional to zoom in between samples
+		/// </summary>
+		IMGUI_API void set_view(double first, double last);
+
+		/// <summary>
+		/// Show the whole series, until the view is changed
+		/// </summary>
+		IMGUI_API void fit();
+
+		[[nodiscard]] IMGUI_API double view_first() const;
+		[[nodiscard]] IMGUI_API double view_last() const;
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+	};
+}
@@ -0,0 +1,386 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "../line_plot.hpp"
+
+#include "imgui/imgui_internal.h"
+
+
+namespace imcxx::misc
+{
+	struct line_plot::data
+	{
+		/// <summary>
+		/// Min and max of a block, Min > Max when the block only has NaN samples
+		/// </summary>
+		struct min_max
+		{
+			float Min;
+			float Max;
+		};
+
+		/// <summary>
+		/// Samples drawn in a pixel column: their min and max, and the indices of the first and last ones to join the neighbour columns
+		/// </summary>
+		struct column
+		{
+			float Min;
+			float Max;
+			size_t First;
+			size_t Last;
+		};
+
+		static constexpr size_t block_size = 8;
+
+		std::vector<float> Values;
+		// Levels[k] holds the min/max of blocks of 8^(k+1) samples, the last level has a single block
+		std::vector<std::vector<min_max>> Levels;
+
+		double ViewFirst{};
+		double ViewLast{};
+		bool Fit{ true };
+
+		// Reused every frame: the points of the polylines, each run ends at RunEnds[i]
+		std::vector<column> Columns;
+		std::vector<ImVec2> Points;
+		std::vector<int> RunEnds;
+
+		/// <summary>
+		/// Recompute the blocks of every level which cover samples from 'first' to the end
+		/// </summary>
+		void update_levels(size_t first)
+		{
+			size_t first_below = first;
+			for (size_t k = 0;; k++)
+			{
+				const size_t below_count = k ? Levels[k - 1].size() : Values.size();
+				if (below_count <= 1)
+				{
+					Levels.resize(k);
+					return;
+				}
+				if (k == Levels.size())
+					Levels.emplace_back();
+
+				std::vector<min_max>& level = Levels[k];
+				const size_t first_block = first_below / block_size;
+				level.resize((below_count + block_size - 1) / block_size);
+				for (size_t b = first_block; b < level.size(); b++)
+				{
+					const size_t begin = b * block_size;
+					const size_t end = std::min(begin + block_size, below_count);
+					min_max block{ FLT_MAX, -FLT_MAX };
+					if (k == 0)
+					{
+						for (size_t i = begin; i < end; i++)
+						{
+							// NaN samples fail both comparisons and are ignored
+							const float v = Values[i];
+							block.Min = v < block.Min ? v : block.Min;
+							block.Max = v > block.Max ? v : block.Max;
+						}
+					}
+					else
+					{
+						const std::vector<min_max>& below = Levels[k - 1];
+						for (size_t i = begin; i < end; i++)
+						{
+							block.Min = below[i].Min < block.Min ? below[i].Min : block.Min;
+							block.Max = below[i].Max > block.Max ? below[i].Max : block.Max;
+						}
+					}
+					level[b] = block;
+				}
+				first_below = first_block;
+			}
+		}
+
+		/// <summary>
+		/// View shown for the current samples
+		/// </summary>
+		void clamped_view(double& first, double& last) const
+		{
+			const double count = static_cast<double>(Values.size());
+			if (Fit)
+			{
+				first = 0.;
+				last = count;
+				return;
+			}
+
+			// At least 2 samples across the plot, at most the whole series
+			const double span = std::clamp(ViewLast - ViewFirst, std::min(2., count), count);
+			first = std::clamp(ViewFirst, 0., count - span);
+			last = first + span;
+		}
+
+		void clamp_view()
+		{
+			clamped_view(ViewFirst, ViewLast);
+		}
+
+		/// <summary>
+		/// End the current polyline, a single point is dropped
+		/// </summary>
+		void end_run()
+		{
+			const int begin = RunEnds.empty() ? 0 : RunEnds.back();
+			const int end = static_cast<int>(Points.size());
+			if (end - begin < 2)
+			{
+				Points.resize(static_cast<size_t>(begin));
+				return;
+			}
+
+			// A lone flat column is drawn a pixel high
+			ImVec2& last = Points.back();
+			if (end - begin == 2 && Points[begin].x == last.x && ImFabs(last.y - Points[begin].y) < 1.f)
+				last.y = Points[begin].y + 1.f;
+			RunEnds.push_back(end);
+		}
+
+		/// <summary>
+		/// Min/max of the samples of each of the 'width' columns of the view, from the level with the largest blocks not wider than a column
+		/// </summary>
+		void build_columns(int width, double samples_per_column)
+		{
+			size_t step = 1;
+			const std::vector<min_max>* level = nullptr;
+			for (const std::vector<min_max>& next : Levels)
+			{
+				if (static_cast<double>(step * block_size) > samples_per_column)
+					break;
+				step *= block_size;
+				level = &next;
+			}
+
+			Columns.assign(static_cast<size_t>(width), { FLT_MAX, -FLT_MAX, SIZE_MAX, 0 });
+			const size_t count = Values.size();
+			const size_t blocks_count = level ? level->size() : count;
+			const size_t first_block = static_cast<size_t>(std::max(0., ViewFirst) / static_cast<double>(step));
+			const size_t end_block = std::min(blocks_count, static_cast<size_t>(std::ceil(ViewLast / static_cast<double>(step))));
+			for (size_t b = first_block; b < end_block; b++)
+			{
+				// Each block goes to the column of its first sample, so the samples of a column are contiguous
+				const size_t begin = b * step;
+				const int c = std::clamp(static_cast<int>((static_cast<double>(begin) - ViewFirst) / samples_per_column), 0, width - 1);
+				const min_max block = level ? (*level)[b] : min_max{ Values[b], Values[b] };
+				column& col = Columns[static_cast<size_t>(c)];
+				col.Min = block.Min < col.Min ? block.Min : col.Min;
+				col.Max = block.Max > col.Max ? block.Max : col.Max;
+				if (col.First == SIZE_MAX)
+					col.First = begin;
+				col.Last = std::min(begin + step, count) - 1;
+			}
+		}
+	};
+
+
+	line_plot::line_plot() :
+		m_Data(std::make_unique<data>())
+	{
+	}
+
+	line_plot::~line_plot() = default;
+
+	void line_plot::assign(const float* values, size_t count)
+	{
+		m_Data->Values.assign(values, values + count);
+		m_Data->Levels.clear();
+		m_Data->update_levels(0);
+	}
+
+	void line_plot::append(const float* values, size_t count)
+	{
+		if (!count)
+			return;
+		const size_t first = m_Data->Values.size();
+		m_Data->Values.insert(m_Data->Values.end(), values, values + count);
+		m_Data->update_levels(first);
+	}
+
+	void line_plot::clear()
+	{
+		m_Data->Values.clear();
+		m_Data->Levels.clear();
+	}
+
+	size_t line_plot::size() const
+	{
+		return m_Data->Values.size();
+	}
+
+	void line_plot::set_view(double first, double last)
+	{
+		m_Data->ViewFirst = std::min(first, last);
+		m_Data->ViewLast = std::max(first, last);
+		m_Data->Fit = false;
+	}
+
+	void line_plot::fit()
+	{
+		m_Data->Fit = true;
+	}
+
+	double line_plot::view_first() const
+	{
+		double first, last;
+		m_Data->clamped_view(first, last);
+		return first;
+	}
+
+	double line_plot::view_last() const
+	{
+		double first, last;
+		m_Data->clamped_view(first, last);
+		return last;
+	}
+
+	void line_plot::render(const char* str_id, const ImVec2& size, float scale_min, float scale_max)
+	{
+		ImGuiWindow* const window = ImGui::GetCurrentWindow();
+		if (window->SkipItems)
+			return;
+
+		data& d = *m_Data;
+		const ImGuiStyle& style = ImGui::GetStyle();
+		const ImGuiID id = window->GetID(str_id);
+		const ImVec2 frame_size = ImGui::CalcItemSize(size, ImGui::CalcItemWidth(), ImGui::GetFrameHeight() * 4.f);
+		const ImVec2 pos = window->DC.CursorPos;
+		const ImRect frame_bb(pos.x, pos.y, pos.x + frame_size.x, pos.y + frame_size.y);
+		const ImRect inner_bb(frame_bb.Min.x + style.FramePadding.x, frame_bb.Min.y + style.FramePadding.y, frame_bb.Max.x - style.FramePadding.x, frame_bb.Max.y - style.FramePadding.y);
+		ImGui::ItemSize(frame_bb, style.FramePadding.y);
+		if (!ImGui::ItemAdd(frame_bb, id))
+			return;
+
+		bool hovered, held;
+		ImGui::ButtonBehavior(frame_bb, id, &hovered, &held);
+		ImGui::SetItemUsingMouseWheel();
+		ImGui::RenderFrame(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+		const int width = std::max(static_cast<int>(inner_bb.GetWidth()), 1);
+		const size_t count = d.Values.size();
+		if (count < 2)
+			return;
+
+		// Pan and zoom
+		const ImGuiIO& io = ImGui::GetIO();
+		d.clamp_view();
+		double samples_per_column = (d.ViewLast - d.ViewFirst) / width;
+		if (hovered && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+			d.Fit = true;
+		else if (held && io.MouseDelta.x != 0.f)
+		{
+			d.ViewFirst -= io.MouseDelta.x * samples_per_column;
+			d.ViewLast -= io.MouseDelta.x * samples_per_column;
+			d.Fit = false;
+		}
+		if (hovered && io.MouseWheel != 0.f)
+		{
+			const double pivot = d.ViewFirst + (io.MousePos.x - inner_bb.Min.x) * samples_per_column;
+			const double zoom = std::pow(0.8, static_cast<double>(io.MouseWheel));
+			d.ViewFirst = pivot - (pivot - d.ViewFirst) * zoom;
+			d.ViewLast = pivot + (d.ViewLast - pivot) * zoom;
+			d.Fit = false;
+		}
+		d.clamp_view();
+		samples_per_column = (d.ViewLast - d.ViewFirst) / width;
+
+		d.Points.clear();
+		d.RunEnds.clear();
+		const float x0 = inner_bb.Min.x;
+		const float y0 = inner_bb.Max.y;
+		const float height = inner_bb.GetHeight();
+		int hovered_column = -1;
+		if (hovered && inner_bb.Contains(io.MousePos))
+			hovered_column = std::clamp(static_cast<int>(io.MousePos.x - inner_bb.Min.x), 0, width - 1);
+
+		if (samples_per_column <= 1.)
+		{
+			// Zoomed in: a point per sample
+			const size_t first = static_cast<size_t>(d.ViewFirst);
+			const size_t last = std::min(count - 1, static_cast<size_t>(std::ceil(d.ViewLast)));
+			float v_min = FLT_MAX, v_max = -FLT_MAX;
+			for (size_t i = first; i <= last; i++)
+			{
+				v_min = d.Values[i] < v_min ? d.Values[i] : v_min;
+				v_max = d.Values[i] > v_max ? d.Values[i] : v_max;
+			}
+			scale_min = scale_min == FLT_MAX ? v_min : scale_min;
+			scale_max = scale_max == FLT_MAX ? v_max : scale_max;
+			const float inv_scale = scale_min == scale_max ? 0.f : 1.f / (scale_max - scale_min);
+
+			const auto x_of = [&](size_t i) { return x0 + static_cast<float>((static_cast<double>(i) - d.ViewFirst) / samples_per_column); };
+			const auto y_of = [&](float v) { return y0 - ImSaturate((v - scale_min) * inv_scale) * height; };
+			// NaN samples break the line
+			for (size_t i = first; i <= last; i++)
+			{
+				if (d.Values[i] == d.Values[i])
+					d.Points.push_back({ x_of(i), y_of(d.Values[i]) });
+				else
+					d.end_run();
+			}
+			d.end_run();
+
+			if (hovered_column >= 0)
+			{
+				const size_t i = std::min(count - 1, static_cast<size_t>(d.ViewFirst + (io.MousePos.x - x0) * samples_per_column + 0.5));
+				ImGui::SetTooltip("%zu: %8.4g", i, d.Values[i]);
+			}
+		}
+		else
+		{
+			d.build_columns(width, samples_per_column);
+			float v_min = FLT_MAX, v_max = -FLT_MAX;
+			for (const data::column& col : d.Columns)
+			{
+				v_min = col.Min < v_min ? col.Min : v_min;
+				v_max = col.Max > v_max ? col.Max : v_max;
+			}
+			scale_min = scale_min == FLT_MAX ? v_min : scale_min;
+			scale_max = scale_max == FLT_MAX ? v_max : scale_max;
+			const float inv_scale = scale_min == scale_max ? 0.f : 1.f / (scale_max - scale_min);
+			const auto y_of = [&](float v) { return y0 - ImSaturate((v - scale_min) * inv_scale) * height; };
+
+			// A vertical strip per column from the min to the max of its samples, in the order of the first and last samples, all joined in a polyline:
+			// 2 points per column, no spike is lost and the line goes on into the next column. Columns with only NaN samples break the line.
+			for (int c = 0; c < width; c++)
+			{
+				const data::column& col = d.Columns[static_cast<size_t>(c)];
+				if (col.Min > col.Max)
+				{
+					d.end_run();
+					continue;
+				}
+
+				const float x = x0 + static_cast<float>(c);
+				const float y_min = y_of(col.Min);
+				const float y_max = y_of(col.Max);
+				const bool rising = !(d.Values[col.Last] < d.Values[col.First]);
+				d.Points.push_back({ x, rising ? y_min : y_max });
+				d.Points.push_back({ x, rising ? y_max : y_min });
+			}
+			d.end_run();
+
+			if (hovered_column >= 0)
+			{
+				const data::column& col = d.Columns[static_cast<size_t>(hovered_column)];
+				if (col.Min <= col.Max)
+					ImGui::SetTooltip("%zu..%zu\nmin: %8.4g\nmax: %8.4g", col.First, col.Last, col.Min, col.Max);
+			}
+		}
+
+		ImDrawList* draw_list = window->DrawList;
+		draw_list->PushClipRect(frame_bb.Min, frame_bb.Max, true);
+		const ImU32 color = ImGui::GetColorU32(ImGuiCol_PlotLines);
+		int begin = 0;
+		for (const int end : d.RunEnds)
+		{
+			draw_list->AddPolyline(d.Points.data() + begin, end - begin, color, ImDrawFlags_None, 1.f);
+			begin = end;
+		}
+		draw_list->PopClipRect();
+	}
+}
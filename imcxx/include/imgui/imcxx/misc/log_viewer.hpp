@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Read-only viewer for large and growing text files, such as service logs
+	/// - The file is memory-mapped and nothing is copied: visible lines are drawn straight from the mapping with ImGui::TextUnformatted(begin, end).
+	/// - A worker thread builds the line index (one offset per line) and keeps polling the file, lines are appended as the file grows (tail -f).
+	/// - Opening does not depend on the size of the file, lines show up as soon as they are indexed.
+	/// - A file which shrinks (truncated or replaced) is indexed again from the start.
+	///   Accessing a mapping of a file truncated by another process can fault before the change is noticed, prefer logs rotated by renaming.
+	/// </summary>
+	class log_viewer
+	{
+	public:
+		IMGUI_API log_viewer();
+		IMGUI_API ~log_viewer();
+
+		log_viewer(const log_viewer&) = delete;
+		log_viewer& operator=(const log_viewer&) = delete;
+
+		/// <summary>
+		/// Map the file and start indexing it, the previous file is closed.
+		/// </summary>
+		IMGUI_API bool open(const char* path);
+
+		/// <summary>
+		/// Stop indexing and unmap the file
+		/// </summary>
+		IMGUI_API void close();
+
+		[[nodiscard]] IMGUI_API bool is_open() const;
+
+		/// <summary>
+		/// Draw the visible lines in a child window, 'size' is the same as in ImGui::BeginChild().
+		/// While following, the view sticks to the last line unless the user scrolls up.
+		/// </summary>
+		IMGUI_API void render(const char* str_id, const ImVec2& size = {});
+
+		/// <summary>
+		/// Number of lines indexed so far
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t lines_count() const;
+
+		/// <summary>
+		/// Number of bytes indexed so far
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t indexed_size() const;
+
+		/// <summary>
+		/// true while the worker thread has not caught up with the end of the file.
+		/// </summary>
+		[[nodiscard]] IMGUI_API bool is_indexing() const;
+
+		void set_follow(bool follow) noexcept
+		{
+			m_Follow = follow;
+		}
+
+		[[nodiscard]] bool is_following() const noexcept
+		{
+			return m_Follow;
+		}
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+		bool m_Follow{ true };
+	};
+}
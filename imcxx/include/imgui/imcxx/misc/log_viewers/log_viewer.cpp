@@ -0,0 +1,346 @@
+
+#include "../log_viewer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Read-only view of the first 'size' bytes of the file, the file stays open to poll its size.
+	/// A new mapping is created when the file grows, the old one is released once the last frame using it is done.
+	/// </summary>
+	struct file_mapping
+	{
+		const char* Data{};
+		size_t Size{};
+#ifdef _WIN32
+		HANDLE Mapping{};
+#endif
+
+		file_mapping() = default;
+		file_mapping(const file_mapping&) = delete;
+		file_mapping& operator=(const file_mapping&) = delete;
+
+		~file_mapping()
+		{
+#ifdef _WIN32
+			if (Data)
+				UnmapViewOfFile(Data);
+			if (Mapping)
+				CloseHandle(Mapping);
+#else
+			if (Data)
+				munmap(const_cast<char*>(Data), Size);
+#endif
+		}
+	};
+
+	struct log_viewer::data
+	{
+#ifdef _WIN32
+		HANDLE File{ INVALID_HANDLE_VALUE };
+#else
+		int File{ -1 };
+#endif
+
+		// Guarded by 'Mutex': the indexer publishes a mapping before indexing past the end of the previous one,
+		// so a (Mapping, LineStarts, IndexedSize) snapshot taken under the lock is always consistent.
+		mutable std::mutex Mutex;
+		std::shared_ptr<const file_mapping> Mapping;
+		std::vector<size_t> LineStarts;
+		size_t IndexedSize{};
+		bool Indexing{ true };
+		// Incremented each time the file is indexed again from the start
+		unsigned Generation{};
+
+		std::condition_variable Wakeup;
+		bool Quit{};
+		std::thread Indexer;
+
+		// Render state, only touched by the UI thread
+		std::vector<size_t> VisibleStarts;
+		unsigned RenderedGeneration{};
+
+		~data()
+		{
+			{
+				std::lock_guard lock(Mutex);
+				Quit = true;
+			}
+			Wakeup.notify_one();
+			if (Indexer.joinable())
+				Indexer.join();
+
+			Mapping.reset();
+#ifdef _WIN32
+			if (File != INVALID_HANDLE_VALUE)
+				CloseHandle(File);
+#else
+			if (File != -1)
+				::close(File);
+#endif
+		}
+
+		bool open_file(const char* path)
+		{
+#ifdef _WIN32
+			std::wstring wpath(MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0), L'\0');
+			MultiByteToWideChar(CP_UTF8, 0, path, -1, wpath.data(), static_cast<int>(wpath.size()));
+			// Let the writer keep appending, renaming or deleting the file
+			File = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			return File != INVALID_HANDLE_VALUE;
+#else
+			File = ::open(path, O_RDONLY | O_CLOEXEC);
+			return File != -1;
+#endif
+		}
+
+		[[nodiscard]] size_t file_size() const
+		{
+#ifdef _WIN32
+			LARGE_INTEGER size;
+			return GetFileSizeEx(File, &size) ? static_cast<size_t>(size.QuadPart) : 0;
+#else
+			struct stat st;
+			return fstat(File, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+#endif
+		}
+
+		[[nodiscard]] std::shared_ptr<const file_mapping> map_file(size_t size) const
+		{
+			auto mapping = std::make_shared<file_mapping>();
+			if (size == 0)
+				return mapping;
+
+#ifdef _WIN32
+			mapping->Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (!mapping->Mapping)
+				return nullptr;
+			mapping->Data = static_cast<const char*>(MapViewOfFile(mapping->Mapping, FILE_MAP_READ, 0, 0, size));
+			if (!mapping->Data)
+				return nullptr;
+#else
+			void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, File, 0);
+			if (data == MAP_FAILED)
+				return nullptr;
+			madvise(data, size, MADV_SEQUENTIAL);
+			mapping->Data = static_cast<const char*>(data);
+#endif
+			mapping->Size = size;
+			return mapping;
+		}
+
+		void index_loop()
+		{
+			// Lines are published in batches, the UI can show the first ones while the rest of the file is scanned
+			constexpr size_t batch_size = size_t{ 4 } << 20;
+			constexpr auto poll_interval = std::chrono::milliseconds(100);
+
+			std::shared_ptr<const file_mapping> mapping;
+			std::vector<size_t> batch;
+			size_t pos = 0;
+			{
+				std::lock_guard lock(Mutex);
+				mapping = Mapping;
+			}
+
+			for (;;)
+			{
+				while (pos < mapping->Size)
+				{
+					const size_t end = std::min(mapping->Size, pos + batch_size);
+					batch.clear();
+					while (pos < end)
+					{
+						const void* eol = std::memchr(mapping->Data + pos, '\n', end - pos);
+						if (!eol)
+						{
+							pos = end;
+							break;
+						}
+						pos = static_cast<size_t>(static_cast<const char*>(eol) - mapping->Data) + 1;
+						batch.push_back(pos);
+					}
+
+					std::lock_guard lock(Mutex);
+					if (Quit)
+						return;
+					// The line after the last '\n' exists as soon as it has one byte
+					LineStarts.insert(LineStarts.end(), batch.begin(), batch.end());
+					IndexedSize = pos;
+				}
+
+				std::unique_lock lock(Mutex);
+				Indexing = false;
+				Wakeup.wait_for(lock, poll_interval, [this] { return Quit; });
+				if (Quit)
+					return;
+				lock.unlock();
+
+				const size_t size = file_size();
+				if (size == mapping->Size)
+					continue;
+
+				auto remapped = map_file(size);
+				if (!remapped)
+					continue;
+
+				lock.lock();
+				if (size < mapping->Size)
+				{
+					// Truncated or replaced in place: start over
+					LineStarts.assign(1, 0);
+					IndexedSize = 0;
+					Generation++;
+					pos = 0;
+				}
+				mapping = remapped;
+				Mapping = std::move(remapped);
+				Indexing = true;
+			}
+		}
+	};
+
+	log_viewer::log_viewer() = default;
+
+	log_viewer::~log_viewer() = default;
+
+	bool log_viewer::open(const char* path)
+	{
+		close();
+
+		auto data = std::make_unique<log_viewer::data>();
+		if (!data->open_file(path))
+			return false;
+
+		data->Mapping = data->map_file(data->file_size());
+		if (!data->Mapping)
+			return false;
+
+		data->LineStarts.assign(1, 0);
+		data->Indexer = std::thread(&log_viewer::data::index_loop, data.get());
+		m_Data = std::move(data);
+		return true;
+	}
+
+	void log_viewer::close()
+	{
+		m_Data.reset();
+	}
+
+	bool log_viewer::is_open() const
+	{
+		return m_Data != nullptr;
+	}
+
+	size_t log_viewer::lines_count() const
+	{
+		if (!m_Data)
+			return 0;
+
+		std::lock_guard lock(m_Data->Mutex);
+		// The last line start is only a line if it has at least one byte
+		return m_Data->LineStarts.size() - (m_Data->LineStarts.back() == m_Data->IndexedSize ? 1 : 0);
+	}
+
+	size_t log_viewer::indexed_size() const
+	{
+		if (!m_Data)
+			return 0;
+
+		std::lock_guard lock(m_Data->Mutex);
+		return m_Data->IndexedSize;
+	}
+
+	bool log_viewer::is_indexing() const
+	{
+		if (!m_Data)
+			return false;
+
+		std::lock_guard lock(m_Data->Mutex);
+		return m_Data->Indexing;
+	}
+
+	void log_viewer::render(const char* str_id, const ImVec2& size)
+	{
+		if (!ImGui::BeginChild(str_id, size, false, ImGuiWindowFlags_HorizontalScrollbar) || !m_Data)
+		{
+			ImGui::EndChild();
+			return;
+		}
+
+		data& d = *m_Data;
+		std::shared_ptr<const file_mapping> mapping;
+		size_t lines, indexed_size;
+		bool restarted;
+		{
+			std::lock_guard lock(d.Mutex);
+			mapping = d.Mapping;
+			indexed_size = d.IndexedSize;
+			lines = d.LineStarts.size() - (d.LineStarts.back() == indexed_size ? 1 : 0);
+			restarted = d.RenderedGeneration != d.Generation;
+			d.RenderedGeneration = d.Generation;
+		}
+
+		if (restarted)
+			ImGui::SetScrollY(0.0f);
+
+		// Stick to the bottom if we were there before new lines came in
+		const bool at_bottom = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(std::min(lines, static_cast<size_t>(INT_MAX))));
+		while (clipper.Step())
+		{
+			// Copy the few visible offsets, the index keeps growing behind our back
+			d.VisibleStarts.clear();
+			{
+				std::lock_guard lock(d.Mutex);
+				if (d.RenderedGeneration != d.Generation)
+					break;
+				const size_t last = std::min(static_cast<size_t>(clipper.DisplayEnd) + 1, d.LineStarts.size());
+				d.VisibleStarts.assign(d.LineStarts.begin() + clipper.DisplayStart, d.LineStarts.begin() + last);
+			}
+
+			// Lines of the snapshot are all in 'VisibleStarts', the one after the last visible line may not be
+			const size_t count = static_cast<size_t>(clipper.DisplayEnd - clipper.DisplayStart);
+			for (size_t i = 0; i < count && i < d.VisibleStarts.size(); i++)
+			{
+				const size_t begin = d.VisibleStarts[i];
+				size_t end = i + 1 < d.VisibleStarts.size() ? d.VisibleStarts[i + 1] - 1 : indexed_size;
+				end = std::max(begin, std::min(end, mapping->Size));
+				if (end > begin && mapping->Data[end - 1] == '\r')
+					end--;
+				ImGui::TextUnformatted(mapping->Data + begin, mapping->Data + end);
+			}
+		}
+
+		if (m_Follow && at_bottom)
+			ImGui::SetScrollHereY(1.0f);
+
+		ImGui::EndChild();
+	}
+}
@@ -19,7 +19,7 @@ namespace imcxx::misc
 			std::string string;
 			uint32_t color;
 
-			_CONSTEXPR20 string_color(std::string_view str, uint32_t color = 0xFF'FF'FF'FF) noexcept :
+			string_color(std::string_view str, uint32_t color = 0xFF'FF'FF'FF) noexcept :
 				string(str), color(color)
 			{}
 		};
@@ -5,6 +5,7 @@
 
 #include "../notification.hpp"
 
+#include "imgui/imcxx/frames.hpp"
 #include "imgui/imcxx/viewports.hpp"
 #include "imgui/imcxx/window.hpp"
 #include "imgui/imcxx/override.hpp"
@@ -254,7 +255,7 @@ namespace imcxx::misc
 
 			bool close = false;
 
-			sprintf_s(window_name, "##NOTIF%x", notif->Id);
+			ImFormatString(window_name, sizeof(window_name), "##NOTIF%x", notif->Id);
 			imcxx::window notification(
 				window_name,
 				nullptr,
@@ -318,5 +319,9 @@ namespace imcxx::misc
 				++num_rendered;
 			}
 		}
+
+		// Timers, fades and progress bars move every frame
+		if (!_Notifications.empty())
+			frame_scheduler::request_redraw();
 	}
 }
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Plot of the last seconds of many series streamed from worker threads (metrics, sensors)
+	/// - Each series has its own single-producer/single-consumer ring: a producer thread pushes samples without lock nor allocation,
+	///   a sample which does not fit is dropped and counted in 'series::dropped()'.
+	/// - The UI thread drains the rings once per frame in 'render()' into buckets of 'history / resolution' seconds (min, max, first and last values),
+	///   and draws each series from its buckets, merged by pixel column: the cost of a frame depends on the number of series and the resolution, not on the sample rate.
+	/// - The plot ends at the most recent sample of all the series and scrolls with it.
+	///
+	/// static imcxx::misc::scrolling_plot plot{ 10.0 };
+	/// static auto& cpu = plot.add_series("cpu");       // UI thread, before the producer uses it
+	/// cpu.push(seconds_since_start(), cpu_load());     // producer thread
+	/// plot.render("##metrics", { -FLT_MIN, 300.f });  // UI thread
+	/// </summary>
+	class scrolling_plot
+	{
+	public:
+		/// <summary>
+		/// Color picked from the index of the series
+		/// </summary>
+		static constexpr uint32_t auto_color = 0;
+
+		struct sample
+		{
+			double time;
+			float value;
+		};
+
+		class series
+		{
+		public:
+			series(const series&) = delete;
+			series& operator=(const series&) = delete;
+
+			/// <summary>
+			/// Single producer, lock-free: queue a sample, returns false if the ring is full.
+			/// Times of a series are expected to increase, NaN values are ignored.
+			/// </summary>
+			bool push(double time, float value) noexcept
+			{
+				const uint64_t write = m_Write.load(std::memory_order_relaxed);
+				if (write - m_ReadCache > m_Mask)
+				{
+					m_ReadCache = m_Read.load(std::memory_order_acquire);
+					if (write - m_ReadCache > m_Mask)
+					{
+						m_Dropped.fetch_add(1, std::memory_order_relaxed);
+						return false;
+					}
+				}
+				m_Ring[write & m_Mask] = { time, value };
+				m_Write.store(write + 1, std::memory_order_release);
+				return true;
+			}
+
+			/// <summary>
+			/// Number of samples dropped because the ring was full
+			/// </summary>
+			[[nodiscard]] size_t dropped() const noexcept
+			{
+				return m_Dropped.load(std::memory_order_relaxed);
+			}
+
+		private:
+			friend class scrolling_plot;
+
+			explicit series(size_t capacity);
+
+			std::unique_ptr<sample[]> m_Ring;
+			uint64_t m_Mask;
+
+			// Producer: next sample, and the last read position it saw
+			alignas(64) std::atomic<uint64_t> m_Write{ };
+			uint64_t m_ReadCache{ };
+			// Consumer
+			alignas(64) std::atomic<uint64_t> m_Read{ };
+			alignas(64) std::atomic<size_t> m_Dropped{ };
+		};
+
+		/// <summary>
+		/// 'history': seconds shown, 'resolution': number of buckets across them (about the width of the plot in pixels).
+		/// </summary>
+		IMGUI_API explicit scrolling_plot(double history = 10.0, size_t resolution = 2048);
+		IMGUI_API ~scrolling_plot();
+
+		scrolling_plot(const scrolling_plot&) = delete;
+		scrolling_plot& operator=(const scrolling_plot&) = delete;
+
+		/// <summary>
+		/// UI thread: add a series, the reference stays valid for the lifetime of the plot and can be handed to a producer thread.
+		/// 'capacity': number of samples the ring holds between two frames, rounded up to a power of 2.
+		/// </summary>
+		IMGUI_API series& add_series(std::string_view name, uint32_t color = auto_color, size_t capacity = 4096);
+
+		[[nodiscard]] IMGUI_API size_t series_count() const;
+
+		/// <summary>
+		/// UI thread: move the queued samples to the buckets, 'render()' calls it.
+		/// </summary>
+		IMGUI_API void drain();
+
+		/// <summary>
+		/// UI thread: drain the queued samples and draw the plot. A 'size' of 0 uses the item width and 8 frames of height (see ImGui::CalcItemSize()).
+		/// The vertical range is the min and max of the visible samples unless 'scale_min'/'scale_max' are set.
+		/// Hovering shows the series closest to the mouse.
+		/// </summary>
+		IMGUI_API void render(const char* str_id, const ImVec2& size = {}, float scale_min = FLT_MAX, float scale_max = FLT_MAX);
+
+		/// <summary>
+		/// UI thread: change the seconds shown, the drained samples are cleared.
+		/// </summary>
+		IMGUI_API void set_history(double seconds);
+
+		[[nodiscard]] IMGUI_API double history() const;
+
+		/// <summary>
+		/// UI thread: time of the most recent drained sample, the right edge of the plot.
+		/// </summary>
+		[[nodiscard]] IMGUI_API double latest() const;
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+	};
+}
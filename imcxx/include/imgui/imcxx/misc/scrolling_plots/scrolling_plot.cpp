@@ -0,0 +1,323 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../scrolling_plot.hpp"
+
+#include "imgui/imgui_internal.h"
+
+
+namespace imcxx::misc
+{
+	struct scrolling_plot::data
+	{
+		/// <summary>
+		/// Samples of a series in [Key * BucketDuration, (Key + 1) * BucketDuration)
+		/// </summary>
+		struct bucket
+		{
+			int64_t Key;
+			float Min;
+			float Max;
+			float First;
+			float Last;
+		};
+
+		struct series_state
+		{
+			std::unique_ptr<series> Series;
+			std::string Name;
+			ImU32 Color;
+			// Ring of 'resolution + 1' buckets indexed by key, so that the buckets of the whole history are kept with the one being filled
+			std::vector<bucket> Buckets;
+			int64_t Newest{ INT64_MIN };
+		};
+
+		static constexpr int64_t empty_key = INT64_MIN;
+
+		double History;
+		double BucketDuration;
+		size_t Resolution;
+		double Latest{ -DBL_MAX };
+		std::vector<series_state> Series;
+
+		// Reused every frame
+		std::vector<int> ColumnOf;
+		std::vector<float> X1, Y1, X2, Y2;
+
+		data(double history, size_t resolution) :
+			History(history),
+			BucketDuration(history / static_cast<double>(resolution)),
+			Resolution(resolution)
+		{
+		}
+
+		[[nodiscard]] size_t buckets_count() const noexcept
+		{
+			return Resolution + 1;
+		}
+
+		[[nodiscard]] size_t bucket_index(int64_t key) const noexcept
+		{
+			const int64_t count = static_cast<int64_t>(buckets_count());
+			return static_cast<size_t>(((key % count) + count) % count);
+		}
+
+		void add(series_state& state, const sample& s)
+		{
+			// NaN values and times are ignored
+			if (!(s.value == s.value) || !std::isfinite(s.time))
+				return;
+
+			const int64_t key = static_cast<int64_t>(std::floor(s.time / BucketDuration));
+			if (state.Newest != empty_key && key <= state.Newest - static_cast<int64_t>(buckets_count()))
+				return;
+			state.Newest = std::max(state.Newest, key);
+			Latest = std::max(Latest, s.time);
+
+			bucket& b = state.Buckets[bucket_index(key)];
+			if (b.Key != key)
+				b = { key, s.value, s.value, s.value, s.value };
+			else
+			{
+				b.Min = s.value < b.Min ? s.value : b.Min;
+				b.Max = s.value > b.Max ? s.value : b.Max;
+				b.Last = s.value;
+			}
+		}
+	};
+
+
+	scrolling_plot::series::series(size_t capacity) :
+		m_Ring(std::make_unique<sample[]>(capacity)),
+		m_Mask(capacity - 1)
+	{
+	}
+
+	scrolling_plot::scrolling_plot(double history, size_t resolution) :
+		m_Data(std::make_unique<data>(history, std::max(resolution, size_t{ 1 })))
+	{
+	}
+
+	scrolling_plot::~scrolling_plot() = default;
+
+	scrolling_plot::series& scrolling_plot::add_series(std::string_view name, uint32_t color, size_t capacity)
+	{
+		data& d = *m_Data;
+		size_t ring_capacity = 2;
+		while (ring_capacity < capacity)
+			ring_capacity *= 2;
+
+		const size_t index = d.Series.size();
+		if (color == auto_color)
+			color = ImColor::HSV(std::fmod(static_cast<float>(index) * 0.618034f, 1.f), 0.6f, 0.95f);
+
+		data::series_state& state = d.Series.emplace_back();
+		state.Series.reset(new series(ring_capacity));
+		state.Name = name;
+		state.Color = color;
+		state.Buckets.assign(d.buckets_count(), { data::empty_key, 0.f, 0.f, 0.f, 0.f });
+		return *state.Series;
+	}
+
+	size_t scrolling_plot::series_count() const
+	{
+		return m_Data->Series.size();
+	}
+
+	void scrolling_plot::drain()
+	{
+		data& d = *m_Data;
+		for (data::series_state& state : d.Series)
+		{
+			series& s = *state.Series;
+			const uint64_t read = s.m_Read.load(std::memory_order_relaxed);
+			const uint64_t write = s.m_Write.load(std::memory_order_acquire);
+			for (uint64_t i = read; i < write; i++)
+				d.add(state, s.m_Ring[i & s.m_Mask]);
+			s.m_Read.store(write, std::memory_order_release);
+		}
+	}
+
+	void scrolling_plot::set_history(double seconds)
+	{
+		data& d = *m_Data;
+		d.History = seconds;
+		d.BucketDuration = seconds / static_cast<double>(d.Resolution);
+		for (data::series_state& state : d.Series)
+		{
+			for (data::bucket& b : state.Buckets)
+				b.Key = data::empty_key;
+			state.Newest = data::empty_key;
+		}
+	}
+
+	double scrolling_plot::history() const
+	{
+		return m_Data->History;
+	}
+
+	double scrolling_plot::latest() const
+	{
+		return m_Data->Latest;
+	}
+
+	void scrolling_plot::render(const char* str_id, const ImVec2& size, float scale_min, float scale_max)
+	{
+		// Drained even when not visible, so that producers never find a full ring
+		drain();
+
+		ImGuiWindow* const window = ImGui::GetCurrentWindow();
+		if (window->SkipItems)
+			return;
+
+		data& d = *m_Data;
+		const ImGuiStyle& style = ImGui::GetStyle();
+		const ImGuiID id = window->GetID(str_id);
+		const ImVec2 frame_size = ImGui::CalcItemSize(size, ImGui::CalcItemWidth(), ImGui::GetFrameHeight() * 8.f);
+		const ImVec2 pos = window->DC.CursorPos;
+		const ImRect frame_bb(pos.x, pos.y, pos.x + frame_size.x, pos.y + frame_size.y);
+		const ImRect inner_bb(frame_bb.Min.x + style.FramePadding.x, frame_bb.Min.y + style.FramePadding.y, frame_bb.Max.x - style.FramePadding.x, frame_bb.Max.y - style.FramePadding.y);
+		ImGui::ItemSize(frame_bb, style.FramePadding.y);
+		if (!ImGui::ItemAdd(frame_bb, id))
+			return;
+
+		const bool hovered = ImGui::ItemHoverable(frame_bb, id);
+		ImGui::RenderFrame(frame_bb.Min, frame_bb.Max, ImGui::GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+		if (d.Latest == -DBL_MAX)
+			return;
+
+		// Column of each bucket of the history, the same for every series
+		const int width = std::max(static_cast<int>(inner_bb.GetWidth()), 1);
+		const size_t buckets_count = d.buckets_count();
+		const int64_t first_key = static_cast<int64_t>(std::floor(d.Latest / d.BucketDuration)) - static_cast<int64_t>(buckets_count) + 1;
+		const size_t first_index = d.bucket_index(first_key);
+		const double first_time = d.Latest - d.History;
+		d.ColumnOf.resize(buckets_count);
+		for (size_t j = 0; j < buckets_count; j++)
+		{
+			const double time = static_cast<double>(first_key + static_cast<int64_t>(j)) * d.BucketDuration;
+			d.ColumnOf[j] = std::clamp(static_cast<int>(std::floor((time - first_time) / d.History * width)), 0, width - 1);
+		}
+
+		if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+		{
+			float v_min = FLT_MAX, v_max = -FLT_MAX;
+			for (const data::series_state& state : d.Series)
+			{
+				for (size_t j = 0, index = first_index; j < buckets_count; j++, index = index + 1 == buckets_count ? 0 : index + 1)
+				{
+					const data::bucket& b = state.Buckets[index];
+					if (b.Key != first_key + static_cast<int64_t>(j))
+						continue;
+					v_min = b.Min < v_min ? b.Min : v_min;
+					v_max = b.Max > v_max ? b.Max : v_max;
+				}
+			}
+			scale_min = scale_min == FLT_MAX ? v_min : scale_min;
+			scale_max = scale_max == FLT_MAX ? v_max : scale_max;
+		}
+		const float inv_scale = scale_min == scale_max ? 0.f : 1.f / (scale_max - scale_min);
+
+		const float x0 = inner_bb.Min.x;
+		const float y0 = inner_bb.Max.y;
+		const float height = inner_bb.GetHeight();
+		const auto y_of = [&](float v) { return y0 - ImSaturate((v - scale_min) * inv_scale) * height; };
+
+		const ImVec2 mouse = ImGui::GetIO().MousePos;
+		const int hovered_column = hovered && inner_bb.Contains(mouse) ? std::clamp(static_cast<int>(mouse.x - x0), 0, width - 1) : -1;
+		const data::series_state* hovered_series = nullptr;
+		float hovered_distance = FLT_MAX, hovered_min = 0.f, hovered_max = 0.f;
+
+		// At most 2 segments per column, written without branching on the data: the count only moves past the ones kept
+		const size_t max_segments = 2 * static_cast<size_t>(width);
+		if (d.X1.size() < max_segments)
+		{
+			d.X1.resize(max_segments);
+			d.Y1.resize(max_segments);
+			d.X2.resize(max_segments);
+			d.Y2.resize(max_segments);
+		}
+		float* const x1 = d.X1.data();
+		float* const y1 = d.Y1.data();
+		float* const x2 = d.X2.data();
+		float* const y2 = d.Y2.data();
+
+		ImDrawList* draw_list = window->DrawList;
+		draw_list->PushClipRect(frame_bb.Min, frame_bb.Max, true);
+		for (const data::series_state& state : d.Series)
+		{
+			// Buckets are merged by column: a vertical span from the min to the max of a column, and a segment from the last value of a column to the first one of the next.
+			// Dense series skip the segment when the spans of two neighbour columns overlap, sparse ones skip the span when it is less than a pixel high:
+			// either way most columns are a single segment.
+			size_t count = 0;
+			data::bucket column{};
+			int c = -1, prev_c = -1;
+			float prev_top = 0.f, prev_bottom = 0.f, prev_last = 0.f;
+			const auto flush = [&]()
+			{
+				const float x = x0 + static_cast<float>(c);
+				const float y_min = y_of(column.Min);
+				const float y_top = y_of(column.Max);
+				const float y_bottom = std::max(y_min, y_top + 1.f);
+				const bool joined = (prev_c >= 0) & !((prev_c + 1 == c) & (y_top <= prev_bottom) & (prev_top <= y_bottom));
+				x1[count] = x0 + static_cast<float>(prev_c);
+				y1[count] = y_of(prev_last);
+				x2[count] = x;
+				y2[count] = y_of(column.First);
+				count += joined;
+				x1[count] = x;
+				y1[count] = y_top;
+				x2[count] = x;
+				y2[count] = y_bottom;
+				count += !joined | (y_min - y_top >= 1.f);
+				prev_c = c;
+				prev_top = y_top;
+				prev_bottom = y_bottom;
+				prev_last = column.Last;
+
+				if (c == hovered_column)
+				{
+					const float distance = mouse.y < y_top ? y_top - mouse.y : mouse.y > y_bottom ? mouse.y - y_bottom : 0.f;
+					if (distance < hovered_distance)
+					{
+						hovered_series = &state;
+						hovered_distance = distance;
+						hovered_min = column.Min;
+						hovered_max = column.Max;
+					}
+				}
+			};
+
+			for (size_t j = 0, index = first_index; j < buckets_count; j++, index = index + 1 == buckets_count ? 0 : index + 1)
+			{
+				const data::bucket& b = state.Buckets[index];
+				if (b.Key != first_key + static_cast<int64_t>(j))
+					continue;
+
+				if (d.ColumnOf[j] != c)
+				{
+					if (c >= 0)
+						flush();
+					c = d.ColumnOf[j];
+					column = b;
+				}
+				else
+				{
+					column.Min = b.Min < column.Min ? b.Min : column.Min;
+					column.Max = b.Max > column.Max ? b.Max : column.Max;
+					column.Last = b.Last;
+				}
+			}
+			if (c >= 0)
+				flush();
+
+			draw_list->AddLines(x1, y1, x2, y2, state.Color, static_cast<int>(count));
+		}
+		draw_list->PopClipRect();
+
+		if (hovered_series)
+			ImGui::SetTooltip("%s\nmin: %8.4g\nmax: %8.4g", hovered_series->Name.c_str(), hovered_min, hovered_max);
+	}
+}
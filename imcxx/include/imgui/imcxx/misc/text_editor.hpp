@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "imgui/imcxx/scopes.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Multiline text editor for large documents (configuration files, logs, data dumps)
+	/// - The document is a piece table: the original text and an append-only buffer of inserted text, referenced by pieces kept in a balanced tree
+	///   with the number of bytes and line returns of each subtree. Inserting, erasing and finding a line are O(log n), nothing is moved or converted.
+	/// - Only the visible lines are extracted and drawn.
+	/// - Undo history only stores piece ranges: inserted and erased text stays in the buffers, consecutive typed characters are merged in one step.
+	/// - Text is UTF-8, lines end with '\n' ('\r' is kept and not displayed).
+	///
+	/// static imcxx::misc::text_editor editor{ read_file("settings.cfg") };
+	/// if (editor.render("##settings"))
+	///     dirty = true;
+	/// </summary>
+	class text_editor
+	{
+	public:
+		IMGUI_API text_editor();
+		IMGUI_API explicit text_editor(std::string_view text);
+		IMGUI_API ~text_editor();
+
+		text_editor(const text_editor&) = delete;
+		text_editor& operator=(const text_editor&) = delete;
+
+		/// <summary>
+		/// Replace the document, the undo history is cleared.
+		/// </summary>
+		IMGUI_API void set_text(std::string_view text);
+
+		/// <summary>
+		/// Copy of the whole document
+		/// </summary>
+		[[nodiscard]] IMGUI_API std::string text() const;
+
+		/// <summary>
+		/// Copy of 'count' bytes from 'offset', clamped to the document
+		/// </summary>
+		[[nodiscard]] IMGUI_API std::string text(size_t offset, size_t count) const;
+
+		/// <summary>
+		/// Copy of a line, without its line return
+		/// </summary>
+		[[nodiscard]] IMGUI_API std::string line(size_t index) const;
+
+		/// <summary>
+		/// Size of the document in bytes
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t size() const;
+
+		/// <summary>
+		/// Number of lines, a document ending with a line return has an empty last line
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t lines_count() const;
+
+		/// <summary>
+		/// Byte offset of the first character of a line
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t line_offset(size_t index) const;
+
+		/// <summary>
+		/// Line containing the byte at 'offset'
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t line_at(size_t offset) const;
+
+		/// <summary>
+		/// Replace 'count' bytes from 'offset' with 'str', as one undo step
+		/// </summary>
+		IMGUI_API void replace(size_t offset, size_t count, std::string_view str);
+
+		void insert(size_t offset, std::string_view str)
+		{
+			replace(offset, 0, str);
+		}
+
+		void erase(size_t offset, size_t count)
+		{
+			replace(offset, count, {});
+		}
+
+		IMGUI_API bool undo();
+		IMGUI_API bool redo();
+		[[nodiscard]] IMGUI_API bool can_undo() const;
+		[[nodiscard]] IMGUI_API bool can_redo() const;
+
+		/// <summary>
+		/// Drop the undo history, the text of erased pieces stays in memory until 'set_text()'.
+		/// </summary>
+		IMGUI_API void clear_undo();
+
+		/// <summary>
+		/// Byte offset of the cursor
+		/// </summary>
+		[[nodiscard]] IMGUI_API size_t cursor() const;
+
+		/// <summary>
+		/// Move the cursor, the selection goes from 'anchor' to 'offset' (no selection by default).
+		/// </summary>
+		IMGUI_API void set_cursor(size_t offset, size_t anchor = SIZE_MAX);
+
+		/// <summary>
+		/// Draw the visible lines in a child window and handle mouse and keyboard input while it is focused, 'size' is the same as in ImGui::BeginChild().
+		/// Returns true when the user modified the document.
+		/// </summary>
+		IMGUI_API bool render(const char* str_id, const ImVec2& size = {});
+
+		void set_read_only(bool read_only) noexcept
+		{
+			m_ReadOnly = read_only;
+		}
+
+		[[nodiscard]] bool is_read_only() const noexcept
+		{
+			return m_ReadOnly;
+		}
+
+	private:
+		struct data;
+		std::unique_ptr<data> m_Data;
+		bool m_ReadOnly{ };
+	};
+}
@@ -0,0 +1,1098 @@
+#include "../text_editor.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "imgui/imgui_internal.h"
+#include "imgui/imcxx/frames.hpp"
+
+namespace imcxx::misc
+{
+	/// <summary>
+	/// Range of one of the two buffers of a document
+	/// </summary>
+	struct text_piece
+	{
+		// 0: original text, 1: inserted text
+		uint32_t Buffer;
+		size_t Start;
+		size_t Length;
+		size_t LineFeeds;
+	};
+
+	struct text_editor::data
+	{
+		/// <summary>
+		/// Node of the piece tree, a treap ordered by position in the document (the key is implicit, from the lengths of the subtrees)
+		/// </summary>
+		struct node
+		{
+			text_piece Piece;
+			// Bytes and line returns of the subtree
+			size_t Length;
+			size_t LineFeeds;
+			uint32_t Left;
+			uint32_t Right;
+			uint32_t Priority;
+		};
+
+		/// <summary>
+		/// Undo step: 'RemovedLength' bytes were replaced at 'Offset' by the 'Inserted' piece
+		/// </summary>
+		struct edit
+		{
+			size_t Offset;
+			text_piece Inserted;
+			// Pieces erased by the edit, in 'RemovedPieces'
+			size_t RemovedFirst;
+			size_t RemovedCount;
+			size_t RemovedLength;
+		};
+
+		std::string Buffers[2];
+		// Offset following each '\n' of a buffer
+		std::vector<size_t> LineStarts[2];
+
+		// Node 0 is the empty tree
+		std::vector<node> Nodes{ node{} };
+		std::vector<uint32_t> FreeNodes;
+		uint32_t Root{};
+		uint32_t Seed{ 0x9E3779B9u };
+
+		// Edits[0, EditsDone) are applied, the rest can be redone
+		std::vector<edit> Edits;
+		std::vector<text_piece> RemovedPieces;
+		size_t EditsDone{};
+		// Typed characters are merged in the last edit until the cursor moves
+		bool MergeTyping{};
+
+		// View state
+		size_t Cursor{};
+		size_t Anchor{};
+		float PreferredX{ -1.0f };
+		float MaxLineWidth{};
+		float CursorAnim{};
+		bool ScrollToCursor{};
+		std::string Line;
+
+		void reset(std::string_view text)
+		{
+			Buffers[0].assign(text);
+			Buffers[1].clear();
+			LineStarts[0].clear();
+			LineStarts[1].clear();
+			index_lines(0, 0);
+
+			Nodes.resize(1);
+			FreeNodes.clear();
+			Root = 0;
+			if (!text.empty())
+				Root = new_node({ 0, 0, text.size(), LineStarts[0].size() });
+
+			Edits.clear();
+			RemovedPieces.clear();
+			EditsDone = 0;
+			MergeTyping = false;
+			Cursor = Anchor = 0;
+			PreferredX = -1.0f;
+			MaxLineWidth = 0.0f;
+		}
+
+		void index_lines(uint32_t buffer, size_t from)
+		{
+			const std::string& str = Buffers[buffer];
+			const char* const begin = str.data();
+			const char* const end = begin + str.size();
+			for (const char* p = begin + from; (p = static_cast<const char*>(memchr(p, '\n', end - p))) != nullptr; )
+				LineStarts[buffer].push_back(++p - begin);
+		}
+
+		[[nodiscard]] size_t count_line_feeds(uint32_t buffer, size_t start, size_t length) const
+		{
+			const std::vector<size_t>& starts = LineStarts[buffer];
+			return static_cast<size_t>(
+				std::upper_bound(starts.begin(), starts.end(), start + length) -
+				std::upper_bound(starts.begin(), starts.end(), start)
+			);
+		}
+
+		//
+		// Piece tree
+		//
+
+		uint32_t new_node(const text_piece& piece)
+		{
+			uint32_t n;
+			if (!FreeNodes.empty())
+			{
+				n = FreeNodes.back();
+				FreeNodes.pop_back();
+			}
+			else
+			{
+				n = static_cast<uint32_t>(Nodes.size());
+				Nodes.emplace_back();
+			}
+
+			Seed ^= Seed << 13;
+			Seed ^= Seed >> 17;
+			Seed ^= Seed << 5;
+			Nodes[n] = { piece, piece.Length, piece.LineFeeds, 0, 0, Seed };
+			return n;
+		}
+
+		void update(uint32_t n)
+		{
+			node& x = Nodes[n];
+			x.Length = Nodes[x.Left].Length + x.Piece.Length + Nodes[x.Right].Length;
+			x.LineFeeds = Nodes[x.Left].LineFeeds + x.Piece.LineFeeds + Nodes[x.Right].LineFeeds;
+		}
+
+		uint32_t merge(uint32_t a, uint32_t b)
+		{
+			if (!a)
+				return b;
+			if (!b)
+				return a;
+
+			if (Nodes[a].Priority > Nodes[b].Priority)
+			{
+				const uint32_t right = merge(Nodes[a].Right, b);
+				Nodes[a].Right = right;
+				update(a);
+				return a;
+			}
+			else
+			{
+				const uint32_t left = merge(a, Nodes[b].Left);
+				Nodes[b].Left = left;
+				update(b);
+				return b;
+			}
+		}
+
+		/// <summary>
+		/// Split the tree before the byte at 'offset', the piece containing it is cut in two
+		/// </summary>
+		std::pair<uint32_t, uint32_t> split(uint32_t n, size_t offset)
+		{
+			if (!n)
+				return { 0, 0 };
+
+			const size_t left_length = Nodes[Nodes[n].Left].Length;
+			if (offset <= left_length)
+			{
+				const auto [left, right] = split(Nodes[n].Left, offset);
+				Nodes[n].Left = right;
+				update(n);
+				return { left, n };
+			}
+
+			const size_t piece_end = left_length + Nodes[n].Piece.Length;
+			if (offset >= piece_end)
+			{
+				const auto [left, right] = split(Nodes[n].Right, offset - piece_end);
+				Nodes[n].Right = left;
+				update(n);
+				return { n, right };
+			}
+
+			// 'n' keeps the head of the piece and its left subtree, a new node takes the tail
+			const size_t cut = offset - left_length;
+			text_piece tail = Nodes[n].Piece;
+			tail.Start += cut;
+			tail.Length -= cut;
+			tail.LineFeeds = count_line_feeds(tail.Buffer, tail.Start, tail.Length);
+			const uint32_t m = new_node(tail);
+
+			node& x = Nodes[n];
+			x.Piece.Length = cut;
+			x.Piece.LineFeeds -= tail.LineFeeds;
+			const uint32_t right = x.Right;
+			x.Right = 0;
+			update(n);
+			return { n, merge(m, right) };
+		}
+
+		/// <summary>
+		/// Grow the piece ending at 'offset' if 'piece' directly follows it in the same buffer (typing at the same place)
+		/// </summary>
+		bool extend(uint32_t n, size_t offset, const text_piece& piece)
+		{
+			if (!n)
+				return false;
+
+			node& x = Nodes[n];
+			const size_t left_length = Nodes[x.Left].Length;
+			const size_t piece_end = left_length + x.Piece.Length;
+			bool extended;
+			if (offset <= left_length)
+				extended = extend(x.Left, offset, piece);
+			else if (offset > piece_end)
+				extended = extend(x.Right, offset - piece_end, piece);
+			else if (offset == piece_end && x.Piece.Buffer == piece.Buffer && x.Piece.Start + x.Piece.Length == piece.Start)
+			{
+				x.Piece.Length += piece.Length;
+				x.Piece.LineFeeds += piece.LineFeeds;
+				extended = true;
+			}
+			else
+				extended = false;
+
+			if (extended)
+				update(n);
+			return extended;
+		}
+
+		/// <summary>
+		/// Free the nodes of a subtree, its pieces are appended to 'pieces' in order
+		/// </summary>
+		void release(uint32_t n, std::vector<text_piece>* pieces)
+		{
+			if (!n)
+				return;
+
+			release(Nodes[n].Left, pieces);
+			if (pieces)
+				pieces->push_back(Nodes[n].Piece);
+			release(Nodes[n].Right, pieces);
+			FreeNodes.push_back(n);
+		}
+
+		void insert_pieces(size_t offset, const text_piece* pieces, size_t count)
+		{
+			if (count == 1 && extend(Root, offset, pieces[0]))
+				return;
+
+			uint32_t inserted = 0;
+			for (size_t i = 0; i < count; i++)
+				inserted = merge(inserted, new_node(pieces[i]));
+
+			const auto [left, right] = split(Root, offset);
+			Root = merge(merge(left, inserted), right);
+		}
+
+		void erase_range(size_t offset, size_t length, std::vector<text_piece>* removed)
+		{
+			if (!length)
+				return;
+
+			const auto [left, rest] = split(Root, offset);
+			const auto [middle, right] = split(rest, length);
+			release(middle, removed);
+			Root = merge(left, right);
+		}
+
+		text_piece append(std::string_view str)
+		{
+			const size_t start = Buffers[1].size();
+			const size_t first_line = LineStarts[1].size();
+			Buffers[1].append(str);
+			index_lines(1, start);
+			return { 1, start, str.size(), LineStarts[1].size() - first_line };
+		}
+
+		//
+		// Queries
+		//
+
+		[[nodiscard]] size_t size() const
+		{
+			return Nodes[Root].Length;
+		}
+
+		[[nodiscard]] size_t lines_count() const
+		{
+			return Nodes[Root].LineFeeds + 1;
+		}
+
+		[[nodiscard]] size_t line_offset(size_t index) const
+		{
+			size_t offset = 0;
+			for (uint32_t n = Root; n && index; )
+			{
+				const node& x = Nodes[n];
+				const node& left = Nodes[x.Left];
+				if (index <= left.LineFeeds)
+				{
+					n = x.Left;
+					continue;
+				}
+
+				index -= left.LineFeeds;
+				offset += left.Length;
+				if (index <= x.Piece.LineFeeds)
+				{
+					const std::vector<size_t>& starts = LineStarts[x.Piece.Buffer];
+					const size_t first = std::upper_bound(starts.begin(), starts.end(), x.Piece.Start) - starts.begin();
+					return offset + starts[first + index - 1] - x.Piece.Start;
+				}
+
+				index -= x.Piece.LineFeeds;
+				offset += x.Piece.Length;
+				n = x.Right;
+			}
+			return index ? size() : offset;
+		}
+
+		/// <summary>
+		/// Offset of the line return ending a line, or the end of the document
+		/// </summary>
+		[[nodiscard]] size_t line_end(size_t index) const
+		{
+			return index + 1 < lines_count() ? line_offset(index + 1) - 1 : size();
+		}
+
+		[[nodiscard]] size_t line_at(size_t offset) const
+		{
+			size_t line = 0;
+			for (uint32_t n = Root; n; )
+			{
+				const node& x = Nodes[n];
+				const node& left = Nodes[x.Left];
+				if (offset < left.Length)
+				{
+					n = x.Left;
+					continue;
+				}
+
+				offset -= left.Length;
+				line += left.LineFeeds;
+				if (offset < x.Piece.Length)
+					return line + count_line_feeds(x.Piece.Buffer, x.Piece.Start, offset);
+
+				offset -= x.Piece.Length;
+				line += x.Piece.LineFeeds;
+				n = x.Right;
+			}
+			return line;
+		}
+
+		[[nodiscard]] char at(size_t offset) const
+		{
+			for (uint32_t n = Root; n; )
+			{
+				const node& x = Nodes[n];
+				const size_t left_length = Nodes[x.Left].Length;
+				if (offset < left_length)
+				{
+					n = x.Left;
+					continue;
+				}
+
+				offset -= left_length;
+				if (offset < x.Piece.Length)
+					return Buffers[x.Piece.Buffer][x.Piece.Start + offset];
+
+				offset -= x.Piece.Length;
+				n = x.Right;
+			}
+			return '\0';
+		}
+
+		/// <summary>
+		/// Append the bytes [begin, end) of the subtree 'n' to 'out'
+		/// </summary>
+		void copy(uint32_t n, size_t begin, size_t end, std::string& out) const
+		{
+			while (n && begin < end)
+			{
+				const node& x = Nodes[n];
+				const size_t left_length = Nodes[x.Left].Length;
+				if (begin < left_length)
+					copy(x.Left, begin, std::min(end, left_length), out);
+
+				const size_t piece_end = left_length + x.Piece.Length;
+				if (begin < piece_end && end > left_length)
+				{
+					const size_t from = std::max(begin, left_length) - left_length;
+					const size_t to = std::min(end, piece_end) - left_length;
+					out.append(Buffers[x.Piece.Buffer], x.Piece.Start + from, to - from);
+				}
+
+				if (end <= piece_end)
+					break;
+				begin = begin > piece_end ? begin - piece_end : 0;
+				end -= piece_end;
+				n = x.Right;
+			}
+		}
+
+		void copy(size_t offset, size_t count, std::string& out) const
+		{
+			out.clear();
+			offset = std::min(offset, size());
+			count = std::min(count, size() - offset);
+			out.reserve(count);
+			copy(Root, offset, offset + count, out);
+		}
+
+		/// <summary>
+		/// Bytes [offset, offset + count) of the document: points into a buffer when they belong to a single piece,
+		/// 'scratch' holds a copy otherwise
+		/// </summary>
+		[[nodiscard]] std::string_view view(size_t offset, size_t count, std::string& scratch) const
+		{
+			offset = std::min(offset, size());
+			count = std::min(count, size() - offset);
+			size_t begin = offset;
+			for (uint32_t n = Root; n && count; )
+			{
+				const node& x = Nodes[n];
+				const size_t left_length = Nodes[x.Left].Length;
+				if (begin < left_length)
+				{
+					n = x.Left;
+					continue;
+				}
+
+				begin -= left_length;
+				if (begin < x.Piece.Length)
+				{
+					if (begin + count <= x.Piece.Length)
+						return std::string_view(Buffers[x.Piece.Buffer]).substr(x.Piece.Start + begin, count);
+					break;
+				}
+
+				begin -= x.Piece.Length;
+				n = x.Right;
+			}
+			copy(offset, count, scratch);
+			return scratch;
+		}
+
+		//
+		// Edits
+		//
+
+		void replace(size_t offset, size_t count, std::string_view str, bool typing)
+		{
+			offset = std::min(offset, size());
+			count = std::min(count, size() - offset);
+			if (!count && str.empty())
+				return;
+
+			// A new edit drops the ones that were undone
+			if (EditsDone < Edits.size())
+			{
+				Edits.resize(EditsDone);
+				RemovedPieces.resize(Edits.empty() ? 0 : Edits.back().RemovedFirst + Edits.back().RemovedCount);
+				MergeTyping = false;
+			}
+
+			edit e{ offset, { 1, Buffers[1].size(), 0, 0 }, RemovedPieces.size(), 0, count };
+			erase_range(offset, count, &RemovedPieces);
+			e.RemovedCount = RemovedPieces.size() - e.RemovedFirst;
+			if (!str.empty())
+			{
+				e.Inserted = append(str);
+				insert_pieces(offset, &e.Inserted, 1);
+			}
+
+			edit* last = Edits.empty() ? nullptr : &Edits.back();
+			if (typing && MergeTyping && !count && last &&
+				last->Offset + last->Inserted.Length == offset &&
+				last->Inserted.Start + last->Inserted.Length == e.Inserted.Start)
+			{
+				last->Inserted.Length += e.Inserted.Length;
+				last->Inserted.LineFeeds += e.Inserted.LineFeeds;
+			}
+			else
+			{
+				Edits.push_back(e);
+				EditsDone = Edits.size();
+			}
+			// A line return ends the undo step
+			MergeTyping = typing && !e.Inserted.LineFeeds;
+
+			const auto shift = [&](size_t& pos)
+			{
+				if (pos >= offset + count)
+					pos = pos - count + str.size();
+				else if (pos > offset)
+					pos = offset + str.size();
+			};
+			shift(Cursor);
+			shift(Anchor);
+		}
+
+		bool undo()
+		{
+			if (!EditsDone)
+				return false;
+
+			const edit& e = Edits[--EditsDone];
+			erase_range(e.Offset, e.Inserted.Length, nullptr);
+			insert_pieces(e.Offset, RemovedPieces.data() + e.RemovedFirst, e.RemovedCount);
+			Cursor = Anchor = e.Offset + e.RemovedLength;
+			MergeTyping = false;
+			ScrollToCursor = true;
+			return true;
+		}
+
+		bool redo()
+		{
+			if (EditsDone == Edits.size())
+				return false;
+
+			const edit& e = Edits[EditsDone++];
+			erase_range(e.Offset, e.RemovedLength, nullptr);
+			if (e.Inserted.Length)
+				insert_pieces(e.Offset, &e.Inserted, 1);
+			Cursor = Anchor = e.Offset + e.Inserted.Length;
+			MergeTyping = false;
+			ScrollToCursor = true;
+			return true;
+		}
+
+		//
+		// Cursor movement
+		//
+
+		[[nodiscard]] size_t prev_char(size_t offset) const
+		{
+			if (!offset)
+				return 0;
+			// Skip UTF-8 continuation bytes
+			while (--offset && (at(offset) & 0xC0) == 0x80)
+				;
+			return offset;
+		}
+
+		[[nodiscard]] size_t next_char(size_t offset) const
+		{
+			const size_t end = size();
+			if (offset >= end)
+				return end;
+			while (++offset < end && (at(offset) & 0xC0) == 0x80)
+				;
+			return offset;
+		}
+
+		/// <summary>
+		/// 0: blank, 1: line return, 2: word, 3: punctuation
+		/// </summary>
+		[[nodiscard]] static int char_class(char c)
+		{
+			if (c == ' ' || c == '\t' || c == '\r')
+				return 0;
+			if (c == '\n')
+				return 1;
+			if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || (c & 0x80))
+				return 2;
+			return 3;
+		}
+
+		[[nodiscard]] size_t prev_word(size_t offset) const
+		{
+			if (!offset)
+				return 0;
+
+			offset--;
+			while (offset && !char_class(at(offset)))
+				offset--;
+			const int cls = char_class(at(offset));
+			if (cls != 1)
+			{
+				while (offset && char_class(at(offset - 1)) == cls)
+					offset--;
+			}
+			return offset;
+		}
+
+		[[nodiscard]] size_t next_word(size_t offset) const
+		{
+			const size_t end = size();
+			if (offset >= end)
+				return end;
+
+			const int cls = char_class(at(offset));
+			if (cls == 1)
+				return offset + 1;
+			while (offset < end && char_class(at(offset)) == cls)
+				offset++;
+			while (offset < end && !char_class(at(offset)))
+				offset++;
+			return offset;
+		}
+
+		void select_word(size_t offset)
+		{
+			const size_t end = size();
+			const int cls = offset < end ? char_class(at(offset)) : 1;
+			Anchor = Cursor = offset;
+			if (cls == 1)
+				return;
+			while (Anchor && char_class(at(Anchor - 1)) == cls)
+				Anchor--;
+			while (Cursor < end && char_class(at(Cursor)) == cls)
+				Cursor++;
+		}
+
+		/// <summary>
+		/// Horizontal position of 'offset' from the start of its line
+		/// </summary>
+		float x_at(size_t offset, ImFont* font, float font_size)
+		{
+			const size_t begin = line_offset(line_at(offset));
+			const std::string_view text = view(begin, offset - begin, Line);
+			return font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, text.data(), text.data() + text.size()).x;
+		}
+
+		/// <summary>
+		/// Offset of the character boundary closest to 'x' on a line
+		/// </summary>
+		size_t offset_at_x(size_t line, float x, ImFont* font, float font_size)
+		{
+			const size_t begin = line_offset(line);
+			if (x <= 0.0f)
+				return begin;
+
+			const std::string_view line_text = view(begin, line_end(line) - begin, Line);
+			const char* const text = line_text.data();
+			const char* const text_end = text + line_text.size();
+			const char* remaining = text_end;
+			const float width = font->CalcTextSizeA(font_size, x, 0.0f, text, text_end, &remaining).x;
+			if (remaining < text_end)
+			{
+				// Round to the nearest side of the character under 'x'
+				const char* const next = remaining + ImTextCountUtf8BytesFromChar(remaining, text_end);
+				const float advance = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, remaining, next).x;
+				if (x - width > advance * 0.5f)
+					remaining = next;
+			}
+			return begin + (remaining - text);
+		}
+	};
+
+
+	text_editor::text_editor() :
+		m_Data(std::make_unique<data>())
+	{
+	}
+
+	text_editor::text_editor(std::string_view text) :
+		m_Data(std::make_unique<data>())
+	{
+		m_Data->reset(text);
+	}
+
+	text_editor::~text_editor() = default;
+
+	void text_editor::set_text(std::string_view text)
+	{
+		m_Data->reset(text);
+	}
+
+	std::string text_editor::text() const
+	{
+		std::string str;
+		m_Data->copy(0, m_Data->size(), str);
+		return str;
+	}
+
+	std::string text_editor::text(size_t offset, size_t count) const
+	{
+		std::string str;
+		m_Data->copy(offset, count, str);
+		return str;
+	}
+
+	std::string text_editor::line(size_t index) const
+	{
+		std::string str;
+		if (index < m_Data->lines_count())
+		{
+			const size_t begin = m_Data->line_offset(index);
+			m_Data->copy(begin, m_Data->line_end(index) - begin, str);
+		}
+		return str;
+	}
+
+	size_t text_editor::size() const
+	{
+		return m_Data->size();
+	}
+
+	size_t text_editor::lines_count() const
+	{
+		return m_Data->lines_count();
+	}
+
+	size_t text_editor::line_offset(size_t index) const
+	{
+		return m_Data->line_offset(index);
+	}
+
+	size_t text_editor::line_at(size_t offset) const
+	{
+		return m_Data->line_at(offset);
+	}
+
+	void text_editor::replace(size_t offset, size_t count, std::string_view str)
+	{
+		m_Data->replace(offset, count, str, false);
+	}
+
+	bool text_editor::undo()
+	{
+		return m_Data->undo();
+	}
+
+	bool text_editor::redo()
+	{
+		return m_Data->redo();
+	}
+
+	bool text_editor::can_undo() const
+	{
+		return m_Data->EditsDone != 0;
+	}
+
+	bool text_editor::can_redo() const
+	{
+		return m_Data->EditsDone != m_Data->Edits.size();
+	}
+
+	void text_editor::clear_undo()
+	{
+		data& d = *m_Data;
+		d.Edits.clear();
+		d.RemovedPieces.clear();
+		d.EditsDone = 0;
+		d.MergeTyping = false;
+	}
+
+	size_t text_editor::cursor() const
+	{
+		return m_Data->Cursor;
+	}
+
+	void text_editor::set_cursor(size_t offset, size_t anchor)
+	{
+		data& d = *m_Data;
+		d.Cursor = std::min(offset, d.size());
+		d.Anchor = anchor == SIZE_MAX ? d.Cursor : std::min(anchor, d.size());
+		d.PreferredX = -1.0f;
+		d.MergeTyping = false;
+		d.ScrollToCursor = true;
+	}
+
+	bool text_editor::render(const char* str_id, const ImVec2& size)
+	{
+		data& d = *m_Data;
+		ImGuiContext& g = *GImGui;
+		ImGuiIO& io = g.IO;
+		ImFont* const font = ImGui::GetFont();
+		const float font_size = ImGui::GetFontSize();
+		const float line_height = ImGui::GetTextLineHeight();
+
+		ImGui::SetNextWindowContentSize({ d.MaxLineWidth + font_size, static_cast<float>(d.lines_count()) * line_height });
+		if (!ImGui::BeginChild(str_id, size, true, ImGuiWindowFlags_HorizontalScrollbar | ImGuiWindowFlags_NoNavInputs))
+		{
+			ImGui::EndChild();
+			return false;
+		}
+
+		ImGuiWindow* const window = ImGui::GetCurrentWindow();
+		const ImVec2 origin = window->DC.CursorPos;
+		const size_t lines_count = d.lines_count();
+		const auto offset_at = [&](const ImVec2& pos)
+		{
+			const float line = (pos.y - origin.y) / line_height;
+			return d.offset_at_x(line <= 0.0f ? 0 : std::min(static_cast<size_t>(line), lines_count - 1), pos.x - origin.x, font, font_size);
+		};
+
+		bool modified = false;
+		bool moved = false;
+
+		// An item over the visible area keeps clicks from moving the parent window
+		const ImGuiID id = window->GetID("##text");
+		const ImRect bb = window->InnerClipRect;
+		ImGui::ItemAdd(bb, id);
+		bool hovered, held;
+		const bool pressed = ImGui::ButtonBehavior(bb, id, &hovered, &held, ImGuiButtonFlags_PressedOnClick);
+		if (hovered || held)
+			ImGui::SetMouseCursor(ImGuiMouseCursor_TextInput);
+		if (pressed)
+		{
+			if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left))
+				d.select_word(offset_at(io.MousePos));
+			else
+			{
+				d.Cursor = offset_at(io.MousePos);
+				if (!io.KeyShift)
+					d.Anchor = d.Cursor;
+			}
+			moved = true;
+		}
+		else if (held && (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f))
+		{
+			d.Cursor = offset_at(io.MousePos);
+			moved = true;
+		}
+
+		if (ImGui::IsWindowFocused())
+		{
+			ImGui::CaptureKeyboardFromApp(true);
+			g.WantTextInputNextFrame = 1;
+
+			const bool is_osx = io.ConfigMacOSXBehaviors;
+			const bool shortcut = is_osx ? io.KeySuper && !io.KeyCtrl : io.KeyCtrl;
+			const bool word_move = is_osx ? io.KeyAlt : io.KeyCtrl;
+			const bool editable = !m_ReadOnly;
+			const size_t sel_begin = std::min(d.Cursor, d.Anchor);
+			const size_t sel_end = std::max(d.Cursor, d.Anchor);
+			const size_t page_lines = std::max(static_cast<size_t>(window->InnerRect.GetHeight() / line_height), size_t{ 1 });
+
+			const auto move_to = [&](size_t offset, bool keep_x = false)
+			{
+				d.Cursor = offset;
+				if (!io.KeyShift)
+					d.Anchor = offset;
+				if (!keep_x)
+					d.PreferredX = -1.0f;
+				moved = true;
+			};
+			const auto move_lines = [&](ptrdiff_t count)
+			{
+				const size_t line = d.line_at(d.Cursor);
+				if (d.PreferredX < 0.0f)
+					d.PreferredX = d.x_at(d.Cursor, font, font_size);
+				const size_t target = count < 0 ?
+					line - std::min(line, static_cast<size_t>(-count)) :
+					std::min(line + static_cast<size_t>(count), lines_count - 1);
+				move_to(d.offset_at_x(target, d.PreferredX, font, font_size), true);
+			};
+			const auto replace_selection = [&](std::string_view str, bool typing)
+			{
+				d.replace(sel_begin, sel_end - sel_begin, str, typing);
+				d.Cursor = d.Anchor = sel_begin + str.size();
+				d.PreferredX = -1.0f;
+				d.ScrollToCursor = true;
+				d.CursorAnim = 0.0f;
+				modified = true;
+			};
+			const auto copy_selection = [&]()
+			{
+				if (sel_begin == sel_end)
+					return false;
+				d.copy(sel_begin, sel_end - sel_begin, d.Line);
+				ImGui::SetClipboardText(d.Line.c_str());
+				return true;
+			};
+
+			if (ImGui::IsKeyPressed(ImGuiKey_LeftArrow))
+				move_to(sel_begin != sel_end && !io.KeyShift ? sel_begin : word_move ? d.prev_word(d.Cursor) : d.prev_char(d.Cursor));
+			else if (ImGui::IsKeyPressed(ImGuiKey_RightArrow))
+				move_to(sel_begin != sel_end && !io.KeyShift ? sel_end : word_move ? d.next_word(d.Cursor) : d.next_char(d.Cursor));
+			else if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))
+				move_lines(-1);
+			else if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))
+				move_lines(1);
+			else if (ImGui::IsKeyPressed(ImGuiKey_PageUp))
+				move_lines(-static_cast<ptrdiff_t>(page_lines));
+			else if (ImGui::IsKeyPressed(ImGuiKey_PageDown))
+				move_lines(static_cast<ptrdiff_t>(page_lines));
+			else if (ImGui::IsKeyPressed(ImGuiKey_Home))
+				move_to(io.KeyCtrl ? 0 : d.line_offset(d.line_at(d.Cursor)));
+			else if (ImGui::IsKeyPressed(ImGuiKey_End))
+				move_to(io.KeyCtrl ? d.size() : d.line_end(d.line_at(d.Cursor)));
+			else if (shortcut && ImGui::IsKeyPressed(ImGuiKey_A))
+			{
+				d.Anchor = 0;
+				d.Cursor = d.size();
+				d.MergeTyping = false;
+			}
+			else if (shortcut && ImGui::IsKeyPressed(ImGuiKey_C))
+				copy_selection();
+			else if (shortcut && ImGui::IsKeyPressed(ImGuiKey_X))
+			{
+				if (copy_selection() && editable)
+					replace_selection({}, false);
+			}
+			else if (shortcut && ImGui::IsKeyPressed(ImGuiKey_V))
+			{
+				if (const char* clipboard = ImGui::GetClipboardText(); clipboard && editable)
+					replace_selection(clipboard, false);
+			}
+			else if (shortcut && ((ImGui::IsKeyPressed(ImGuiKey_Z) && io.KeyShift) || ImGui::IsKeyPressed(ImGuiKey_Y)))
+				modified |= editable && d.redo();
+			else if (shortcut && ImGui::IsKeyPressed(ImGuiKey_Z))
+				modified |= editable && d.undo();
+			else if (editable && ImGui::IsKeyPressed(ImGuiKey_Backspace))
+			{
+				if (sel_begin == sel_end)
+					d.Anchor = word_move ? d.prev_word(d.Cursor) : d.prev_char(d.Cursor);
+				const size_t begin = std::min(d.Cursor, d.Anchor);
+				d.replace(begin, std::max(d.Cursor, d.Anchor) - begin, {}, false);
+				move_to(begin);
+				d.Anchor = begin;
+				modified = true;
+			}
+			else if (editable && ImGui::IsKeyPressed(ImGuiKey_Delete))
+			{
+				if (sel_begin == sel_end)
+					d.Anchor = word_move ? d.next_word(d.Cursor) : d.next_char(d.Cursor);
+				const size_t begin = std::min(d.Cursor, d.Anchor);
+				d.replace(begin, std::max(d.Cursor, d.Anchor) - begin, {}, false);
+				move_to(begin);
+				d.Anchor = begin;
+				modified = true;
+			}
+			else if (editable && (ImGui::IsKeyPressed(ImGuiKey_Enter) || ImGui::IsKeyPressed(ImGuiKey_KeypadEnter)))
+				replace_selection("\n", true);
+			else if (editable && ImGui::IsKeyPressed(ImGuiKey_Tab) && !io.KeyCtrl && !io.InputQueueCharacters.contains('\t'))
+				replace_selection("\t", true);
+
+			// Characters typed with Ctrl are shortcuts, AltGr (Ctrl+Alt) is a regular key
+			if (editable && !io.InputQueueCharacters.empty() && !(io.KeyCtrl && !io.KeyAlt) && !(is_osx && io.KeySuper))
+			{
+				std::string typed;
+				for (const ImWchar c : io.InputQueueCharacters)
+				{
+					if (c == '\t' || (c >= ' ' && c != 0x7F))
+					{
+						char utf8[5];
+						typed += ImTextCharToUtf8(utf8, c);
+					}
+				}
+				if (!typed.empty())
+				{
+					// Each frame of typed characters replaces the selection of the previous one
+					const size_t begin = std::min(d.Cursor, d.Anchor);
+					d.replace(begin, std::max(d.Cursor, d.Anchor) - begin, typed, true);
+					d.Cursor = d.Anchor = begin + typed.size();
+					d.PreferredX = -1.0f;
+					d.ScrollToCursor = true;
+					d.CursorAnim = 0.0f;
+					modified = true;
+				}
+				io.InputQueueCharacters.resize(0);
+			}
+		}
+
+		if (moved)
+		{
+			d.MergeTyping = false;
+			d.ScrollToCursor = true;
+			d.CursorAnim = 0.0f;
+		}
+
+		if (d.ScrollToCursor)
+		{
+			d.ScrollToCursor = false;
+			const ImRect& view = window->InnerClipRect;
+			const float top = origin.y + static_cast<float>(d.line_at(d.Cursor)) * line_height;
+			const float left = origin.x + d.x_at(d.Cursor, font, font_size);
+			if (top < view.Min.y)
+				ImGui::SetScrollY(window->Scroll.y - (view.Min.y - top));
+			else if (top + line_height > view.Max.y)
+				ImGui::SetScrollY(window->Scroll.y + (top + line_height - view.Max.y));
+			// Keep a few characters of context on the sides
+			if (left < view.Min.x)
+				ImGui::SetScrollX(std::max(window->Scroll.x - (view.Min.x - left) - font_size * 4.0f, 0.0f));
+			else if (left + font_size > view.Max.x)
+				ImGui::SetScrollX(window->Scroll.x + (left - view.Max.x) + font_size * 4.0f);
+		}
+
+		// Blink as InputText(), the cursor stays visible while it moves
+		d.CursorAnim += io.DeltaTime;
+		const bool focused = ImGui::IsWindowFocused();
+		const bool cursor_visible = focused && (!io.ConfigInputTextCursorBlink || d.CursorAnim <= 0.0f || std::fmod(d.CursorAnim, 1.20f) <= 0.80f);
+		if (focused && io.ConfigInputTextCursorBlink)
+		{
+			const float phase = d.CursorAnim <= 0.0f ? d.CursorAnim : std::fmod(d.CursorAnim, 1.20f);
+			frame_scheduler::request_redraw((phase <= 0.80f ? 0.80f - phase : 1.20f - phase) + 0.001);
+		}
+
+		ImDrawList* const draw_list = window->DrawList;
+		const ImU32 text_col = ImGui::GetColorU32(ImGuiCol_Text);
+		const ImU32 selection_col = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+		const size_t sel_begin = std::min(d.Cursor, d.Anchor);
+		const size_t sel_end = std::max(d.Cursor, d.Anchor);
+		const size_t cursor_line = d.line_at(d.Cursor);
+		const auto width_of = [&](const char* text, const char* text_end)
+		{
+			return text == text_end ? 0.0f : font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, text, text_end).x;
+		};
+
+		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { g.Style.ItemSpacing.x, 0.0f });
+		ImGuiListClipper clipper;
+		clipper.Begin(static_cast<int>(std::min(lines_count, static_cast<size_t>(INT_MAX))), line_height);
+		while (clipper.Step())
+		{
+			size_t begin = d.line_offset(clipper.DisplayStart);
+			for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+			{
+				// 'end' is the line return or the end of the document
+				const size_t next = static_cast<size_t>(i) + 1 < lines_count ? d.line_offset(static_cast<size_t>(i) + 1) : d.size() + 1;
+				const size_t end = next - 1;
+				const std::string_view line_text = d.view(begin, end - begin, d.Line);
+				const char* const text = line_text.data();
+				const char* const text_end = text + line_text.size();
+				const ImVec2 pos = window->DC.CursorPos;
+				const bool is_cursor_line = static_cast<size_t>(i) == cursor_line;
+				const bool is_selected = sel_begin <= end && sel_end > begin;
+
+				// Widths of the prefixes ending at the selection bounds and the cursor, in one pass over the line
+				// 0: selection begin, 1: selection end, 2: cursor
+				size_t stops[3] = { 0, line_text.size(), line_text.size() };
+				if (is_selected)
+				{
+					stops[0] = sel_begin <= begin ? 0 : sel_begin - begin;
+					stops[1] = sel_end > end ? line_text.size() : sel_end - begin;
+				}
+				if (is_cursor_line)
+					stops[2] = d.Cursor - begin;
+				int order[3] = { 0, 1, 2 };
+				std::sort(order, order + 3, [&](int a, int b) { return stops[a] < stops[b]; });
+				float stop_x[3];
+				float width = 0.0f;
+				size_t measured = 0;
+				for (const int stop : order)
+				{
+					width += width_of(text + measured, text + stops[stop]);
+					measured = stops[stop];
+					stop_x[stop] = width;
+				}
+				width += width_of(text + measured, text_end);
+				d.MaxLineWidth = std::max(d.MaxLineWidth, width);
+
+				if (is_selected)
+				{
+					// A selected line return is shown as a small space
+					const float x1 = sel_end > end ? width + font_size * 0.4f : stop_x[1];
+					draw_list->AddRectFilled({ pos.x + stop_x[0], pos.y }, { pos.x + x1, pos.y + line_height }, selection_col);
+				}
+				if (text != text_end)
+					draw_list->AddText(font, font_size, pos, text_col, text, text_end);
+				if (is_cursor_line)
+				{
+					const float x = pos.x + stop_x[2];
+					if (cursor_visible)
+						draw_list->AddLine({ x, pos.y }, { x, pos.y + line_height - 0.5f }, text_col);
+					if (focused)
+					{
+						g.PlatformImeData.WantVisible = true;
+						g.PlatformImeData.InputPos = { x - 1.0f, pos.y };
+						g.PlatformImeData.InputLineHeight = line_height;
+					}
+				}
+
+				ImGui::ItemSize({ width, line_height });
+				begin = next;
+			}
+		}
+		ImGui::PopStyleVar();
+
+		ImGui::EndChild();
+		return modified;
+	}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scopes.hpp"
+#include "label_id.hpp"
 
 namespace imcxx
 {
@@ -21,6 +22,14 @@ namespace imcxx
 			m_ShouldPop(should_tree_pop(flags))
 		{}
 
+		/// <summary>
+		/// Same as 'ImGui::TreeNodeEx(label, flags)' with the label's hash precomputed.
+		/// </summary>
+		tree_node(const label_id& label, ImGuiTreeNodeFlags flags = 0) :
+			scope_wrap(tree_node_behavior(label, flags)),
+			m_ShouldPop(should_tree_pop(flags))
+		{}
+
 
 		template<typename _StrTy, typename _FmtTy>
 		tree_node(va_args, const _StrTy& label, ImGuiTreeNodeFlags flags, const _FmtTy& fmt, va_list arg_list) :
@@ -69,6 +78,16 @@ namespace imcxx
 			return !(flags & ImGuiTreeNodeFlags_NoTreePushOnOpen);
 		}
 
+		static bool tree_node_behavior(const label_id& label, ImGuiTreeNodeFlags flags)
+		{
+			ImGuiWindow* window = ImGui::GetCurrentWindow();
+			if (window->SkipItems)
+				return false;
+			return ImGui::TreeNodeBehavior(label.get_id(window), flags, label.label());
+		}
+
+		friend class collapsing_header;
+
 		void destruct()
 		{
 			if (m_ShouldPop)
@@ -86,6 +105,13 @@ namespace imcxx
 			scope_wrap(ImGui::CollapsingHeader(impl::get_string(label), flags))
 		{}
 
+		/// <summary>
+		/// Same as 'ImGui::CollapsingHeader(label, flags)' with the label's hash precomputed.
+		/// </summary>
+		collapsing_header(const label_id& label, ImGuiTreeNodeFlags flags = 0) :
+			scope_wrap(tree_node::tree_node_behavior(label, flags | ImGuiTreeNodeFlags_CollapsingHeader))
+		{}
+
 		void open_next(bool is_open, ImGuiCond cond = 0)
 		{
 			ImGui::SetNextItemOpen(is_open, cond);
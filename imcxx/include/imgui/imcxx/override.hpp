@@ -1,6 +1,9 @@
 #pragma once
 
+#include <utility>
 #include "scopes.hpp"
+#include "label_id.hpp"
+#include "imgui/imgui_internal.h"
 
 namespace imcxx
 {
@@ -240,6 +243,8 @@ namespace imcxx
 				++m_PopCount;
 				if constexpr (std::is_same_v<_Ty0, std::initializer_list<const char*>>)
 					ImGui::PushID(*value.begin(), *value.end());
+				else if constexpr (std::is_same_v<_Ty0, label_id>)
+					ImGui::PushOverrideID(value.get_id_no_keepalive());
 				else
 					ImGui::PushID(value);
 			}
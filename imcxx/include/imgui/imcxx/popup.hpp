@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scopes.hpp"
+#include "label_id.hpp"
 
 namespace imcxx
 {
@@ -33,6 +34,13 @@ namespace imcxx
 			scope_wrap(ImGui::BeginPopup(impl::get_string(str_id), flags))
 		{}
 
+		/// <summary>
+		/// Same as 'ImGui::BeginPopup(str_id, flags)' with the identifier's hash precomputed.
+		/// </summary>
+		popup(const label_id& str_id, ImGuiWindowFlags flags = 0) :
+			scope_wrap(begin_popup(str_id, flags))
+		{}
+
 		/// <summary>
 		/// Popups: begin/end functions
 		///  - BeginPopup(): query popup state, if open start appending into the window. Call EndPopup() afterwards. ImGuiWindowFlags are forwarded to the window.
@@ -90,7 +98,38 @@ namespace imcxx
 			ImGui::CloseCurrentPopup();
 		}
 
+		/// <summary>
+		/// Same as 'ImGui::OpenPopup(str_id, popup_flags)' with the identifier's hash precomputed.
+		/// </summary>
+		static void open(const label_id& str_id, ImGuiPopupFlags popup_flags = 0)
+		{
+			ImGui::OpenPopupEx(str_id.get_id(), popup_flags);
+		}
+
+		/// <summary>
+		/// Same as 'ImGui::IsPopupOpen(str_id, flags)' with the identifier's hash precomputed.
+		/// With 'ImGuiPopupFlags_AnyPopupId' the identifier is ignored, as by 'ImGui::IsPopupOpen()'.
+		/// </summary>
+		[[nodiscard]] static bool is_open(const label_id& str_id, ImGuiPopupFlags flags = 0)
+		{
+			const ImGuiID id = (flags & ImGuiPopupFlags_AnyPopupId) ? 0 : str_id.get_id_no_keepalive();
+			IM_ASSERT((!(flags & ImGuiPopupFlags_AnyPopupLevel) || id == 0) && "Cannot use is_open() with a string id and ImGuiPopupFlags_AnyPopupLevel.");
+			return ImGui::IsPopupOpen(id, flags);
+		}
+
 	private:
+		static bool begin_popup(const label_id& str_id, ImGuiWindowFlags flags)
+		{
+			ImGuiContext& g = *GImGui;
+			if (g.OpenPopupStack.Size <= g.BeginPopupStack.Size) // Early out for performance
+			{
+				g.NextWindowData.ClearFlags(); // We behave like Begin() and need to consume those values
+				return false;
+			}
+			flags |= ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoSavedSettings;
+			return ImGui::BeginPopupEx(str_id.get_id(g.CurrentWindow), flags);
+		}
+
 		void destruct()
 		{
 			ImGui::EndPopup();
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <type_traits>
+#include <functional>
 #include <string>
+#include <array>
 #include "imgui/imgui.h"
 
 namespace imcxx
@@ -127,16 +129,16 @@ namespace imcxx
 		}
 
 	protected:
-		template<bool _HasBool = true>
+		template<bool _HasBool = true, typename = void>
 		struct _compressed_type_t
 		{
 			bool _HasMoved : 1;
 			bool _Value : 1;
-			constexpr _compressed_type_t(bool v) noexcept :_Value(v), _HasMoved(false) {}
+			constexpr _compressed_type_t(bool v) noexcept : _HasMoved(false), _Value(v) {}
 		};
 
-		template<>
-		struct _compressed_type_t<false>
+		template<typename _Dummy>
+		struct _compressed_type_t<false, _Dummy>
 		{
 			bool _HasMoved : 1;
 			constexpr _compressed_type_t(bool) noexcept : _HasMoved(false) {}
@@ -213,7 +215,7 @@ namespace imcxx
 
 
 		template<typename _Ty>
-		constexpr [[nodiscard]] ImVec2 to_imvec2(const _Ty& vec) noexcept
+		[[nodiscard]] constexpr ImVec2 to_imvec2(const _Ty& vec) noexcept
 		{
 			if constexpr (is_imvec2_v<_Ty>)
 				return vec;
@@ -231,7 +233,7 @@ namespace imcxx
 		}
 
 		template<typename _Ty>
-		constexpr [[nodiscard]] ImVec4 to_imvec4(const _Ty& vec) noexcept
+		[[nodiscard]] constexpr ImVec4 to_imvec4(const _Ty& vec) noexcept
 		{
 			if constexpr (is_imvec4_v<_Ty>)
 				return vec;
@@ -246,7 +248,7 @@ namespace imcxx
 		}
 
 		template<typename _Ty>
-		static constexpr [[nodiscard]] const char* get_string(const _Ty& str) noexcept
+		[[nodiscard]] static constexpr const char* get_string(const _Ty& str) noexcept
 		{
 			if constexpr (std::is_same_v<char*, std::decay_t<_Ty>> || std::is_same_v<const char*, std::decay_t<_Ty>>)
 				return str;
@@ -262,7 +264,7 @@ namespace imcxx
 		}
 
 		template<typename _Ty>
-		static constexpr [[nodiscard]] ImGuiDataType to_imdatatype() noexcept
+		[[nodiscard]] static constexpr ImGuiDataType to_imdatatype() noexcept
 		{
 			if constexpr (std::is_same_v<_Ty, char>)
 				return ImGuiDataType_S8;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "scopes.hpp"
+#include "label_id.hpp"
 
 namespace imcxx
 {
@@ -24,11 +25,16 @@ namespace imcxx
 		/// create a Tab. Returns true if the Tab is selected.
 		/// </summary>
 		template<typename _StrTy>
-		[[nodiscard]] item add_item(const _StrTy& label, bool* p_open = nullptr, ImGuiTabItemFlags flags = 0)
+		[[nodiscard]] auto add_item(const _StrTy& label, bool* p_open = nullptr, ImGuiTabItemFlags flags = 0)
 		{
 			return add_item_impl(impl::get_string(label), p_open, flags);
 		}
 
+		/// <summary>
+		/// Same as 'add_item(label)' with the label's hash precomputed.
+		/// </summary>
+		[[nodiscard]] item add_item(const label_id& label, bool* p_open = nullptr, ImGuiTabItemFlags flags = 0);
+
 		/// <summary>
 		/// create a Tab behaving like a button. return true when clicked. cannot be selected in the tab bar
 		/// </summary>
@@ -64,7 +70,36 @@ namespace imcxx
 			scope_wrap(ImGui::BeginTabItem(impl::get_string(label), p_open, flags))
 		{}
 
+		/// <summary>
+		/// Same as 'ImGui::BeginTabItem(label, p_open, flags)' with the label's hash precomputed.
+		/// </summary>
+		item(const label_id& label, bool* p_open = nullptr, ImGuiTabItemFlags flags = 0) :
+			scope_wrap(begin_tab_item(label, p_open, flags))
+		{}
+
 	private:
+		static bool begin_tab_item(const label_id& label, bool* p_open, ImGuiTabItemFlags flags)
+		{
+			ImGuiContext& g = *GImGui;
+			ImGuiWindow* window = g.CurrentWindow;
+			if (window->SkipItems)
+				return false;
+
+			ImGuiTabBar* tab_bar = g.CurrentTabBar;
+			if (tab_bar == nullptr)
+			{
+				IM_ASSERT_USER_ERROR(tab_bar, "Needs to be called between BeginTabBar() and EndTabBar()!");
+				return false;
+			}
+			IM_ASSERT((flags & ImGuiTabItemFlags_Button) == 0);
+
+			const ImGuiID id = label.get_id(window);
+			const bool ret = ImGui::TabItemEx(tab_bar, label.label(), id, p_open, flags, nullptr);
+			if (ret && !(flags & ImGuiTabItemFlags_NoPushId))
+				ImGui::PushOverrideID(id);
+			return ret;
+		}
+
 		void destruct()
 		{
 			ImGui::EndTabItem();
@@ -75,4 +110,9 @@ namespace imcxx
 	{
 		return item{ label, p_open, flags };
 	}
+
+	inline auto tabbar::add_item(const label_id& label, bool* p_open, ImGuiTabItemFlags flags) -> item
+	{
+		return item{ label, p_open, flags };
+	}
 }
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include "scopes.hpp"
+
+namespace imcxx
+{
+	/// <summary>
+	/// Sorted-index cache for a table over a random-access range, driven by the table's ImGuiTableSortSpecs.
+	/// - Keeps a permutation of the range ('order()[display_row] == index in the range'), the range itself is never moved.
+	/// - A comparator per column (indexed by column index) returns <0, 0 or >0 like 'strcmp', multi-column specs are chained and ties are broken by index, so the order is deterministic.
+	/// - A full sort only happens when the specs change (or too many rows were invalidated): appended rows and rows marked with 'invalidate()' are sorted
+	///   on their own and merged into the existing order.
+	/// - With 'async_threshold' != 0, full sorts of at least that many rows run on a worker thread while 'order()' keeps the previous order (new rows appended at the end).
+	///   The range must not be modified (e.g. reallocated by push_back) while 'is_sorting()' is true. A sort that completes after the specs changed or rows were removed
+	///   is discarded and started again.
+	/// - The sorter must outlive the frames it is used in: keep it next to the data, not in the frame scope.
+	///
+	/// static imcxx::table_sorter<std::vector<order>> sorter{ { compare_id, compare_price }, 100000 };
+	/// sorter.update(orders); // inside the table, after TableSetupColumn()
+	/// for (size_t index : sorter.order()) ...
+	/// </summary>
+	template<typename _RangeTy>
+	class table_sorter
+	{
+	public:
+		using range_type = _RangeTy;
+		using iterator_type = decltype(std::cbegin(std::declval<const _RangeTy&>()));
+		using value_type = typename std::iterator_traits<iterator_type>::value_type;
+		using compare_fn = std::function<int(const value_type& a, const value_type& b)>;
+
+		explicit table_sorter(std::vector<compare_fn> columns, size_t async_threshold = 0) :
+			m_Columns(std::move(columns)),
+			m_AsyncThreshold(async_threshold)
+		{}
+
+		table_sorter(const table_sorter&) = delete;
+		table_sorter& operator=(const table_sorter&) = delete;
+
+		~table_sorter()
+		{
+			if (m_Job.valid())
+				m_Job.wait();
+		}
+
+		/// <summary>
+		/// Update the order from the current table's sort specs, call it once per frame inside the table after its columns were setup.
+		/// Returns true if 'order()' changed.
+		/// </summary>
+		bool update(const range_type& range)
+		{
+			return update(range, ImGui::TableGetSortSpecs());
+		}
+
+		/// <summary>
+		/// Update the order from 'specs' (NULL: keep the current specs).
+		/// Returns true if 'order()' changed.
+		/// </summary>
+		bool update(const range_type& range, ImGuiTableSortSpecs* specs)
+		{
+			const size_t count = static_cast<size_t>(std::size(range));
+
+			if (specs && specs->SpecsDirty)
+			{
+				set_specs(specs);
+				specs->SpecsDirty = false;
+			}
+
+			if (count < m_Order.size())
+			{
+				// Rows were removed: indices are meaningless now, start over
+				m_Order.clear();
+				m_Changed.clear();
+				m_NeedsFullSort = !m_Keys.empty();
+				m_Generation++;
+			}
+
+			const bool changed = poll_job(count);
+			if (m_Job.valid())
+				return append_unsorted(count) || changed;
+
+			if (m_NeedsFullSort || m_Changed.size() > count / 8)
+			{
+				m_NeedsFullSort = false;
+				m_Changed.clear();
+				full_sort(range, count);
+				return true;
+			}
+
+			if (count > m_Order.size() || !m_Changed.empty())
+			{
+				merge_pending(range, count);
+				return true;
+			}
+			return changed;
+		}
+
+		/// <summary>
+		/// Mark a row whose sorted columns changed, it will be moved to its new place by the next update().
+		/// </summary>
+		void invalidate(size_t index)
+		{
+			m_Changed.push_back(index);
+		}
+
+		/// <summary>
+		/// Force a full sort on the next update().
+		/// </summary>
+		void invalidate_all() noexcept
+		{
+			m_NeedsFullSort = true;
+			m_Generation++;
+		}
+
+		/// <summary>
+		/// 'order()[display_row]' is the index of the row in the range.
+		/// </summary>
+		[[nodiscard]] const std::vector<size_t>& order() const noexcept
+		{
+			return m_Order;
+		}
+
+		/// <summary>
+		/// true while a full sort runs on a worker thread.
+		/// </summary>
+		[[nodiscard]] bool is_sorting() const noexcept
+		{
+			return m_Job.valid();
+		}
+
+		/// <summary>
+		/// true when the current specs sort on at least one column.
+		/// </summary>
+		[[nodiscard]] bool has_specs() const noexcept
+		{
+			return !m_Keys.empty();
+		}
+
+	private:
+		struct sort_key
+		{
+			compare_fn compare;
+			bool descending;
+		};
+
+		struct index_less
+		{
+			iterator_type begin;
+			const std::vector<sort_key>* keys;
+
+			bool operator()(size_t a, size_t b) const
+			{
+				for (const sort_key& key : *keys)
+				{
+					const int res = key.compare(begin[a], begin[b]);
+					if (res != 0)
+						return key.descending ? res > 0 : res < 0;
+				}
+				return a < b;
+			}
+		};
+
+		void set_specs(const ImGuiTableSortSpecs* specs)
+		{
+			m_Keys.clear();
+			for (int i = 0; i < specs->SpecsCount; i++)
+			{
+				const ImGuiTableColumnSortSpecs& spec = specs->Specs[i];
+				if (spec.ColumnIndex < 0 || static_cast<size_t>(spec.ColumnIndex) >= m_Columns.size() || !m_Columns[spec.ColumnIndex])
+					continue;
+				m_Keys.push_back({ m_Columns[spec.ColumnIndex], spec.SortDirection == ImGuiSortDirection_Descending });
+			}
+			m_NeedsFullSort = true;
+			m_Generation++;
+		}
+
+		bool append_unsorted(size_t count)
+		{
+			const size_t old_size = m_Order.size();
+			for (size_t i = old_size; i < count; i++)
+				m_Order.push_back(i);
+			return count != old_size;
+		}
+
+		void full_sort(const range_type& range, size_t count)
+		{
+			if (m_Keys.empty())
+			{
+				m_Order.resize(count);
+				std::iota(m_Order.begin(), m_Order.end(), size_t{ 0 });
+				return;
+			}
+
+			if (m_AsyncThreshold && count >= m_AsyncThreshold)
+			{
+				append_unsorted(count);
+				m_JobGeneration = m_Generation;
+				m_JobCount = count;
+				m_Job = std::async(
+					std::launch::async,
+					[begin = std::cbegin(range), count, keys = m_Keys]()
+					{
+						std::vector<size_t> order(count);
+						std::iota(order.begin(), order.end(), size_t{ 0 });
+						std::sort(order.begin(), order.end(), index_less{ begin, &keys });
+						return order;
+					}
+				);
+				return;
+			}
+
+			m_Order.resize(count);
+			std::iota(m_Order.begin(), m_Order.end(), size_t{ 0 });
+			std::sort(m_Order.begin(), m_Order.end(), index_less{ std::cbegin(range), &m_Keys });
+		}
+
+		void merge_pending(const range_type& range, size_t count)
+		{
+			const size_t covered = m_Order.size();
+			m_Pending.clear();
+
+			if (!m_Changed.empty() && !m_Keys.empty())
+			{
+				// Rows past 'covered' are not in the order yet, they are merged as appended rows below
+				std::sort(m_Changed.begin(), m_Changed.end());
+				m_Changed.erase(std::unique(m_Changed.begin(), m_Changed.end()), m_Changed.end());
+				while (!m_Changed.empty() && m_Changed.back() >= covered)
+					m_Changed.pop_back();
+
+				m_IsChanged.resize(covered);
+				for (size_t index : m_Changed)
+					m_IsChanged[index] = true;
+				m_Order.erase(
+					std::remove_if(m_Order.begin(), m_Order.end(), [this](size_t index) { return m_IsChanged[index]; }),
+					m_Order.end()
+				);
+				for (size_t index : m_Changed)
+					m_IsChanged[index] = false;
+				m_Pending.insert(m_Pending.end(), m_Changed.begin(), m_Changed.end());
+			}
+			m_Changed.clear();
+
+			for (size_t i = covered; i < count; i++)
+				m_Pending.push_back(i);
+
+			if (m_Keys.empty())
+			{
+				m_Order.insert(m_Order.end(), m_Pending.begin(), m_Pending.end());
+				return;
+			}
+
+			// Binary search the place of each pending row and copy the runs in between:
+			// O(k.log(n)) comparisons for k pending rows, instead of O(n) for a full merge
+			const index_less less{ std::cbegin(range), &m_Keys };
+			std::sort(m_Pending.begin(), m_Pending.end(), less);
+
+			m_Scratch.resize(m_Order.size() + m_Pending.size());
+			auto out = m_Scratch.begin();
+			auto first = m_Order.cbegin();
+			for (size_t index : m_Pending)
+			{
+				const auto pos = std::upper_bound(first, m_Order.cend(), index, less);
+				out = std::copy(first, pos, out);
+				*out++ = index;
+				first = pos;
+			}
+			std::copy(first, m_Order.cend(), out);
+			m_Order.swap(m_Scratch);
+		}
+
+		bool poll_job(size_t count)
+		{
+			if (!m_Job.valid() || m_Job.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return false;
+
+			std::vector<size_t> order = m_Job.get();
+			if (m_JobGeneration != m_Generation || m_JobCount > count)
+			{
+				// The specs changed or rows were removed while sorting: the result is stale, sort again
+				m_NeedsFullSort = true;
+				return false;
+			}
+
+			// Rows appended while sorting are past the end of the result, the next merge will place them
+			m_Order = std::move(order);
+			return true;
+		}
+
+		std::vector<compare_fn> m_Columns;
+		std::vector<sort_key> m_Keys;
+		std::vector<size_t> m_Order;
+		std::vector<size_t> m_Changed;
+		std::vector<size_t> m_Pending;
+		std::vector<size_t> m_Scratch;
+		std::vector<bool> m_IsChanged;
+		std::future<std::vector<size_t>> m_Job;
+		size_t m_AsyncThreshold;
+		// Bumped when the order must be rebuilt from scratch (specs changed, rows removed), a job of an older generation is discarded
+		size_t m_Generation{ };
+		size_t m_JobGeneration{ };
+		size_t m_JobCount{ };
+		bool m_NeedsFullSort{ };
+	};
+}
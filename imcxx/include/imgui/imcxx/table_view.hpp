@@ -0,0 +1,155 @@
+#pragma once
+
+#include <climits>
+#include <functional>
+#include <iterator>
+#include "tables.hpp"
+#include "table_sorter.hpp"
+
+namespace imcxx
+{
+	/// <summary>
+	/// Virtualized table over a random-access range ('std::vector', 'std::deque', 'std::array', c-array...)
+	/// - Columns are described once with 'column_info' (header setup + a function to draw a cell), the view submits the rows.
+	/// - Only rows inside the scrolling region are submitted with ImGuiListClipper, the cost of a frame depends on the visible rows, not on the size of the range.
+	/// - Rows frozen with 'setup(cols, rows)' are always submitted first, the header row being the first of them.
+	/// - Each row pushes an ID from its key (its index in the range by default), so widgets in a row keep their state (selection, open nodes...) while scrolling.
+	/// - Cells of hidden or clipped columns are not drawn.
+	/// - Rows can be displayed in the order of a 'table_sorter' with 'sort()', cell functions and keys still receive the index in the range.
+	/// - The range and the columns are referenced, not copied: they must outlive the view.
+	///
+	/// imcxx::table_view view{ "##orders", orders, columns, ImGuiTableFlags_ScrollY };
+	/// if (view)
+	/// {
+	///		view.setup(0, 1);
+	///		view.sort(sorter); // optional
+	///		view.render();
+	/// }
+	/// </summary>
+	template<typename _RangeTy>
+	class [[nodiscard]] table_view : public table
+	{
+	public:
+		using range_type = _RangeTy;
+		using iterator_type = decltype(std::cbegin(std::declval<const _RangeTy&>()));
+		using value_type = typename std::iterator_traits<iterator_type>::value_type;
+
+		using cell_fn = std::function<void(const value_type& value, size_t index)>;
+		using key_fn = std::function<size_t(const value_type& value, size_t index)>;
+
+		struct column_info
+		{
+			setup_info setup;
+			cell_fn cell;
+		};
+
+		/// <summary>
+		/// 'columns' can be a c-array, 'std::array' or 'std::vector' of 'column_info'
+		/// </summary>
+		template<typename _StrTy, typename _ColumnsTy>
+		table_view(const _StrTy& name, const _RangeTy& range, const _ColumnsTy& columns, ImGuiTableFlags flags = 0, const ImVec2& outer_size = {}, float inner_width = 0.0f) :
+			table(name, static_cast<int>(std::size(columns)), flags, outer_size, inner_width),
+			m_Range(&range),
+			m_Begin(std::cbegin(range)),
+			m_Size(static_cast<size_t>(std::size(range))),
+			m_Columns(std::data(columns)),
+			m_ColumnsCount(std::size(columns))
+		{
+			static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<iterator_type>::iterator_category>, "table_view requires a random-access range");
+		}
+
+		/// <summary>
+		/// Setup the columns from their 'column_info' and submit the header row.
+		/// - 'cols', 'rows': TableSetupScrollFreeze(), 'rows' includes the header row
+		/// </summary>
+		void setup(int cols = 0, int rows = 1)
+		{
+			ImGui::TableSetupScrollFreeze(cols, rows);
+			setup(setup_no_row{});
+		}
+
+		/// <summary>
+		/// Setup the columns from their 'column_info' and submit the header row.
+		/// </summary>
+		void setup(setup_no_row)
+		{
+			for (size_t i = 0; i < m_ColumnsCount; i++)
+			{
+				const setup_info& info = m_Columns[i].setup;
+				ImGui::TableSetupColumn(info.label, info.flags, info.init_width_or_weight, info.user_id);
+			}
+			ImGui::TableHeadersRow();
+		}
+
+		/// <summary>
+		/// Update 'sorter' from the table's sort specs and display the rows in its order, call it after setup().
+		/// </summary>
+		void sort(table_sorter<_RangeTy>& sorter)
+		{
+			sorter.update(*m_Range);
+			m_Order = &sorter.order();
+		}
+
+		/// <summary>
+		/// Submit the visible rows.
+		/// - 'key': identity of a row pushed in the ID stack, defaults to the index in the range.
+		/// - 'row_height' < 0.0f: measured from the first submitted row.
+		/// </summary>
+		void render(const key_fn& key = {}, float row_height = -1.0f, ImGuiTableRowFlags row_flags = 0)
+		{
+			IM_ASSERT(m_Size <= static_cast<size_t>(INT_MAX) && "ImGuiListClipper is limited to INT_MAX rows");
+
+			IM_ASSERT((!m_Order || m_Order->size() == m_Size) && "table_sorter was updated with another range");
+
+			m_SubmittedRows = 0;
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(m_Size), row_height);
+			while (clipper.Step())
+			{
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+					render_row(m_Order ? (*m_Order)[row] : static_cast<size_t>(row), key, row_flags);
+			}
+		}
+
+		/// <summary>
+		/// Number of rows in the range
+		/// </summary>
+		[[nodiscard]] size_t size() const noexcept
+		{
+			return m_Size;
+		}
+
+		/// <summary>
+		/// Number of rows submitted by the last call to render()
+		/// </summary>
+		[[nodiscard]] size_t submitted_rows() const noexcept
+		{
+			return m_SubmittedRows;
+		}
+
+	private:
+		void render_row(size_t index, const key_fn& key, ImGuiTableRowFlags row_flags)
+		{
+			const value_type& value = m_Begin[index];
+			const size_t row_key = key ? key(value, index) : index;
+
+			ImGui::TableNextRow(row_flags);
+			ImGui::PushID(reinterpret_cast<const void*>(row_key));
+			for (size_t i = 0; i < m_ColumnsCount; i++)
+			{
+				if (ImGui::TableSetColumnIndex(static_cast<int>(i)) && m_Columns[i].cell)
+					m_Columns[i].cell(value, index);
+			}
+			ImGui::PopID();
+			m_SubmittedRows++;
+		}
+
+		const _RangeTy* m_Range;
+		iterator_type m_Begin;
+		size_t m_Size;
+		const column_info* m_Columns;
+		size_t m_ColumnsCount;
+		const std::vector<size_t>* m_Order{ };
+		size_t m_SubmittedRows{ };
+	};
+}
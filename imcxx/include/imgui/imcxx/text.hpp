@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cfloat>
 #include "scopes.hpp"
+#include "draw_list.hpp"
 #include "imgui/imgui_internal.h"
 
 namespace imcxx
@@ -40,7 +42,7 @@ namespace imcxx
 		/// <summary>
 		/// formatted text
 		/// </summary>
-		text(const char* fmt, ...) IM_FMTLIST(1)
+		text(const char* fmt, ...) IM_FMTARGS(2)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -77,7 +79,7 @@ namespace imcxx
 		/// <summary>
 		/// shortcut for TextColoredV();
 		/// </summary>
-		text(const ImVec4& color, const char* fmt, ...) IM_FMTLIST(2)
+		text(const ImVec4& color, const char* fmt, ...) IM_FMTARGS(3)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -111,7 +113,7 @@ namespace imcxx
 		/// <summary>
 		/// shortcut for PushStyleColor(ImGuiCol_Text, style.Colors[ImGuiCol_TextDisabled]); Text(fmt, ...); PopStyleColor();
 		/// </summary>
-		text(disabled, const char* fmt, ...) IM_FMTLIST(2)
+		text(disabled, const char* fmt, ...) IM_FMTARGS(3)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -152,7 +154,7 @@ namespace imcxx
 		/// <summary>
 		/// shortcut for PushStyleColor(ImGuiCol_Text, style.Colors[ImGuiCol_TextDisabled]); Text(fmt, ...); PopStyleColor();
 		/// </summary>
-		text(wrapped, const char* fmt, ...) IM_FMTLIST(2)
+		text(wrapped, const char* fmt, ...) IM_FMTARGS(3)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -164,7 +166,7 @@ namespace imcxx
 		/// <summary>
 		/// display text+label aligned the same way as value+label widgets
 		/// </summary>
-		text(label, const char* label, const char* fmt, ...) IM_FMTLIST(2)
+		text(label, const char* label, const char* fmt, ...) IM_FMTARGS(4)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -183,7 +185,7 @@ namespace imcxx
 		/// <summary>
 		/// display text+label aligned the same way as value+label widgets
 		/// </summary>
-		text(bullet, const char* fmt, ...) IM_FMTLIST(2)
+		text(bullet, const char* fmt, ...) IM_FMTARGS(3)
 		{
 			va_list args;
 			va_start(args, fmt);
@@ -198,4 +200,225 @@ namespace imcxx
 			text(bullet_state, str.data())
 		{}
 	};
-}
\ No newline at end of file
+
+
+	/// <summary>
+	/// Block of static text whose glyph quads are built once, then copied to the draw list with an offset on the next frames.
+	/// For text drawn unchanged every frame (help panels, notification bodies, table headers...), where AddText() would look up glyphs and build quads again.
+	/// - Quads are rebuilt when the text, font, font size or wrap width changes, or when the font atlas is rebuilt ('ImFontAtlas::BuildCount'),
+	///   and once the glyphs they were built without are rasterized (ImFontConfig::DynamicGlyphs).
+	///   The color is applied while copying, so animated or hovered colors don't rebuild them.
+	/// - Keeps a copy of the text and 4 vertices per visible glyph, indices are generated while copying.
+	/// - Quads are built at the origin then moved: positions can differ from AddText() by float rounding.
+	/// - Quads outside of the draw list's clip rectangle are skipped, there is no CPU fine clipping.
+	///
+	/// static imcxx::retained_text help{ "Drag a node to move it, right-click for options..." };
+	/// help.render();                                  // like ImGui::TextUnformatted()
+	/// help.render(imcxx::text::wrapped{});            // like ImGui::TextWrapped()
+	/// help.draw(draw_list, pos, IM_COL32_WHITE);      // like ImDrawList::AddText()
+	/// </summary>
+	class retained_text
+	{
+	public:
+		retained_text() = default;
+
+		explicit retained_text(std::string_view str) :
+			m_Text(str)
+		{}
+
+		/// <summary>
+		/// Replace the text, quads are rebuilt on the next draw if it changed.
+		/// </summary>
+		void set(std::string_view str)
+		{
+			if (str == m_Text)
+				return;
+			m_Text.assign(str);
+			m_Font = nullptr;
+		}
+
+		[[nodiscard]] const std::string& str() const noexcept
+		{
+			return m_Text;
+		}
+
+		/// <summary>
+		/// Size of the text when it was last drawn, as returned by ImGui::CalcTextSize()
+		/// </summary>
+		[[nodiscard]] const ImVec2& size() const noexcept
+		{
+			return m_Size;
+		}
+
+		/// <summary>
+		/// Text item with the current font and text color, wrapped if a wrap position was pushed: same as ImGui::TextUnformatted().
+		/// </summary>
+		void render()
+		{
+			ImGuiWindow* window = ImGui::GetCurrentWindow();
+			if (window->SkipItems)
+				return;
+
+			ImGuiContext& g = *GImGui;
+			const float wrap_pos_x = window->DC.TextWrapPos;
+			const float wrap_width = wrap_pos_x >= 0.f ? ImGui::CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.f;
+			update(g.Font, g.FontSize, wrap_width);
+
+			const ImVec2 text_pos{ window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset };
+			const ImRect bb{ text_pos, { text_pos.x + m_Size.x, text_pos.y + m_Size.y } };
+			ImGui::ItemSize(m_Size, 0.f);
+			if (!ImGui::ItemAdd(bb, 0))
+				return;
+
+			copy(window->DrawList, bb.Min, ImGui::GetColorU32(ImGuiCol_Text));
+			if (g.LogEnabled)
+				ImGui::LogRenderedText(&bb.Min, m_Text.data(), m_Text.data() + m_Text.size());
+		}
+
+		/// <summary>
+		/// Text item wrapped at the end of the window or column: same as ImGui::TextWrapped().
+		/// </summary>
+		void render(text::wrapped)
+		{
+			bool need_backup = (ImGui::GetCurrentWindow()->DC.TextWrapPos < 0.0f);  // Keep existing wrap position if one is already set
+			if (need_backup)
+				ImGui::PushTextWrapPos(0.f);
+			render();
+			if (need_backup)
+				ImGui::PopTextWrapPos();
+		}
+
+		/// <summary>
+		/// Same as ImDrawList::AddText(pos, col, text), with the draw list's current font.
+		/// </summary>
+		void draw(ImDrawList* draw_list, const ImVec2& pos, ImU32 col)
+		{
+			draw(draw_list, nullptr, 0.f, pos, col);
+		}
+
+		/// <summary>
+		/// Same as ImDrawList::AddText(font, font_size, pos, col, text, wrap_width), 'font' must be the one of the draw list's current texture.
+		/// </summary>
+		void draw(ImDrawList* draw_list, const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, float wrap_width = 0.f)
+		{
+			if ((col & IM_COL32_A_MASK) == 0 || m_Text.empty())
+				return;
+
+			if (!font)
+				font = draw_list->_Data->Font;
+			if (font_size == 0.f)
+				font_size = draw_list->_Data->FontSize;
+
+			IM_ASSERT(font->ContainerAtlas->TexID == draw_list->_CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+			update(font, font_size, wrap_width);
+			copy(draw_list, pos, col);
+		}
+
+	private:
+		// Opaque black: regular glyphs get no color bits, colored glyphs get white (see ImFont::RenderText()), 'copy()' adds the color to them
+		static constexpr ImU32 build_color = IM_COL32_A_MASK;
+
+		void update(const ImFont* font, float font_size, float wrap_width)
+		{
+			if (m_Font == font && m_FontSize == font_size && m_WrapWidth == wrap_width && m_BuildCount == font->ContainerAtlas->BuildCount)
+				return;
+
+			m_Font = font;
+			m_FontSize = font_size;
+			m_WrapWidth = wrap_width;
+			m_BuildCount = font->ContainerAtlas->BuildCount;
+
+			const char* text_begin = m_Text.data();
+			const char* text_end = text_begin + m_Text.size();
+			m_Size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text_begin, text_end);
+			m_Size.x = IM_FLOOR(m_Size.x + 0.99999f);
+
+			// Let ImFont::RenderText() build the quads at the origin, only its vertices are kept.
+			// Glyphs rasterized on demand are logged, 'copy()' marks them as used each time the quads are drawn.
+			ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+			ImFontGlyphUses* glyph_uses = shared->GlyphUses;
+			shared->GlyphUses = &m_GlyphUses;
+			m_GlyphUses.Clear();
+			ImDrawList scratch(shared);
+			scratch._ResetForNewFrame();
+			if (text_begin != text_end)
+				font->RenderText(&scratch, font_size, { 0.f, 0.f }, build_color, { -FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX }, text_begin, text_end, wrap_width, false);
+			m_Vertices.swap(scratch.VtxBuffer);
+			shared->GlyphUses = glyph_uses;
+
+			m_Min = { FLT_MAX, FLT_MAX };
+			m_Max = { -FLT_MAX, -FLT_MAX };
+			for (int i = 0; i < m_Vertices.Size; i += 4)
+			{
+				m_Min = ImMin(m_Min, vertex_pos(m_Vertices[i]));
+				m_Max = ImMax(m_Max, vertex_pos(m_Vertices[i + 2]));
+			}
+		}
+
+		void copy(ImDrawList* draw_list, const ImVec2& pos, ImU32 col)
+		{
+			// Same pixel alignment as ImFont::RenderText()
+			const float x = IM_FLOOR(pos.x), y = IM_FLOOR(pos.y);
+			const ImVec4& clip = draw_list->_CmdHeader.ClipRect;
+			if (m_Vertices.empty() || m_Min.x + x > clip.z || m_Max.x + x < clip.x || m_Min.y + y > clip.w || m_Max.y + y < clip.y)
+				return;
+
+			// Quads drawn with the fallback glyph are rebuilt on the next draw
+			if (ImFontMarkGlyphsUsed(draw_list->_Data, m_GlyphUses))
+				m_Font = nullptr;
+			const bool clipped = m_Min.x + x < clip.x || m_Max.x + x > clip.z || m_Min.y + y < clip.y || m_Max.y + y > clip.w;
+			const ImVec2 offset = vertex_offset({ x, y }, { 0.f, 0.f }, *draw_list);
+
+			// Reserve by chunks to stay within 16-bit indices
+			constexpr int chunk_quads = 8192;
+			const int quads_count = m_Vertices.Size / 4;
+			for (int first = 0; first < quads_count; first += chunk_quads)
+			{
+				const int reserved = ImMin(quads_count - first, chunk_quads);
+				draw_list->PrimReserve(reserved * 6, reserved * 4);
+
+				ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+				ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+				unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+
+				const ImDrawVert* quad = m_Vertices.Data + first * 4;
+				for (int i = 0; i < reserved; i++, quad += 4)
+				{
+					if (clipped)
+					{
+						const ImVec2 quad_min = vertex_pos(quad[0]), quad_max = vertex_pos(quad[2]);
+						if (quad_min.x + x > clip.z || quad_max.x + x < clip.x || quad_min.y + y > clip.w || quad_max.y + y < clip.y)
+							continue;
+					}
+
+					translate_vertices(vtx_write, quad, 4, offset);
+					for (int v = 0; v < 4; v++)
+						vtx_write[v].col = col | (quad[v].col & ~IM_COL32_A_MASK);
+					idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx + 1); idx_write[2] = (ImDrawIdx)(vtx_current_idx + 2);
+					idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx + 2); idx_write[5] = (ImDrawIdx)(vtx_current_idx + 3);
+					vtx_write += 4;
+					idx_write += 6;
+					vtx_current_idx += 4;
+				}
+
+				const int unused = reserved - static_cast<int>(vtx_write - draw_list->_VtxWritePtr) / 4;
+				draw_list->_VtxWritePtr = vtx_write;
+				draw_list->_IdxWritePtr = idx_write;
+				draw_list->_VtxCurrentIdx = vtx_current_idx;
+				draw_list->PrimUnreserve(unused * 6, unused * 4);
+			}
+		}
+
+		std::string m_Text;
+		ImVector<ImDrawVert> m_Vertices;
+		ImFontGlyphUses m_GlyphUses;
+		ImVec2 m_Min{ }, m_Max{ };
+		ImVec2 m_Size{ };
+
+		const ImFont* m_Font{ };
+		float m_FontSize{ };
+		float m_WrapWidth{ };
+		int m_BuildCount{ };
+	};
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include "scopes.hpp"
+#include "label_id.hpp"
+#include "draw_list.hpp"
 #include "imgui/imgui_internal.h"
 
 namespace imcxx
@@ -41,6 +44,180 @@ namespace imcxx
 	using window_child = window::child;
 	using current_window = window::capture;
 
+	/// <summary>
+	/// Draw commands of a child window kept between frames, see 'window::child::cached'.
+	/// One cache per child window, it keeps a copy of the vertices, indices and commands of the child's contents and of the style they were drawn with.
+	/// </summary>
+	class child_cache
+	{
+		friend class window::child;
+	public:
+		child_cache() = default;
+		child_cache(const child_cache&) = delete;
+		child_cache& operator=(const child_cache&) = delete;
+
+		/// <summary>
+		/// Drop the commands, the contents are submitted on the next frame.
+		/// </summary>
+		void invalidate() noexcept
+		{
+			m_Valid = false;
+		}
+
+		/// <summary>
+		/// True when the last frame drew the cached commands instead of submitting the contents
+		/// </summary>
+		[[nodiscard]] bool replayed() const noexcept
+		{
+			return m_Replayed;
+		}
+
+	private:
+		/// <summary>
+		/// Called in the child window after BeginChild() returned true.
+		/// Returns false when the cached commands were drawn and the contents must be skipped.
+		/// </summary>
+		bool begin(uint64_t version)
+		{
+			ImGuiContext& g = *GImGui;
+			ImGuiWindow* window = g.CurrentWindow;
+			m_Replayed = false;
+			m_Recording = false;
+
+			// Widgets may change from one frame to the next while the user interacts with the child or a popup opened from it
+			if (g.HoveredWindow == window || g.ActiveIdWindow == window || g.NavWindow == window || g.LogEnabled || has_popup(window))
+			{
+				m_Valid = false;
+				return true;
+			}
+
+			const ImVec2 clip_min{ window->InnerClipRect.Min.x - window->Pos.x, window->InnerClipRect.Min.y - window->Pos.y };
+			const ImVec2 clip_max{ window->InnerClipRect.Max.x - window->Pos.x, window->InnerClipRect.Max.y - window->Pos.y };
+			const int build_count = g.Font->ContainerAtlas->BuildCount;
+
+			if (m_Valid && m_Version == version && m_Font == g.Font && m_FontSize == g.FontSize && m_BuildCount == build_count &&
+				memcmp(&m_Style, &g.Style, sizeof(ImGuiStyle)) == 0 && m_ItemFlags == g.CurrentItemFlags &&
+				m_Size.x == window->Size.x && m_Size.y == window->Size.y && m_Scroll.x == window->Scroll.x && m_Scroll.y == window->Scroll.y &&
+				m_ClipMin.x == clip_min.x && m_ClipMin.y == clip_min.y && m_ClipMax.x == clip_max.x && m_ClipMax.y == clip_max.y)
+			{
+				// Vertices and clip rects follow the window, the content size is the one of the recorded frame
+				append_draw_list(window->DrawList, m_DrawList, { window->Pos.x - m_Pos.x, window->Pos.y - m_Pos.y });
+				ImFontMarkGlyphsUsed(window->DrawList->_Data, m_GlyphUses);
+				const ImVec2& start = window->DC.CursorStartPos;
+				window->DC.CursorMaxPos = ImMax(window->DC.CursorMaxPos, { start.x + m_CursorMax.x, start.y + m_CursorMax.y });
+				window->DC.IdealMaxPos = ImMax(window->DC.IdealMaxPos, { start.x + m_IdealMax.x, start.y + m_IdealMax.y });
+				m_Replayed = true;
+				return false;
+			}
+
+			m_Valid = false;
+			m_Recording = true;
+			m_Version = version;
+			m_Font = g.Font;
+			m_FontSize = g.FontSize;
+			m_BuildCount = build_count;
+			memcpy(&m_Style, &g.Style, sizeof(ImGuiStyle));
+			m_ItemFlags = g.CurrentItemFlags;
+			m_Pos = window->Pos;
+			m_Size = window->Size;
+			m_Scroll = window->Scroll;
+			m_ClipMin = clip_min;
+			m_ClipMax = clip_max;
+			m_VtxStart = window->DrawList->VtxBuffer.Size;
+			m_IdxStart = window->DrawList->IdxBuffer.Size;
+			m_CmdStart = window->DrawList->CmdBuffer.Size - 1;
+
+			// Glyphs rasterized on demand are logged to be marked as used when the commands are drawn again
+			ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+			m_OuterGlyphUses = shared->GlyphUses;
+			shared->GlyphUses = &m_GlyphUses;
+			m_GlyphUses.Clear();
+			return true;
+		}
+
+		/// <summary>
+		/// Called in the child window before EndChild(), copies the commands of the contents submitted since 'begin()'.
+		/// </summary>
+		void end()
+		{
+			if (!m_Recording)
+				return;
+			m_Recording = false;
+
+			ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+			shared->GlyphUses = m_OuterGlyphUses;
+			const bool glyphs_requested = ImFontMarkGlyphsUsed(shared, m_GlyphUses);
+
+			// Nested child windows and popups have their own draw list and must be submitted every frame, glyphs not rasterized yet are drawn on the next frames
+			ImGuiWindow* window = GImGui->CurrentWindow;
+			const ImDrawList& draw_list = *window->DrawList;
+			if (window->DC.ChildWindows.Size || has_popup(window) || draw_list._Splitter._Count > 1 || glyphs_requested)
+				return;
+
+			m_DrawList.VtxOrigin = draw_list.VtxOrigin;
+			m_DrawList.VtxBuffer.resize(draw_list.VtxBuffer.Size - m_VtxStart);
+			if (!m_DrawList.VtxBuffer.empty())
+				memcpy(m_DrawList.VtxBuffer.Data, draw_list.VtxBuffer.Data + m_VtxStart, m_DrawList.VtxBuffer.size_in_bytes());
+
+			// Indices and vertex offsets are made relative to the first vertex of the contents
+			const unsigned vtx_start = static_cast<unsigned>(m_VtxStart);
+			const unsigned idx_start = static_cast<unsigned>(m_IdxStart);
+			m_DrawList.IdxBuffer.resize(draw_list.IdxBuffer.Size - m_IdxStart);
+			m_DrawList.CmdBuffer.resize(0);
+			for (int i = m_CmdStart; i < draw_list.CmdBuffer.Size; i++)
+			{
+				ImDrawCmd cmd = draw_list.CmdBuffer[i];
+				const unsigned first = ImMax(cmd.IdxOffset, idx_start);
+				const unsigned last = cmd.IdxOffset + cmd.ElemCount;
+				if (cmd.UserCallback ? i == m_CmdStart : last <= first)
+					continue;
+
+				const unsigned base = cmd.VtxOffset < vtx_start ? vtx_start - cmd.VtxOffset : 0;
+				for (unsigned n = first; n < last; n++)
+					m_DrawList.IdxBuffer.Data[n - idx_start] = static_cast<ImDrawIdx>(draw_list.IdxBuffer.Data[n] - base);
+
+				cmd.VtxOffset = cmd.VtxOffset < vtx_start ? 0 : cmd.VtxOffset - vtx_start;
+				cmd.IdxOffset = first - idx_start;
+				cmd.ElemCount = last > first ? last - first : 0;
+				m_DrawList.CmdBuffer.push_back(cmd);
+			}
+
+			const ImVec2& start = window->DC.CursorStartPos;
+			m_CursorMax = { window->DC.CursorMaxPos.x - start.x, window->DC.CursorMaxPos.y - start.y };
+			m_IdealMax = { window->DC.IdealMaxPos.x - start.x, window->DC.IdealMaxPos.y - start.y };
+			m_Valid = true;
+		}
+
+		static bool has_popup(const ImGuiWindow* window)
+		{
+			for (const ImGuiPopupData& popup : GImGui->OpenPopupStack)
+			{
+				if (popup.SourceWindow == window)
+					return true;
+			}
+			return false;
+		}
+
+		ImDrawList m_DrawList{ nullptr };
+		ImFontGlyphUses m_GlyphUses;
+		ImFontGlyphUses* m_OuterGlyphUses{ };
+
+		uint64_t m_Version{ };
+		const ImFont* m_Font{ };
+		float m_FontSize{ };
+		int m_BuildCount{ };
+		ImGuiStyle m_Style;
+		ImGuiItemFlags m_ItemFlags{ };
+		ImVec2 m_Pos{ }, m_Size{ }, m_Scroll{ };
+		ImVec2 m_ClipMin{ }, m_ClipMax{ };
+		ImVec2 m_CursorMax{ }, m_IdealMax{ };
+
+		int m_VtxStart{ }, m_IdxStart{ }, m_CmdStart{ };
+		bool m_Valid{ };
+		bool m_Recording{ };
+		bool m_Replayed{ };
+	};
+
 	/// <summary>
 	/// Child Windows
 	/// - Use child windows to begin into a self-contained independent scrolling/clipping regions within a host window. Child windows can embed their own child.
@@ -57,11 +234,47 @@ namespace imcxx
 	public:
 		struct frame {};
 
+		/// <summary>
+		/// Cached contents: 'cache' keeps the draw commands of the child and its inputs (size, scroll, clip rect, style, font, 'version').
+		/// While they are unchanged and the child is not hovered, focused, active or the source of an open popup, the commands are drawn again
+		/// at the position of the child and the scope is inactive: the contents are not submitted.
+		/// - Increment 'version' (or call 'cache.invalidate()') when the contents change.
+		/// - Items of a cached frame are not submitted: no ID, no keyboard navigation until the child is hovered or focused.
+		/// - Contents with nested child windows or popups are never cached, nor contents drawing glyphs not rasterized yet (ImFontConfig::DynamicGlyphs).
+		///
+		/// static imcxx::child_cache legend_cache;
+		/// imcxx::window::child{ imcxx::window::child::cached{ legend_cache, legend_version }, "##legend", { 0.f, 120.f } } << []() { /* ... */ };
+		/// </summary>
+		struct cached
+		{
+			child_cache& cache;
+			uint64_t version{ };
+		};
+
+		template<typename _StrTy, typename _VecTy = ImVec2>
+		child(cached c, const _StrTy& str_id, _VecTy size = {}, bool border = false, ImGuiWindowFlags flags = 0) :
+			child(str_id, size, border, flags)
+		{
+			if (m_Result._Value)
+			{
+				m_Cache = &c.cache;
+				m_Result._Value = c.cache.begin(c.version);
+			}
+		}
+
 		template<typename _StrTy, typename _VecTy = ImVec2>
 		child(const _StrTy& str_id, _VecTy size = {}, bool border = false, ImGuiWindowFlags flags = 0) :
 			scope_wrap(ImGui::BeginChild(impl::get_string(str_id), impl::to_imvec2(size), border, flags))
 		{}
 
+		/// <summary>
+		/// Same as 'ImGui::BeginChild(str_id, ...)' with the identifier's hash precomputed.
+		/// </summary>
+		template<typename _VecTy = ImVec2>
+		child(const label_id& str_id, const _VecTy& size = {}, bool border = false, ImGuiWindowFlags flags = 0) :
+			scope_wrap(ImGui::BeginChildEx(str_id.label(), str_id.get_id(ImGui::GetCurrentWindow()), impl::to_imvec2(size), border, flags))
+		{}
+
 		template<typename _VecTy = ImVec2>
 		child(ImGuiID id, const _VecTy& size = {}, bool border = false, ImGuiWindowFlags flags = 0) :
 			scope_wrap(ImGui::BeginChild(id, impl::to_imvec2(size), border, flags))
@@ -75,7 +288,11 @@ namespace imcxx
 	private:
 		void destruct()
 		{
+			if (m_Cache)
+				m_Cache->end();
 			ImGui::EndChild();
 		}
+
+		child_cache* m_Cache{ };
 	};
 }
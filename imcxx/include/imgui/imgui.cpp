@@ -935,6 +935,15 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
 
+// Text size cache
+#ifndef IMGUI_TEXT_SIZE_CACHE_MIN_LENGTH
+#define IMGUI_TEXT_SIZE_CACHE_MIN_LENGTH    16
+#endif
+static ImU64            TextSizeCacheHash(const ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+static ImGuiTextSizeCacheEntry* TextSizeCacheFind(ImGuiTextSizeCache* cache, ImU64 key);
+static void             TextSizeCacheAdd(ImGuiTextSizeCache* cache, ImU64 key, const ImVec2& size, int max_entries, int frame_count);
+static bool             TextSizeCacheRenderWrapped(ImDrawList* draw_list, ImVec2 pos, const char* text, const char* text_end, float wrap_width);
+
 // Settings
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
@@ -1183,6 +1192,7 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigTextSizeCacheMaxEntries = 0;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1795,6 +1805,115 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+// 64-bit hash of large buffers, used to find the draw lists which didn't change since the previous frame.
+// Same construction as XXH3: 64 bytes stripes accumulated in 8 lanes with a 32x32->64 multiply, the key moves along a 192 bytes secret
+// and the lanes are scrambled every 16 stripes, the lanes are merged with XXH64 rounds. The SSE2 path gives the same result as the scalar one.
+static const ImU64 GHash64Secret[24] =
+{
+    0x1AC046DDA8E86E2AULL,0xBE2C3B00B1D348C8ULL,0x9B1A66A95412FF75ULL,0xC448C2B1F05F7E4CULL,0xC111CA6B8F6E73C4ULL,0xB54861920D05B01DULL,0x8D61500F4A7BBE16ULL,0x5E0C25471F89E02EULL,
+    0x48105A3D28F0E221ULL,0x2169F8846B637746ULL,0x3D628782E0C0D863ULL,0xA5DDB2216078AA40ULL,0xC8119D17F0571101ULL,0x98E2E2EB8F33280FULL,0x8CD1E28860679CC4ULL,0x9DCA6189C923AEF3ULL,
+    0x9D8D3071BA4F04C4ULL,0x5D395ADA34220C26ULL,0xE6DE42A441A1E28EULL,0x308FBF68CC864F59ULL,0x216A3C81332862F9ULL,0xBACECA0A77F3132EULL,0xDF2A2215339CA69CULL,0x3E4C11A103A5D859ULL,
+};
+
+static const ImU32 HASH64_PRIME32_1 = 0x9E3779B1U;
+static const ImU64 HASH64_PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const ImU64 HASH64_PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const ImU64 HASH64_PRIME64_3 = 0x165667B19E3779F9ULL;
+static const ImU64 HASH64_PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const ImU64 HASH64_PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static inline ImU64 ImHash64Read(const unsigned char* p)  { ImU64 v; memcpy(&v, p, sizeof(v)); return v; }
+static inline ImU64 ImHash64Rotl(ImU64 x, int r)          { return (x << r) | (x >> (64 - r)); }
+
+// Accumulate 'stripes_count' stripes of 64 bytes, plus the last stripe 'last' with its own key
+static void ImHash64Accumulate(ImU64 acc[8], const unsigned char* data, size_t stripes_count, const unsigned char* last)
+{
+    const int stripes_per_block = 16;
+    const unsigned char* secret = (const unsigned char*)GHash64Secret;
+    const unsigned char* scramble_key = secret + sizeof(GHash64Secret) - 64;
+#ifdef IMGUI_ENABLE_SSE
+    __m128i lanes[4];
+    for (int j = 0; j < 4; j++)
+        lanes[j] = _mm_loadu_si128((const __m128i*)(acc + j * 2));
+    const __m128i prime = _mm_set1_epi32((int)HASH64_PRIME32_1);
+    for (size_t s = 0; s <= stripes_count; s++)
+    {
+        const bool is_last = (s == stripes_count);
+        const unsigned char* stripe = is_last ? last : data + s * 64;
+        const unsigned char* key = is_last ? secret + sizeof(GHash64Secret) - 64 - 7 : secret + (s % stripes_per_block) * 8;
+        for (int j = 0; j < 4; j++)
+        {
+            // lane += lo32(d ^ k) * hi32(d ^ k) + neighbour lane's data
+            const __m128i d = _mm_loadu_si128((const __m128i*)(stripe + j * 16));
+            const __m128i dk = _mm_xor_si128(d, _mm_loadu_si128((const __m128i*)(key + j * 16)));
+            const __m128i product = _mm_mul_epu32(dk, _mm_shuffle_epi32(dk, _MM_SHUFFLE(0, 3, 0, 1)));
+            lanes[j] = _mm_add_epi64(lanes[j], _mm_add_epi64(product, _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+        if (!is_last && s % stripes_per_block == stripes_per_block - 1)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                // lane = (lane ^ (lane >> 47) ^ k) * PRIME32_1
+                const __m128i x = _mm_xor_si128(_mm_xor_si128(lanes[j], _mm_srli_epi64(lanes[j], 47)), _mm_loadu_si128((const __m128i*)(scramble_key + j * 16)));
+                const __m128i lo = _mm_mul_epu32(x, prime);
+                const __m128i hi = _mm_mul_epu32(_mm_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+                lanes[j] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+            }
+        }
+    }
+    for (int j = 0; j < 4; j++)
+        _mm_storeu_si128((__m128i*)(acc + j * 2), lanes[j]);
+#else
+    for (size_t s = 0; s <= stripes_count; s++)
+    {
+        const bool is_last = (s == stripes_count);
+        const unsigned char* stripe = is_last ? last : data + s * 64;
+        const unsigned char* key = is_last ? secret + sizeof(GHash64Secret) - 64 - 7 : secret + (s % stripes_per_block) * 8;
+        for (int i = 0; i < 8; i++)
+        {
+            const ImU64 dk = ImHash64Read(stripe + i * 8) ^ ImHash64Read(key + i * 8);
+            acc[i] += (dk & 0xFFFFFFFF) * (dk >> 32) + ImHash64Read(stripe + (i ^ 1) * 8);
+        }
+        if (!is_last && s % stripes_per_block == stripes_per_block - 1)
+            for (int i = 0; i < 8; i++)
+                acc[i] = (acc[i] ^ (acc[i] >> 47) ^ ImHash64Read(scramble_key + i * 8)) * HASH64_PRIME32_1;
+    }
+#endif
+}
+
+ImU64 ImHashData64(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU64 acc[8] = { 0xC2B2AE3DULL, HASH64_PRIME64_1, HASH64_PRIME64_2, HASH64_PRIME64_3, HASH64_PRIME64_4, 0x85EBCA77ULL, HASH64_PRIME64_5, HASH64_PRIME32_1 };
+    for (int i = 0; i < 8; i++)
+        acc[i] ^= seed;
+
+    // The last stripe overlaps the previous one, or is zero-padded for small buffers
+    unsigned char last[64];
+    if (data_size >= 64)
+        memcpy(last, data + data_size - 64, 64);
+    else
+    {
+        memset(last, 0, sizeof(last));
+        if (data_size > 0)
+            memcpy(last, data, data_size);
+    }
+    ImHash64Accumulate(acc, data, data_size > 0 ? (data_size - 1) / 64 : 0, last);
+
+    ImU64 h = seed + (ImU64)data_size * HASH64_PRIME64_5;
+    for (int i = 0; i < 8; i++)
+    {
+        const ImU64 lane = ImHash64Rotl(acc[i] * HASH64_PRIME64_2, 31) * HASH64_PRIME64_1;
+        h = (h ^ lane) * HASH64_PRIME64_1 + HASH64_PRIME64_4;
+    }
+    h ^= h >> 33;
+    h *= HASH64_PRIME64_2;
+    h ^= h >> 29;
+    h *= HASH64_PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -1959,6 +2078,46 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     return char_count;
 }
 
+#ifdef IMGUI_ENABLE_SSE
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static inline int ImCountTrailingZeroes32(unsigned int v) { unsigned long i; _BitScanForward(&i, v); return (int)i; }
+#else
+static inline int ImCountTrailingZeroes32(unsigned int v) { return __builtin_ctz(v); }
+#endif
+#endif
+
+// Used by text measurement and rendering to handle runs of printable ASCII characters without decoding them one by one.
+// A signed comparison with ' ' catches both control characters and bytes >= 0x80 (which are negative as signed chars).
+const char* ImTextFindNonPrintableAscii(const char* in_text, const char* in_text_end)
+{
+#if defined(IMGUI_ENABLE_SSE) && defined(__AVX2__)
+    const __m256i space32 = _mm256_set1_epi8(' ');
+    while (in_text_end - in_text >= 32)
+    {
+        const __m256i chars = _mm256_loadu_si256((const __m256i*)(const void*)in_text);
+        const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpgt_epi8(space32, chars));
+        if (mask != 0)
+            return in_text + ImCountTrailingZeroes32(mask);
+        in_text += 32;
+    }
+#endif
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    const __m128i space16 = _mm_set1_epi8(' ');
+    while (in_text_end - in_text >= 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+        const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmplt_epi8(chars, space16));
+        if (mask != 0)
+            return in_text + ImCountTrailingZeroes32(mask);
+        in_text += 16;
+    }
+#endif
+    while (in_text < in_text_end && (signed char)*in_text >= ' ')
+        in_text++;
+    return in_text;
+}
+
 // Based on stb_to_utf8() from github.com/nothings/stb/
 static inline int ImTextCharToUtf8_inline(char* buf, int buf_size, unsigned int c)
 {
@@ -3057,7 +3216,8 @@ void ImGui::RenderTextWrapped(ImVec2 pos, const char* text, const char* text_end
 
     if (text != text_end)
     {
-        window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+        if (wrap_width <= 0.0f || !TextSizeCacheRenderWrapped(window->DrawList, pos, text, text_end, wrap_width))
+            window->DrawList->AddText(g.Font, g.FontSize, pos, GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
         if (g.LogEnabled)
             LogRenderedText(&pos, text, text_end);
     }
@@ -3374,6 +3534,7 @@ void ImGui::GcCompactTransientMiscBuffers()
     ImGuiContext& g = *GImGui;
     g.ItemFlagsStack.clear();
     g.GroupStack.clear();
+    g.DrawListArcCache.Clear();
     TableGcCompactSettings();
 }
 
@@ -3822,6 +3983,7 @@ static ImDrawList* GetViewportDrawList(ImGuiViewportP* viewport, size_t drawlist
     if (viewport->DrawListsLastFrame[drawlist_no] != g.FrameCount)
     {
         draw_list->_ResetForNewFrame();
+        draw_list->VtxOrigin = ImFloor(viewport->Pos + viewport->Size * 0.5f);
         draw_list->PushTextureID(g.IO.Fonts->TexID);
         draw_list->PushClipRect(viewport->Pos, viewport->Pos + viewport->Size, false);
         viewport->DrawListsLastFrame[drawlist_no] = g.FrameCount;
@@ -4383,6 +4545,12 @@ void ImGui::NewFrame()
     g.WithinFrameScope = true;
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
+    g.IO.MetricsTextSizeCacheHits = g.TextSizeCache.Hits;
+    g.IO.MetricsTextSizeCacheMisses = g.TextSizeCache.Misses;
+    g.TextSizeCache.Hits = g.TextSizeCache.Misses = 0;
+    // Disabled or resized: start over, a smaller table may not hold the entries in use
+    if (g.TextSizeCache.Slots.Size > 0 && (g.IO.ConfigTextSizeCacheMaxEntries <= 0 || g.TextSizeCache.Slots.Size != ImUpperPowerOfTwo(g.IO.ConfigTextSizeCacheMaxEntries * 2)))
+        g.TextSizeCache.Clear();
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
 
@@ -4395,6 +4563,24 @@ void ImGui::NewFrame()
 
     UpdateViewportsNewFrame();
 
+    // Rasterize the glyphs requested during the previous frame, the renderer backend uploads the texture areas they changed
+    if (g.IO.Fonts->DynamicData != NULL)
+    {
+        IM_ASSERT((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates) && "Fonts with ImFontConfig::DynamicGlyphs need a renderer backend uploading io.Fonts->TexDirtyRects!");
+        g.IO.Fonts->UpdateDynamicGlyphs();
+    }
+
+    // Cached text sizes were measured with the glyphs of another atlas build
+    // (Glyphs rasterized on demand are measured with their own advance before they are, adding or evicting them doesn't change text sizes)
+    ImGuiTextSizeCache& text_size_cache = g.TextSizeCache;
+    if (text_size_cache.FontAtlas != g.IO.Fonts || text_size_cache.FontAtlasBuildCount != g.IO.Fonts->BuildCount)
+    {
+        if (text_size_cache.Slots.Size > 0)
+            text_size_cache.Clear();
+        text_size_cache.FontAtlas = g.IO.Fonts;
+        text_size_cache.FontAtlasBuildCount = g.IO.Fonts->BuildCount;
+    }
+
     // Setup current font and draw list shared data
     // FIXME-VIEWPORT: the concept of a single ClipRectFullscreen is not ideal!
     g.IO.Fonts->Locked = true;
@@ -4727,6 +4913,32 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
     }
 }
 
+// Hash the fields of draw commands, not their bytes: the padding of a copied ImDrawCmd is indeterminate
+// (e.g. 'ImDrawCmd cmd = src_cmd;'), so identical commands could hash differently.
+static ImU64 ImHashDrawCmds64(const ImDrawCmd* cmds, int cmds_count)
+{
+    ImDrawCmd packed[32];   // Zeroed padding, hashed 32 commands at a time
+    ImU64 hash = 0;
+    for (int first = 0; first < cmds_count; first += IM_ARRAYSIZE(packed))
+    {
+        const int count = ImMin(cmds_count - first, (int)IM_ARRAYSIZE(packed));
+        for (int n = 0; n < count; n++)
+        {
+            const ImDrawCmd& src = cmds[first + n];
+            ImDrawCmd& dst = packed[n];
+            dst.ClipRect = src.ClipRect;
+            dst.TextureId = src.TextureId;
+            dst.VtxOffset = src.VtxOffset;
+            dst.IdxOffset = src.IdxOffset;
+            dst.ElemCount = src.ElemCount;
+            dst.UserCallback = src.UserCallback;
+            dst.UserCallbackData = src.UserCallbackData;
+        }
+        hash = ImHashData64(packed, (size_t)count * sizeof(ImDrawCmd), hash);
+    }
+    return hash;
+}
+
 static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
     // Remove trailing command if unused.
@@ -4760,6 +4972,21 @@ static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* d
     if (sizeof(ImDrawIdx) == 2)
         IM_ASSERT(draw_list->_VtxCurrentIdx < (1 << 16) && "Too many vertices in ImDrawList using 16-bit indices. Read comment above");
 
+    // Renderers keeping buffers per draw list only upload the ones whose hash changed
+    if (GImGui->IO.BackendFlags & ImGuiBackendFlags_RendererReusesDrawLists)
+    {
+        ImU64 hash = ImHashDrawCmds64(draw_list->CmdBuffer.Data, draw_list->CmdBuffer.Size);
+        hash = ImHashData64(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), hash);
+        hash = ImHashData64(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), hash);
+        hash = ImHashData64(&draw_list->VtxOrigin, sizeof(draw_list->VtxOrigin), hash); // Compact vertices are relative to it
+        draw_list->ContentChanged = (hash != draw_list->ContentHash);
+        draw_list->ContentHash = hash;
+    }
+    else
+    {
+        draw_list->ContentChanged = true;
+    }
+
     out_list->push_back(draw_list);
 }
 
@@ -4823,7 +5050,7 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
     draw_data->Valid = true;
     draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
     draw_data->CmdListsCount = draw_lists->Size;
-    draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
+    draw_data->TotalVtxCount = draw_data->TotalIdxCount = draw_data->ChangedListsCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = is_minimized ? ImVec2(0.0f, 0.0f) : viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale; // FIXME-VIEWPORT: This may vary on a per-monitor/viewport basis?
@@ -4832,6 +5059,7 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
     {
         draw_data->TotalVtxCount += draw_lists->Data[n]->VtxBuffer.Size;
         draw_data->TotalIdxCount += draw_lists->Data[n]->IdxBuffer.Size;
+        draw_data->ChangedListsCount += draw_lists->Data[n]->ContentChanged ? 1 : 0;
     }
 }
 
@@ -5160,6 +5388,26 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    ImU64 cache_key = 0;
+    if (g.IO.ConfigTextSizeCacheMaxEntries > 0)
+    {
+        // Short texts are measured faster than they are hashed and looked up
+        if (text_display_end == NULL)
+            text_display_end = text + strlen(text);
+        if (text_display_end - text >= IMGUI_TEXT_SIZE_CACHE_MIN_LENGTH)
+        {
+            cache_key = TextSizeCacheHash(font, font_size, wrap_width, text, text_display_end);
+            if (ImGuiTextSizeCacheEntry* entry = TextSizeCacheFind(&g.TextSizeCache, cache_key))
+            {
+                g.TextSizeCache.Hits++;
+                entry->LastFrameUsed = g.FrameCount;
+                return entry->Size;
+            }
+            g.TextSizeCache.Misses++;
+        }
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -5169,9 +5417,217 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_FLOOR(text_size.x + 0.99999f);
 
+    if (cache_key != 0)
+        TextSizeCacheAdd(&g.TextSizeCache, cache_key, text_size, g.IO.ConfigTextSizeCacheMaxEntries, g.FrameCount);
+
     return text_size;
 }
 
+// Hash of everything CalcTextSize() depends on, 8 bytes of text at a time (the inner loop of MurmurHash3 with a 64-bit lane).
+// 64-bit keys: a collision would silently return the size of another text.
+static ImU64 TextSizeCacheHash(const ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    const ImU64 c1 = 0x87C37B91114253D5ULL, c2 = 0x4CF5AD432745937FULL;
+    ImU32 sizes[2];
+    memcpy(&sizes[0], &font_size, sizeof(float));
+    memcpy(&sizes[1], &wrap_width, sizeof(float));
+    ImU64 h = (ImU64)(size_t)font ^ ((ImU64)sizes[0] << 32 | sizes[1]) * c2 ^ (ImU64)(text_end - text) * c1;
+    for (; text_end - text >= 8; text += 8)
+    {
+        ImU64 k;
+        memcpy(&k, text, 8);
+        k *= c1; k = (k << 31) | (k >> 33); k *= c2;
+        h ^= k; h = (h << 27) | (h >> 37); h = h * 5 + 0x52DCE729;
+    }
+    ImU64 k = 0;
+    memcpy(&k, text, (size_t)(text_end - text));
+    k *= c1; k = (k << 31) | (k >> 33); k *= c2;
+    h ^= k;
+
+    // Finalization mix
+    h ^= h >> 33; h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33; h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h ? h : 1;
+}
+
+// Return the slot holding 'key', or the empty slot where it would be inserted
+static ImGuiTextSizeCacheEntry* TextSizeCacheFindSlot(ImGuiTextSizeCache* cache, ImU64 key)
+{
+    const int mask = cache->Slots.Size - 1;
+    int n = (int)(key & (ImU64)mask);
+    while (cache->Slots[n].Key != 0 && cache->Slots[n].Key != key)
+        n = (n + 1) & mask;
+    return &cache->Slots[n];
+}
+
+static ImGuiTextSizeCacheEntry* TextSizeCacheFind(ImGuiTextSizeCache* cache, ImU64 key)
+{
+    if (cache->Slots.Size == 0)
+        return NULL;
+    ImGuiTextSizeCacheEntry* entry = TextSizeCacheFindSlot(cache, key);
+    return entry->Key != 0 ? entry : NULL;
+}
+
+// Move the entries used since 'min_frame' to a table of 'slots_count' slots, dropping the others
+static void TextSizeCacheRehash(ImGuiTextSizeCache* cache, int slots_count, int min_frame)
+{
+    ImVector<ImGuiTextSizeCacheEntry> old_slots;
+    ImVector<int> old_lines;
+    old_slots.swap(cache->Slots);
+    old_lines.swap(cache->Lines);
+    cache->Slots.resize(slots_count);
+    memset(cache->Slots.Data, 0, (size_t)cache->Slots.size_in_bytes());
+    cache->Count = 0;
+    for (const ImGuiTextSizeCacheEntry& entry : old_slots)
+        if (entry.Key != 0 && entry.LastFrameUsed >= min_frame)
+        {
+            ImGuiTextSizeCacheEntry* new_entry = TextSizeCacheFindSlot(cache, entry.Key);
+            *new_entry = entry;
+            if (entry.LinesCount > 0)
+            {
+                new_entry->LinesOffset = cache->Lines.Size;
+                cache->Lines.resize(cache->Lines.Size + entry.LinesCount * 2);
+                memcpy(cache->Lines.Data + new_entry->LinesOffset, old_lines.Data + entry.LinesOffset, (size_t)entry.LinesCount * 2 * sizeof(int));
+            }
+            cache->Count++;
+        }
+}
+
+static void TextSizeCacheAdd(ImGuiTextSizeCache* cache, ImU64 key, const ImVec2& size, int max_entries, int frame_count)
+{
+    // Entries are only kept when the table grows (io.ConfigTextSizeCacheMaxEntries changed during the frame)
+    const int slots_count = ImUpperPowerOfTwo(max_entries * 2);
+    if (cache->Slots.Size != slots_count)
+        TextSizeCacheRehash(cache, slots_count, slots_count > cache->Slots.Size ? INT_MIN : INT_MAX);
+    if (cache->Count >= max_entries)
+    {
+        // Evict what was not used during this frame or the previous one, drop the new entry if everything is still in use
+        if (cache->LastFrameEvicted == frame_count)
+            return;
+        cache->LastFrameEvicted = frame_count;
+        TextSizeCacheRehash(cache, slots_count, frame_count - 1);
+        if (cache->Count >= max_entries)
+            return;
+    }
+
+    ImGuiTextSizeCacheEntry* entry = TextSizeCacheFindSlot(cache, key);
+    entry->Key = key;
+    entry->Size = size;
+    entry->LastFrameUsed = frame_count;
+    entry->LinesOffset = 0;
+    entry->LinesCount = -1;
+    cache->Count++;
+}
+
+// Visual lines of a wrapped text, broken where ImFont::RenderText() breaks them: at wrap positions (skipping the blanks and line return after them) and at line returns.
+static void TextSizeCacheBuildLines(const ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end, ImVector<int>* out_lines)
+{
+    const float scale = font_size / font->FontSize;
+    const char* word_wrap_eol = NULL;
+    const char* line_begin = text;
+    const char* s = text;
+    while (s < text_end)
+    {
+        if (!word_wrap_eol)
+        {
+            word_wrap_eol = font->CalcWordWrapPositionA(scale, s, text_end, wrap_width);
+            if (word_wrap_eol == s)
+                word_wrap_eol++;
+        }
+
+        if (s >= word_wrap_eol)
+        {
+            out_lines->push_back((int)(line_begin - text));
+            out_lines->push_back((int)(s - text));
+            word_wrap_eol = NULL;
+            while (s < text_end)
+            {
+                const char c = *s;
+                if (ImCharIsBlankA(c)) { s++; } else if (c == '\n') { s++; break; } else { break; }
+            }
+            line_begin = s;
+            continue;
+        }
+
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+        {
+            s += 1;
+        }
+        else
+        {
+            s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0) // Malformed UTF-8: RenderText() stops there
+            {
+                s = prev_s;
+                break;
+            }
+        }
+
+        if (c == '\n')
+        {
+            out_lines->push_back((int)(line_begin - text));
+            out_lines->push_back((int)(prev_s - text));
+            line_begin = s;
+        }
+    }
+    if (line_begin < s)
+    {
+        out_lines->push_back((int)(line_begin - text));
+        out_lines->push_back((int)(s - text));
+    }
+}
+
+// Render a wrapped text line by line from its cache entry (added by the CalcTextSize() call laying it out), without wrapping it again.
+// Return false if the text has no entry or is rendered for the first time.
+static bool TextSizeCacheRenderWrapped(ImDrawList* draw_list, ImVec2 pos, const char* text, const char* text_end, float wrap_width)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.IO.ConfigTextSizeCacheMaxEntries <= 0 || text_end - text < IMGUI_TEXT_SIZE_CACHE_MIN_LENGTH)
+        return false;
+
+    ImGuiTextSizeCache* cache = &g.TextSizeCache;
+    const ImFont* font = g.Font;
+    const float font_size = g.FontSize;
+    ImGuiTextSizeCacheEntry* entry = TextSizeCacheFind(cache, TextSizeCacheHash(font, font_size, wrap_width, text, text_end));
+    if (entry == NULL || entry->LinesCount == -1)
+    {
+        if (entry)
+            entry->LinesCount = -2;
+        return false;
+    }
+    if (entry->LinesCount == -2)
+    {
+        entry->LinesOffset = cache->Lines.Size;
+        TextSizeCacheBuildLines(font, font_size, wrap_width, text, text_end, &cache->Lines);
+        entry->LinesCount = (cache->Lines.Size - entry->LinesOffset) / 2;
+    }
+
+    const ImU32 col = ImGui::GetColorU32(ImGuiCol_Text);
+    if ((col & IM_COL32_A_MASK) == 0)
+        return true;
+    IM_ASSERT(font->ContainerAtlas->TexID == draw_list->_CmdHeader.TextureId);
+
+    // Same line positions as ImFont::RenderText(), lines outside of the clip rectangle are skipped
+    const ImVec4& clip_rect = draw_list->_CmdHeader.ClipRect;
+    const float line_height = font->FontSize * (font_size / font->FontSize);
+    const float x = IM_FLOOR(pos.x);
+    float y = IM_FLOOR(pos.y);
+    const int* line = cache->Lines.Data + entry->LinesOffset;
+    for (int n = 0; n < entry->LinesCount && y <= clip_rect.w; n++, line += 2, y += line_height)
+        if (y + line_height >= clip_rect.y && line[0] != line[1])
+            font->RenderText(draw_list, font_size, ImVec2(x, y), col, clip_rect, text + line[0], text + line[1], 0.0f, false);
+    return true;
+}
+
+void ImGui::ClearTextSizeCache()
+{
+    ImGuiContext& g = *GImGui;
+    g.TextSizeCache.Clear();
+}
+
 // Find window given position, search front-to-back
 // FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
 // with SetWindowPos() and not SetNextWindowPos() will have that rectangle lagging by a frame at the time FindHoveredWindow() is
@@ -6854,6 +7310,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Setup draw list and outer clipping rectangle
         IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
+        window->DrawList->VtxOrigin = ImFloor(window->Pos + window->Size * 0.5f); // With IMGUI_USE_COMPACT_DRAWVERT, vertices are encoded relative to the center of the window (+/- IM_DRAWVERT_POS_RANGE)
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -17531,6 +17988,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
     Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
+    if (io.ConfigTextSizeCacheMaxEntries > 0)
+        Text("Text size cache: %d/%d entries, %d lines of wrapped text, %d hits, %d misses", g.TextSizeCache.Count, io.ConfigTextSizeCacheMaxEntries, g.TextSizeCache.Lines.Size / 2, io.MetricsTextSizeCacheHits, io.MetricsTextSizeCacheMisses);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -18166,7 +18625,7 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         {
             ImVec2 triangle[3];
             for (int n = 0; n < 3; n++, idx_n++)
-                triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos;
+                triangle[n] = draw_list->GetVtxPos(vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n]);
             total_area += ImTriangleArea(triangle[0], triangle[1], triangle[2]);
         }
 
@@ -18187,9 +18646,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 for (int n = 0; n < 3; n++, idx_i++)
                 {
                     const ImDrawVert& v = vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
-                    triangle[n] = v.pos;
+                    const ImVec2 uv = draw_list->GetVtxUV(v);
+                    triangle[n] = draw_list->GetVtxPos(v);
                     buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                        (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                        (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x, triangle[n].y, uv.x, uv.y, v.col);
                 }
 
                 Selectable(buf, false);
@@ -18223,7 +18683,7 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
 
         ImVec2 triangle[3];
         for (int n = 0; n < 3; n++, idx_n++)
-            vtxs_rect.Add((triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos));
+            vtxs_rect.Add((triangle[n] = draw_list->GetVtxPos(vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n])));
         if (show_mesh)
             out_draw_list->AddPolyline(triangle, 3, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f); // In yellow: mesh triangles
     }
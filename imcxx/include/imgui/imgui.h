@@ -142,8 +142,11 @@ struct ImDrawListSplitter;          // Helper to split a draw list into differen
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDirtyRect;        // Area of the font atlas texture changed since the renderer uploaded it (glyphs rasterized on demand)
+struct ImFontAtlasDynamicData;      // Opaque rasterizer state of the glyphs rasterized on demand
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
+struct ImFontDynamicGlyphs;         // Glyphs of a font rasterized on demand: requests and last use (see ImFontConfig::DynamicGlyphs)
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
@@ -1581,6 +1584,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererReusesDrawLists = 1 << 4, // Backend Renderer keeps the vertices and indices of each ImDrawList between frames. Render() hashes every draw list into ImDrawList::ContentHash so only changed lists need to be uploaded.
+    ImGuiBackendFlags_RendererHasTexUpdates = 1 << 5,   // Backend Renderer uploads io.Fonts->TexDirtyRects of the font texture before rendering. Required by fonts with ImFontConfig::DynamicGlyphs.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -1846,7 +1851,7 @@ struct ImVector
     // Constructors, destructor
     inline ImVector()                                       { Size = Capacity = 0; Data = NULL; }
     inline ImVector(const ImVector<T>& src)                 { Size = Capacity = 0; Data = NULL; operator=(src); }
-    inline ImVector<T>& operator=(const ImVector<T>& src)   { clear(); resize(src.Size); memcpy(Data, src.Data, (size_t)Size * sizeof(T)); return *this; }
+    inline ImVector<T>& operator=(const ImVector<T>& src)   { clear(); resize(src.Size); if (src.Data) memcpy(Data, src.Data, (size_t)Size * sizeof(T)); return *this; }
     inline ~ImVector()                                      { if (Data) IM_FREE(Data); } // Important: does not destruct anything
 
     inline void         clear()                             { if (Data) { Size = Capacity = 0; IM_FREE(Data); Data = NULL; } }  // Important: does not destruct anything
@@ -2014,6 +2019,7 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    int         ConfigTextSizeCacheMaxEntries;  // = 0              // [BETA] Cache up to N results of CalcTextSize() per font, font size, wrap width and text, and the line breaks of texts rendered by TextWrapped(). When full, entries not used during the last two frames are evicted. Each entry takes 64 bytes, plus 8 bytes per line of wrapped text. Set to 0 to disable.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -2082,6 +2088,8 @@ struct ImGuiIO
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
     int         MetricsActiveAllocations;           // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsTextSizeCacheHits;           // CalcTextSize() calls answered by the cache during the last frame (see ConfigTextSizeCacheMaxEntries)
+    int         MetricsTextSizeCacheMisses;         // CalcTextSize() calls measured during the last frame while the cache is enabled
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     // Legacy: before 1.87, we required backend to fill io.KeyMap[] (imgui->native map) during initialization and io.KeysDown[] (native indices) every frame.
@@ -2512,7 +2520,29 @@ struct ImDrawCmd
 };
 
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#ifdef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#error "IMGUI_USE_COMPACT_DRAWVERT and IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT can't be both defined"
+#endif
+// Compact vertex layout (12 bytes instead of 20), enabled by defining IMGUI_USE_COMPACT_DRAWVERT in imconfig.h
+// - pos: fixed-point position in 1/IM_DRAWVERT_POS_SCALE pixels, relative to the ImDrawList::VtxOrigin of its draw list (the center of its window or viewport).
+//   AddLine() (horizontal and vertical lines), AddRect() and AddRectFilled() cut their shapes at IM_DRAWVERT_POS_RANGE pixels from it (e.g. the borders of a tall table).
+//   Other positions further away are clamped one coordinate at a time, which distorts slanted edges: they assert in debug builds.
+// - uv: texture coordinates normalized to 0..65535. They are clamped to 0..1: textures can't be repeated with coordinates outside of it (AddImage() etc. assert in debug builds).
+// Renderers decode them with ImDrawList::GetVtxPos()/GetVtxUV(), or in their vertex shader: pos = VtxOrigin + pos / IM_DRAWVERT_POS_SCALE, uv = uv / 65535.
+#define IM_DRAWVERT_POS_SCALE   8.0f
+#define IM_DRAWVERT_POS_RANGE   (32767.0f / IM_DRAWVERT_POS_SCALE)
+struct ImDrawVert
+{
+    ImS16   pos[2];
+    ImU16   uv[2];
+    ImU32   col;
+
+    // Rounded to nearest and clamped without branches (the comparisons compile to min/max instructions): the value is biased to stay positive so truncation rounds
+    static inline ImS16 EncodePos(float v)  { v = v * IM_DRAWVERT_POS_SCALE + 32768.5f; v = v > 0.0f ? v : 0.0f; v = v < 65535.0f ? v : 65535.0f; return (ImS16)((int)v - 32768); }
+    static inline ImU16 EncodeUV(float v)   { v = v * 65535.0f + 0.5f; v = v > 0.0f ? v : 0.0f; v = v < 65535.0f ? v : 65535.0f; return (ImU16)(int)v; }
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
@@ -2607,6 +2637,9 @@ struct ImDrawList
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
+    ImU64                   ContentHash;        // Hash of CmdBuffer, IdxBuffer and VtxBuffer, set by Render() when the renderer sets ImGuiBackendFlags_RendererReusesDrawLists.
+    bool                    ContentChanged;     // ContentHash differs from the previous Render() of this draw list (always true when the renderer doesn't reuse draw lists).
+    ImVec2                  VtxOrigin;          // Origin of the vertex positions with IMGUI_USE_COMPACT_DRAWVERT (center of the window, or of the viewport), unused otherwise.
 
     // [Internal, used while building lists]
     unsigned int            _VtxCurrentIdx;     // [Internal] generally == VtxBuffer.Size unless we are past 64K vertices, in which case this gets reset to 0.
@@ -2658,6 +2691,17 @@ struct ImDrawList
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
 
+    // Batched primitives
+    // - Draw 'count' shapes from separate arrays of coordinates (heatmap cells, depth bars, scatter plot markers...), as if calling the single shape function for each.
+    // - Vertices and indices are reserved once per group of shapes, shapes outside of the current clip rect or fully transparent are skipped (tested 4 at a time with SSE).
+    // - Pass one color per shape in "cols", or a single "col" for all of them.
+    inline    void  AddRectsFilled(const float* x, const float* y, const float* w, const float* h, const ImU32* cols, int count)            { _AddRectsFilled(x, y, w, h, cols, 1, count); }   // AddRectFilled(ImVec2(x, y), ImVec2(x + w, y + h), col) without rounding
+    inline    void  AddRectsFilled(const float* x, const float* y, const float* w, const float* h, ImU32 col, int count)                    { _AddRectsFilled(x, y, w, h, &col, 0, count); }
+    inline    void  AddCirclesFilled(const float* x, const float* y, float radius, const ImU32* cols, int count, int num_segments = 0)     { _AddCirclesFilled(x, y, radius, cols, 1, count, num_segments); }  // AddCircleFilled(ImVec2(x, y), radius, col, num_segments), anti-aliased fringes are computed once for all circles
+    inline    void  AddCirclesFilled(const float* x, const float* y, float radius, ImU32 col, int count, int num_segments = 0)             { _AddCirclesFilled(x, y, radius, &col, 0, count, num_segments); }
+    inline    void  AddLines(const float* x1, const float* y1, const float* x2, const float* y2, const ImU32* cols, int count, float thickness = 1.0f) { _AddLines(x1, y1, x2, y2, cols, 1, count, thickness); }  // AddLine(ImVec2(x1, y1), ImVec2(x2, y2), col, thickness)
+    inline    void  AddLines(const float* x1, const float* y1, const float* x2, const float* y2, ImU32 col, int count, float thickness = 1.0f)         { _AddLines(x1, y1, x2, y2, &col, 0, count, thickness); }
+
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
     // - "p_min" and "p_max" represent the upper-left and lower-right corners of the rectangle.
@@ -2701,10 +2745,25 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
-    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)    { _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+    inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)    { _WriteVtx(_VtxWritePtr, pos, uv, col); _VtxWritePtr++; _VtxCurrentIdx++; }
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
+    // Advanced: Vertex encoding
+    // - Positions and texture coordinates are converted from/to the compact layout when IMGUI_USE_COMPACT_DRAWVERT is defined, they are copied as is otherwise.
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    inline    ImVec2 GetVtxPos(const ImDrawVert& vtx) const                     { return ImVec2(VtxOrigin.x + vtx.pos[0] * (1.0f / IM_DRAWVERT_POS_SCALE), VtxOrigin.y + vtx.pos[1] * (1.0f / IM_DRAWVERT_POS_SCALE)); }
+    inline    ImVec2 GetVtxUV(const ImDrawVert& vtx) const                      { return ImVec2(vtx.uv[0] * (1.0f / 65535.0f), vtx.uv[1] * (1.0f / 65535.0f)); }
+    inline    void  _WriteVtx(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col) const { IM_ASSERT(_IsVtxPosEncodable(pos) && "Vertex too far from VtxOrigin for IMGUI_USE_COMPACT_DRAWVERT!"); vtx->pos[0] = ImDrawVert::EncodePos(pos.x - VtxOrigin.x); vtx->pos[1] = ImDrawVert::EncodePos(pos.y - VtxOrigin.y); _WriteVtxUV(vtx, uv); vtx->col = col; }
+    inline    void  _WriteVtxUV(ImDrawVert* vtx, const ImVec2& uv) const        { vtx->uv[0] = ImDrawVert::EncodeUV(uv.x); vtx->uv[1] = ImDrawVert::EncodeUV(uv.y); }
+    inline    bool  _IsVtxPosEncodable(const ImVec2& pos) const                 { const float dx = pos.x - VtxOrigin.x, dy = pos.y - VtxOrigin.y; return dx >= -IM_DRAWVERT_POS_RANGE && dx <= IM_DRAWVERT_POS_RANGE && dy >= -IM_DRAWVERT_POS_RANGE && dy <= IM_DRAWVERT_POS_RANGE; }
+#else
+    inline    ImVec2 GetVtxPos(const ImDrawVert& vtx) const                     { return vtx.pos; }
+    inline    ImVec2 GetVtxUV(const ImDrawVert& vtx) const                      { return vtx.uv; }
+    inline    void  _WriteVtx(ImDrawVert* vtx, const ImVec2& pos, const ImVec2& uv, ImU32 col) const { vtx->pos = pos; vtx->uv = uv; vtx->col = col; }
+    inline    void  _WriteVtxUV(ImDrawVert* vtx, const ImVec2& uv) const        { vtx->uv = uv; }
+#endif
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     inline    void  AddBezierCurve(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0) { AddBezierCubic(p1, p2, p3, p4, col, thickness, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
     inline    void  PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments = 0) { PathBezierCubicCurveTo(p2, p3, p4, num_segments); } // OBSOLETED in 1.80 (Jan 2021)
@@ -2721,6 +2780,9 @@ struct ImDrawList
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
+    IMGUI_API void  _AddRectsFilled(const float* x, const float* y, const float* w, const float* h, const ImU32* cols, int col_step, int count);    // col_step: 1 (one color per shape) or 0 (same color)
+    IMGUI_API void  _AddCirclesFilled(const float* x, const float* y, float radius, const ImU32* cols, int col_step, int count, int num_segments);
+    IMGUI_API void  _AddLines(const float* x1, const float* y1, const float* x2, const float* y2, const ImU32* cols, int col_step, int count, float thickness);
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2732,6 +2794,7 @@ struct ImDrawData
     int             CmdListsCount;          // Number of ImDrawList* to render
     int             TotalIdxCount;          // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int             TotalVtxCount;          // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    int             ChangedListsCount;      // Number of CmdLists[] with ContentChanged set, == CmdListsCount unless the renderer sets ImGuiBackendFlags_RendererReusesDrawLists
     ImDrawList**    CmdLists;               // Array of ImDrawList* to render. The ImDrawList are owned by ImGuiContext and only pointed to from here.
     ImVec2          DisplayPos;             // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2          DisplaySize;            // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
@@ -2768,6 +2831,7 @@ struct ImFontConfig
     unsigned int    FontBuilderFlags;       // 0        // Settings for custom font builder. THIS IS BUILDER IMPLEMENTATION DEPENDENT. Leave as zero if unsure.
     float           RasterizerMultiply;     // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
     ImWchar         EllipsisChar;           // -1       // Explicitly specify unicode codepoint of ellipsis character. When fonts are being merged first specified ellipsis will be used.
+    bool            DynamicGlyphs;          // false    // Rasterize the glyphs of GlyphRanges the first time they are drawn instead of in Build() (printable ASCII is still built), for large ranges such as GetGlyphRangesChineseFull(). Needs ImGuiBackendFlags_RendererHasTexUpdates, see ImFontAtlas::UpdateDynamicGlyphs().
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -2817,6 +2881,13 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// See ImFontAtlas::TexDirtyRects.
+struct ImFontAtlasDirtyRect
+{
+    unsigned short  X, Y;           // Upper-left corner in the texture, in pixels
+    unsigned short  Width, Height;
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
@@ -2900,6 +2971,20 @@ struct ImFontAtlas
     IMGUI_API int               AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset = ImVec2(0, 0));
     ImFontAtlasCustomRect*      GetCustomRectByIndex(int index) { IM_ASSERT(index >= 0); return &CustomRects[index]; }
 
+    //-------------------------------------------
+    // [BETA] Glyphs rasterized on demand
+    //-------------------------------------------
+
+    // Fonts added with ImFontConfig::DynamicGlyphs only build printable ASCII, their other glyphs are rasterized when they are first drawn:
+    // - Build() keeps the advance of every glyph of the ranges (text is measured right away) and reserves TexDynamicGlyphsHeight rows of the texture for them.
+    // - ImFont::FindGlyph() returns the fallback glyph for a missing one and requests it. NewFrame() calls UpdateDynamicGlyphs(), which rasterizes
+    //   the requested glyphs in free space of the reserved rows (packed with stb_rect_pack) and adds the rectangles it wrote to TexDirtyRects.
+    // - When the rows are full, the glyphs unused for the longest time (not drawn in the last frame) are evicted and the others are moved together.
+    // - The renderer backend uploads TexDirtyRects of TexPixelsRGBA32 or TexPixelsAlpha8 before rendering, then clears it. Don't call ClearTexData().
+    // - Glyphs are requested by the thread calling NewFrame(). Draw lists recorded on other threads or cached log their glyphs instead (ImDrawListSharedData::GlyphUses, see ImFontMarkGlyphsUsed()).
+    IMGUI_API bool              UpdateDynamicGlyphs();      // Rasterize the glyphs requested since the previous call, outside of NewFrame()/Render(). Returns true when glyphs were added or moved. Only moving glyphs (evictions) increments BuildCount.
+    IMGUI_API bool              HasDynamicGlyphRequests() const;    // Glyphs were requested since the last UpdateDynamicGlyphs(): the next frame draws them instead of the fallback glyph.
+
     // [Internal]
     IMGUI_API void              CalcCustomRectUV(const ImFontAtlasCustomRect* rect, ImVec2* out_uv_min, ImVec2* out_uv_max) const;
     IMGUI_API bool              GetMouseCursorTexData(ImGuiMouseCursor cursor, ImVec2* out_offset, ImVec2* out_size, ImVec2 out_uv_border[2], ImVec2 out_uv_fill[2]);
@@ -2912,12 +2997,14 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    int                         TexDynamicGlyphsHeight; // Texture rows reserved by Build() for glyphs rasterized on demand (see ImFontConfig::DynamicGlyphs). 0: room for up to 512 glyphs of each of these fonts.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
     bool                        TexReady;           // Set when texture was built matching current font input
     bool                        TexPixelsUseColors; // Tell whether our texture data is known to use colors (rather than just alpha channel), in order to help backend select a format.
+    int                         BuildCount;         // Incremented each time glyphs are built, moved or evicted, or their lookup tables rebuilt. Data derived from glyphs (e.g. cached quads) needs to be rebuilt when it changes. Glyphs rasterized on demand don't increment it: data drawn with their fallback glyph is rebuilt by its own means (see ImFontMarkGlyphsUsed()).
     unsigned char*              TexPixelsAlpha8;    // 1 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight
     unsigned int*               TexPixelsRGBA32;    // 4 component per pixel, each component is unsigned 8-bit. Total size = TexWidth * TexHeight * 4
     int                         TexWidth;           // Texture width calculated during Build().
@@ -2928,6 +3015,8 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Configuration data
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
+    ImVector<ImFontAtlasDirtyRect> TexDirtyRects;   // Areas of the texture changed by UpdateDynamicGlyphs() since the renderer backend uploaded them. The backend clears it after the upload.
+    ImFontAtlasDynamicData*     DynamicData;        // Rasterizer state of the glyphs rasterized on demand, NULL without ImFontConfig::DynamicGlyphs
 
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
@@ -2965,6 +3054,7 @@ struct ImFont
     ImWchar                     DotChar;            // 2     // out // = '.'      // Character used for ellipsis rendering (if a single '...' character isn't found)
     bool                        DirtyLookupTables;  // 1     // out //
     float                       Scale;              // 4     // in  // = 1.f      // Base font scale, multiplied by the per-window font scale which you can adjust with SetWindowFontScale()
+    ImFontDynamicGlyphs*        DynamicGlyphs;      // 4-8   // out //            // Glyphs rasterized on demand, NULL unless a source has ImFontConfig::DynamicGlyphs
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
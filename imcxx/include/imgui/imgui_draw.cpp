@@ -389,6 +389,60 @@ ImDrawListSharedData::ImDrawListSharedData()
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
 }
 
+const ImVec2* ImDrawListArcCache::GetUnitArc(float a_min, float a_max, int num_segments)
+{
+    if (num_segments <= 0 || num_segments > IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX)
+        return NULL;
+
+    UseCounter++;
+    ImDrawListArcCacheEntry* entry = &Entries[LastHit];
+    if (entry->NumSegments != num_segments || entry->AMin != a_min || entry->AMax != a_max)
+    {
+        entry = NULL;
+        int lru = 0;
+        for (int n = 0; n < IM_ARRAYSIZE(Entries); n++)
+        {
+            ImDrawListArcCacheEntry* e = &Entries[n];
+            if (e->NumSegments == num_segments && e->AMin == a_min && e->AMax == a_max)
+            {
+                entry = e;
+                LastHit = n;
+                break;
+            }
+            if (e->LastUse < Entries[lru].LastUse)
+                lru = n;
+        }
+        if (entry == NULL)
+        {
+            LastHit = lru;
+            entry = &Entries[lru];
+            entry->AMin = a_min;
+            entry->AMax = a_max;
+            entry->NumSegments = num_segments;
+            entry->Points.resize(num_segments + 1);
+            for (int i = 0; i <= num_segments; i++)
+            {
+                const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
+                entry->Points[i] = ImVec2(ImCos(a), ImSin(a));
+            }
+        }
+    }
+    entry->LastUse = UseCounter;
+    return entry->Points.Data;
+}
+
+void ImDrawListArcCache::Clear()
+{
+    for (int n = 0; n < IM_ARRAYSIZE(Entries); n++)
+    {
+        Entries[n].NumSegments = 0;
+        Entries[n].LastUse = 0;
+        Entries[n].Points.clear();
+    }
+    UseCounter = 0;
+    LastHit = 0;
+}
+
 void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
 {
     if (CircleSegmentMaxError == max_error)
@@ -419,6 +473,7 @@ void ImDrawList::_ResetForNewFrame()
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
     Flags = _Data->InitialFlags;
+    VtxOrigin = ImVec2(0.0f, 0.0f);
     memset(&_CmdHeader, 0, sizeof(_CmdHeader));
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
@@ -453,6 +508,7 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
     dst->Flags = Flags;
+    dst->VtxOrigin = VtxOrigin;
     return dst;
 }
 
@@ -679,10 +735,10 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+    _WriteVtx(&_VtxWritePtr[0], a, uv, col);
+    _WriteVtx(&_VtxWritePtr[1], b, uv, col);
+    _WriteVtx(&_VtxWritePtr[2], c, uv, col);
+    _WriteVtx(&_VtxWritePtr[3], d, uv, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -694,10 +750,10 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    _WriteVtx(&_VtxWritePtr[0], a, uv_a, col);
+    _WriteVtx(&_VtxWritePtr[1], b, uv_b, col);
+    _WriteVtx(&_VtxWritePtr[2], c, uv_c, col);
+    _WriteVtx(&_VtxWritePtr[3], d, uv_d, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -708,10 +764,10 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    _WriteVtx(&_VtxWritePtr[0], a, uv_a, col);
+    _WriteVtx(&_VtxWritePtr[1], b, uv_b, col);
+    _WriteVtx(&_VtxWritePtr[2], c, uv_c, col);
+    _WriteVtx(&_VtxWritePtr[3], d, uv_d, col);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -859,8 +915,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
+                    _WriteVtx(&_VtxWritePtr[0], temp_points[i * 2 + 0], tex_uv0, col); // Left-side outer edge
+                    _WriteVtx(&_VtxWritePtr[1], temp_points[i * 2 + 1], tex_uv1, col); // Right-side outer edge
                     _VtxWritePtr += 2;
                 }
             }
@@ -869,9 +925,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 // If we're not using a texture, we need the center vertex as well
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
+                    _WriteVtx(&_VtxWritePtr[0], points[i],              opaque_uv, col);       // Center of line
+                    _WriteVtx(&_VtxWritePtr[1], temp_points[i * 2 + 0], opaque_uv, col_trans); // Left-side outer edge
+                    _WriteVtx(&_VtxWritePtr[2], temp_points[i * 2 + 1], opaque_uv, col_trans); // Right-side outer edge
                     _VtxWritePtr += 3;
                 }
             }
@@ -939,10 +995,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // Add vertices
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
+                _WriteVtx(&_VtxWritePtr[0], temp_points[i * 4 + 0], opaque_uv, col_trans);
+                _WriteVtx(&_VtxWritePtr[1], temp_points[i * 4 + 1], opaque_uv, col);
+                _WriteVtx(&_VtxWritePtr[2], temp_points[i * 4 + 2], opaque_uv, col);
+                _WriteVtx(&_VtxWritePtr[3], temp_points[i * 4 + 3], opaque_uv, col_trans);
                 _VtxWritePtr += 4;
             }
         }
@@ -967,10 +1023,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             dx *= (thickness * 0.5f);
             dy *= (thickness * 0.5f);
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+            _WriteVtx(&_VtxWritePtr[0], ImVec2(p1.x + dy, p1.y - dx), opaque_uv, col);
+            _WriteVtx(&_VtxWritePtr[1], ImVec2(p2.x + dy, p2.y - dx), opaque_uv, col);
+            _WriteVtx(&_VtxWritePtr[2], ImVec2(p2.x - dy, p2.y + dx), opaque_uv, col);
+            _WriteVtx(&_VtxWritePtr[3], ImVec2(p1.x - dy, p1.y + dx), opaque_uv, col);
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
@@ -1032,8 +1088,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _WriteVtx(&_VtxWritePtr[0], ImVec2((points[i1].x - dm_x), (points[i1].y - dm_y)), uv, col);        // Inner
+            _WriteVtx(&_VtxWritePtr[1], ImVec2((points[i1].x + dm_x), (points[i1].y + dm_y)), uv, col_trans);  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1051,7 +1107,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _WriteVtx(&_VtxWritePtr[0], points[i], uv, col);
             _VtxWritePtr++;
         }
         for (int i = 2; i < points_count; i++)
@@ -1166,11 +1222,29 @@ void ImDrawList::_PathArcToN(const ImVec2& center, float radius, float a_min, fl
     // Note that we are adding a point at both a_min and a_max.
     // If you are trying to draw a full closed circle you don't want the overlapping points!
     _Path.reserve(_Path.Size + (num_segments + 1));
-    for (int i = 0; i <= num_segments; i++)
+    const ImVec2* unit = _Data->ArcCache ? _Data->ArcCache->GetUnitArc(a_min, a_max, num_segments) : NULL;
+    if (unit == NULL)
     {
-        const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
-        _Path.push_back(ImVec2(center.x + ImCos(a) * radius, center.y + ImSin(a) * radius));
+        for (int i = 0; i <= num_segments; i++)
+        {
+            const float a = a_min + ((float)i / (float)num_segments) * (a_max - a_min);
+            _Path.push_back(ImVec2(center.x + ImCos(a) * radius, center.y + ImSin(a) * radius));
+        }
+        return;
     }
+
+    // Same operations as above on the cached cos/sin pairs, so the points are identical
+    ImVec2* out_ptr = _Path.Data + _Path.Size;
+    int i = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 r4 = _mm_set1_ps(radius);
+    const __m128 c4 = _mm_setr_ps(center.x, center.y, center.x, center.y);
+    for (; i + 2 <= num_segments + 1; i += 2)
+        _mm_storeu_ps(&out_ptr[i].x, _mm_add_ps(c4, _mm_mul_ps(_mm_loadu_ps(&unit[i].x), r4)));
+#endif
+    for (; i <= num_segments; i++)
+        out_ptr[i] = ImVec2(center.x + unit[i].x * radius, center.y + unit[i].y * radius);
+    _Path.Size += num_segments + 1;
 }
 
 // 0: East, 3: South, 6: West, 9: North, 12: East
@@ -1387,10 +1461,34 @@ void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, ImDr
     }
 }
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Cut an axis-aligned shape at the range of compact positions around VtxOrigin (less 'margin', for rounded corners and anti-aliased edges):
+// what is cut can't be visible, and no vertex of the shape has to be clamped (_WriteVtx() asserts on that, as clamping distorts slanted edges).
+static inline void ImDrawListCutToVtxRange(const ImDrawList* draw_list, ImVec2& a, ImVec2& b, float margin)
+{
+    const float range = IM_DRAWVERT_POS_RANGE - margin;
+    const ImVec2 min(draw_list->VtxOrigin.x - range, draw_list->VtxOrigin.y - range);
+    const ImVec2 max(draw_list->VtxOrigin.x + range, draw_list->VtxOrigin.y + range);
+    a = ImClamp(a, min, max);
+    b = ImClamp(b, min, max);
+}
+#endif
+
 void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    if (p1.x == p2.x || p1.y == p2.y)
+    {
+        ImVec2 a = p1, b = p2;
+        ImDrawListCutToVtxRange(this, a, b, thickness + 2.0f);
+        PathLineTo(a + ImVec2(0.5f, 0.5f));
+        PathLineTo(b + ImVec2(0.5f, 0.5f));
+        PathStroke(col, 0, thickness);
+        return;
+    }
+#endif
     PathLineTo(p1 + ImVec2(0.5f, 0.5f));
     PathLineTo(p2 + ImVec2(0.5f, 0.5f));
     PathStroke(col, 0, thickness);
@@ -1398,10 +1496,14 @@ void ImDrawList::AddLine(const ImVec2& p1, const ImVec2& p2, ImU32 col, float th
 
 // p_min = upper-left, p_max = lower-right
 // Note we don't render 1 pixels sized rectangles properly.
-void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
+void ImDrawList::AddRect(const ImVec2& p_min_in, const ImVec2& p_max_in, ImU32 col, float rounding, ImDrawFlags flags, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    ImVec2 p_min = p_min_in, p_max = p_max_in;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    ImDrawListCutToVtxRange(this, p_min, p_max, ImMax(rounding, 0.0f) + thickness + 2.0f);
+#endif
     if (Flags & ImDrawListFlags_AntiAliasedLines)
         PathRect(p_min + ImVec2(0.50f, 0.50f), p_max - ImVec2(0.50f, 0.50f), rounding, flags);
     else
@@ -1409,10 +1511,14 @@ void ImDrawList::AddRect(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, fl
     PathStroke(col, ImDrawFlags_Closed, thickness);
 }
 
-void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 col, float rounding, ImDrawFlags flags)
+void ImDrawList::AddRectFilled(const ImVec2& p_min_in, const ImVec2& p_max_in, ImU32 col, float rounding, ImDrawFlags flags)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
+    ImVec2 p_min = p_min_in, p_max = p_max_in;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    ImDrawListCutToVtxRange(this, p_min, p_max, ImMax(rounding, 0.0f) + 2.0f);
+#endif
     if (rounding <= 0.0f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
     {
         PrimReserve(6, 4);
@@ -1615,8 +1721,17 @@ void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, c
     AddText(NULL, 0.0f, pos, col, text_begin, text_end);
 }
 
+// Compact vertices (IMGUI_USE_COMPACT_DRAWVERT) clamp texture coordinates to 0..1: an image can't be repeated with coordinates outside of it
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#define IM_ASSERT_DRAWVERT_UV(_UV)  IM_ASSERT((_UV).x >= 0.0f && (_UV).x <= 1.0f && (_UV).y >= 0.0f && (_UV).y <= 1.0f && "Texture coordinates outside of 0..1 aren't supported with IMGUI_USE_COMPACT_DRAWVERT!")
+#else
+#define IM_ASSERT_DRAWVERT_UV(_UV)
+#endif
+
 void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col)
 {
+    IM_ASSERT_DRAWVERT_UV(uv_min);
+    IM_ASSERT_DRAWVERT_UV(uv_max);
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -1633,6 +1748,10 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
 
 void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, const ImVec2& uv1, const ImVec2& uv2, const ImVec2& uv3, const ImVec2& uv4, ImU32 col)
 {
+    IM_ASSERT_DRAWVERT_UV(uv1);
+    IM_ASSERT_DRAWVERT_UV(uv2);
+    IM_ASSERT_DRAWVERT_UV(uv3);
+    IM_ASSERT_DRAWVERT_UV(uv4);
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
@@ -1659,6 +1778,8 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
         return;
     }
 
+    IM_ASSERT_DRAWVERT_UV(uv_min);
+    IM_ASSERT_DRAWVERT_UV(uv_max);
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
         PushTextureID(user_texture_id);
@@ -1674,6 +1795,299 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 }
 
 
+// Batched primitives: shapes are processed by groups of up to 64. A bit mask of the visible shapes of the group (overlapping the clip rect
+// and not fully transparent) is computed 4 shapes at a time, then vertices and indices are reserved once and written for the visible shapes.
+#define IM_DRAWLIST_BATCH_GROUP_SIZE    64
+
+// Bit n is set when shape n is visible. Bounding boxes are [min(x1, x2) - expand, max(x1, x2) + expand] on each axis,
+// with (x2, y2) relative to (x1, y1) when 'relative' is set, and equal to (x1, y1) when NULL.
+static ImU64 ImDrawListBatchVisibleMask(const ImVec4& clip, const float* x1, const float* y1, const float* x2, const float* y2, bool relative, float expand, const ImU32* cols, int col_step, int count)
+{
+    ImU64 mask = 0;
+    int n = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 clip_min_x = _mm_set1_ps(clip.x), clip_min_y = _mm_set1_ps(clip.y);
+    const __m128 clip_max_x = _mm_set1_ps(clip.z), clip_max_y = _mm_set1_ps(clip.w);
+    const __m128 expand4 = _mm_set1_ps(expand);
+    for (; n + 4 <= count; n += 4)
+    {
+        const __m128 ax = _mm_loadu_ps(x1 + n);
+        const __m128 ay = _mm_loadu_ps(y1 + n);
+        __m128 bx = ax, by = ay;
+        if (x2 != NULL)
+        {
+            bx = _mm_loadu_ps(x2 + n);
+            by = _mm_loadu_ps(y2 + n);
+            if (relative)
+            {
+                bx = _mm_add_ps(ax, bx);
+                by = _mm_add_ps(ay, by);
+            }
+        }
+        const __m128 in_x = _mm_and_ps(_mm_cmplt_ps(_mm_sub_ps(_mm_min_ps(ax, bx), expand4), clip_max_x), _mm_cmpgt_ps(_mm_add_ps(_mm_max_ps(ax, bx), expand4), clip_min_x));
+        const __m128 in_y = _mm_and_ps(_mm_cmplt_ps(_mm_sub_ps(_mm_min_ps(ay, by), expand4), clip_max_y), _mm_cmpgt_ps(_mm_add_ps(_mm_max_ps(ay, by), expand4), clip_min_y));
+        mask |= (ImU64)_mm_movemask_ps(_mm_and_ps(in_x, in_y)) << n;
+    }
+#endif
+    for (; n < count; n++)
+    {
+        float bx = x1[n], by = y1[n];
+        if (x2 != NULL)
+        {
+            bx = relative ? x1[n] + x2[n] : x2[n];
+            by = relative ? y1[n] + y2[n] : y2[n];
+        }
+        if (ImMin(x1[n], bx) - expand < clip.z && ImMax(x1[n], bx) + expand > clip.x && ImMin(y1[n], by) - expand < clip.w && ImMax(y1[n], by) + expand > clip.y)
+            mask |= (ImU64)1 << n;
+    }
+
+    if (col_step == 0)
+        return (cols[0] & IM_COL32_A_MASK) ? mask : 0;
+    n = 0;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i alpha_mask = _mm_set1_epi32((int)IM_COL32_A_MASK);
+    for (; n + 4 <= count; n += 4)
+    {
+        const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(_mm_loadu_si128((const __m128i*)(cols + n)), alpha_mask), _mm_setzero_si128());
+        mask &= ~((ImU64)_mm_movemask_ps(_mm_castsi128_ps(transparent)) << n);
+    }
+#endif
+    for (; n < count; n++)
+        if ((cols[n] & IM_COL32_A_MASK) == 0)
+            mask &= ~((ImU64)1 << n);
+    return mask;
+}
+
+static inline int ImDrawListBatchCount(ImU64 mask)
+{
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        count++;
+    return count;
+}
+
+void ImDrawList::_AddRectsFilled(const float* x, const float* y, const float* w, const float* h, const ImU32* cols, int col_step, int count)
+{
+    const ImVec4 clip = _CmdHeader.ClipRect;
+    for (int group = 0; group < count; group += IM_DRAWLIST_BATCH_GROUP_SIZE)
+    {
+        const int group_count = ImMin(count - group, IM_DRAWLIST_BATCH_GROUP_SIZE);
+        const ImU64 visible = ImDrawListBatchVisibleMask(clip, x + group, y + group, w + group, h + group, true, 0.0f, cols + group * col_step, col_step, group_count);
+        const int visible_count = ImDrawListBatchCount(visible);
+        if (visible_count == 0)
+            continue;
+
+        PrimReserve(visible_count * 6, visible_count * 4);
+        for (int n = 0; n < group_count; n++)
+            if (visible & ((ImU64)1 << n))
+            {
+                const int i = group + n;
+                PrimRect(ImVec2(x[i], y[i]), ImVec2(x[i] + w[i], y[i] + h[i]), cols[i * col_step]);
+            }
+    }
+}
+
+void ImDrawList::_AddCirclesFilled(const float* x, const float* y, float radius, const ImU32* cols, int col_step, int count, int num_segments)
+{
+    if (radius <= 0.0f || count <= 0)
+        return;
+
+    // Outline of a circle centered on (0, 0), same points as AddCircleFilled() before they are moved to each center
+    PathClear();
+    if (num_segments <= 0)
+    {
+        _PathArcToFastEx(ImVec2(0.0f, 0.0f), radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        _Path.Size--;
+    }
+    else
+    {
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        PathArcTo(ImVec2(0.0f, 0.0f), radius, 0.0f, a_max, num_segments - 1);
+    }
+    const int points_count = _Path.Size;
+    if (points_count < 3)
+    {
+        PathClear();
+        return;
+    }
+
+    // Vertices and indices of one circle, see AddConvexPolyFilled(). Anti-aliased fringes use the normals of this outline for every circle.
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int vtx_count = anti_aliased ? points_count * 2 : points_count;
+    const int idx_count = anti_aliased ? (points_count - 2) * 3 + points_count * 6 : (points_count - 2) * 3;
+    ImVec2* shape_vtx = (ImVec2*)alloca(vtx_count * sizeof(ImVec2)); //-V630
+    unsigned int* shape_idx = (unsigned int*)alloca(idx_count * sizeof(unsigned int));
+    const ImVec2* points = _Path.Data;
+    unsigned int* idx_write = shape_idx;
+    if (anti_aliased)
+    {
+        const float AA_SIZE = _FringeScale;
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = 0; idx_write[1] = (i - 1) << 1; idx_write[2] = i << 1;
+            idx_write += 3;
+        }
+
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            float dx = points[i1].x - points[i0].x;
+            float dy = points[i1].y - points[i0].y;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            temp_normals[i0].x = dy;
+            temp_normals[i0].y = -dx;
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            float dm_x = (temp_normals[i0].x + temp_normals[i1].x) * 0.5f;
+            float dm_y = (temp_normals[i0].y + temp_normals[i1].y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            dm_x *= AA_SIZE * 0.5f;
+            dm_y *= AA_SIZE * 0.5f;
+            shape_vtx[i1 * 2 + 0] = ImVec2(points[i1].x - dm_x, points[i1].y - dm_y); // Inner
+            shape_vtx[i1 * 2 + 1] = ImVec2(points[i1].x + dm_x, points[i1].y + dm_y); // Outer
+            idx_write[0] = i1 << 1; idx_write[1] = i0 << 1; idx_write[2] = (i0 << 1) + 1;
+            idx_write[3] = (i0 << 1) + 1; idx_write[4] = (i1 << 1) + 1; idx_write[5] = i1 << 1;
+            idx_write += 6;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < points_count; i++)
+            shape_vtx[i] = points[i];
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = 0; idx_write[1] = i - 1; idx_write[2] = i;
+            idx_write += 3;
+        }
+    }
+    PathClear();
+
+    // Groups are small enough for 16-bit indices
+    const ImVec4 clip = _CmdHeader.ClipRect;
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const int group_size = ImClamp(0x8000 / vtx_count, 1, IM_DRAWLIST_BATCH_GROUP_SIZE);
+    for (int group = 0; group < count; group += group_size)
+    {
+        const int group_count = ImMin(count - group, group_size);
+        const ImU64 visible = ImDrawListBatchVisibleMask(clip, x + group, y + group, NULL, NULL, false, radius + _FringeScale, cols + group * col_step, col_step, group_count);
+        const int visible_count = ImDrawListBatchCount(visible);
+        if (visible_count == 0)
+            continue;
+
+        PrimReserve(visible_count * idx_count, visible_count * vtx_count);
+        for (int n = 0; n < group_count; n++)
+        {
+            if (!(visible & ((ImU64)1 << n)))
+                continue;
+            const int i = group + n;
+            const float cx = x[i], cy = y[i];
+            const ImU32 col = cols[i * col_step];
+            if (anti_aliased)
+            {
+                const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+                for (int v = 0; v < vtx_count; v += 2)
+                {
+                    _WriteVtx(&_VtxWritePtr[v + 0], ImVec2(cx + shape_vtx[v + 0].x, cy + shape_vtx[v + 0].y), uv, col);
+                    _WriteVtx(&_VtxWritePtr[v + 1], ImVec2(cx + shape_vtx[v + 1].x, cy + shape_vtx[v + 1].y), uv, col_trans);
+                }
+            }
+            else
+            {
+                for (int v = 0; v < vtx_count; v++)
+                    _WriteVtx(&_VtxWritePtr[v], ImVec2(cx + shape_vtx[v].x, cy + shape_vtx[v].y), uv, col);
+            }
+            const unsigned int base = _VtxCurrentIdx;
+            for (int k = 0; k < idx_count; k++)
+                _IdxWritePtr[k] = (ImDrawIdx)(base + shape_idx[k]);
+            _VtxWritePtr += vtx_count;
+            _IdxWritePtr += idx_count;
+            _VtxCurrentIdx += vtx_count;
+        }
+    }
+}
+
+void ImDrawList::_AddLines(const float* x1, const float* y1, const float* x2, const float* y2, const ImU32* cols, int col_step, int count, float thickness)
+{
+    // Same paths as AddPolyline() for two points: textured anti-aliased lines and non anti-aliased lines take 4 vertices and are written here,
+    // other anti-aliased lines (fractional or large thickness, no baked lines) are drawn one by one with AddLine()
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    const float aa_thickness = ImMax(thickness, 1.0f);
+    const int integer_thickness = (int)aa_thickness;
+    const bool use_texture = anti_aliased && (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (aa_thickness - integer_thickness <= 0.00001f) && (_FringeScale == 1.0f);
+    const float half_draw_size = use_texture ? (aa_thickness * 0.5f) + 1 : thickness * 0.5f;
+    const float expand = 0.5f + aa_thickness * 0.5f + _FringeScale + 1.0f; // Lines are offset by half a pixel (see AddLine()), fringes and mitered ends are a bit larger
+
+    const ImVec4 clip = _CmdHeader.ClipRect;
+    const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
+    const ImVec4 tex_uvs = use_texture ? _Data->TexUvLines[integer_thickness] : ImVec4();
+    const ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
+    const ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
+    for (int group = 0; group < count; group += IM_DRAWLIST_BATCH_GROUP_SIZE)
+    {
+        const int group_count = ImMin(count - group, IM_DRAWLIST_BATCH_GROUP_SIZE);
+        const ImU64 visible = ImDrawListBatchVisibleMask(clip, x1 + group, y1 + group, x2 + group, y2 + group, false, expand, cols + group * col_step, col_step, group_count);
+        if (visible == 0)
+            continue;
+
+        if (anti_aliased && !use_texture)
+        {
+            for (int n = 0; n < group_count; n++)
+                if (visible & ((ImU64)1 << n))
+                    AddLine(ImVec2(x1[group + n], y1[group + n]), ImVec2(x2[group + n], y2[group + n]), cols[(group + n) * col_step], thickness);
+            continue;
+        }
+
+        const int visible_count = ImDrawListBatchCount(visible);
+        PrimReserve(visible_count * 6, visible_count * 4);
+        for (int n = 0; n < group_count; n++)
+        {
+            if (!(visible & ((ImU64)1 << n)))
+                continue;
+            const int i = group + n;
+            const ImU32 col = cols[i * col_step];
+            const ImVec2 p1(x1[i] + 0.5f, y1[i] + 0.5f);
+            const ImVec2 p2(x2[i] + 0.5f, y2[i] + 0.5f);
+            float dx = p2.x - p1.x;
+            float dy = p2.y - p1.y;
+            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+            const unsigned int idx = _VtxCurrentIdx;
+            if (use_texture)
+            {
+                // [PATH 1] of AddPolyline(): the end point uses the averaged normal of the (single) segment
+                const float n_x = dy, n_y = -dx;
+                float dm_x = (n_x + n_x) * 0.5f;
+                float dm_y = (n_y + n_y) * 0.5f;
+                IM_FIXNORMAL2F(dm_x, dm_y);
+                dm_x *= half_draw_size;
+                dm_y *= half_draw_size;
+                _WriteVtx(&_VtxWritePtr[0], ImVec2(p1.x + n_x * half_draw_size, p1.y + n_y * half_draw_size), tex_uv0, col);
+                _WriteVtx(&_VtxWritePtr[1], ImVec2(p1.x - n_x * half_draw_size, p1.y - n_y * half_draw_size), tex_uv1, col);
+                _WriteVtx(&_VtxWritePtr[2], ImVec2(p2.x + dm_x, p2.y + dm_y), tex_uv0, col);
+                _WriteVtx(&_VtxWritePtr[3], ImVec2(p2.x - dm_x, p2.y - dm_y), tex_uv1, col);
+                _IdxWritePtr[0] = (ImDrawIdx)(idx + 2); _IdxWritePtr[1] = (ImDrawIdx)(idx + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx + 1);
+                _IdxWritePtr[3] = (ImDrawIdx)(idx + 3); _IdxWritePtr[4] = (ImDrawIdx)(idx + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx + 2);
+            }
+            else
+            {
+                // [PATH 4] of AddPolyline()
+                dx *= half_draw_size;
+                dy *= half_draw_size;
+                _WriteVtx(&_VtxWritePtr[0], ImVec2(p1.x + dy, p1.y - dx), opaque_uv, col);
+                _WriteVtx(&_VtxWritePtr[1], ImVec2(p2.x + dy, p2.y - dx), opaque_uv, col);
+                _WriteVtx(&_VtxWritePtr[2], ImVec2(p2.x - dy, p2.y + dx), opaque_uv, col);
+                _WriteVtx(&_VtxWritePtr[3], ImVec2(p1.x - dy, p1.y + dx), opaque_uv, col);
+                _IdxWritePtr[0] = (ImDrawIdx)(idx); _IdxWritePtr[1] = (ImDrawIdx)(idx + 1); _IdxWritePtr[2] = (ImDrawIdx)(idx + 2);
+                _IdxWritePtr[3] = (ImDrawIdx)(idx); _IdxWritePtr[4] = (ImDrawIdx)(idx + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx + 3);
+            }
+            _VtxWritePtr += 4;
+            _IdxWritePtr += 6;
+            _VtxCurrentIdx += 4;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawListSplitter
 //-----------------------------------------------------------------------------
@@ -1875,7 +2289,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
     const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
     for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
     {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float d = ImDot(draw_list->GetVtxPos(*vert) - gradient_p0, gradient_extent);
         float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         int r = (int)(col0_r + col_delta_r * t);
         int g = (int)(col0_g + col_delta_g * t);
@@ -1900,12 +2314,12 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
         const ImVec2 min = ImMin(uv_a, uv_b);
         const ImVec2 max = ImMax(uv_a, uv_b);
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            draw_list->_WriteVtxUV(vertex, ImClamp(uv_a + ImMul(draw_list->GetVtxPos(*vertex) - a, scale), min, max));
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            draw_list->_WriteVtxUV(vertex, uv_a + ImMul(draw_list->GetVtxPos(*vertex) - a, scale));
     }
 }
 
@@ -1978,6 +2392,8 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(109,0),ImVec2(13,15), ImVec2( 6, 7) }, // ImGuiMouseCursor_NotAllowed
 };
 
+static void ImFontAtlasDestroyDynamicData(ImFontAtlas* atlas);
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
@@ -2011,6 +2427,7 @@ void    ImFontAtlas::ClearInputData()
     ConfigData.clear();
     CustomRects.clear();
     PackIdMouseCursors = PackIdLines = -1;
+    ImFontAtlasDestroyDynamicData(this);
     // Important: we leave TexReady untouched
 }
 
@@ -2024,6 +2441,8 @@ void    ImFontAtlas::ClearTexData()
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
     TexPixelsUseColors = false;
+    TexDirtyRects.clear();
+    ImFontAtlasDestroyDynamicData(this);
     // Important: we leave TexReady untouched
 }
 
@@ -2032,6 +2451,7 @@ void    ImFontAtlas::ClearFonts()
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     Fonts.clear_delete();
     TexReady = false;
+    ImFontAtlasDestroyDynamicData(this);
 }
 
 void    ImFontAtlas::Clear()
@@ -2309,6 +2729,14 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// Rough surface of a glyph in the texture for ImFont::MetricsTotalSurface (+1 to account for average padding, +0.99 to round)
+// We use (U1-U0)*TexWidth instead of X1-X0 to account for oversampling.
+static int ImFontAtlasCalcGlyphSurface(const ImFontAtlas* atlas, const ImFontGlyph& glyph)
+{
+    const float pad = atlas->TexGlyphPadding + 0.99f;
+    return (int)((glyph.U1 - glyph.U0) * atlas->TexWidth + pad) * (int)((glyph.V1 - glyph.V0) * atlas->TexHeight + pad);
+}
+
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 // Temporary data for one source font (multiple source fonts can be merged into one destination ImFont)
 // (C++03 doesn't allow instancing ImVector<> with function-local types so we declare the type here.)
@@ -2324,6 +2752,7 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsMap)
+    ImVector<int>       DynamicList;        // Codepoints rasterized on demand (ImFontConfig::DynamicGlyphs), not packed by Build()
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -2347,6 +2776,93 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Source font of glyphs rasterized on demand (ImFontConfig::DynamicGlyphs)
+struct ImFontAtlasDynamicSource
+{
+    stbtt_fontinfo      FontInfo;
+    const ImFontConfig* Config;             // Within atlas->ConfigData
+    const ImWchar*      SrcRanges;
+    float               Scale;              // Same as stbtt_PackFontRangesRenderIntoRects()
+};
+
+struct ImFontAtlasDynamicRequest
+{
+    ImFont*             Font;
+    int                 SrcIndex;           // Index into ImFontAtlasDynamicData::Sources[]
+    int                 Codepoint;
+};
+
+struct ImFontAtlasDynamicData
+{
+    ImVector<ImFontAtlasDynamicSource> Sources;
+    int                 AreaY, AreaHeight;  // Texture rows reserved for the glyphs
+    stbrp_context       PackContext;        // Packer of the reserved rows, started again when glyphs are evicted
+    ImVector<stbrp_node> PackNodes;
+    int                 Frame;              // Incremented by each ImFontAtlas::UpdateDynamicGlyphs()
+
+    // Temporary storage of ImFontAtlas::UpdateDynamicGlyphs()
+    ImVector<ImFontAtlasDynamicRequest> Requests;
+    ImVector<stbrp_rect> Rects;
+
+    ImFontAtlasDynamicData()                { AreaY = AreaHeight = Frame = 0; memset(&PackContext, 0, sizeof(PackContext)); }
+};
+
+static void ImFontAtlasDestroyDynamicData(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicData)
+        IM_DELETE(atlas->DynamicData);
+    atlas->DynamicData = NULL;
+}
+
+// Same adjustments as ImFont::AddGlyph()
+static float ImFontAtlasBuildAdjustAdvanceX(const ImFontConfig& cfg, float advance_x)
+{
+    advance_x = ImClamp(advance_x, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX);
+    if (cfg.PixelSnapH)
+        advance_x = IM_ROUND(advance_x);
+    return advance_x + cfg.GlyphExtraSpacing.x;
+}
+
+static void ImFontAtlasBuildSetupDynamicGlyphs(ImFontAtlas* atlas, ImVector<ImFontBuildSrcData>& src_tmp_array, int area_y, int area_height)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData = IM_NEW(ImFontAtlasDynamicData)();
+    data->AreaY = area_y;
+    data->AreaHeight = area_height;
+    data->PackNodes.resize(atlas->TexWidth);
+    stbrp_init_target(&data->PackContext, atlas->TexWidth, area_height, data->PackNodes.Data, data->PackNodes.Size);
+
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        if (src_tmp.DynamicList.Size == 0)
+            continue;
+
+        ImFontConfig& cfg = atlas->ConfigData[src_i];
+        ImFontAtlasDynamicSource src;
+        src.FontInfo = src_tmp.FontInfo;
+        src.Config = &cfg;
+        src.SrcRanges = src_tmp.SrcRanges;
+        src.Scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+        data->Sources.push_back(src);
+
+        // Advance of every glyph, so text is measured the same before and after its glyphs are rasterized
+        ImFont* dst_font = cfg.DstFont;
+        if (dst_font->DynamicGlyphs == NULL)
+            dst_font->DynamicGlyphs = IM_NEW(ImFontDynamicGlyphs)();
+        ImFontDynamicGlyphs* dynamic_glyphs = dst_font->DynamicGlyphs;
+        if (dynamic_glyphs->AdvanceX.Size < src_tmp.GlyphsHighest + 1)
+            dynamic_glyphs->AdvanceX.resize(src_tmp.GlyphsHighest + 1, -1.0f);
+        for (int glyph_i = 0; glyph_i < src_tmp.DynamicList.Size; glyph_i++)
+        {
+            const int codepoint = src_tmp.DynamicList[glyph_i];
+            int advance, lsb;
+            stbtt_GetGlyphHMetrics(&src_tmp.FontInfo, stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint), &advance, &lsb);
+            dynamic_glyphs->AdvanceX[codepoint] = ImFontAtlasBuildAdjustAdvanceX(cfg, src.Scale * advance);
+        }
+        dynamic_glyphs->Requested.Create(dynamic_glyphs->AdvanceX.Size);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2406,6 +2922,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
         ImFontBuildDstData& dst_tmp = dst_tmp_array[src_tmp.DstIndex];
+        const bool dynamic_glyphs = atlas->ConfigData[src_i].DynamicGlyphs;
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
@@ -2418,6 +2935,14 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
                     continue;
 
+                // Glyphs rasterized on demand only take their codepoint, printable ASCII is always built
+                if (dynamic_glyphs && (codepoint < 0x20 || codepoint > 0x7E))
+                {
+                    dst_tmp.GlyphsSet.SetBit(codepoint);
+                    src_tmp.DynamicList.push_back((int)codepoint);
+                    continue;
+                }
+
                 // Add to avail set/counters
                 src_tmp.GlyphsCount++;
                 dst_tmp.GlyphsCount++;
@@ -2489,6 +3014,30 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // Glyphs rasterized on demand get rows below the others: TexDynamicGlyphsHeight, or room for up to 512 glyphs of each source,
+    // measured from a sample of them, with some slack for the packing.
+    int dynamic_surface = 0;
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+    {
+        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
+        if (src_tmp.DynamicList.Size == 0)
+            continue;
+        const ImFontConfig& cfg = atlas->ConfigData[src_i];
+        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
+        const int sample_count = ImMin(src_tmp.DynamicList.Size, 64);
+        int sample_surface = 0;
+        for (int sample_i = 0; sample_i < sample_count; sample_i++)
+        {
+            int x0, y0, x1, y1;
+            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.DynamicList[sample_i * src_tmp.DynamicList.Size / sample_count]);
+            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+            sample_surface += (x1 - x0 + atlas->TexGlyphPadding + cfg.OversampleH - 1) * (y1 - y0 + atlas->TexGlyphPadding + cfg.OversampleV - 1);
+        }
+        dynamic_surface += sample_surface / sample_count * ImMin(src_tmp.DynamicList.Size, 512) * 5 / 4;
+    }
+    if (atlas->TexDynamicGlyphsHeight <= 0)
+        total_surface += dynamic_surface;
+
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
     // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
@@ -2498,6 +3047,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    const int dynamic_height = (dynamic_surface == 0) ? 0 : (atlas->TexDynamicGlyphsHeight > 0) ? atlas->TexDynamicGlyphsHeight : (dynamic_surface + atlas->TexWidth - 1) / atlas->TexWidth;
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
@@ -2521,6 +3071,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             if (src_tmp.Rects[glyph_i].was_packed)
                 atlas->TexHeight = ImMax(atlas->TexHeight, src_tmp.Rects[glyph_i].y + src_tmp.Rects[glyph_i].h);
     }
+    const int dynamic_y = atlas->TexHeight;
+    atlas->TexHeight += dynamic_height;
 
     // 7. Allocate texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
@@ -2561,7 +3113,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
+        if (src_tmp.GlyphsCount == 0 && src_tmp.DynamicList.Size == 0)
             continue;
 
         // When merging fonts with MergeMode=true:
@@ -2592,6 +3144,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // 10. Keep the sources and a packer of the reserved rows for the glyphs rasterized on demand, and their advances for the lookup tables
+    if (dynamic_height > 0)
+        ImFontAtlasBuildSetupDynamicGlyphs(atlas, src_tmp_array, dynamic_y, atlas->TexHeight - dynamic_y);
+
     // Cleanup
     src_tmp_array.clear_destruct();
 
@@ -2606,8 +3162,341 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
     return &io;
 }
 
+//-----------------------------------------------------------------------------
+// Glyphs rasterized on demand (ImFontConfig::DynamicGlyphs)
+//-----------------------------------------------------------------------------
+
+// First source of 'font' with DynamicGlyphs holding 'codepoint', same priority as the build
+static int ImFontAtlasDynamicFindSource(const ImFontAtlasDynamicData* data, const ImFont* font, int codepoint)
+{
+    for (int src_i = 0; src_i < data->Sources.Size; src_i++)
+    {
+        const ImFontAtlasDynamicSource& src = data->Sources[src_i];
+        if (src.Config->DstFont != font)
+            continue;
+        for (const ImWchar* src_range = src.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
+            if (codepoint >= (int)src_range[0] && codepoint <= (int)src_range[1])
+            {
+                if (stbtt_FindGlyphIndex(&src.FontInfo, codepoint))
+                    return src_i;
+                break;
+            }
+    }
+    return -1;
+}
+
+static void ImFontAtlasDynamicUpdateRGBA32(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32 == NULL)
+        return;
+    for (int off_y = 0; off_y < h; off_y++)
+    {
+        const unsigned char* src = atlas->TexPixelsAlpha8 + x + (size_t)(y + off_y) * atlas->TexWidth;
+        unsigned int* dst = atlas->TexPixelsRGBA32 + x + (size_t)(y + off_y) * atlas->TexWidth;
+        for (int off_x = 0; off_x < w; off_x++)
+            dst[off_x] = IM_COL32(255, 255, 255, (unsigned int)src[off_x]);
+    }
+}
+
+static void ImFontAtlasDynamicEvictGlyph(ImFont* font, int glyph_index)
+{
+    ImFontDynamicGlyphs* dynamic_glyphs = font->DynamicGlyphs;
+    ImFontDynamicGlyph& slot = dynamic_glyphs->Slots[glyph_index];
+    font->IndexLookup[font->Glyphs[glyph_index].Codepoint] = (ImWchar)-1;   // IndexAdvanceX keeps the advance of the glyph
+    font->MetricsTotalSurface -= ImFontAtlasCalcGlyphSurface(font->ContainerAtlas, font->Glyphs[glyph_index]);
+    slot.LastUsedFrame = -2;
+    dynamic_glyphs->FreeGlyphs.push_back(glyph_index);
+}
+
+struct ImFontAtlasDynamicGlyphRef
+{
+    ImFont*             Font;
+    int                 GlyphIndex;
+    int                 LastUsedFrame;
+};
+
+static int IMGUI_CDECL ImFontAtlasDynamicGlyphRefComparerByLastUse(const void* lhs, const void* rhs)
+{
+    const int a = ((const ImFontAtlasDynamicGlyphRef*)lhs)->LastUsedFrame;
+    const int b = ((const ImFontAtlasDynamicGlyphRef*)rhs)->LastUsedFrame;
+    return (a > b) - (a < b);
+}
+
+// Evict the glyphs unused for the longest time until 'surface' pixels are freed (at least a quarter of the rows, so evictions stay rare),
+// then pack the other glyphs again from the top of the rows. Glyphs drawn during the previous frame are kept. Returns false when none could be evicted.
+static bool ImFontAtlasDynamicEvict(ImFontAtlas* atlas, int surface)
+{
+    ImFontAtlasDynamicData* data = atlas->DynamicData;
+    ImVector<ImFontAtlasDynamicGlyphRef> glyphs;
+    for (int font_i = 0; font_i < atlas->Fonts.Size; font_i++)
+        if (ImFontDynamicGlyphs* dynamic_glyphs = atlas->Fonts[font_i]->DynamicGlyphs)
+            for (int glyph_i = 0; glyph_i < dynamic_glyphs->Slots.Size; glyph_i++)
+                if (dynamic_glyphs->Slots[glyph_i].LastUsedFrame >= 0)
+                {
+                    ImFontAtlasDynamicGlyphRef ref = { atlas->Fonts[font_i], glyph_i, dynamic_glyphs->Slots[glyph_i].LastUsedFrame };
+                    glyphs.push_back(ref);
+                }
+    if (glyphs.Size == 0)
+        return false;
+    ImQsort(glyphs.Data, (size_t)glyphs.Size, sizeof(glyphs[0]), ImFontAtlasDynamicGlyphRefComparerByLastUse);
+
+    surface = ImMax(surface, atlas->TexWidth * data->AreaHeight / 4);
+    int evicted_count = 0;
+    for (int freed = 0; evicted_count < glyphs.Size && freed < surface && glyphs[evicted_count].LastUsedFrame < data->Frame - 1; evicted_count++)
+    {
+        const ImFontAtlasDynamicGlyphRef& ref = glyphs[evicted_count];
+        const ImFontDynamicGlyph& slot = ref.Font->DynamicGlyphs->Slots[ref.GlyphIndex];
+        freed += slot.Width * slot.Height;
+        ImFontAtlasDynamicEvictGlyph(ref.Font, ref.GlyphIndex);
+    }
+    if (evicted_count == 0)
+        return false;
+
+    // Copy the pixels of the other glyphs, clear the rows and pack them again
+    const int kept_count = glyphs.Size - evicted_count;
+    ImVector<stbrp_rect> rects;
+    ImVector<unsigned char> pixels;
+    rects.reserve(kept_count);
+    for (int kept_i = 0; kept_i < kept_count; kept_i++)
+    {
+        const ImFontAtlasDynamicGlyphRef& ref = glyphs[evicted_count + kept_i];
+        const ImFontDynamicGlyph& slot = ref.Font->DynamicGlyphs->Slots[ref.GlyphIndex];
+        stbrp_rect r = {};
+        r.id = pixels.Size;
+        r.w = slot.Width;
+        r.h = slot.Height;
+        rects.push_back(r);
+        pixels.resize(pixels.Size + slot.Width * slot.Height);
+        for (int off_y = 0; off_y < slot.Height; off_y++)
+            memcpy(pixels.Data + r.id + off_y * slot.Width, atlas->TexPixelsAlpha8 + slot.X + (size_t)(slot.Y + off_y) * atlas->TexWidth, slot.Width);
+    }
+    memset(atlas->TexPixelsAlpha8 + (size_t)data->AreaY * atlas->TexWidth, 0, (size_t)data->AreaHeight * atlas->TexWidth);
+    stbrp_init_target(&data->PackContext, atlas->TexWidth, data->AreaHeight, data->PackNodes.Data, data->PackNodes.Size);
+    stbrp_pack_rects(&data->PackContext, rects.Data, rects.Size);
+
+    for (int kept_i = 0; kept_i < kept_count; kept_i++)
+    {
+        const ImFontAtlasDynamicGlyphRef& ref = glyphs[evicted_count + kept_i];
+        const stbrp_rect& r = rects[kept_i];
+        if (!r.was_packed)
+        {
+            ImFontAtlasDynamicEvictGlyph(ref.Font, ref.GlyphIndex);
+            continue;
+        }
+        ImFontDynamicGlyph& slot = ref.Font->DynamicGlyphs->Slots[ref.GlyphIndex];
+        const int x = r.x;
+        const int y = r.y + data->AreaY;
+        for (int off_y = 0; off_y < slot.Height; off_y++)
+            memcpy(atlas->TexPixelsAlpha8 + x + (size_t)(y + off_y) * atlas->TexWidth, pixels.Data + r.id + off_y * slot.Width, slot.Width);
+
+        // Same as stbtt_GetPackedQuad(): UVs are texel coordinates times TexUvScale, they don't drift after several moves
+        ImFontGlyph& glyph = ref.Font->Glyphs[ref.GlyphIndex];
+        glyph.U0 = (x + slot.TexelX0) * atlas->TexUvScale.x;
+        glyph.V0 = (y + slot.TexelY0) * atlas->TexUvScale.y;
+        glyph.U1 = (x + slot.TexelX1) * atlas->TexUvScale.x;
+        glyph.V1 = (y + slot.TexelY1) * atlas->TexUvScale.y;
+        slot.X = (unsigned short)x;
+        slot.Y = (unsigned short)y;
+    }
+    ImFontAtlasDynamicUpdateRGBA32(atlas, 0, data->AreaY, atlas->TexWidth, data->AreaHeight);
+    ImFontAtlasDirtyRect dirty = { 0, (unsigned short)data->AreaY, (unsigned short)atlas->TexWidth, (unsigned short)data->AreaHeight };
+    atlas->TexDirtyRects.push_back(dirty);
+    return true;
+}
+
+static bool ImFontAtlasDynamicAddGlyph(ImFont* font, const ImFontConfig* cfg, int codepoint, const stbtt_aligned_quad& q, float advance_x, const ImFontDynamicGlyph& slot)
+{
+    // Evicted entries are reused, ImFont::IndexLookup[] reserves (ImWchar)-1
+    ImFontDynamicGlyphs* dynamic_glyphs = font->DynamicGlyphs;
+    if (dynamic_glyphs->FreeGlyphs.Size == 0 && font->Glyphs.Size >= 0xFFFE)
+        return false;
+
+    const float font_off_x = cfg->GlyphOffset.x;
+    const float font_off_y = cfg->GlyphOffset.y + IM_ROUND(font->Ascent);
+    font->AddGlyph(cfg, (ImWchar)codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, advance_x);
+    int glyph_index = font->Glyphs.Size - 1;
+    if (dynamic_glyphs->FreeGlyphs.Size > 0)
+    {
+        glyph_index = dynamic_glyphs->FreeGlyphs.back();
+        dynamic_glyphs->FreeGlyphs.pop_back();
+        font->Glyphs[glyph_index] = font->Glyphs.back();
+        font->Glyphs.pop_back();
+    }
+    else
+    {
+        dynamic_glyphs->Slots.push_back(slot);
+    }
+    dynamic_glyphs->Slots[glyph_index] = slot;
+
+    // Same as ImFont::BuildLookupTable() for one glyph
+    font->IndexLookup[codepoint] = (ImWchar)glyph_index;
+    const int page_n = codepoint / 4096;
+    font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+    font->DirtyLookupTables = false;
+    return true;
+}
+
+bool ImFontAtlas::UpdateDynamicGlyphs()
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDynamicData* data = DynamicData;
+    if (data == NULL || TexPixelsAlpha8 == NULL)
+        return false;
+
+    // Glyphs drawn during the previous frame have LastUsedFrame == data->Frame - 1 from now on
+    data->Frame++;
+    data->Requests.resize(0);
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+    {
+        ImFont* font = Fonts[font_i];
+        ImFontDynamicGlyphs* dynamic_glyphs = font->DynamicGlyphs;
+        if (dynamic_glyphs == NULL)
+            continue;
+        dynamic_glyphs->Frame = data->Frame;
+        for (int request_i = 0; request_i < dynamic_glyphs->Requests.Size; request_i++)
+        {
+            const int codepoint = dynamic_glyphs->Requests[request_i];
+            dynamic_glyphs->Requested.ClearBit(codepoint);
+            if (font->FindGlyphNoFallback((ImWchar)codepoint) != NULL)
+                continue;
+            const int src_i = ImFontAtlasDynamicFindSource(data, font, codepoint);
+            if (src_i < 0)
+                continue;
+            ImFontAtlasDynamicRequest request = { font, src_i, codepoint };
+            data->Requests.push_back(request);
+        }
+        dynamic_glyphs->Requests.resize(0);
+    }
+    if (data->Requests.Size == 0)
+        return false;
+
+    // Gather the glyph sizes (same as the build)
+    data->Rects.resize(data->Requests.Size);
+    memset(data->Rects.Data, 0, (size_t)data->Rects.size_in_bytes());
+    int surface = 0;
+    for (int request_i = 0; request_i < data->Requests.Size; request_i++)
+    {
+        const ImFontAtlasDynamicRequest& request = data->Requests[request_i];
+        const ImFontAtlasDynamicSource& src = data->Sources[request.SrcIndex];
+        const ImFontConfig& cfg = *src.Config;
+        int x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(&src.FontInfo, stbtt_FindGlyphIndex(&src.FontInfo, request.Codepoint), src.Scale * cfg.OversampleH, src.Scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        stbrp_rect& r = data->Rects[request_i];
+        r.w = (stbrp_coord)(x1 - x0 + TexGlyphPadding + cfg.OversampleH - 1);
+        r.h = (stbrp_coord)(y1 - y0 + TexGlyphPadding + cfg.OversampleV - 1);
+        surface += r.w * r.h;
+    }
+
+    // Not enough room: evict glyphs and pack everything again
+    bool moved = false;
+    stbrp_pack_rects(&data->PackContext, data->Rects.Data, data->Rects.Size);
+    for (int request_i = 0; request_i < data->Rects.Size && !moved; request_i++)
+        if (!data->Rects[request_i].was_packed)
+        {
+            moved = ImFontAtlasDynamicEvict(this, surface);
+            if (!moved)
+                break;
+            for (int rect_i = 0; rect_i < data->Rects.Size; rect_i++)
+                data->Rects[rect_i].was_packed = 0;
+            stbrp_pack_rects(&data->PackContext, data->Rects.Data, data->Rects.Size);
+        }
+
+    // Rasterize into the packed rectangles. The others are dropped, they are requested again when drawn.
+    stbtt_pack_context spc = {};
+    spc.width = TexWidth;
+    spc.height = TexHeight;
+    spc.stride_in_bytes = TexWidth;
+    spc.padding = TexGlyphPadding;
+    spc.pixels = TexPixelsAlpha8;
+    int added_count = 0;
+    ImVec4 dirty(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int request_i = 0; request_i < data->Requests.Size; request_i++)
+    {
+        stbrp_rect r = data->Rects[request_i];
+        if (!r.was_packed)
+            continue;
+        const ImFontAtlasDynamicRequest& request = data->Requests[request_i];
+        const ImFontAtlasDynamicSource& src = data->Sources[request.SrcIndex];
+        const ImFontConfig& cfg = *src.Config;
+        r.y += data->AreaY;
+        ImFontDynamicGlyph slot = { data->Frame, (unsigned short)r.x, (unsigned short)r.y, (unsigned short)r.w, (unsigned short)r.h, 0, 0, 0, 0 };
+
+        // Empty rectangles are not rendered: the packed char only has its advance
+        int codepoint = request.Codepoint;
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(&src.FontInfo, stbtt_FindGlyphIndex(&src.FontInfo, codepoint), &advance, &lsb);
+        stbtt_packedchar pc = {};
+        pc.xadvance = src.Scale * advance;
+        stbtt_pack_range range = {};
+        range.font_size = cfg.SizePixels;
+        range.array_of_unicode_codepoints = &codepoint;
+        range.num_chars = 1;
+        range.chardata_for_range = &pc;
+        range.h_oversample = (unsigned char)cfg.OversampleH;
+        range.v_oversample = (unsigned char)cfg.OversampleV;
+        stbtt_PackFontRangesRenderIntoRects(&spc, &src.FontInfo, &range, 1, &r);
+        if (cfg.RasterizerMultiply != 1.0f && r.w > 0 && r.h > 0)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, TexPixelsAlpha8, r.x, r.y, r.w, r.h, TexWidth * 1);
+        }
+
+        stbtt_aligned_quad q;
+        float unused_x = 0.0f, unused_y = 0.0f;
+        stbtt_GetPackedQuad(&pc, TexWidth, TexHeight, 0, &unused_x, &unused_y, &q, 0);
+        slot.TexelX0 = (unsigned short)(pc.x0 - slot.X);
+        slot.TexelY0 = (unsigned short)(pc.y0 - slot.Y);
+        slot.TexelX1 = (unsigned short)(pc.x1 - slot.X);
+        slot.TexelY1 = (unsigned short)(pc.y1 - slot.Y);
+        if (!ImFontAtlasDynamicAddGlyph(request.Font, &cfg, codepoint, q, pc.xadvance, slot))
+            continue;
+        added_count++;
+        dirty.x = ImMin(dirty.x, (float)slot.X);
+        dirty.y = ImMin(dirty.y, (float)slot.Y);
+        dirty.z = ImMax(dirty.z, (float)(slot.X + slot.Width));
+        dirty.w = ImMax(dirty.w, (float)(slot.Y + slot.Height));
+    }
+
+    // ImFont::Glyphs may have grown
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        if (Fonts[font_i]->DynamicGlyphs)
+            Fonts[font_i]->FallbackGlyph = Fonts[font_i]->FindGlyphNoFallback(Fonts[font_i]->FallbackChar);
+
+    // One rectangle for all the new glyphs, moved glyphs already marked the whole rows
+    if (added_count > 0 && !moved && dirty.x < dirty.z && dirty.y < dirty.w)
+    {
+        ImFontAtlasDynamicUpdateRGBA32(this, (int)dirty.x, (int)dirty.y, (int)(dirty.z - dirty.x), (int)(dirty.w - dirty.y));
+        ImFontAtlasDirtyRect dirty_rect = { (unsigned short)dirty.x, (unsigned short)dirty.y, (unsigned short)(dirty.z - dirty.x), (unsigned short)(dirty.w - dirty.y) };
+        TexDirtyRects.push_back(dirty_rect);
+    }
+    else if (added_count > 0 && moved)
+    {
+        ImFontAtlasDynamicUpdateRGBA32(this, 0, data->AreaY, TexWidth, data->AreaHeight);
+    }
+    // Glyphs drawn before are unchanged unless glyphs were moved or evicted
+    if (moved)
+        BuildCount++;
+    return added_count > 0 || moved;
+}
+
+#else
+
+static void ImFontAtlasDestroyDynamicData(ImFontAtlas*) {}
+bool ImFontAtlas::UpdateDynamicGlyphs() { return false; }
+
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+bool ImFontAtlas::HasDynamicGlyphRequests() const
+{
+    if (DynamicData == NULL)
+        return false;
+    for (int font_i = 0; font_i < Fonts.Size; font_i++)
+        if (Fonts[font_i]->DynamicGlyphs && Fonts[font_i]->DynamicGlyphs->Requests.Size > 0)
+            return true;
+    return false;
+}
+
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
 {
     if (!font_config->MergeMode)
@@ -2810,6 +3699,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             atlas->Fonts[i]->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->BuildCount++;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -3121,6 +4011,7 @@ ImFont::ImFont()
     ConfigDataCount = 0;
     DirtyLookupTables = false;
     Scale = 1.0f;
+    DynamicGlyphs = NULL;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
@@ -3141,6 +4032,9 @@ void    ImFont::ClearOutputData()
     FallbackGlyph = NULL;
     ContainerAtlas = NULL;
     DirtyLookupTables = true;
+    if (DynamicGlyphs)
+        IM_DELETE(DynamicGlyphs);
+    DynamicGlyphs = NULL;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
 }
@@ -3164,10 +4058,23 @@ void ImFont::BuildLookupTable()
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
+    if (ContainerAtlas)
+        ContainerAtlas->BuildCount++;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
     GrowIndex(max_codepoint + 1);
+    if (DynamicGlyphs)
+    {
+        // Glyphs which can be rasterized on demand are measured with their own advance before they are
+        GrowIndex(DynamicGlyphs->AdvanceX.Size);
+        DynamicGlyphs->Slots.resize(Glyphs.Size, ImFontDynamicGlyph{ -1, 0, 0, 0, 0, 0, 0, 0, 0 });
+        for (int c = 0; c < DynamicGlyphs->AdvanceX.Size; c++)
+            if (DynamicGlyphs->AdvanceX[c] >= 0.0f)
+                IndexAdvanceX[c] = DynamicGlyphs->AdvanceX[c];
+    }
     for (int i = 0; i < Glyphs.Size; i++)
     {
+        if (DynamicGlyphs && DynamicGlyphs->Slots[i].LastUsedFrame == -2)
+            continue;
         int codepoint = (int)Glyphs[i].Codepoint;
         IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
         IndexLookup[codepoint] = (ImWchar)i;
@@ -3181,16 +4088,25 @@ void ImFont::BuildLookupTable()
     // FIXME: Needs proper TAB handling but it needs to be contextualized (or we could arbitrary say that each string starts at "column 0" ?)
     if (FindGlyph((ImWchar)' '))
     {
-        if (Glyphs.back().Codepoint != '\t')   // So we can call this function multiple times (FIXME: Flaky)
+        // Reuse the TAB glyph of a previous call, it is not necessarily the last glyph (glyphs rasterized on demand come after it)
+        int tab_glyph_index = FindGlyphNoFallback((ImWchar)'\t') ? (int)IndexLookup[(int)'\t'] : -1;
+        if (tab_glyph_index == -1)
+        {
+            tab_glyph_index = Glyphs.Size;
             Glyphs.resize(Glyphs.Size + 1);
-        ImFontGlyph& tab_glyph = Glyphs.back();
+        }
+        ImFontGlyph& tab_glyph = Glyphs[tab_glyph_index];
         tab_glyph = *FindGlyph((ImWchar)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= IM_TABSIZE;
         IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)(Glyphs.Size - 1);
+        IndexLookup[(int)tab_glyph.Codepoint] = (ImWchar)tab_glyph_index;
     }
 
+    // The TAB glyph may have been added: every glyph needs its slot before FindGlyph() is called on it
+    if (DynamicGlyphs)
+        DynamicGlyphs->Slots.resize(Glyphs.Size, ImFontDynamicGlyph{ -1, 0, 0, 0, 0, 0, 0, 0, 0 });
+
     // Mark special glyphs as not visible (note that AddGlyph already mark as non-visible glyphs with zero-size polygons)
     SetGlyphVisible((ImWchar)' ', false);
     SetGlyphVisible((ImWchar)'\t', false);
@@ -3220,7 +4136,7 @@ void ImFont::BuildLookupTable()
     }
 
     FallbackAdvanceX = FallbackGlyph->AdvanceX;
-    for (int i = 0; i < max_codepoint + 1; i++)
+    for (int i = 0; i < IndexAdvanceX.Size; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
 }
@@ -3293,11 +4209,9 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     glyph.V1 = v1;
     glyph.AdvanceX = advance_x;
 
-    // Compute rough surface usage metrics (+1 to account for average padding, +0.99 to round)
-    // We use (U1-U0)*TexWidth instead of X1-X0 to account for oversampling.
-    float pad = ContainerAtlas->TexGlyphPadding + 0.99f;
+    // Compute rough surface usage metrics
     DirtyLookupTables = true;
-    MetricsTotalSurface += (int)((glyph.U1 - glyph.U0) * ContainerAtlas->TexWidth + pad) * (int)((glyph.V1 - glyph.V0) * ContainerAtlas->TexHeight + pad);
+    MetricsTotalSurface += ImFontAtlasCalcGlyphSurface(ContainerAtlas, glyph);
 }
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
@@ -3321,7 +4235,14 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
         return FallbackGlyph;
     const ImWchar i = IndexLookup.Data[c];
     if (i == (ImWchar)-1)
+    {
+        // Rasterized by the next ImFontAtlas::UpdateDynamicGlyphs()
+        if (DynamicGlyphs)
+            DynamicGlyphs->Request(c);
         return FallbackGlyph;
+    }
+    if (DynamicGlyphs && DynamicGlyphs->Slots.Data[i].LastUsedFrame >= 0)
+        DynamicGlyphs->Slots.Data[i].LastUsedFrame = DynamicGlyphs->Frame;
     return &Glyphs.Data[i];
 }
 
@@ -3335,6 +4256,61 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     return &Glyphs.Data[i];
 }
 
+void ImFontGlyphUses::Add(const ImFont* font, ImWchar c)
+{
+    // Glyphs built with the atlas (and codepoints missing from the font) have nothing to update
+    if (!font->DynamicGlyphs->CanRasterize(c))
+        return;
+
+    // Few fonts per log, the last one is the most likely
+    int font_n = Fonts.Size - 1;
+    while (font_n >= 0 && Fonts.Data[font_n] != font)
+        font_n--;
+    if (font_n < 0)
+    {
+        font_n = Fonts.Size;
+        Fonts.push_back(font);
+    }
+    const ImGuiID key = ((ImGuiID)font_n << 21) | (ImGuiID)c;
+    int* logged = Logged.GetIntRef(key, 0);
+    if (*logged)
+        return;
+    *logged = 1;
+    ImFontGlyphUse use = { font, c };
+    Uses.push_back(use);
+}
+
+// Same as ImFont::FindGlyph() without updating the font: the glyph is logged in 'uses' when the font has glyphs rasterized on demand
+static inline const ImFontGlyph* ImFontFindGlyphLogged(const ImFont* font, ImFontGlyphUses* uses, ImWchar c)
+{
+    if (uses == NULL || font->DynamicGlyphs == NULL)
+        return font->FindGlyph(c);
+    if (uses->Uses.Size == 0 || uses->Uses.back().Font != font || uses->Uses.back().Codepoint != c)
+        uses->Add(font, c);
+    const ImFontGlyph* glyph = font->FindGlyphNoFallback(c);
+    return glyph ? glyph : font->FallbackGlyph;
+}
+
+// Update the fonts for glyphs logged through ImDrawListSharedData::GlyphUses (or drawn again from a cache), as ImFont::FindGlyph() would have, on the UI thread.
+// When 'shared' logs glyphs too (e.g. contents of a cached child window being recorded), they are logged there instead.
+// Returns true when some of them are not rasterized yet: they were drawn with the fallback glyph and are requested.
+bool ImFontMarkGlyphsUsed(const ImDrawListSharedData* shared, const ImFontGlyphUses& uses)
+{
+    ImFontGlyphUses* shared_uses = shared ? shared->GlyphUses : NULL;
+    bool requested = false;
+    for (int n = 0; n < uses.Uses.Size; n++)
+    {
+        const ImFontGlyphUse& use = uses.Uses[n];
+        if (use.Font->FindGlyphNoFallback(use.Codepoint) == NULL)
+            requested = true;
+        if (shared_uses)
+            shared_uses->Add(use.Font, use.Codepoint);
+        else
+            use.Font->FindGlyph(use.Codepoint);
+    }
+    return requested;
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -3361,35 +4337,52 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     const char* prev_word_end = NULL;
     bool inside_word = true;
 
+    // Runs of printable ASCII characters are found 16 bytes at a time and don't need decoding nor bounds checks
+    const bool ascii_lookup = IndexAdvanceX.Size >= 0x80;
+    const char* ascii_run_end = text;
+
     const char* s = text;
     while (s < text_end)
     {
-        unsigned int c = (unsigned int)*s;
+        unsigned int c = (unsigned int)(unsigned char)*s;
+        if (s >= ascii_run_end && ascii_lookup && c >= 32 && c < 0x80)
+            ascii_run_end = ImTextFindNonPrintableAscii(s + 1, text_end);
+
         const char* next_s;
-        if (c < 0x80)
+        float char_width;
+        if (s < ascii_run_end)
+        {
             next_s = s + 1;
+            char_width = IndexAdvanceX.Data[c];
+        }
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
-        if (c == 0)
-            break;
-
-        if (c < 32)
         {
-            if (c == '\n')
-            {
-                line_width = word_width = blank_width = 0.0f;
-                inside_word = true;
-                s = next_s;
-                continue;
-            }
-            if (c == '\r')
+            if (c < 0x80)
+                next_s = s + 1;
+            else
+                next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+            if (c == 0)
+                break;
+
+            if (c < 32)
             {
-                s = next_s;
-                continue;
+                if (c == '\n')
+                {
+                    line_width = word_width = blank_width = 0.0f;
+                    inside_word = true;
+                    s = next_s;
+                    continue;
+                }
+                if (c == '\r')
+                {
+                    s = next_s;
+                    continue;
+                }
             }
+
+            char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX.Data[c] : FallbackAdvanceX);
         if (ImCharIsBlankW(c))
         {
             if (inside_word)
@@ -3447,6 +4440,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
+    const bool ascii_lookup = IndexAdvanceX.Size >= 0x80;
 
     const char* s = text_begin;
     while (s < text_end)
@@ -3479,6 +4473,23 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Runs of printable ASCII characters are found 16 bytes at a time and measured without decoding nor bounds checks
+        if (ascii_lookup && (signed char)*s >= ' ')
+        {
+            const char* run_end = ImTextFindNonPrintableAscii(s + 1, word_wrap_enabled ? ImMin(word_wrap_eol, text_end) : text_end);
+            const float* advance_x = IndexAdvanceX.Data;
+            for (; s < run_end; s++)
+            {
+                const float char_width = advance_x[(unsigned char)*s] * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3528,10 +4539,42 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Write the 4 vertices of a glyph quad in the compact layout, each coordinate is converted once.
+static inline void ImFontWriteQuadCompact(ImDrawVert* vtx_write, const ImVec2& origin, float x1, float y1, float x2, float y2, float u1, float v1, float u2, float v2, ImU32 col)
+{
+#ifdef IMGUI_ENABLE_SSE
+    // Same rounding and clamping as ImDrawVert::EncodePos()/EncodeUV(), the 8 values at once
+    const __m128 zero = _mm_setzero_ps(), max = _mm_set1_ps(65535.0f);
+    __m128 pos = _mm_sub_ps(_mm_setr_ps(x1, x2, y1, y2), _mm_setr_ps(origin.x, origin.x, origin.y, origin.y));
+    pos = _mm_add_ps(_mm_mul_ps(pos, _mm_set1_ps(IM_DRAWVERT_POS_SCALE)), _mm_set1_ps(32768.5f));
+    __m128 uv = _mm_add_ps(_mm_mul_ps(_mm_setr_ps(u1, u2, v1, v2), max), _mm_set1_ps(0.5f));
+    const __m128i pos_i = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(pos, zero), max));
+    const __m128i uv_i = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(uv, zero), max));
+
+    // Both biased to signed 16-bit to be packed, the bias of the texture coordinates is removed after
+    const __m128i bias = _mm_set1_epi32(32768);
+    const __m128i packed = _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(pos_i, bias), _mm_sub_epi32(uv_i, bias)), _mm_setr_epi16(0, 0, 0, 0, -32768, -32768, -32768, -32768));
+    ImU16 c[8];
+    _mm_storeu_si128((__m128i*)c, packed);
+    const ImS16 px1 = (ImS16)c[0], px2 = (ImS16)c[1], py1 = (ImS16)c[2], py2 = (ImS16)c[3];
+    const ImU16 pu1 = c[4], pu2 = c[5], pv1 = c[6], pv2 = c[7];
+#else
+    const ImS16 px1 = ImDrawVert::EncodePos(x1 - origin.x), px2 = ImDrawVert::EncodePos(x2 - origin.x);
+    const ImS16 py1 = ImDrawVert::EncodePos(y1 - origin.y), py2 = ImDrawVert::EncodePos(y2 - origin.y);
+    const ImU16 pu1 = ImDrawVert::EncodeUV(u1), pu2 = ImDrawVert::EncodeUV(u2), pv1 = ImDrawVert::EncodeUV(v1), pv2 = ImDrawVert::EncodeUV(v2);
+#endif
+    vtx_write[0].pos[0] = px1; vtx_write[0].pos[1] = py1; vtx_write[0].col = col; vtx_write[0].uv[0] = pu1; vtx_write[0].uv[1] = pv1;
+    vtx_write[1].pos[0] = px2; vtx_write[1].pos[1] = py1; vtx_write[1].col = col; vtx_write[1].uv[0] = pu2; vtx_write[1].uv[1] = pv1;
+    vtx_write[2].pos[0] = px2; vtx_write[2].pos[1] = py2; vtx_write[2].col = col; vtx_write[2].uv[0] = pu2; vtx_write[2].uv[1] = pv2;
+    vtx_write[3].pos[0] = px1; vtx_write[3].pos[1] = py2; vtx_write[3].col = col; vtx_write[3].uv[0] = pu1; vtx_write[3].uv[1] = pv2;
+}
+#endif
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, ImWchar c) const
 {
-    const ImFontGlyph* glyph = FindGlyph(c);
+    const ImFontGlyph* glyph = ImFontFindGlyphLogged(this, draw_list->_Data->GlyphUses, c);
     if (!glyph || !glyph->Visible)
         return;
     if (glyph->Colored)
@@ -3598,8 +4641,14 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_current_idx = draw_list->_VtxCurrentIdx;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const ImVec2 origin = draw_list->VtxOrigin;
+#endif
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    const bool ascii_lookup = IndexLookup.Size >= 0x80;
+    const char* ascii_run_end = s;
+    ImFontGlyphUses* glyph_uses = draw_list->_Data->GlyphUses;
 
     while (s < text_end)
     {
@@ -3630,33 +4679,47 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         }
 
         // Decode and advance source
-        unsigned int c = (unsigned int)*s;
-        if (c < 0x80)
+        // Runs of printable ASCII characters are found 16 bytes at a time and looked up without decoding nor bounds checks
+        unsigned int c = (unsigned int)(unsigned char)*s;
+        if (s >= ascii_run_end && ascii_lookup && c >= 32 && c < 0x80)
+            ascii_run_end = ImTextFindNonPrintableAscii(s + 1, text_end);
+
+        const ImFontGlyph* glyph;
+        if (s < ascii_run_end)
         {
             s += 1;
+            const ImWchar glyph_index = IndexLookup.Data[c];
+            glyph = (glyph_index != (ImWchar)-1) ? &Glyphs.Data[glyph_index] : FallbackGlyph;
         }
         else
         {
-            s += ImTextCharFromUtf8(&c, s, text_end);
-            if (c == 0) // Malformed UTF-8?
-                break;
-        }
+            if (c < 0x80)
+            {
+                s += 1;
+            }
+            else
+            {
+                s += ImTextCharFromUtf8(&c, s, text_end);
+                if (c == 0) // Malformed UTF-8?
+                    break;
+            }
 
-        if (c < 32)
-        {
-            if (c == '\n')
+            if (c < 32)
             {
-                x = pos.x;
-                y += line_height;
-                if (y > clip_rect.w)
-                    break; // break out of main loop
-                continue;
+                if (c == '\n')
+                {
+                    x = pos.x;
+                    y += line_height;
+                    if (y > clip_rect.w)
+                        break; // break out of main loop
+                    continue;
+                }
+                if (c == '\r')
+                    continue;
             }
-            if (c == '\r')
-                continue;
-        }
 
-        const ImFontGlyph* glyph = FindGlyph((ImWchar)c);
+            glyph = ImFontFindGlyphLogged(this, glyph_uses, (ImWchar)c);
+        }
         if (glyph == NULL)
             continue;
 
@@ -3713,10 +4776,15 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                 {
                     idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                     idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                    IM_ASSERT(draw_list->_IsVtxPosEncodable(ImVec2(x1, y1)) && draw_list->_IsVtxPosEncodable(ImVec2(x2, y2)));
+                    ImFontWriteQuadCompact(vtx_write, origin, x1, y1, x2, y2, u1, v1, u2, v2, glyph_col);
+#else
                     vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
                     vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
                     vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
                     vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+#endif
                     vtx_write += 4;
                     vtx_current_idx += 4;
                     idx_write += 6;
@@ -3997,9 +5065,10 @@ static unsigned int stb_decompress_length(const unsigned char *input)
     return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *stb__barrier_out_e, *stb__barrier_out_b;
-static const unsigned char *stb__barrier_in_b;
-static unsigned char *stb__dout;
+// Thread local: an atlas may be built on a worker thread while another one adds compressed fonts on the UI thread
+static thread_local unsigned char *stb__barrier_out_e, *stb__barrier_out_b;
+static thread_local const unsigned char *stb__barrier_in_b;
+static thread_local unsigned char *stb__dout;
 static void stb__match(const unsigned char *data, unsigned int length)
 {
     // INVERSE of memmove... write each byte before copying the next...
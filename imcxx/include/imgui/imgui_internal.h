@@ -112,7 +112,10 @@ Index of this file:
 struct ImBitVector;                 // Store 1-bit per value
 struct ImRect;                      // An axis-aligned rectangle (2 points)
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
+struct ImDrawListArcCache;          // Unit circle points of recently drawn arcs, shared by the draw lists of a context
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImFontGlyphUse;              // Glyph of a font with ImFontConfig::DynamicGlyphs drawn without updating the font (see ImDrawListSharedData::GlyphUses)
+struct ImFontGlyphUses;             // Log of the glyphs rasterized on demand drawn without updating their font, each glyph once
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
 struct ImGuiContext;                // Main Dear ImGui context
 struct ImGuiContextHook;            // Hook for extensions like ImGuiTestEngine
@@ -142,6 +145,7 @@ struct ImGuiTableColumn;            // Storage for one column of a table
 struct ImGuiTableTempData;          // Temporary storage for one table (one per table in the stack), shared between tables.
 struct ImGuiTableSettings;          // Storage for a table .ini settings
 struct ImGuiTableColumnsSettings;   // Storage for a column .ini settings
+struct ImGuiTextSizeCache;          // Storage for CalcTextSize() results
 struct ImGuiWindow;                 // Storage for one window
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame, in practice we currently keep it for each window)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
@@ -307,6 +311,7 @@ namespace ImStb
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImU32 seed = 0);
+IMGUI_API ImU64         ImHashData64(const void* data, size_t data_size, ImU64 seed = 0);  // 64-bit hash of large buffers (change detection of draw lists), 64 bytes at a time with SSE2
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline ImGuiID   ImHash(const void* data, int size, ImU32 seed = 0) { return size ? ImHashData(data, (size_t)size, seed) : ImHashStr((const char*)data, 0, seed); } // [moved to ImHashStr/ImHashData in 1.68]
 #endif
@@ -354,6 +359,7 @@ IMGUI_API int           ImTextStrFromUtf8(ImWchar* out_buf, int out_buf_size, co
 IMGUI_API int           ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end);                                 // return number of UTF-8 code-points (NOT bytes count)
 IMGUI_API int           ImTextCountUtf8BytesFromChar(const char* in_text, const char* in_text_end);                             // return number of bytes to express one char in UTF-8
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                        // return number of bytes to express string in UTF-8
+IMGUI_API const char*   ImTextFindNonPrintableAscii(const char* in_text, const char* in_text_end);                         // return first byte which is a control character or part of a multi-byte character, or in_text_end. Scans 16/32 bytes at a time with SSE2/AVX2
 
 // Helpers: ImVec2/ImVec4 operators
 // We are keeping those disabled by default so they don't leak in user space, to allow user enabling implicit cast operators between ImVec2 and their own types (using IM_VEC2_CLASS_EXTRA etc.)
@@ -720,6 +726,35 @@ struct IMGUI_API ImChunkStream
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Number of arcs kept by ImDrawListArcCache.
+#ifndef IM_DRAWLIST_ARC_CACHE_SIZE
+#define IM_DRAWLIST_ARC_CACHE_SIZE                              64 // Least recently used arcs are replaced. Arcs of more than IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX segments are not cached.
+#endif
+
+// Unit circle points of an arc drawn by _PathArcToN(): AddNgon(), AddCircle() with explicit segments, PathArcTo() with explicit segments or beyond ArcFastRadiusCutoff.
+struct ImDrawListArcCacheEntry
+{
+    float           AMin, AMax;
+    int             NumSegments;                // 0: empty slot
+    ImU32           LastUse;
+    ImVector<ImVec2> Points;                    // NumSegments + 1 points (cos(a), sin(a))
+
+    ImDrawListArcCacheEntry() { AMin = AMax = 0.0f; NumSegments = 0; LastUse = 0; }
+};
+
+// Keyed by angles and segment count only: the same arc at any radius and position is scaled from the cached points instead of calling ImCos()/ImSin() per point.
+// Owned by the context, not thread-safe: draw lists recorded on other threads must use shared data with a NULL ArcCache.
+struct IMGUI_API ImDrawListArcCache
+{
+    ImDrawListArcCacheEntry Entries[IM_DRAWLIST_ARC_CACHE_SIZE];
+    ImU32           UseCounter;
+    int             LastHit;                    // Checked first, consecutive arcs are often the same (rows of identical widgets)
+
+    ImDrawListArcCache()    { UseCounter = 0; LastHit = 0; }
+    const ImVec2*   GetUnitArc(float a_min, float a_max, int num_segments); // NULL if the arc is not cacheable
+    void            Clear();
+};
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -737,6 +772,8 @@ struct IMGUI_API ImDrawListSharedData
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
+    ImDrawListArcCache* ArcCache;               // Unit arcs for _PathArcToN(), optional (NULL: points are computed each time)
+    ImFontGlyphUses* GlyphUses;                 // Glyphs of fonts with ImFontConfig::DynamicGlyphs are logged there instead of updating the fonts, for draw lists recorded outside of the UI thread (NULL: ImFont::FindGlyph())
 
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
@@ -752,6 +789,32 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// Cached CalcTextSize() result (see io.ConfigTextSizeCacheMaxEntries)
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64                   Key;                // Hash of the font, font size, wrap width and text. 0: empty slot
+    ImVec2                  Size;
+    int                     LastFrameUsed;
+    int                     LinesOffset;        // Wrapped text: first visual line in ImGuiTextSizeCache::Lines
+    int                     LinesCount;         // Wrapped text: number of visual lines. -1: not rendered yet, -2: rendered once (lines are computed the second time, texts shown for a single frame don't pay for it)
+};
+
+// Open addressing hash table with linear probing, kept at most half full
+struct ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Slots;    // Power of two size, or empty
+    ImVector<int>           Lines;              // Visual lines of wrapped texts, (begin, end) byte offsets pairs. Compacted when entries are evicted
+    int                     Count;
+    int                     Hits;               // Since the beginning of the frame
+    int                     Misses;             // Since the beginning of the frame
+    int                     LastFrameEvicted;   // Evict at most once per frame, if everything is in use the table stays full until the next frame
+    const ImFontAtlas*      FontAtlas;          // io.Fonts and its BuildCount when the entries were measured, NewFrame() clears the table when they change
+    int                     FontAtlasBuildCount;
+
+    ImGuiTextSizeCache()    { Count = Hits = Misses = 0; LastFrameEvicted = -1; FontAtlas = NULL; FontAtlasBuildCount = -1; }
+    void Clear()            { Slots.clear(); Lines.clear(); Count = 0; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -1729,6 +1792,7 @@ struct ImGuiContext
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize(). Text height for current window.
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Base text height.
     ImDrawListSharedData    DrawListSharedData;
+    ImDrawListArcCache      DrawListArcCache;                   // Pointed to by DrawListSharedData.ArcCache
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -1738,6 +1802,7 @@ struct ImGuiContext
     bool                    WithinFrameScopeWithImplicitWindow; // Set by NewFrame(), cleared by EndFrame() when the implicit debug window has been pushed
     bool                    WithinEndChild;                     // Set within EndChild()
     bool                    GcCompactAll;                       // Request full GC
+    ImGuiTextSizeCache      TextSizeCache;                      // CalcTextSize() results, when io.ConfigTextSizeCacheMaxEntries > 0
     bool                    TestEngineHookItems;                // Will call test engine hooks: ImGuiTestEngineHook_ItemAdd(), ImGuiTestEngineHook_ItemInfo(), ImGuiTestEngineHook_Log()
     void*                   TestEngine;                         // Test engine user data
 
@@ -1995,6 +2060,7 @@ struct ImGuiContext
         Font = NULL;
         FontSize = FontBaseSize = 0.0f;
         IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
+        DrawListSharedData.ArcCache = &DrawListArcCache;
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountPlatformEnded = FrameCountRendered = -1;
@@ -3023,6 +3089,7 @@ namespace ImGui
     IMGUI_API void          TabBarQueueReorderFromMousePos(ImGuiTabBar* tab_bar, const ImGuiTabItem* tab, ImVec2 mouse_pos);
     IMGUI_API bool          TabBarProcessReorder(ImGuiTabBar* tab_bar);
     IMGUI_API bool          TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open, ImGuiTabItemFlags flags, ImGuiWindow* docked_window);
+    IMGUI_API bool          TabItemEx(ImGuiTabBar* tab_bar, const char* label, ImGuiID id, bool* p_open, ImGuiTabItemFlags flags, ImGuiWindow* docked_window);
     IMGUI_API ImVec2        TabItemCalcSize(const char* label, bool has_close_button);
     IMGUI_API void          TabItemBackground(ImDrawList* draw_list, const ImRect& bb, ImGuiTabItemFlags flags, ImU32 col);
     IMGUI_API void          TabItemLabelAndCloseButton(ImDrawList* draw_list, const ImRect& bb, ImGuiTabItemFlags flags, ImVec2 frame_padding, const char* label, ImGuiID tab_id, ImGuiID close_button_id, bool is_contents_visible, bool* out_just_closed, bool* out_text_clipped);
@@ -3122,6 +3189,7 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
 
     // Garbage collection
+    IMGUI_API void          ClearTextSizeCache();                   // Call after changing glyph advances of a loaded font without rebuilding the atlas (NewFrame() clears the cache when io.Fonts->BuildCount changes)
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
     IMGUI_API void          GcAwakeTransientWindowBuffers(ImGuiWindow* window);
@@ -3163,6 +3231,48 @@ struct ImFontBuilderIO
     bool    (*FontBuilder_Build)(ImFontAtlas* atlas);
 };
 
+// Rasterized glyph of a font with ImFontConfig::DynamicGlyphs
+struct ImFontDynamicGlyph
+{
+    int             LastUsedFrame;      // ImFontDynamicGlyphs::Frame when ImFont::FindGlyph() (or ImFontMarkGlyphsUsed()) last returned the glyph. -1: built with the atlas, -2: evicted, the ImFont::Glyphs entry is free
+    unsigned short  X, Y, Width, Height;// Packed rectangle in the texture, padding included
+    unsigned short  TexelX0, TexelY0, TexelX1, TexelY1; // Texels of the glyph (ImFontGlyph::U0/V0/U1/V1) relative to X, Y: its UVs are computed again from them when the glyph is moved
+};
+
+// Glyphs of an ImFont rasterized on demand (see ImFontAtlas::UpdateDynamicGlyphs())
+struct ImFontDynamicGlyphs
+{
+    int                         Frame;          // Incremented by ImFontAtlas::UpdateDynamicGlyphs()
+    ImVector<ImFontDynamicGlyph> Slots;         // Parallel to ImFont::Glyphs
+    ImVector<float>             AdvanceX;       // Indexed by codepoint: advance of the glyphs which can be rasterized, -1.0f for the others. Copied to ImFont::IndexAdvanceX.
+    ImVector<int>               FreeGlyphs;     // Evicted entries of ImFont::Glyphs, reused by the next rasterized glyphs
+    ImVector<ImWchar>           Requests;       // Codepoints found missing since the last update
+    ImBitVector                 Requested;      // Same as Requests, by codepoint
+
+    ImFontDynamicGlyphs()       { Frame = 0; }
+    bool    CanRasterize(ImWchar c) const { return (int)c < AdvanceX.Size && AdvanceX.Data[c] >= 0.0f; }
+    void    Request(ImWchar c)  { if (CanRasterize(c) && !Requested.TestBit(c)) { Requested.SetBit(c); Requests.push_back(c); } }
+};
+
+// Glyph drawn with ImDrawListSharedData::GlyphUses set, see ImFontMarkGlyphsUsed(). Caches of draw commands keep them to mark their glyphs as used when drawn again.
+struct ImFontGlyphUse
+{
+    const ImFont*   Font;
+    ImWchar         Codepoint;
+};
+
+// Glyphs logged through ImDrawListSharedData::GlyphUses. Only the glyphs rasterized on demand (or to be) are logged, each of them once:
+// glyphs built with the atlas are never evicted nor requested, there is nothing to update for them.
+struct IMGUI_API ImFontGlyphUses
+{
+    ImVector<ImFontGlyphUse>    Uses;
+    ImVector<const ImFont*>     Fonts;          // Fonts of Uses, their index is part of the Logged keys
+    ImGuiStorage                Logged;         // (font index << 21 | codepoint) -> 1
+
+    void    Clear()             { Uses.resize(0); Fonts.resize(0); Logged.Data.resize(0); }
+    void    Add(const ImFont* font, ImWchar c);
+};
+
 // Helper for font builder
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 IMGUI_API const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype();
@@ -3175,6 +3285,7 @@ IMGUI_API void      ImFontAtlasBuildRender8bppRectFromString(ImFontAtlas* atlas,
 IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char, unsigned int in_marker_pixel_value);
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API bool      ImFontMarkGlyphsUsed(const ImDrawListSharedData* shared, const ImFontGlyphUses& uses);
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
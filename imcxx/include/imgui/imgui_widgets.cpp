@@ -1161,6 +1161,12 @@ bool ImGui::CheckboxFlagsT(const char* label, T* flags, T flags_value)
     return pressed;
 }
 
+// Instantiated for the types of the CheckboxFlags() overloads, so wrappers can call CheckboxFlagsT() directly with an "extern template" statement
+template IMGUI_API bool ImGui::CheckboxFlagsT<int>(const char* label, int* flags, int flags_value);
+template IMGUI_API bool ImGui::CheckboxFlagsT<unsigned int>(const char* label, unsigned int* flags, unsigned int flags_value);
+template IMGUI_API bool ImGui::CheckboxFlagsT<ImS64>(const char* label, ImS64* flags, ImS64 flags_value);
+template IMGUI_API bool ImGui::CheckboxFlagsT<ImU64>(const char* label, ImU64* flags, ImU64 flags_value);
+
 bool ImGui::CheckboxFlags(const char* label, int* flags, int flags_value)
 {
     return CheckboxFlagsT(label, flags, flags_value);
@@ -7962,6 +7968,14 @@ bool    ImGui::TabItemButton(const char* label, ImGuiTabItemFlags flags)
 }
 
 bool    ImGui::TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open, ImGuiTabItemFlags flags, ImGuiWindow* docked_window)
+{
+    ImGuiContext& g = *GImGui;
+    const ImGuiID id = g.CurrentWindow->SkipItems ? 0 : TabBarCalcTabID(tab_bar, label, docked_window);
+    return TabItemEx(tab_bar, label, id, p_open, flags, docked_window);
+}
+
+// 'id' is the ID TabBarCalcTabID() would return for 'label', e.g. precomputed by the caller
+bool    ImGui::TabItemEx(ImGuiTabBar* tab_bar, const char* label, ImGuiID id, bool* p_open, ImGuiTabItemFlags flags, ImGuiWindow* docked_window)
 {
     // Layout whole tab bar if not already done
     if (tab_bar->WantLayout)
@@ -7973,7 +7987,6 @@ bool    ImGui::TabItemEx(ImGuiTabBar* tab_bar, const char* label, bool* p_open,
         return false;
 
     const ImGuiStyle& style = g.Style;
-    const ImGuiID id = TabBarCalcTabID(tab_bar, label, docked_window);
 
     // If the user called us with *p_open == false, we early out and don't render.
     // We make a call to ItemAdd() so that attempts to use a contextual popup menu with an implicit ID won't use an older ID.
@@ -5,6 +5,9 @@
 //  [X] Renderer: User texture binding. Use 'LPDIRECT3DTEXTURE9' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Multi-viewport support. Enable with 'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'.
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Partial font texture updates for glyphs rasterized on demand (ImGuiBackendFlags_RendererHasTexUpdates).
+//  [X] Renderer: Vertex/index buffers kept per draw list, only draw lists whose content changed are uploaded (ImGuiBackendFlags_RendererReusesDrawLists).
+//  [X] Renderer: Compact vertices (IMGUI_USE_COMPACT_DRAWVERT) are uploaded as they are and decoded by a vertex shader. Requires D3DDTCAPS_UBYTE4N and D3DDTCAPS_USHORT2N.
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -13,6 +16,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2022-XX-XX: DirectX9: Upload compact vertices (IMGUI_USE_COMPACT_DRAWVERT) as they are, decode them in a vertex shader with a vertex declaration instead of converting them on the CPU.
+//  2022-XX-XX: DirectX9: Keep a vertex/index buffer pair per draw list and only upload the draw lists whose ImDrawList::ContentHash changed, enable ImGuiBackendFlags_RendererReusesDrawLists flag.
+//  2022-XX-XX: DirectX9: Upload io.Fonts->TexDirtyRects to the font texture, enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2022-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2021-06-29: Reorganized backend to pull data from a single structure to facilitate usage with multiple-contexts (all g_XXXX access changed to bd->XXXX).
 //  2021-06-25: DirectX9: Explicitly disable texture state stages after >= 1.
@@ -37,6 +43,21 @@
 // DirectX
 #include <d3d9.h>
 
+// Vertex/index buffers kept between frames for one draw list (ImGuiBackendFlags_RendererReusesDrawLists)
+struct ImGui_ImplDX9_ListBuffers
+{
+    const ImDrawList*           DrawList;
+    ImU64                       ContentHash;
+    bool                        Uploaded;
+    int                         LastFrame;
+    LPDIRECT3DVERTEXBUFFER9     pVB;
+    LPDIRECT3DINDEXBUFFER9      pIB;
+    int                         VertexBufferSize;
+    int                         IndexBufferSize;
+
+    ImGui_ImplDX9_ListBuffers() { memset(this, 0, sizeof(*this)); }
+};
+
 // DirectX data
 struct ImGui_ImplDX9_Data
 {
@@ -46,10 +67,26 @@ struct ImGui_ImplDX9_Data
     LPDIRECT3DTEXTURE9          FontTexture;
     int                         VertexBufferSize;
     int                         IndexBufferSize;
+    ImVector<ImGui_ImplDX9_ListBuffers*> ListBuffers;   // Sorted by ImDrawList pointer
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    LPDIRECT3DVERTEXDECLARATION9 VertexDeclaration;
+    LPDIRECT3DVERTEXSHADER9     VertexShader;
+#endif
 
-    ImGui_ImplDX9_Data()        { memset(this, 0, sizeof(*this)); VertexBufferSize = 5000; IndexBufferSize = 10000; }
+    ImGui_ImplDX9_Data()
+    {
+        pd3dDevice = NULL; pVB = NULL; pIB = NULL; FontTexture = NULL; VertexBufferSize = 5000; IndexBufferSize = 10000;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        VertexDeclaration = NULL; VertexShader = NULL;
+#endif
+    }
 };
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Compact vertices are uploaded as they are, our vertex shader decodes them (see ImGui_ImplDX9_CreateShaderObjects())
+typedef ImDrawVert CUSTOMVERTEX;
+#define D3DFVF_CUSTOMVERTEX 0
+#else
 struct CUSTOMVERTEX
 {
     float    pos[3];
@@ -57,6 +94,7 @@ struct CUSTOMVERTEX
     float    uv[2];
 };
 #define D3DFVF_CUSTOMVERTEX (D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1)
+#endif
 
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IMGUI_COL_TO_DX9_ARGB(_COL)     (_COL)
@@ -91,9 +129,15 @@ static void ImGui_ImplDX9_SetupRenderState(ImDrawData* draw_data)
     vp.MaxZ = 1.0f;
     bd->pd3dDevice->SetViewport(&vp);
 
-    // Setup render state: fixed-pipeline, alpha-blending, no face culling, no depth testing, shade mode (for gradient)
+    // Setup render state: fixed-pipeline (or our vertex shader for compact vertices), alpha-blending, no face culling, no depth testing, shade mode (for gradient)
     bd->pd3dDevice->SetPixelShader(NULL);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    bd->pd3dDevice->SetVertexShader(bd->VertexShader);
+    bd->pd3dDevice->SetVertexDeclaration(bd->VertexDeclaration);
+#else
     bd->pd3dDevice->SetVertexShader(NULL);
+    bd->pd3dDevice->SetFVF(D3DFVF_CUSTOMVERTEX);
+#endif
     bd->pd3dDevice->SetRenderState(D3DRS_FILLMODE, D3DFILL_SOLID);
     bd->pd3dDevice->SetRenderState(D3DRS_SHADEMODE, D3DSHADE_GOURAUD);
     bd->pd3dDevice->SetRenderState(D3DRS_ZWRITEENABLE, FALSE);
@@ -147,30 +191,292 @@ static void ImGui_ImplDX9_SetupRenderState(ImDrawData* draw_data)
     }
 }
 
-// Render function.
-void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Our vertex shader transforms the positions of a draw list with a single matrix: the decoding (VtxOrigin + pos / IM_DRAWVERT_POS_SCALE) then the projection above
+static void ImGui_ImplDX9_SetupVertexShaderConstants(ImDrawData* draw_data, const ImDrawList* cmd_list)
 {
-    // Avoid rendering when minimized
-    if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    float L = draw_data->DisplayPos.x + 0.5f;
+    float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x + 0.5f;
+    float T = draw_data->DisplayPos.y + 0.5f;
+    float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y + 0.5f;
+    const float scale = 1.0f / IM_DRAWVERT_POS_SCALE;
+    const ImVec2 origin = cmd_list->VtxOrigin;
+
+    // One row per output component (m4x4 computes dot products), the SHORT2 position is expanded to (x, y, 0, 1)
+    const float constants[4][4] =
+    {
+        { 2.0f*scale/(R-L), 0.0f,               0.0f,  2.0f*origin.x/(R-L) + (L+R)/(L-R) },
+        { 0.0f,             2.0f*scale/(T-B),   0.0f,  2.0f*origin.y/(T-B) + (T+B)/(B-T) },
+        { 0.0f,             0.0f,               0.0f,  0.5f },
+        { 0.0f,             0.0f,               0.0f,  1.0f },
+    };
+    bd->pd3dDevice->SetVertexShaderConstantF(0, &constants[0][0], 4);
+}
+#endif
+
+// Copy the rectangles of the atlas changed by ImFontAtlas::UpdateDynamicGlyphs() into the font texture
+static void ImGui_ImplDX9_UpdateFontsTexture()
+{
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexDirtyRects.Size == 0 || !bd->FontTexture || !atlas->TexPixelsRGBA32)
         return;
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+    {
+        const ImFontAtlasDirtyRect& r = atlas->TexDirtyRects[n];
+        RECT rect = { (LONG)r.X, (LONG)r.Y, (LONG)(r.X + r.Width), (LONG)(r.Y + r.Height) };
+        D3DLOCKED_RECT tex_locked_rect;
+        if (bd->FontTexture->LockRect(0, &tex_locked_rect, &rect, 0) != D3D_OK)
+            break;
+        for (int y = 0; y < r.Height; y++)
+        {
+            const ImU32* src = atlas->TexPixelsRGBA32 + r.X + (size_t)(r.Y + y) * atlas->TexWidth;
+            ImU32* dst = (ImU32*)((unsigned char*)tex_locked_rect.pBits + (size_t)tex_locked_rect.Pitch * y);
+#ifndef IMGUI_USE_BGRA_PACKED_COLOR
+            if (atlas->TexPixelsUseColors)
+            {
+                for (int x = 0; x < r.Width; x++)
+                    dst[x] = IMGUI_COL_TO_DX9_ARGB(src[x]);
+                continue;
+            }
+#endif
+            memcpy(dst, src, (size_t)r.Width * sizeof(ImU32));
+        }
+        bd->FontTexture->UnlockRect(0);
+    }
+    atlas->TexDirtyRects.resize(0);
+}
+
+// Convert the vertices of a draw list to our FVF vertex, convert colors to DX9 default format.
+// FIXME-OPT: This is a minor waste of resource, the ideal is to use imconfig.h and
+//  1) to avoid repacking colors:   #define IMGUI_USE_BGRA_PACKED_COLOR
+//  2) to avoid repacking vertices: #define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT struct ImDrawVert { ImVec2 pos; float z; ImU32 col; ImVec2 uv; }
+//     or #define IMGUI_USE_COMPACT_DRAWVERT, whose vertices are copied as they are.
+static void ImGui_ImplDX9_CopyVertices(CUSTOMVERTEX* vtx_dst, const ImDrawList* cmd_list)
+{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.size_in_bytes());
+#else
+    const ImDrawVert* vtx_src = cmd_list->VtxBuffer.Data;
+    for (int i = 0; i < cmd_list->VtxBuffer.Size; i++)
+    {
+        vtx_dst->pos[0] = vtx_src->pos.x;
+        vtx_dst->pos[1] = vtx_src->pos.y;
+        vtx_dst->pos[2] = 0.0f;
+        vtx_dst->col = IMGUI_COL_TO_DX9_ARGB(vtx_src->col);
+        vtx_dst->uv[0] = vtx_src->uv.x;
+        vtx_dst->uv[1] = vtx_src->uv.y;
+        vtx_dst++;
+        vtx_src++;
+    }
+#endif
+}
+
+// Whether a draw list is drawn from the shared vertex/index buffers rather than its own ones
+static bool ImGui_ImplDX9_UsesSharedBuffers(ImGui_ImplDX9_Data* bd, const ImDrawList* cmd_list, bool reuse_lists)
+{
+    if (!reuse_lists)
+        return true;
+    const ImGui_ImplDX9_ListBuffers* buffers = ImGui_ImplDX9_FindListBuffers(bd, cmd_list);
+    return buffers == NULL || !buffers->Uploaded;
+}
+
+// Copy the draw lists without buffers of their own (all of them when not reusing draw lists) into our shared vertex/index buffers, recreated every frame
+static bool ImGui_ImplDX9_UploadSharedLists(ImGui_ImplDX9_Data* bd, ImDrawData* draw_data, bool reuse_lists)
+{
+    int total_vtx_count = 0, total_idx_count = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        if (!ImGui_ImplDX9_UsesSharedBuffers(bd, cmd_list, reuse_lists))
+            continue;
+        total_vtx_count += cmd_list->VtxBuffer.Size;
+        total_idx_count += cmd_list->IdxBuffer.Size;
+    }
+    if (total_vtx_count == 0 || total_idx_count == 0)
+        return true;
 
     // Create and grow buffers if needed
-    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
-    if (!bd->pVB || bd->VertexBufferSize < draw_data->TotalVtxCount)
+    if (!bd->pVB || bd->VertexBufferSize < total_vtx_count)
     {
         if (bd->pVB) { bd->pVB->Release(); bd->pVB = NULL; }
-        bd->VertexBufferSize = draw_data->TotalVtxCount + 5000;
+        bd->VertexBufferSize = total_vtx_count + 5000;
         if (bd->pd3dDevice->CreateVertexBuffer(bd->VertexBufferSize * sizeof(CUSTOMVERTEX), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, D3DFVF_CUSTOMVERTEX, D3DPOOL_DEFAULT, &bd->pVB, NULL) < 0)
-            return;
+            return false;
     }
-    if (!bd->pIB || bd->IndexBufferSize < draw_data->TotalIdxCount)
+    if (!bd->pIB || bd->IndexBufferSize < total_idx_count)
     {
         if (bd->pIB) { bd->pIB->Release(); bd->pIB = NULL; }
-        bd->IndexBufferSize = draw_data->TotalIdxCount + 10000;
+        bd->IndexBufferSize = total_idx_count + 10000;
         if (bd->pd3dDevice->CreateIndexBuffer(bd->IndexBufferSize * sizeof(ImDrawIdx), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, sizeof(ImDrawIdx) == 2 ? D3DFMT_INDEX16 : D3DFMT_INDEX32, D3DPOOL_DEFAULT, &bd->pIB, NULL) < 0)
-            return;
+            return false;
+    }
+
+    // Allocate buffers
+    CUSTOMVERTEX* vtx_dst;
+    ImDrawIdx* idx_dst;
+    if (bd->pVB->Lock(0, (UINT)(total_vtx_count * sizeof(CUSTOMVERTEX)), (void**)&vtx_dst, D3DLOCK_DISCARD) < 0)
+        return false;
+    if (bd->pIB->Lock(0, (UINT)(total_idx_count * sizeof(ImDrawIdx)), (void**)&idx_dst, D3DLOCK_DISCARD) < 0)
+    {
+        bd->pVB->Unlock();
+        return false;
+    }
+
+    // Copy and convert all vertices into a single contiguous buffer
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        if (!ImGui_ImplDX9_UsesSharedBuffers(bd, cmd_list, reuse_lists))
+            continue;
+        ImGui_ImplDX9_CopyVertices(vtx_dst, cmd_list);
+        vtx_dst += cmd_list->VtxBuffer.Size;
+        memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        idx_dst += cmd_list->IdxBuffer.Size;
+    }
+    bd->pVB->Unlock();
+    bd->pIB->Unlock();
+    return true;
+}
+
+// Index of the first buffers whose draw list pointer is not less than 'draw_list' (binary search, ListBuffers is sorted by pointer)
+static int ImGui_ImplDX9_ListBuffersLowerBound(ImGui_ImplDX9_Data* bd, const ImDrawList* draw_list)
+{
+    int first = 0, count = bd->ListBuffers.Size;
+    while (count > 0)
+    {
+        const int half = count >> 1;
+        if ((size_t)bd->ListBuffers[first + half]->DrawList < (size_t)draw_list)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+            count = half;
+    }
+    return first;
+}
+
+static ImGui_ImplDX9_ListBuffers* ImGui_ImplDX9_FindListBuffers(ImGui_ImplDX9_Data* bd, const ImDrawList* draw_list)
+{
+    const int n = ImGui_ImplDX9_ListBuffersLowerBound(bd, draw_list);
+    return (n < bd->ListBuffers.Size && bd->ListBuffers[n]->DrawList == draw_list) ? bd->ListBuffers[n] : NULL;
+}
+
+static void ImGui_ImplDX9_ReleaseListBuffers(ImGui_ImplDX9_ListBuffers* buffers)
+{
+    if (buffers->pVB) { buffers->pVB->Release(); buffers->pVB = NULL; }
+    if (buffers->pIB) { buffers->pIB->Release(); buffers->pIB = NULL; }
+    buffers->Uploaded = false;
+}
+
+static void ImGui_ImplDX9_DestroyAllListBuffers(ImGui_ImplDX9_Data* bd)
+{
+    for (int n = 0; n < bd->ListBuffers.Size; n++)
+    {
+        ImGui_ImplDX9_ReleaseListBuffers(bd->ListBuffers[n]);
+        IM_DELETE(bd->ListBuffers[n]);
+    }
+    bd->ListBuffers.clear();
+}
+
+// Copy one draw list into its own vertex/index buffers, growing them if needed
+static bool ImGui_ImplDX9_UploadListBuffers(ImGui_ImplDX9_Data* bd, ImGui_ImplDX9_ListBuffers* buffers, const ImDrawList* cmd_list)
+{
+    const int vtx_count = cmd_list->VtxBuffer.Size;
+    const int idx_count = cmd_list->IdxBuffer.Size;
+    if (vtx_count == 0 || idx_count == 0)
+        return true;
+    if (!buffers->pVB || buffers->VertexBufferSize < vtx_count)
+    {
+        if (buffers->pVB) { buffers->pVB->Release(); buffers->pVB = NULL; }
+        buffers->VertexBufferSize = vtx_count + vtx_count / 4;
+        if (bd->pd3dDevice->CreateVertexBuffer(buffers->VertexBufferSize * sizeof(CUSTOMVERTEX), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, D3DFVF_CUSTOMVERTEX, D3DPOOL_DEFAULT, &buffers->pVB, NULL) < 0)
+            return false;
+    }
+    if (!buffers->pIB || buffers->IndexBufferSize < idx_count)
+    {
+        if (buffers->pIB) { buffers->pIB->Release(); buffers->pIB = NULL; }
+        buffers->IndexBufferSize = idx_count + idx_count / 4;
+        if (bd->pd3dDevice->CreateIndexBuffer(buffers->IndexBufferSize * sizeof(ImDrawIdx), D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY, sizeof(ImDrawIdx) == 2 ? D3DFMT_INDEX16 : D3DFMT_INDEX32, D3DPOOL_DEFAULT, &buffers->pIB, NULL) < 0)
+            return false;
+    }
+
+    CUSTOMVERTEX* vtx_dst;
+    ImDrawIdx* idx_dst;
+    if (buffers->pVB->Lock(0, (UINT)(vtx_count * sizeof(CUSTOMVERTEX)), (void**)&vtx_dst, D3DLOCK_DISCARD) < 0)
+        return false;
+    if (buffers->pIB->Lock(0, (UINT)(idx_count * sizeof(ImDrawIdx)), (void**)&idx_dst, D3DLOCK_DISCARD) < 0)
+    {
+        buffers->pVB->Unlock();
+        return false;
+    }
+    ImGui_ImplDX9_CopyVertices(vtx_dst, cmd_list);
+    memcpy(idx_dst, cmd_list->IdxBuffer.Data, idx_count * sizeof(ImDrawIdx));
+    buffers->pVB->Unlock();
+    buffers->pIB->Unlock();
+    return true;
+}
+
+// Upload the draw lists whose content hash changed into their own buffers, release the buffers of draw lists unused for a while
+// (We compare with the hash of our last upload rather than ImDrawList::ContentChanged, a draw list may skip a Render() or move to another viewport)
+// The draw lists whose buffers could not be uploaded are left to ImGui_ImplDX9_UploadSharedLists().
+static void ImGui_ImplDX9_UploadChangedLists(ImGui_ImplDX9_Data* bd, ImDrawData* draw_data)
+{
+    const int frame_count = ImGui::GetFrameCount();
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const int insert_n = ImGui_ImplDX9_ListBuffersLowerBound(bd, cmd_list);
+        ImGui_ImplDX9_ListBuffers* buffers = (insert_n < bd->ListBuffers.Size && bd->ListBuffers[insert_n]->DrawList == cmd_list) ? bd->ListBuffers[insert_n] : NULL;
+        if (buffers == NULL)
+        {
+            buffers = IM_NEW(ImGui_ImplDX9_ListBuffers)();
+            buffers->DrawList = cmd_list;
+            bd->ListBuffers.insert(bd->ListBuffers.Data + insert_n, buffers);
+        }
+        buffers->LastFrame = frame_count;
+        if (buffers->Uploaded && buffers->ContentHash == cmd_list->ContentHash)
+            continue;
+
+        buffers->ContentHash = cmd_list->ContentHash;
+        buffers->Uploaded = ImGui_ImplDX9_UploadListBuffers(bd, buffers, cmd_list);
     }
 
+    for (int n = 0; n < bd->ListBuffers.Size; n++)
+    {
+        ImGui_ImplDX9_ListBuffers* buffers = bd->ListBuffers[n];
+        if (frame_count - buffers->LastFrame < 60)
+            continue;
+        ImGui_ImplDX9_ReleaseListBuffers(buffers);
+        IM_DELETE(buffers);
+        bd->ListBuffers.erase(bd->ListBuffers.Data + n--);
+    }
+}
+
+// Render function.
+void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplDX9_UpdateFontsTexture();
+
+    // Avoid rendering when minimized
+    if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+        return;
+
+    // Upload vertices and indices: every draw list into shared buffers, or only the changed ones into their own buffers
+    // (When reusing draw lists, those whose own buffers could not be created still go through the shared buffers)
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    const bool reuse_lists = (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererReusesDrawLists) != 0;
+    if (reuse_lists)
+        ImGui_ImplDX9_UploadChangedLists(bd, draw_data);
+    if (!ImGui_ImplDX9_UploadSharedLists(bd, draw_data, reuse_lists))
+        return;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    if (!bd->VertexShader)
+        return;
+#endif
+
     // Backup the DX9 state
     IDirect3DStateBlock9* d3d9_state_block = NULL;
     if (bd->pd3dDevice->CreateStateBlock(D3DSBT_ALL, &d3d9_state_block) < 0)
@@ -187,60 +493,39 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
     bd->pd3dDevice->GetTransform(D3DTS_VIEW, &last_view);
     bd->pd3dDevice->GetTransform(D3DTS_PROJECTION, &last_projection);
 
-    // Allocate buffers
-    CUSTOMVERTEX* vtx_dst;
-    ImDrawIdx* idx_dst;
-    if (bd->pVB->Lock(0, (UINT)(draw_data->TotalVtxCount * sizeof(CUSTOMVERTEX)), (void**)&vtx_dst, D3DLOCK_DISCARD) < 0)
-    {
-        d3d9_state_block->Release();
-        return;
-    }
-    if (bd->pIB->Lock(0, (UINT)(draw_data->TotalIdxCount * sizeof(ImDrawIdx)), (void**)&idx_dst, D3DLOCK_DISCARD) < 0)
-    {
-        bd->pVB->Unlock();
-        d3d9_state_block->Release();
-        return;
-    }
-
-    // Copy and convert all vertices into a single contiguous buffer, convert colors to DX9 default format.
-    // FIXME-OPT: This is a minor waste of resource, the ideal is to use imconfig.h and
-    //  1) to avoid repacking colors:   #define IMGUI_USE_BGRA_PACKED_COLOR
-    //  2) to avoid repacking vertices: #define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT struct ImDrawVert { ImVec2 pos; float z; ImU32 col; ImVec2 uv; }
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
-    {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        const ImDrawVert* vtx_src = cmd_list->VtxBuffer.Data;
-        for (int i = 0; i < cmd_list->VtxBuffer.Size; i++)
-        {
-            vtx_dst->pos[0] = vtx_src->pos.x;
-            vtx_dst->pos[1] = vtx_src->pos.y;
-            vtx_dst->pos[2] = 0.0f;
-            vtx_dst->col = IMGUI_COL_TO_DX9_ARGB(vtx_src->col);
-            vtx_dst->uv[0] = vtx_src->uv.x;
-            vtx_dst->uv[1] = vtx_src->uv.y;
-            vtx_dst++;
-            vtx_src++;
-        }
-        memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-        idx_dst += cmd_list->IdxBuffer.Size;
-    }
-    bd->pVB->Unlock();
-    bd->pIB->Unlock();
-    bd->pd3dDevice->SetStreamSource(0, bd->pVB, 0, sizeof(CUSTOMVERTEX));
-    bd->pd3dDevice->SetIndices(bd->pIB);
-    bd->pd3dDevice->SetFVF(D3DFVF_CUSTOMVERTEX);
 
     // Setup desired DX state
     ImGui_ImplDX9_SetupRenderState(draw_data);
 
     // Render command lists
-    // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    // (When we merged buffers into a single one, we maintain our own offset into them)
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
     ImVec2 clip_off = draw_data->DisplayPos;
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const bool shared_buffers = ImGui_ImplDX9_UsesSharedBuffers(bd, cmd_list, reuse_lists);
+        int list_vtx_offset = global_vtx_offset;
+        int list_idx_offset = global_idx_offset;
+        if (shared_buffers)
+        {
+            bd->pd3dDevice->SetStreamSource(0, bd->pVB, 0, sizeof(CUSTOMVERTEX));
+            bd->pd3dDevice->SetIndices(bd->pIB);
+        }
+        else
+        {
+            ImGui_ImplDX9_ListBuffers* buffers = ImGui_ImplDX9_FindListBuffers(bd, cmd_list);
+            if (buffers->pVB)
+            {
+                bd->pd3dDevice->SetStreamSource(0, buffers->pVB, 0, sizeof(CUSTOMVERTEX));
+                bd->pd3dDevice->SetIndices(buffers->pIB);
+            }
+            list_vtx_offset = list_idx_offset = 0;
+        }
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        ImGui_ImplDX9_SetupVertexShaderConstants(draw_data, cmd_list);
+#endif
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
@@ -249,7 +534,12 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplDX9_SetupRenderState(draw_data);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                    ImGui_ImplDX9_SetupVertexShaderConstants(draw_data, cmd_list);
+#endif
+                }
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -266,16 +556,19 @@ void ImGui_ImplDX9_RenderDrawData(ImDrawData* draw_data)
                 const LPDIRECT3DTEXTURE9 texture = (LPDIRECT3DTEXTURE9)pcmd->GetTexID();
                 bd->pd3dDevice->SetTexture(0, texture);
                 bd->pd3dDevice->SetScissorRect(&r);
-                bd->pd3dDevice->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, pcmd->VtxOffset + global_vtx_offset, 0, (UINT)cmd_list->VtxBuffer.Size, pcmd->IdxOffset + global_idx_offset, pcmd->ElemCount / 3);
+                bd->pd3dDevice->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, pcmd->VtxOffset + list_vtx_offset, 0, (UINT)cmd_list->VtxBuffer.Size, pcmd->IdxOffset + list_idx_offset, pcmd->ElemCount / 3);
             }
         }
-        global_idx_offset += cmd_list->IdxBuffer.Size;
-        global_vtx_offset += cmd_list->VtxBuffer.Size;
+        if (shared_buffers)
+        {
+            global_idx_offset += cmd_list->IdxBuffer.Size;
+            global_vtx_offset += cmd_list->VtxBuffer.Size;
+        }
     }
 
     // When using multi-viewports, it appears that there's an odd logic in DirectX9 which prevent subsequent windows
     // from rendering until the first window submits at least one draw call, even once. That's our workaround. (see #2560)
-    if (global_vtx_offset == 0)
+    if (draw_data->TotalVtxCount == 0)
         bd->pd3dDevice->DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, 0, 0, 0, 0);
 
     // Restore the DX9 transform
@@ -299,6 +592,8 @@ bool ImGui_ImplDX9_Init(IDirect3DDevice9* device)
     io.BackendRendererName = "imgui_impl_dx9";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;  // We can create multi-viewports on the Renderer side (optional)
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can honor io.Fonts->TexDirtyRects, allowing for ImFontConfig::DynamicGlyphs.
+    io.BackendFlags |= ImGuiBackendFlags_RendererReusesDrawLists; // We keep buffers per draw list, only the draw lists whose ImDrawList::ContentHash changed are uploaded.
 
     bd->pd3dDevice = device;
     bd->pd3dDevice->AddRef();
@@ -365,11 +660,70 @@ static bool ImGui_ImplDX9_CreateFontsTexture()
     return true;
 }
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// The vertex declaration reads compact vertices as they are, the vertex shader decodes the positions with the constants set by ImGui_ImplDX9_SetupVertexShaderConstants()
+static bool ImGui_ImplDX9_CreateShaderObjects()
+{
+    ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
+    if (bd->VertexShader)
+        return true;
+
+    // Colors are read as 4 bytes in memory order (R, G, B, A), or as a D3DCOLOR when they are already packed that way
+#ifdef IMGUI_USE_BGRA_PACKED_COLOR
+    const BYTE col_type = D3DDECLTYPE_D3DCOLOR;
+#else
+    const BYTE col_type = D3DDECLTYPE_UBYTE4N;
+#endif
+    D3DCAPS9 caps;
+    if (bd->pd3dDevice->GetDeviceCaps(&caps) != D3D_OK || (caps.DeclTypes & (D3DDTCAPS_UBYTE4N | D3DDTCAPS_USHORT2N)) != (D3DDTCAPS_UBYTE4N | D3DDTCAPS_USHORT2N))
+        return false;
+    const D3DVERTEXELEMENT9 elements[] =
+    {
+        { 0, (WORD)IM_OFFSETOF(ImDrawVert, pos), D3DDECLTYPE_SHORT2,    D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_POSITION, 0 },
+        { 0, (WORD)IM_OFFSETOF(ImDrawVert, col), col_type,              D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_COLOR,    0 },
+        { 0, (WORD)IM_OFFSETOF(ImDrawVert, uv),  D3DDECLTYPE_USHORT2N,  D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, 0 },
+        D3DDECL_END()
+    };
+    if (bd->pd3dDevice->CreateVertexDeclaration(elements, &bd->VertexDeclaration) != D3D_OK)
+        return false;
+
+    // vs_1_1
+    // dcl_position v0
+    // dcl_color v1
+    // dcl_texcoord v2
+    // m4x4 oPos, v0, c0
+    // mov oD0, v1
+    // mov oT0, v2
+    static const DWORD vertex_shader[] =
+    {
+        0xFFFE0101,
+        0x0000001F, 0x80000000, 0x900F0000,
+        0x0000001F, 0x8000000A, 0x900F0001,
+        0x0000001F, 0x80000005, 0x900F0002,
+        0x00000014, 0xC00F0000, 0x90E40000, 0xA0E40000,
+        0x00000001, 0xD00F0000, 0x90E40001,
+        0x00000001, 0xE00F0000, 0x90E40002,
+        0x0000FFFF,
+    };
+    if (bd->pd3dDevice->CreateVertexShader(vertex_shader, &bd->VertexShader) != D3D_OK)
+    {
+        bd->VertexDeclaration->Release();
+        bd->VertexDeclaration = NULL;
+        return false;
+    }
+    return true;
+}
+#endif
+
 bool ImGui_ImplDX9_CreateDeviceObjects()
 {
     ImGui_ImplDX9_Data* bd = ImGui_ImplDX9_GetBackendData();
     if (!bd || !bd->pd3dDevice)
         return false;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    if (!ImGui_ImplDX9_CreateShaderObjects())
+        return false;
+#endif
     if (!ImGui_ImplDX9_CreateFontsTexture())
         return false;
     ImGui_ImplDX9_CreateDeviceObjectsForPlatformWindows();
@@ -383,6 +737,11 @@ void ImGui_ImplDX9_InvalidateDeviceObjects()
         return;
     if (bd->pVB) { bd->pVB->Release(); bd->pVB = NULL; }
     if (bd->pIB) { bd->pIB->Release(); bd->pIB = NULL; }
+    ImGui_ImplDX9_DestroyAllListBuffers(bd);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    if (bd->VertexShader) { bd->VertexShader->Release(); bd->VertexShader = NULL; }
+    if (bd->VertexDeclaration) { bd->VertexDeclaration->Release(); bd->VertexDeclaration = NULL; }
+#endif
     if (bd->FontTexture) { bd->FontTexture->Release(); bd->FontTexture = NULL; ImGui::GetIO().Fonts->SetTexID(NULL); } // We copied bd->pFontTextureView to io.Fonts->TexID so let's clear that as well.
     ImGui_ImplDX9_InvalidateDeviceObjectsForPlatformWindows();
 }
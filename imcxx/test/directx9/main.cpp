@@ -4,6 +4,7 @@
 
 
 #include <chrono>
+#include <cmath>
 #include "imgui/imcxx/all_in_one.hpp"
 #include "imgui/imcxx/misc/notification.hpp"
 #include "imgui/imcxx/misc/shortcut.hpp"
@@ -101,10 +102,20 @@ int main(int, char**)
     static uint64_t last_profile_0[60]{};
     int pos = 0; 
 
+    // Only render when an input, an animation or a redraw request needs a frame, other threads wake the loop with an empty message
+    imcxx::frame_scheduler scheduler{ [hwnd]() { ::PostMessage(hwnd, WM_NULL, 0, 0); } };
+
     // Main loop
     bool done = false;
     while (!done)
     {
+        scheduler.wait(
+            [](double timeout)
+            {
+                ::MsgWaitForMultipleObjects(0, NULL, FALSE, timeout < 0.0 ? INFINITE : (DWORD)std::ceil(timeout * 1000.0), QS_ALLINPUT);
+            }
+        );
+
         // Poll and handle messages (inputs, window resize, etc.)
         // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application.
@@ -0,0 +1,2220 @@
+// imcxx: headless behavior checks
+// Drives Dear ImGui through the null backend and compares the results of the optimized paths (caches, precomputed ids,
+// compact vertices, glyphs rasterized on demand...) with the plain ones. The benchmark (main.cpp) only measures them.
+//
+// usage: imcxx_checks [--list] [NAME...]
+//
+// Every check runs when no name is given. The exit code is the number of failed checks.
+
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <string.h>
+
+#include "imgui/imcxx/all_in_one.hpp"
+#include "imgui/imcxx/misc/console.hpp"
+#include "imgui/imcxx/misc/draw_recorder.hpp"
+#include "imgui/imcxx/misc/font_loader.hpp"
+#include "imgui/imcxx/misc/line_plot.hpp"
+#include "imgui/imcxx/misc/log_viewer.hpp"
+#include "imgui/imcxx/misc/scrolling_plot.hpp"
+#include "imgui/imcxx/misc/text_editor.hpp"
+
+#include "imgui_impl_null.h"
+#include "../software/imgui_impl_software.h"
+
+
+// Failures are counted for the current check, which goes on: the failed expressions of one check are all reported
+static int g_CheckFailures = 0;
+
+#define CHECK(_EXPR) do { if (!(_EXPR)) { fprintf(stderr, "  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #_EXPR); g_CheckFailures++; } } while (0)
+#define CHECK_EQ(_A, _B) do { if (!((_A) == (_B))) { fprintf(stderr, "  %s:%d: CHECK_EQ(%s, %s) failed: %g != %g\n", __FILE__, __LINE__, #_A, #_B, (double)(_A), (double)(_B)); g_CheckFailures++; } } while (0)
+
+// A Dear ImGui context with the null backend, destroyed with the object
+struct CheckContext
+{
+    CheckContext(const ImVec2& display_size = { 1280.f, 720.f }, bool install_renderer = true) :
+        HasRenderer(install_renderer)
+    {
+        IMGUI_CHECKVERSION();
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        ImGui::StyleColorsDark();
+        ImGui_ImplNull_Init(display_size, 1.0f / 60.0f, install_renderer);
+    }
+
+    ~CheckContext()
+    {
+        ImGui_ImplNull_Shutdown();
+        ImGui::DestroyContext();
+    }
+
+    CheckContext(const CheckContext&) = delete;
+    CheckContext& operator=(const CheckContext&) = delete;
+
+    // NewFrame(), 'submit', Render() and the null renderer when it is installed
+    void Frame(const std::function<void()>& submit)
+    {
+        ImGui_ImplNull_NewFrame();
+        ImGui::NewFrame();
+        submit();
+        ImGui::Render();
+        if (HasRenderer)
+            ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+    }
+
+    bool HasRenderer;
+};
+
+// Window covering the display, without decorations so its contents start at a known position
+static bool BeginFullscreenWindow(const char* name)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    return ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+}
+
+
+// Checks
+struct Check
+{
+    const char* Name;
+    const char* Description;
+    void        (*Run)();
+};
+
+static void CheckNullBackend()
+{
+    CheckContext ctx({ 800.f, 600.f });
+    ImGuiIO& io = ImGui::GetIO();
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Null"))
+                ImGui::TextUnformatted("Hello");
+            ImGui::End();
+        }
+    );
+    CHECK(io.DisplaySize.x == 800.f && io.DisplaySize.y == 600.f);
+    CHECK(io.DeltaTime == 1.0f / 60.0f);
+    CHECK(io.Fonts->TexID != nullptr);
+
+    // Every draw list is copied and every visible command reaches the renderer
+    const ImDrawData* draw_data = ImGui::GetDrawData();
+    const ImGui_ImplNull_RenderStats& stats = ImGui_ImplNull_GetRenderStats();
+    CHECK_EQ(stats.CmdListsCount, draw_data->CmdListsCount);
+    CHECK_EQ(stats.CmdListsUploaded, draw_data->CmdListsCount);
+    CHECK_EQ(stats.TotalVtxCount, draw_data->TotalVtxCount);
+    CHECK_EQ(stats.TotalIdxCount, draw_data->TotalIdxCount);
+    CHECK(stats.TotalVtxCount > 0);
+
+    int draw_calls = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        for (const ImDrawCmd& cmd : draw_data->CmdLists[n]->CmdBuffer)
+            if (!cmd.UserCallback && cmd.ClipRect.z > cmd.ClipRect.x && cmd.ClipRect.w > cmd.ClipRect.y)
+                draw_calls++;
+    CHECK_EQ(stats.DrawCalls, draw_calls);
+    CHECK(stats.BytesUploaded >= (size_t)draw_data->TotalVtxCount * sizeof(ImDrawVert) + (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx));
+
+    // Display size changes are applied on the next frame
+    ImGui_ImplNull_SetDisplaySize({ 640.f, 480.f });
+    ctx.Frame([]() {});
+    CHECK(io.DisplaySize.x == 640.f && io.DisplaySize.y == 480.f);
+}
+
+// Framebuffer of the software renderer with 'threads_count' threads, after the same frame
+static std::vector<ImU32> RenderSoftwareFrame(int threads_count)
+{
+    CheckContext ctx({ 256.f, 192.f }, false);
+    ImGui_ImplSoftware_Init(threads_count);
+    ImGui_ImplSoftware_SetClearColor(IM_COL32(0, 0, 64, 255));
+    for (int frame = 0; frame < 2; frame++)
+    {
+        ImGui_ImplSoftware_NewFrame();
+        ctx.Frame(
+            []()
+            {
+                ImGui::SetNextWindowPos({ 128.f, 0.f });
+                ImGui::SetNextWindowSize({ 128.f, 192.f });
+                if (ImGui::Begin("Software", nullptr, ImGuiWindowFlags_NoSavedSettings))
+                {
+                    ImGui::TextUnformatted("The quick brown fox jumps over the lazy dog");
+                    ImGui::Button("Button");
+                }
+                ImGui::End();
+
+                // Opaque shapes, one of them cut by a clip rect
+                ImDrawList* draw_list = ImGui::GetForegroundDrawList();
+                draw_list->AddRectFilled({ 10.f, 10.f }, { 20.f, 20.f }, IM_COL32(255, 0, 0, 255));
+                draw_list->PushClipRect({ 40.f, 40.f }, { 50.f, 50.f });
+                draw_list->AddRectFilled({ 30.f, 30.f }, { 60.f, 60.f }, IM_COL32(0, 255, 0, 255));
+                draw_list->PopClipRect();
+                draw_list->AddCircleFilled({ 64.f, 128.f }, 40.f, IM_COL32(255, 255, 255, 255));
+            }
+        );
+        ImGui_ImplSoftware_RenderDrawData(ImGui::GetDrawData());
+    }
+
+    std::vector<ImU32> framebuffer;
+    const ImU32* pixels;
+    int width, height;
+    if (ImGui_ImplSoftware_GetFramebuffer(&pixels, &width, &height) && width == 256 && height == 192)
+        framebuffer.assign(pixels, pixels + width * height);
+    ImGui_ImplSoftware_Shutdown();
+    return framebuffer;
+}
+
+static void CheckSoftwareRenderer()
+{
+    const std::vector<ImU32> single = RenderSoftwareFrame(1);
+    CHECK_EQ(single.size(), 256 * 192);
+    if (single.size() != 256 * 192)
+        return;
+
+    const auto pixel = [&](int x, int y) { return single[y * 256 + x]; };
+    CHECK(pixel(5, 5) == IM_COL32(0, 0, 64, 255));
+    CHECK(pixel(10, 10) == IM_COL32(255, 0, 0, 255));
+    CHECK(pixel(19, 19) == IM_COL32(255, 0, 0, 255));
+    CHECK(pixel(20, 20) == IM_COL32(0, 0, 64, 255));
+    CHECK(pixel(35, 35) == IM_COL32(0, 0, 64, 255));
+    CHECK(pixel(45, 45) == IM_COL32(0, 255, 0, 255));
+    CHECK(pixel(55, 55) == IM_COL32(0, 0, 64, 255));
+    CHECK(pixel(64, 128) == IM_COL32(255, 255, 255, 255));
+
+    // The window and its text are drawn: some pixels of the right half differ from the clear color
+    int drawn = 0;
+    for (int y = 0; y < 192; y++)
+        for (int x = 128; x < 256; x++)
+            drawn += pixel(x, y) != IM_COL32(0, 0, 64, 255);
+    CHECK(drawn > 128 * 192 / 2);
+
+    // Same pixels whatever the number of threads
+    CHECK(RenderSoftwareFrame(4) == single);
+    CHECK(RenderSoftwareFrame(7) == single);
+}
+
+static void CheckLabelId()
+{
+    using namespace imcxx::literals;
+    CheckContext ctx;
+
+    // Same hash as ImHashStr(), '##' and '###' handling included, with or without a seed
+    static const char* labels[] = { "", "Node", "Node##2", "Label###Id", "###", "##", "a#b##c###d###e", "\xC3\xA9t\xC3\xA9" };
+    static const ImGuiID seeds[] = { 0, 1, 0x12345678, 0xFFFFFFFF };
+    for (const char* label : labels)
+    {
+        CHECK_EQ(imcxx::hash_str(label), ImHashStr(label));
+        CHECK_EQ(imcxx::hash_str(label, strlen(label)), ImHashStr(label, strlen(label)));
+        for (ImGuiID seed : seeds)
+        {
+            CHECK_EQ(imcxx::hash_str(label, 0, seed), ImHashStr(label, 0, seed));
+            CHECK_EQ(imcxx::label_id(label, strlen(label)).get(seed), ImHashStr(label, 0, seed));
+        }
+    }
+
+    // Computed at compile time
+    static constexpr imcxx::label_id node_id = "Node"_id;
+    static constexpr ImGuiID node_hash = node_id.get();
+    static_assert(node_hash == imcxx::hash_str("Node"), "label_id and hash_str differ");
+    CHECK_EQ(node_hash, ImHashStr("Node"));
+
+    // Character buffers end at their first '\0'
+    char buffer[64] = "Buffer";
+    CHECK_EQ(imcxx::label_id(buffer).get(), ImHashStr("Buffer"));
+
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Ids"))
+            {
+                // Same identifiers as GetID() with the ID stack of the window
+                CHECK_EQ(node_id.get_id(), ImGui::GetID("Node"));
+                ImGui::PushID(42);
+                CHECK_EQ("Label###Id"_id.get_id(), ImGui::GetID("Label###Id"));
+                ImGui::PopID();
+
+                // ImGuiPopupFlags_AnyPopupId ignores the identifier
+                CHECK(!imcxx::popup::is_open("Popup"_id, ImGuiPopupFlags_AnyPopupId));
+                imcxx::popup::open("Popup"_id);
+                CHECK(imcxx::popup::is_open("Popup"_id));
+                CHECK(imcxx::popup::is_open("Other"_id, ImGuiPopupFlags_AnyPopupId));
+                CHECK(!imcxx::popup::is_open("Other"_id));
+            }
+            ImGui::End();
+        }
+    );
+
+    // Tab items: same tabs, selection, closing and ID stack in their contents as with the labels hashed by BeginTabItem()
+    static bool use_id;
+    static int step;
+    static bool open_b;
+    static std::vector<ImGuiID> ids;
+    const auto tabs = []()
+    {
+        if (BeginFullscreenWindow("Tabs"))
+        {
+            if (imcxx::tabbar bar{ "##tabs" })
+            {
+                const auto contents = []() { ids.push_back(ImGui::GetID("Inside")); };
+                const ImGuiTabItemFlags flags_a = step == 2 ? ImGuiTabItemFlags_SetSelected : 0;
+                const ImGuiTabItemFlags flags_b = step == 1 ? ImGuiTabItemFlags_SetSelected : 0;
+                if (use_id)
+                {
+                    bar.add_item("A"_id, nullptr, flags_a) << contents;
+                    imcxx::tabbar::item{ "B###b"_id, &open_b, flags_b } << contents;
+                }
+                else
+                {
+                    bar.add_item("A", nullptr, flags_a) << contents;
+                    imcxx::tabbar::item{ "B###b", &open_b, flags_b } << contents;
+                }
+                for (const ImGuiTabItem& tab : GImGui->CurrentTabBar->Tabs)
+                    ids.push_back(tab.ID);
+                ids.push_back(GImGui->CurrentTabBar->SelectedTabId);
+            }
+        }
+        ImGui::End();
+    };
+    // The first run creates the tab bar, the next ones start from the same state
+    std::vector<ImGuiID> hashed;
+    for (const bool id : { false, false, true })
+    {
+        use_id = id;
+        open_b = true;
+        ids.clear();
+        for (step = 0; step < 6; step++)
+        {
+            open_b = step < 4;
+            ctx.Frame(tabs);
+        }
+        if (!id)
+            hashed = ids;
+    }
+    CHECK(ids == hashed);
+    CHECK(std::find(hashed.begin(), hashed.end(), ImHashStr("B###b", 0, ImHashStr("##tabs", 0, ImHashStr("Tabs")))) != hashed.end());
+}
+
+static void CheckTableView()
+{
+    CheckContext ctx;
+    using view_type = imcxx::table_view<std::vector<int>>;
+    using sorter_type = imcxx::table_sorter<std::vector<int>>;
+    static std::vector<int> values;
+    static std::vector<size_t> drawn;
+    static std::vector<size_t> keys;
+    static size_t submitted;
+    static float scroll_y = 0.f;
+    static bool sorted = false;
+    static sorter_type sorter{ { [](const int& a, const int& b) { return a < b ? -1 : a > b ? 1 : 0; } } };
+    values.resize(100000);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = static_cast<int>((i * 7919) % 100003);
+
+    static const view_type::column_info columns[] =
+    {
+        { { "Value", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending }, [](const int& value, size_t index) { drawn.push_back(index); imcxx::text::call("%d", value); } },
+        { { "Index", ImGuiTableColumnFlags_NoSort }, [](const int&, size_t index) { imcxx::text::call("%zu", index); } },
+    };
+    const auto frame = []()
+    {
+        drawn.clear();
+        keys.clear();
+        if (BeginFullscreenWindow("TableView"))
+        {
+            view_type view{ "##view", values, columns, ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable, { 0.f, 400.f } };
+            if (view)
+            {
+                if (scroll_y >= 0.f)
+                    ImGui::SetScrollY(scroll_y);
+                view.setup(0, 1);
+                if (sorted)
+                    view.sort(sorter);
+                view.render([](const int&, size_t index) { keys.push_back(index); return index; });
+                submitted = view.submitted_rows();
+            }
+        }
+        ImGui::End();
+    };
+
+    // Only the visible rows are submitted, each of them once, in the order of the range
+    ctx.Frame(frame);
+    ctx.Frame(frame);
+    const float row_height = ImGui::GetTextLineHeight() + ImGui::GetStyle().CellPadding.y * 2.f;
+    const size_t visible = static_cast<size_t>(400.f / row_height);
+    CHECK(submitted >= visible - 1 && submitted <= visible + 2);
+    CHECK_EQ(drawn.size(), submitted);
+    CHECK(drawn == keys);
+    for (size_t n = 0; n < drawn.size(); n++)
+        CHECK_EQ(drawn[n], n);
+
+    scroll_y = row_height * 50000.f;
+    ctx.Frame(frame);
+    scroll_y = -1.f;
+    ctx.Frame(frame);
+    // Scrolled: the first row measures the height of the rows, then the rows under the scrolling position
+    CHECK(drawn.size() > 2 && drawn[0] == 0 && drawn[1] >= 49999 && drawn[1] <= 50001);
+    for (size_t n = 2; n < drawn.size(); n++)
+        CHECK_EQ(drawn[n], drawn[n - 1] + 1);
+
+    // Sorted: the rows of the largest values first, cells still receive their index in the range
+    sorted = true;
+    scroll_y = 0.f;
+    ctx.Frame(frame);
+    ctx.Frame(frame);
+    CHECK(!drawn.empty() && values[drawn.front()] == *std::max_element(values.begin(), values.end()));
+    for (size_t n = 1; n < drawn.size(); n++)
+        CHECK(values[drawn[n - 1]] >= values[drawn[n]]);
+}
+
+static void CheckTableSorter()
+{
+    std::vector<int> rows;
+    rows.reserve(20000);
+    for (int i = 0; i < 10000; i++)
+        rows.push_back((i * 7919) % 10007);
+
+    using sorter_type = imcxx::table_sorter<std::vector<int>>;
+    sorter_type sorter{ { [](const int& a, const int& b) { return a < b ? -1 : a > b ? 1 : 0; } }, 1 };
+    ImGuiTableColumnSortSpecs column_specs;
+    ImGuiTableSortSpecs specs;
+    specs.Specs = &column_specs;
+    specs.SpecsCount = 1;
+
+    const auto is_sorted = [&](bool descending)
+    {
+        const std::vector<size_t>& order = sorter.order();
+        if (order.size() != rows.size())
+            return false;
+        for (size_t n = 1; n < order.size(); n++)
+            if (descending ? rows[order[n - 1]] < rows[order[n]] : rows[order[n - 1]] > rows[order[n]])
+                return false;
+        return true;
+    };
+    const auto wait_sorted = [&]()
+    {
+        for (int n = 0; n < 1000 && sorter.is_sorting(); n++)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            sorter.update(rows, nullptr);
+        }
+    };
+
+    // Rows appended while sorting are merged once the sort completes
+    column_specs.SortDirection = ImGuiSortDirection_Ascending;
+    specs.SpecsDirty = true;
+    sorter.update(rows, &specs);
+    CHECK(sorter.is_sorting());
+    for (int i = 0; i < 100; i++)
+        rows.push_back(i * 97);
+    wait_sorted();
+    sorter.update(rows, nullptr);
+    CHECK(!sorter.is_sorting());
+    CHECK(is_sorted(false));
+
+    column_specs.SortDirection = ImGuiSortDirection_Descending;
+    specs.SpecsDirty = true;
+    sorter.update(rows, &specs);
+    wait_sorted();
+    CHECK(is_sorted(true));
+
+    // A sort that completes after the specs changed is discarded, the previous order stays until the new one is ready
+    column_specs.SortDirection = ImGuiSortDirection_Ascending;
+    specs.SpecsDirty = true;
+    sorter.update(rows, &specs);
+    CHECK(sorter.is_sorting());
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    column_specs.SortDirection = ImGuiSortDirection_Descending;
+    specs.SpecsDirty = true;
+    sorter.update(rows, &specs);
+    CHECK(sorter.is_sorting());
+    CHECK(is_sorted(true));
+    wait_sorted();
+    CHECK(!sorter.is_sorting());
+    CHECK(is_sorted(true));
+}
+
+static void CheckVariableClipper()
+{
+    CheckContext ctx;
+    static imcxx::variable_clipper clipper{ 20.f };
+    static std::vector<size_t> submitted;
+    static float scroll_y = 0.f;
+    const auto height_of = [](size_t index) { return 10.f + static_cast<float>(index % 7) * 5.f; };
+    static float (*item_height)(size_t) = +height_of;
+    const auto frame = []()
+    {
+        submitted.clear();
+        ImGui::SetNextWindowPos({ 0.f, 0.f });
+        ImGui::SetNextWindowSize({ 400.f, 300.f });
+        if (ImGui::Begin("Clipper", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings))
+        {
+            if (scroll_y >= 0.f)
+                ImGui::SetScrollY(scroll_y);
+            clipper.render(10000, [](size_t index) { submitted.push_back(index); ImGui::Dummy({ 10.f, item_height(index) }); });
+        }
+        ImGui::End();
+    };
+
+    // The visible items are measured, the others keep the estimated height
+    ctx.Frame(frame);
+    const float spacing = ImGui::GetStyle().ItemSpacing.y;
+    CHECK(!submitted.empty() && submitted.front() == 0);
+    CHECK(submitted.size() < 30);
+    CHECK_EQ(clipper.submitted(), submitted.size());
+    float expected = 0.f;
+    for (size_t n = 0; n < submitted.size(); n++)
+    {
+        CHECK(ImFabs(clipper.offset(n) - expected) < 0.01f);
+        expected += height_of(n) + spacing;
+    }
+    CHECK(ImFabs(clipper.total_height() - (expected + 20.f * static_cast<float>(10000 - submitted.size()))) < 0.5f);
+
+    // Scrolled to the offset of an item: the submitted items start with it (or the previous one, partly visible in the window padding)
+    scroll_y = clipper.offset(5000);
+    ctx.Frame(frame);
+    scroll_y = -1.f;
+    ctx.Frame(frame);
+    CHECK(submitted.size() > 2 && (submitted[0] == 5000 || (submitted[0] == 4999 && submitted[1] == 5000)));
+    for (size_t n = 1; n < submitted.size(); n++)
+        CHECK_EQ(submitted[n], submitted[n - 1] + 1);
+
+    // An invalidated item goes back to the estimated height
+    clipper.invalidate(0);
+    CHECK(ImFabs(clipper.offset(1) - 20.f) < 0.01f);
+}
+
+// Poll 'done' for up to 5 seconds, for the results of worker threads
+static bool WaitFor(const std::function<bool()>& done)
+{
+    for (int n = 0; n < 500; n++)
+    {
+        if (done())
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return done();
+}
+
+static void WriteFile(const char* path, const char* mode, const std::string& contents)
+{
+    if (FILE* f = fopen(path, mode))
+    {
+        fwrite(contents.data(), 1, contents.size(), f);
+        fclose(f);
+    }
+}
+
+static void CheckLogViewer()
+{
+    CheckContext ctx;
+    static const char* path = "imcxx_checks.log";
+    std::string lines;
+    for (int i = 0; i < 1000; i++)
+        lines += "line " + std::to_string(i) + (i % 2 ? "\r\n" : "\n");
+    WriteFile(path, "wb", lines);
+
+    static imcxx::misc::log_viewer* viewer;
+    imcxx::misc::log_viewer instance;
+    viewer = &instance;
+    CHECK(viewer->open(path));
+    CHECK(WaitFor([]() { return !viewer->is_indexing() && viewer->lines_count() == 1000; }));
+    CHECK_EQ(viewer->indexed_size(), lines.size());
+
+    // Lines appended to the file show up, a last line without line return included
+    WriteFile(path, "ab", "appended\nwithout line return");
+    CHECK(WaitFor([]() { return viewer->lines_count() == 1002; }));
+
+    // Following: the view sticks to the last line
+    static ImGuiWindow* child;
+    for (int frame = 0; frame < 3; frame++)
+    {
+        ctx.Frame(
+            []()
+            {
+                if (BeginFullscreenWindow("Log"))
+                {
+                    viewer->render("##log", { 0.f, 300.f });
+                    child = ImGui::GetCurrentWindow()->DC.ChildWindows.back();
+                }
+                ImGui::End();
+            }
+        );
+    }
+    CHECK(child->ScrollMax.y > 0.f && child->Scroll.y == child->ScrollMax.y);
+
+    // A truncated file is indexed again from the start
+    WriteFile(path, "wb", "first\nsecond\n");
+    CHECK(WaitFor([]() { return viewer->lines_count() == 2 && !viewer->is_indexing(); }));
+    CHECK_EQ(viewer->indexed_size(), 13);
+
+    viewer->close();
+    CHECK(!viewer->is_open());
+    remove(path);
+}
+
+static void CheckConsole()
+{
+    CheckContext ctx;
+    static imcxx::misc::console* console;
+    imcxx::misc::console instance{ 4096, 0 };
+    console = &instance;
+
+    // Messages with line breaks become one line per line break, a colored span keeps its color on every line
+    CHECK(console->push("single"));
+    CHECK(console->push("first\nsecond\nthird"));
+    CHECK(console->push("ends with a line break\n"));
+    CHECK(console->push({ { "[A]\n", 0xFF0000FF }, { "b\n\nc" } }));
+    console->drain();
+    CHECK_EQ(console->lines_count(), 1 + 3 + 1 + 4);
+
+    // Dropped when the ring is full, nothing is lost otherwise
+    std::string big(8192, 'x');
+    CHECK(!console->push(big));
+    CHECK_EQ(console->dropped(), 1);
+
+    // Every line takes one line height: the last line ends where the content size says
+    static ImGuiWindow* child;
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Console"))
+            {
+                console->render("##console", { 0.f, 0.f });
+                child = ImGui::GetCurrentWindow()->DC.ChildWindows.back();
+            }
+            ImGui::End();
+        }
+    );
+    const float line_height = ImGui::GetTextLineHeightWithSpacing();
+    const float content_height = child->DC.CursorMaxPos.y - child->DC.CursorStartPos.y;
+    CHECK(ImFabs(content_height - (9 * line_height - ImGui::GetStyle().ItemSpacing.y)) < 0.5f);
+}
+
+static const char* g_MeasuredTexts[] =
+{
+    "The quick brown fox jumps over the lazy dog",
+    "Label of a button##with a hidden identifier",
+    "Two lines of text\nand the second line, longer than the first",
+    "\xC3\x9Cn\xC3\xAF""c\xC3\xB6""d\xC3\xA9 text with accented letters",
+    "Tabulations\tand\tcontrol\x01characters",
+    "short",
+};
+static const float g_MeasuredWrapWidths[] = { -1.f, 0.f, 60.f, 150.f };
+
+// CalcTextSize() of every text and wrap width, with or without hiding the text after '##'
+static std::vector<ImVec2> MeasureTexts()
+{
+    std::vector<ImVec2> sizes;
+    for (const char* text : g_MeasuredTexts)
+        for (float wrap_width : g_MeasuredWrapWidths)
+            for (bool hide : { false, true })
+                sizes.push_back(ImGui::CalcTextSize(text, nullptr, hide, wrap_width));
+    return sizes;
+}
+
+static bool SameSizes(const std::vector<ImVec2>& a, const std::vector<ImVec2>& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t n = 0; n < a.size(); n++)
+        if (a[n].x != b[n].x || a[n].y != b[n].y)
+            return false;
+    return true;
+}
+
+static void CheckTextSizeCache()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiContext& g = *GImGui;
+    static std::vector<ImVec2> uncached, cached;
+    static int hits, misses;
+    const auto measure = [](std::vector<ImVec2>& sizes)
+    {
+        return [&sizes]()
+        {
+            sizes = MeasureTexts();
+            hits = GImGui->TextSizeCache.Hits;
+            misses = GImGui->TextSizeCache.Misses;
+        };
+    };
+
+    // Same sizes as without the cache: measured on the first frame, found on the next one (texts shorter than 16 bytes aren't cached,
+    // texts without '##' are measured once whether it is hidden or not)
+    ctx.Frame(measure(uncached));
+    io.ConfigTextSizeCacheMaxEntries = 1000;
+    ctx.Frame(measure(cached));
+    CHECK(SameSizes(cached, uncached));
+    CHECK(misses > 0 && hits + misses < (int)uncached.size());
+    const int cacheable = hits + misses, distinct = misses;
+    ctx.Frame(measure(cached));
+    CHECK(SameSizes(cached, uncached));
+    CHECK_EQ(misses, 0);
+    CHECK_EQ(hits, cacheable);
+    ctx.Frame([]() {});
+    CHECK_EQ(io.MetricsTextSizeCacheHits, cacheable);
+
+    // A table too small for the texts evicts entries, sizes stay the same
+    io.ConfigTextSizeCacheMaxEntries = 4;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ctx.Frame(measure(cached));
+        CHECK(SameSizes(cached, uncached));
+        CHECK(g.TextSizeCache.Count <= 4);
+    }
+
+    // A new build of the atlas clears the cache: here a glyph advance changes as if the font was rebuilt
+    io.ConfigTextSizeCacheMaxEntries = 1000;
+    ctx.Frame(measure(cached));
+    const std::vector<ImVec2> before = cached;
+    ImFont* font = io.Fonts->Fonts[0];
+    font->IndexAdvanceX['o'] += 3.f;
+    const_cast<ImFontGlyph*>(font->FindGlyph('o'))->AdvanceX += 3.f;
+    io.Fonts->BuildCount++;
+    ctx.Frame(measure(cached));
+    CHECK_EQ(misses, distinct);
+    io.ConfigTextSizeCacheMaxEntries = 0;
+    ctx.Frame(measure(uncached));
+    CHECK(SameSizes(cached, uncached));
+    CHECK(!SameSizes(cached, before));
+}
+
+// Deterministic pseudo-random numbers for the checks
+static ImU32 CheckRandom()
+{
+    static ImU32 state = 0x12345678u;
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+static void CheckAsciiFastPath()
+{
+    CheckContext ctx;
+    ctx.Frame([]() {});
+
+    // Same result as a byte at a time, at every alignment and length around the 16 and 32 bytes steps
+    char buffer[160];
+    for (int iteration = 0; iteration < 2000; iteration++)
+    {
+        const int length = (int)(CheckRandom() % 100);
+        const int offset = (int)(CheckRandom() % 33);
+        for (int n = 0; n < length; n++)
+            buffer[offset + n] = (char)(' ' + CheckRandom() % 95);
+        if (length > 0 && CheckRandom() % 4 != 0)
+        {
+            static const char stoppers[] = { '\n', '\t', '\x01', '\x80', '\xC3', '\xFF' };
+            buffer[offset + (int)(CheckRandom() % length)] = stoppers[CheckRandom() % IM_ARRAYSIZE(stoppers)];
+        }
+        const char* text = buffer + offset;
+        const char* expected = text;
+        while (expected < text + length && (signed char)*expected >= ' ')
+            expected++;
+        CHECK(ImTextFindNonPrintableAscii(text, text + length) == expected);
+    }
+
+    // Runs of ASCII characters measure the same as the characters one at a time, UTF-8 and tabulations in between
+    ImFont* font = ImGui::GetFont();
+    static const char* pieces[] = { "a", "Z", " ", "~", "0", "\t", "\xC3\xA9", "\xE2\x82\xAC", "The quick brown fox" };
+    for (int iteration = 0; iteration < 500; iteration++)
+    {
+        std::string text;
+        const int count = 1 + (int)(CheckRandom() % 40);
+        for (int n = 0; n < count; n++)
+            text += pieces[CheckRandom() % IM_ARRAYSIZE(pieces)];
+
+        for (float size : { 13.f, 20.f })
+        {
+            // Sums in the same order as CalcTextSizeA()
+            float width = 0.f;
+            const char* cut = nullptr;
+            const float max_width = 40.f + (float)(CheckRandom() % 200);
+            float cut_width = 0.f;
+            for (const char* c = text.c_str(); *c; )
+            {
+                const char* next = c + ImTextCountUtf8BytesFromChar(c, text.c_str() + text.size());
+                const float char_width = font->CalcTextSizeA(size, FLT_MAX, 0.f, c, next).x;
+                if (!cut && width + char_width >= max_width)
+                {
+                    cut = c;
+                    cut_width = width;
+                }
+                width += char_width;
+                c = next;
+            }
+            CHECK_EQ(font->CalcTextSizeA(size, FLT_MAX, 0.f, text.c_str()).x, width);
+
+            const char* remaining = nullptr;
+            const float measured = font->CalcTextSizeA(size, max_width, 0.f, text.c_str(), nullptr, &remaining).x;
+            CHECK(remaining == (cut ? cut : text.c_str() + text.size()));
+            CHECK_EQ(measured, cut ? cut_width : width);
+        }
+    }
+}
+
+// Vertices [begin, end) of two ranges of a draw list are the same, positions within 'tolerance'
+static bool SameVertices(const ImDrawList* draw_list, int a_begin, int b_begin, int count, float tolerance)
+{
+    for (int n = 0; n < count; n++)
+    {
+        const ImDrawVert& a = draw_list->VtxBuffer[a_begin + n];
+        const ImDrawVert& b = draw_list->VtxBuffer[b_begin + n];
+        const ImVec2 a_pos = draw_list->GetVtxPos(a), b_pos = draw_list->GetVtxPos(b);
+        const ImVec2 a_uv = draw_list->GetVtxUV(a), b_uv = draw_list->GetVtxUV(b);
+        if (ImFabs(a_pos.x - b_pos.x) > tolerance || ImFabs(a_pos.y - b_pos.y) > tolerance || a_uv.x != b_uv.x || a_uv.y != b_uv.y || a.col != b.col)
+            return false;
+    }
+    return true;
+}
+
+static void CheckRetainedText()
+{
+    CheckContext ctx;
+    static imcxx::retained_text text{ "Retained text, drawn from\nprebuilt glyph quads \xC3\xA9\t\xE2\x82\xAC" };
+    static int vertices[2], indices[2], first[2];
+    static bool same;
+    static ImU32 color;
+
+    // Same quads as AddText() at the same place, with the color of the frame, rebuilt with the text
+    for (int pass = 0; pass < 3; pass++)
+    {
+        color = pass == 1 ? IM_COL32(255, 0, 0, 128) : IM_COL32(255, 255, 255, 255);
+        if (pass == 2)
+            text.set("Other text\n\n  after an empty line");
+        for (int frame = 0; frame < 2; frame++)
+        {
+            ctx.Frame(
+                []()
+                {
+                    if (BeginFullscreenWindow("Retained"))
+                    {
+                        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                        for (int n = 0; n < 2; n++)
+                        {
+                            first[n] = draw_list->VtxBuffer.Size;
+                            const int idx_begin = draw_list->IdxBuffer.Size;
+                            if (n == 0)
+                                draw_list->AddText({ 100.f, 100.f }, color, text.str().c_str());
+                            else
+                                text.draw(draw_list, { 100.f, 100.f }, color);
+                            vertices[n] = draw_list->VtxBuffer.Size - first[n];
+                            indices[n] = draw_list->IdxBuffer.Size - idx_begin;
+                        }
+                        same = vertices[0] == vertices[1] && SameVertices(draw_list, first[0], first[1], vertices[0], 0.01f);
+                    }
+                    ImGui::End();
+                }
+            );
+            CHECK(vertices[0] > 0);
+            CHECK_EQ(vertices[1], vertices[0]);
+            CHECK_EQ(indices[1], indices[0]);
+            CHECK(same);
+        }
+    }
+
+    // Text item of the same size as TextUnformatted(), wrapped like TextWrapped()
+    static ImVec2 sizes[2];
+    ctx.Frame(
+        []()
+        {
+            ImGui::SetNextWindowPos({ 0.f, 0.f });
+            ImGui::SetNextWindowSize({ 120.f, 400.f });
+            if (ImGui::Begin("Wrapped", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings))
+            {
+                ImGui::TextWrapped("%s", text.str().c_str());
+                sizes[0] = ImGui::GetItemRectSize();
+                text.render(imcxx::text::wrapped{});
+                sizes[1] = ImGui::GetItemRectSize();
+            }
+            ImGui::End();
+        }
+    );
+    CHECK(sizes[0].x == sizes[1].x && sizes[0].y == sizes[1].y);
+    CHECK(sizes[0].y > 3 * ImGui::GetTextLineHeight());
+}
+
+static void CheckWrappedTextCache()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiContext& g = *GImGui;
+
+    // Random words, UTF-8 characters, runs of blanks and line returns
+    static std::vector<std::string> texts;
+    static const char* const pieces[] = { "word", "longerword", "\xC3\xA9t\xC3\xA9", "\xE2\x82\xAC", " ", "   ", "\n", "\n\n", "\t", "aVeryLongWordWithoutAnyBlankThatDoesNotFitOnALine" };
+    texts.clear();
+    for (int n = 0; n < 60; n++)
+    {
+        std::string text;
+        const int count = 4 + (int)(CheckRandom() % 60);
+        for (int piece = 0; piece < count; piece++)
+            text += pieces[CheckRandom() % IM_ARRAYSIZE(pieces)];
+        texts.push_back(std::move(text));
+    }
+
+    // Glyph quads of a scrolled window with the texts wrapped, some of them above or below the window. Without the cache,
+    // lines above the window are drawn too (their glyphs are culled horizontally only), only the visible quads are compared
+    static std::vector<ImDrawVert> vertices;
+    const auto render = []()
+    {
+        ImGui::SetNextWindowPos({ 0.f, 0.f });
+        ImGui::SetNextWindowSize({ 230.f, 500.f });
+        ImGui::SetNextWindowScroll({ 0.f, 900.f });
+        if (ImGui::Begin("Wrapped", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings))
+        {
+            const ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            const int vtx_begin = draw_list->VtxBuffer.Size;
+            for (size_t n = 0; n < texts.size(); n++)
+            {
+                if (n % 2)
+                {
+                    ImGui::TextWrapped("%s", texts[n].c_str());
+                }
+                else
+                {
+                    ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + 120.f);
+                    ImGui::TextUnformatted(texts[n].c_str(), texts[n].c_str() + texts[n].size());
+                    ImGui::PopTextWrapPos();
+                }
+            }
+            const ImRect clip_rect = ImGui::GetCurrentWindow()->InnerClipRect;
+            vertices.clear();
+            for (int quad = vtx_begin; quad + 4 <= draw_list->VtxBuffer.Size; quad += 4)
+                if (draw_list->GetVtxPos(draw_list->VtxBuffer[quad + 2]).y >= clip_rect.Min.y && draw_list->GetVtxPos(draw_list->VtxBuffer[quad]).y <= clip_rect.Max.y)
+                    vertices.insert(vertices.end(), draw_list->VtxBuffer.Data + quad, draw_list->VtxBuffer.Data + quad + 4);
+        }
+        ImGui::End();
+    };
+    const auto same = [](const std::vector<ImDrawVert>& a, const std::vector<ImDrawVert>& b)
+    {
+        return a.size() == b.size() && memcmp(a.data(), b.data(), a.size() * sizeof(ImDrawVert)) == 0;
+    };
+
+    ctx.Frame(render);
+    ctx.Frame(render);
+    const std::vector<ImDrawVert> uncached_vertices = vertices;
+    CHECK(uncached_vertices.size() > 1000);
+
+    // Measured on the first frame, lines computed on the second one and drawn from the cache on the next ones
+    io.ConfigTextSizeCacheMaxEntries = 1000;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ctx.Frame(render);
+        CHECK(same(vertices, uncached_vertices));
+    }
+    CHECK(g.TextSizeCache.Lines.Size > 0);
+
+    // Same output while entries are evicted and their lines compacted
+    io.ConfigTextSizeCacheMaxEntries = 16;
+    for (int frame = 0; frame < 4; frame++)
+    {
+        ctx.Frame(render);
+        CHECK(same(vertices, uncached_vertices));
+        CHECK(g.TextSizeCache.Count <= 16);
+    }
+}
+
+static void CheckTextEditor()
+{
+    CheckContext ctx;
+    static imcxx::misc::text_editor* editor;
+    imcxx::misc::text_editor instance{ "alpha beta\ngamma delta\nepsilon" };
+    editor = &instance;
+
+    // The second line is split between the original text and inserted pieces
+    editor->insert(15, "XY");
+    editor->insert(12, "\xC3\xA9");
+    CHECK(editor->line(1) == "g\xC3\xA9" "ammXYa delta");
+    CHECK_EQ(editor->lines_count(), 3);
+    const size_t line1 = editor->line_offset(1);
+    editor->set_cursor(line1 + 7, 2);
+
+    // Selection and cursor positions are the widths of the line prefixes
+    static ImGuiWindow* child;
+    for (int frame = 0; frame < 2; frame++)
+    {
+        ctx.Frame(
+            []()
+            {
+                if (BeginFullscreenWindow("Editor"))
+                {
+                    ImGui::SetNextWindowFocus();
+                    editor->render("##editor", { 0.f, 0.f });
+                    child = ImGui::GetCurrentWindow()->DC.ChildWindows.back();
+                }
+                ImGui::End();
+            }
+        );
+    }
+
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    const auto width_of = [&](const std::string& str) { return font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, str.c_str()).x; };
+    const ImVec2 origin = child->DC.CursorStartPos;
+
+    // Selection rectangles, in the order of the lines (compact vertices are rounded to 1/8 pixel)
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const float tolerance = 0.5f / IM_DRAWVERT_POS_SCALE + 0.01f;
+#else
+    const float tolerance = 0.01f;
+#endif
+    const ImU32 selection_col = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+    std::vector<ImRect> rects;
+    const ImDrawList* draw_list = child->DrawList;
+    for (int n = 0; n + 3 < draw_list->VtxBuffer.Size; n++)
+    {
+        if (draw_list->VtxBuffer[n].col != selection_col)
+            continue;
+        const ImVec2 pos = draw_list->GetVtxPos(draw_list->VtxBuffer[n]);
+        ImRect rect(pos, pos);
+        for (int k = 1; k < 4; k++)
+            rect.Add(draw_list->GetVtxPos(draw_list->VtxBuffer[n + k]));
+        rects.push_back(rect);
+        n += 3;
+    }
+    CHECK_EQ(rects.size(), 2);
+    if (rects.size() == 2)
+    {
+        CHECK(ImFabs(rects[0].Min.x - (origin.x + width_of("al"))) < tolerance);
+        CHECK(ImFabs(rects[0].Max.x - (origin.x + width_of(editor->line(0)) + font_size * 0.4f)) < tolerance);
+        CHECK(ImFabs(rects[1].Min.x - origin.x) < tolerance);
+        CHECK(ImFabs(rects[1].Max.x - (origin.x + width_of(editor->text(line1, 7)))) < tolerance);
+    }
+
+    // The text input position follows the cursor
+    ImGuiContext& g = *GImGui;
+    CHECK(g.PlatformImeData.WantVisible);
+    CHECK(ImFabs(g.PlatformImeData.InputPos.x - (origin.x + width_of(editor->text(line1, 7)) - 1.0f)) < 0.01f);
+    CHECK(ImFabs(g.PlatformImeData.InputPos.y - (origin.y + ImGui::GetTextLineHeight())) < 0.01f);
+}
+
+static void CheckStringInput()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Focus the field (active on the next frame, its text selected), move to the end of its text, then type one character per frame
+    static std::string field;
+    static std::pmr::string* arena_field;
+    const auto type = [&ctx, &io](const char* typed, auto&& on_key)
+    {
+        const int length = (int)strlen(typed);
+        for (int frame = 0; frame < length + 4; frame++)
+        {
+            if (frame == 2 || frame == 3)
+                io.AddKeyEvent(ImGuiKey_End, frame == 2);
+            else if (frame > 3)
+                io.AddInputCharacter(typed[frame - 4]);
+            static int focus_frame;
+            focus_frame = frame;
+            ctx.Frame(
+                []()
+                {
+                    if (BeginFullscreenWindow("Inputs"))
+                    {
+                        if (focus_frame == 0)
+                            ImGui::SetKeyboardFocusHere();
+                        if (arena_field)
+                            imcxx::input{ imcxx::input::multiline{}, "##arena", *arena_field };
+                        else
+                            imcxx::input{ imcxx::input::text{}, "##field", field };
+                    }
+                    ImGui::End();
+                }
+            );
+            on_key();
+        }
+    };
+
+    // Capacity == size as loaded from a file, it grows by the policy: at least twice, with 64 free bytes
+    std::string typed;
+    for (int n = 0; n < 200; n++)
+        typed += (char)('a' + n % 26);
+    field = "tcp://gateway-01.example.net:9000/session";
+    field.shrink_to_fit();
+    const std::string expected = field + typed;
+    size_t capacity = field.capacity();
+    int reallocations = 0;
+    bool grown_by_policy = true;
+    type(typed.c_str(),
+        [&]()
+        {
+            if (field.capacity() == capacity)
+                return;
+            grown_by_policy &= field.capacity() >= capacity * 2 && field.capacity() >= field.size() + 64;
+            capacity = field.capacity();
+            reallocations++;
+        }
+    );
+    CHECK(field == expected);
+    CHECK(grown_by_policy);
+    CHECK_EQ(reallocations, 3); // 41 -> 106 -> 212 -> 424 bytes for 241
+
+    // A std::pmr::string in a fixed buffer without heap fallback, through the multiline overload
+    alignas(std::max_align_t) static std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+    std::pmr::string arena_string{ "first line", &arena };
+    arena_field = &arena_string;
+    type("\nsecond line\nthird line", []() {});
+    arena_field = nullptr;
+    CHECK(arena_string == "first line\nsecond line\nthird line");
+}
+
+// Triangles of the draw data as drawn: the clip rect, texture and vertex of each index
+struct DrawnVertex
+{
+    ImVec4      ClipRect;
+    ImTextureID TextureId;
+    ImVec2      Pos;
+    ImVec2      UV;
+    ImU32       Col;
+};
+
+static void FlattenDrawList(const ImDrawList* draw_list, std::vector<DrawnVertex>& drawn)
+{
+    for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+    {
+        if (cmd.UserCallback)
+            continue;
+        for (unsigned int i = cmd.IdxOffset; i < cmd.IdxOffset + cmd.ElemCount; i++)
+        {
+            const ImDrawVert& vtx = draw_list->VtxBuffer[cmd.VtxOffset + draw_list->IdxBuffer[i]];
+            drawn.push_back({ cmd.ClipRect, cmd.GetTexID(), draw_list->GetVtxPos(vtx), draw_list->GetVtxUV(vtx), vtx.col });
+        }
+    }
+}
+
+static std::vector<DrawnVertex> FlattenDrawData(const ImDrawData* draw_data)
+{
+    std::vector<DrawnVertex> drawn;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        FlattenDrawList(draw_data->CmdLists[n], drawn);
+    return drawn;
+}
+
+static bool SameDrawnVertices(const std::vector<DrawnVertex>& a, const std::vector<DrawnVertex>& b, float tolerance)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t n = 0; n < a.size(); n++)
+    {
+        if (memcmp(&a[n].ClipRect, &b[n].ClipRect, sizeof(ImVec4)) != 0 || a[n].TextureId != b[n].TextureId || a[n].Col != b[n].Col)
+            return false;
+        if (ImFabs(a[n].Pos.x - b[n].Pos.x) > tolerance || ImFabs(a[n].Pos.y - b[n].Pos.y) > tolerance || a[n].UV.x != b[n].UV.x || a[n].UV.y != b[n].UV.y)
+            return false;
+    }
+    return true;
+}
+
+static void CheckDrawRecorder()
+{
+    CheckContext ctx;
+
+    // Recordings with the window clip rect or their own, spliced between widgets
+    static const imcxx::misc::draw_recorder::record_fn recordings[] =
+    {
+        [](ImDrawList& draw_list)
+        {
+            ImVec2 points[64];
+            for (int n = 0; n < IM_ARRAYSIZE(points); n++)
+                points[n] = { 40.f + n * 9.f, 200.f + 80.f * ImSin(n * 0.3f) };
+            draw_list.AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 200, 0, 255), ImDrawFlags_None, 2.5f);
+            draw_list.AddCircleFilled({ 300.f, 200.f }, 30.f, IM_COL32(0, 128, 255, 200));
+        },
+        [](ImDrawList& draw_list)
+        {
+            draw_list.AddText({ 50.f, 320.f }, IM_COL32_WHITE, "Recorded text, \xC3\xA9\xE2\x82\xAC");
+            draw_list.AddBezierCubic({ 50.f, 400.f }, { 150.f, 300.f }, { 250.f, 500.f }, { 350.f, 400.f }, IM_COL32(255, 0, 255, 255), 1.5f);
+        },
+        [](ImDrawList& draw_list)
+        {
+            draw_list.AddRectFilled({ 0.f, 0.f }, { 1000.f, 1000.f }, IM_COL32(40, 40, 40, 255), 8.f);
+            draw_list.AddRect({ 500.f, 500.f }, { 600.f, 560.f }, IM_COL32(255, 255, 255, 255), 4.f, ImDrawFlags_None, 3.f);
+        },
+    };
+    static imcxx::misc::draw_recorder* recorder;
+
+    const auto draw = []()
+    {
+        if (BeginFullscreenWindow("Recorded"))
+        {
+            size_t tickets[IM_ARRAYSIZE(recordings)];
+            if (recorder)
+            {
+                tickets[0] = recorder->record(recordings[0]);
+                tickets[1] = recorder->record(recordings[1]);
+                tickets[2] = recorder->record(recordings[2], { 450.f, 450.f }, { 650.f, 540.f });
+            }
+            for (int n = 0; n < IM_ARRAYSIZE(recordings); n++)
+            {
+                ImGui::Text("Widget %d", n);
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                if (recorder)
+                {
+                    recorder->splice(tickets[n]);
+                }
+                else
+                {
+                    // Same as a recording, on the UI thread
+                    const ImVec4 clip_rect = n == 2 ? ImVec4(450.f, 450.f, 650.f, 540.f) : draw_list->_CmdHeader.ClipRect;
+                    draw_list->PushClipRect({ clip_rect.x, clip_rect.y }, { clip_rect.z, clip_rect.w });
+                    recordings[n](*draw_list);
+                    draw_list->PopClipRect();
+                }
+            }
+            ImGui::Button("Last widget");
+        }
+        ImGui::End();
+    };
+
+    ctx.Frame(draw);
+    const std::vector<DrawnVertex> direct = FlattenDrawData(ImGui::GetDrawData());
+    CHECK(direct.size() > 1000);
+
+    // Same triangles whatever the number of workers: none (recorded in splice()), one or several
+    for (unsigned threads : { 0u, 1u, 4u })
+    {
+        imcxx::misc::draw_recorder instance{ threads };
+        recorder = &instance;
+        for (int frame = 0; frame < 3; frame++)
+        {
+            ctx.Frame(draw);
+            CHECK(SameDrawnVertices(FlattenDrawData(ImGui::GetDrawData()), direct, 0.0f));
+        }
+        recorder = nullptr;
+    }
+}
+
+static void CheckCachedChild()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+
+    // A host window at 'position' with a child whose contents are counted each time they are submitted
+    static imcxx::child_cache cache;
+    static bool use_cache;
+    static uint64_t version;
+    static ImVec2 position;
+    static int submits;
+    const auto draw = []()
+    {
+        ImGui::SetNextWindowPos(position);
+        ImGui::SetNextWindowSize({ 400.f, 300.f });
+        if (ImGui::Begin("Host", nullptr, ImGuiWindowFlags_NoSavedSettings))
+        {
+            ImGui::TextUnformatted("Above the child");
+            const auto contents = []()
+            {
+                submits++;
+                for (int n = 0; n < 20; n++)
+                    ImGui::Text("Legend entry %d", n);
+                ImGui::Button("Button");
+                const ImVec2 pos = ImGui::GetCursorScreenPos();
+                ImGui::GetWindowDrawList()->AddRectFilled(pos, { pos.x + 50.f, pos.y + 20.f }, IM_COL32(255, 0, 0, 255), 4.f);
+                ImGui::Dummy({ 600.f, 20.f });
+            };
+            if (use_cache)
+                imcxx::window::child{ imcxx::window::child::cached{ cache, version }, "##legend", { 0.f, 200.f }, true, ImGuiWindowFlags_HorizontalScrollbar } << contents;
+            else
+                imcxx::window::child{ "##legend", { 0.f, 200.f }, true, ImGuiWindowFlags_HorizontalScrollbar } << contents;
+            ImGui::TextUnformatted("Below the child");
+        }
+        ImGui::End();
+    };
+    const auto frame = [&ctx, &draw]()
+    {
+        ctx.Frame(draw);
+        return FlattenDrawData(ImGui::GetDrawData());
+    };
+
+    // Contents submitted every frame, at two positions
+    position = { 100.f, 50.f };
+    frame();
+    const std::vector<DrawnVertex> uncached_first = frame();
+    position = { 237.f, 121.f };
+    frame();
+    const std::vector<DrawnVertex> uncached_moved = frame();
+
+    // Recorded on the first frame, drawn again without submitting the contents on the next ones, moved with the host window
+    use_cache = true;
+    position = { 100.f, 50.f };
+    submits = 0;
+    CHECK(SameDrawnVertices(frame(), uncached_first, 0.01f));
+    CHECK_EQ(submits, 1);
+    CHECK(!cache.replayed());
+    for (int n = 0; n < 2; n++)
+    {
+        CHECK(SameDrawnVertices(frame(), uncached_first, 0.01f));
+        CHECK_EQ(submits, 1);
+        CHECK(cache.replayed());
+    }
+    position = { 237.f, 121.f };
+    CHECK(SameDrawnVertices(frame(), uncached_moved, 0.01f));
+    CHECK_EQ(submits, 1);
+
+    // The content size of the recorded frame is kept: the horizontal scrollbar of the child stays
+    CHECK(ImGui::FindWindowByName("Host")->DC.ChildWindows.Size == 1 && ImGui::FindWindowByName("Host")->DC.ChildWindows[0]->ScrollbarX);
+
+    // A new version is recorded again
+    version++;
+    frame();
+    CHECK_EQ(submits, 2);
+    frame();
+    CHECK_EQ(submits, 2);
+
+    // Contents are submitted while the child is hovered, and cached again once the mouse leaves
+    io.AddMousePosEvent(position.x + 50.f, position.y + 60.f);
+    frame();
+    frame();
+    CHECK_EQ(submits, 4);
+    CHECK(!cache.replayed());
+    io.AddMousePosEvent(-FLT_MAX, -FLT_MAX);
+    frame();
+    frame();
+    CHECK_EQ(submits, 5);
+    CHECK(cache.replayed());
+
+    // Contents crossing the 64k vertices of 16-bit indices: the long line reserves more vertices than it draws, so the
+    // recording starts a new vertex offset and still fits in the child draw list when it is drawn again
+    static imcxx::child_cache large_cache;
+    const auto draw_large = []()
+    {
+        ImGui::SetNextWindowPos({ 0.f, 0.f });
+        ImGui::SetNextWindowSize({ 400.f, 300.f });
+        if (ImGui::Begin("Large", nullptr, ImGuiWindowFlags_NoSavedSettings))
+        {
+            const auto contents = []()
+            {
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                const ImVec2 pos = ImGui::GetCursorScreenPos();
+                for (int n = 0; draw_list->_VtxCurrentIdx < 60000; n++)
+                    draw_list->AddRectFilled({ pos.x + n % 100, pos.y }, { pos.x + n % 100 + 2.f, pos.y + 2.f }, IM_COL32(n % 256, 0, 0, 255));
+                ImGui::TextUnformatted(std::string(4000, 'x').c_str());
+                draw_list->AddRectFilled({ pos.x, pos.y + 40.f }, { pos.x + 50.f, pos.y + 60.f }, IM_COL32(0, 255, 0, 255));
+                ImGui::TextUnformatted("After the new vertex offset");
+            };
+            if (use_cache)
+                imcxx::window::child{ imcxx::window::child::cached{ large_cache, 0 }, "##large", { 0.f, 200.f } } << contents;
+            else
+                imcxx::window::child{ "##large", { 0.f, 200.f } } << contents;
+        }
+        ImGui::End();
+    };
+    const auto large_frame = [&ctx, &draw_large]()
+    {
+        ctx.Frame(draw_large);
+        return FlattenDrawData(ImGui::GetDrawData());
+    };
+    use_cache = false;
+    large_frame();
+    const std::vector<DrawnVertex> uncached_large = large_frame();
+    const ImDrawList* child_draw_list = ImGui::FindWindowByName("Large")->DC.ChildWindows[0]->DrawList;
+    CHECK(child_draw_list->CmdBuffer.back().VtxOffset > 0 && child_draw_list->VtxBuffer.Size < (1 << 16));
+    use_cache = true;
+    CHECK(SameDrawnVertices(large_frame(), uncached_large, 0.01f));
+    CHECK(!large_cache.replayed());
+    CHECK(SameDrawnVertices(large_frame(), uncached_large, 0.01f));
+    CHECK(large_cache.replayed());
+}
+
+static void CheckFrameScheduler()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+
+    // 'wait()' records the timeout it would wait for instead of waiting, -2 when it didn't call the wait function
+    static int woken;
+    imcxx::frame_scheduler scheduler{ []() { woken++; } };
+    double waited = 0.0;
+    const auto wait = [&scheduler, &waited](const std::function<void()>& while_waiting = {})
+    {
+        waited = -2.0;
+        return scheduler.wait(
+            [&waited, &while_waiting](double timeout)
+            {
+                waited = timeout;
+                if (while_waiting)
+                    while_waiting();
+            }
+        );
+    };
+    static bool focus_input;
+    const auto frame = [&ctx]()
+    {
+        ctx.Frame(
+            []()
+            {
+                if (BeginFullscreenWindow("Scheduled"))
+                {
+                    static char buffer[64];
+                    if (focus_input)
+                        ImGui::SetKeyboardFocusHere();
+                    focus_input = false;
+                    ImGui::InputText("##input", buffer, sizeof(buffer));
+                    ImGui::Button("Button");
+                }
+                ImGui::End();
+            }
+        );
+    };
+
+    // The first frames are needed, then nothing changes: no limit on the wait
+    CHECK(!wait());
+    int needed = 0;
+    for (frame(); !wait() && needed < 10; frame())
+        needed++;
+    CHECK(needed < 10);
+    CHECK_EQ(waited, -1.0);
+
+    // An input event, the frame processing it, then 'settle_frames' frames
+    io.AddMousePosEvent(20.f, 20.f);
+    CHECK(!wait() && waited == -2.0);
+    for (int n = 0; n < scheduler.settle_frames + 1; n++)
+    {
+        frame();
+        CHECK(!wait());
+    }
+    frame();
+    CHECK(wait());
+
+    // 'max_idle' and requested redraws
+    scheduler.max_idle = 0.5;
+    CHECK(wait() && waited == 0.5);
+    scheduler.max_idle = -1.0;
+    imcxx::frame_scheduler::request_redraw();
+    CHECK(!wait());
+    CHECK(wait() && waited == -1.0);
+    imcxx::frame_scheduler::request_redraw(30.0);
+    CHECK(wait() && waited > 29.0 && waited <= 30.0);
+    imcxx::frame_scheduler::request_redraw();
+    CHECK(!wait());
+
+    // Requests go to the schedulers driving their context: not to the ones of another context, and not only to the last one constructed
+    ImGuiContext* context = ImGui::GetCurrentContext();
+    ImGuiContext* other_context = ImGui::CreateContext();
+    imcxx::frame_scheduler::request_redraw(0.0, other_context);
+    CHECK(wait() && waited == -1.0);
+    {
+        imcxx::frame_scheduler other;
+        imcxx::frame_scheduler::request_redraw();
+        CHECK(!wait());
+    }
+    ImGui::DestroyContext(other_context);
+    imcxx::frame_scheduler::request_redraw();
+    CHECK(!wait());
+
+    // A request from another thread while waiting wakes the wait, and is consumed by it
+    CHECK(wait([context]() { std::thread([context]() { imcxx::frame_scheduler::request_redraw(0.0, context); }).join(); }));
+    CHECK_EQ(woken, 1);
+    CHECK(wait() && waited == -1.0);
+    imcxx::frame_scheduler::request_redraw();
+    CHECK_EQ(woken, 1);
+    CHECK(!wait());
+
+    // Frames are needed while a mouse button is held
+    io.AddMouseButtonEvent(0, true);
+    for (int n = 0; n < 5; n++)
+    {
+        CHECK(!wait());
+        frame();
+    }
+    io.AddMouseButtonEvent(0, false);
+    needed = 0;
+    for (frame(); !wait() && needed < 10; frame())
+        needed++;
+    CHECK(needed < 10);
+
+    // An active text input only needs the frames of its blinking cursor
+    focus_input = true;
+    needed = 0;
+    for (frame(); !wait() && needed < 10; frame())
+        needed++;
+    CHECK(needed < 10);
+    CHECK(GImGui->ActiveId != 0 && GImGui->ActiveId == GImGui->InputTextState.ID);
+    CHECK(waited > 0.0 && waited <= 0.30 + 0.81); // The cursor stays visible 0.3s longer after activation
+}
+
+static void CheckDrawListReuse()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+
+    // A window drawing the same thing every frame, another one showing 'counter', padding bytes of the draw commands set to 'padding'
+    static int counter;
+    static unsigned char padding;
+    const auto draw = []()
+    {
+        ImGui::SetNextWindowPos({ 0.f, 0.f });
+        if (ImGui::Begin("Static", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize))
+            ImGui::TextUnformatted("Always the same text");
+        ImGui::End();
+        ImGui::SetNextWindowPos({ 400.f, 0.f });
+        if (ImGui::Begin("Counter", nullptr, ImGuiWindowFlags_NoSavedSettings))
+        {
+            ImGui::Text("Counter: %d", counter);
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            const size_t padding_begin = IM_OFFSETOF(ImDrawCmd, ElemCount) + sizeof(unsigned int), padding_end = IM_OFFSETOF(ImDrawCmd, UserCallback);
+            for (ImDrawCmd& cmd : draw_list->CmdBuffer)
+                if (padding_end > padding_begin)
+                    memset(reinterpret_cast<char*>(&cmd) + padding_begin, padding, padding_end - padding_begin);
+        }
+        ImGui::End();
+    };
+    const auto changed_lists = []()
+    {
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        int changed = 0;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+            changed += draw_data->CmdLists[n]->ContentChanged ? 1 : 0;
+        CHECK_EQ(changed, draw_data->ChangedListsCount);
+        return changed;
+    };
+
+    // Without reuse every list is changed and uploaded
+    for (int frame = 0; frame < 3; frame++)
+        ctx.Frame(draw);
+    const ImGui_ImplNull_RenderStats& stats = ImGui_ImplNull_GetRenderStats();
+    CHECK(stats.CmdListsCount >= 2);
+    CHECK_EQ(changed_lists(), stats.CmdListsCount);
+    CHECK_EQ(stats.CmdListsUploaded, stats.CmdListsCount);
+
+    // With reuse, lists are uploaded once, then only when their contents change
+    ImGui_ImplNull_SetReuseDrawLists(true);
+    CHECK(io.BackendFlags & ImGuiBackendFlags_RendererReusesDrawLists);
+    ctx.Frame(draw);
+    CHECK_EQ(stats.CmdListsUploaded, stats.CmdListsCount);
+    for (int frame = 0; frame < 2; frame++)
+    {
+        ctx.Frame(draw);
+        CHECK_EQ(changed_lists(), 0);
+        CHECK_EQ(stats.CmdListsUploaded, 0);
+        CHECK_EQ(stats.BytesUploaded, 0);
+    }
+    counter++;
+    ctx.Frame(draw);
+    CHECK_EQ(changed_lists(), 1);
+    CHECK_EQ(stats.CmdListsUploaded, 1);
+    CHECK(ImGui::FindWindowByName("Counter")->DrawList->ContentChanged);
+    CHECK(!ImGui::FindWindowByName("Static")->DrawList->ContentChanged);
+
+    // Padding of the draw commands isn't part of their hash
+    padding = 0xA5;
+    ctx.Frame(draw);
+    CHECK_EQ(changed_lists(), 0);
+    CHECK_EQ(stats.CmdListsUploaded, 0);
+
+    ImGui_ImplNull_SetReuseDrawLists(false);
+    ctx.Frame(draw);
+    CHECK_EQ(stats.CmdListsUploaded, stats.CmdListsCount);
+}
+
+static void CheckCompactVertices()
+{
+    CheckContext ctx;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const float pos_step = 1.0f / IM_DRAWVERT_POS_SCALE, uv_step = 1.0f / 65535.0f;
+#else
+    const float pos_step = 0.0f, uv_step = 0.0f;
+#endif
+
+    // Positions round trip to the nearest 1/8 pixel and texture coordinates to the nearest 1/65535 around VtxOrigin
+    static ImDrawList* draw_list;
+    static ImVec2 origin;
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Vertices"))
+            {
+                draw_list = ImGui::GetWindowDrawList();
+                origin = draw_list->VtxOrigin;
+            }
+            ImGui::End();
+        }
+    );
+    static const ImVec2 offsets[] = { { 0.f, 0.f }, { 0.0625f, -0.0625f }, { 123.4567f, -987.6543f }, { -4000.3f, 4000.7f }, { 4095.f, -4095.f } };
+    static const ImVec2 uvs[] = { { 0.f, 0.f }, { 1.f, 1.f }, { 0.5f, 0.25f }, { 1.f / 3.f, 2.f / 3.f }, { 0.99999f, 0.00001f } };
+    for (int n = 0; n < IM_ARRAYSIZE(offsets); n++)
+    {
+        const ImVec2 pos(origin.x + offsets[n].x, origin.y + offsets[n].y);
+        ImDrawVert vtx;
+        draw_list->_WriteVtx(&vtx, pos, uvs[n], IM_COL32(1, 2, 3, 4));
+        const ImVec2 decoded_pos = draw_list->GetVtxPos(vtx);
+        const ImVec2 decoded_uv = draw_list->GetVtxUV(vtx);
+        CHECK(ImFabs(decoded_pos.x - pos.x) <= pos_step * 0.5f + 1e-3f);
+        CHECK(ImFabs(decoded_pos.y - pos.y) <= pos_step * 0.5f + 1e-3f);
+        CHECK(ImFabs(decoded_uv.x - uvs[n].x) <= uv_step * 0.5f + 1e-6f);
+        CHECK(ImFabs(decoded_uv.y - uvs[n].y) <= uv_step * 0.5f + 1e-6f);
+        CHECK_EQ(vtx.col, IM_COL32(1, 2, 3, 4));
+    }
+
+    // Axis-aligned shapes reaching far out of the range (tall tables, large scrolled backgrounds) are cut instead of clamped:
+    // the visible part is the same, and no vertex asserts in debug builds
+    static ImVec2 far_min, far_max;
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Vertices"))
+            {
+                draw_list = ImGui::GetWindowDrawList();
+                const ImVec2 o = draw_list->VtxOrigin;
+                const int vtx_begin = draw_list->VtxBuffer.Size;
+                draw_list->AddLine({ o.x - 100.f, o.y - 100.f }, { o.x - 100.f, o.y + 60000.f }, IM_COL32_WHITE);
+                draw_list->AddRect({ o.x - 20000.f, o.y - 50.f }, { o.x + 20000.f, o.y + 50.f }, IM_COL32_WHITE, 4.f);
+                draw_list->AddRectFilled({ o.x - 60.f, o.y - 60000.f }, { o.x + 60.f, o.y + 60000.f }, IM_COL32_WHITE);
+                far_min = ImVec2(FLT_MAX, FLT_MAX);
+                far_max = ImVec2(-FLT_MAX, -FLT_MAX);
+                for (int n = vtx_begin; n < draw_list->VtxBuffer.Size; n++)
+                {
+                    const ImVec2 pos = draw_list->GetVtxPos(draw_list->VtxBuffer[n]);
+                    far_min = ImMin(far_min, ImVec2(pos.x - o.x, pos.y - o.y));
+                    far_max = ImMax(far_max, ImVec2(pos.x - o.x, pos.y - o.y));
+                }
+            }
+            ImGui::End();
+        }
+    );
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    CHECK(far_min.x > -IM_DRAWVERT_POS_RANGE && far_min.y > -IM_DRAWVERT_POS_RANGE);
+    CHECK(far_max.x < IM_DRAWVERT_POS_RANGE && far_max.y < IM_DRAWVERT_POS_RANGE);
+    CHECK(far_max.y > IM_DRAWVERT_POS_RANGE - 16.f);
+#else
+    CHECK(far_max.y >= 60000.f);
+#endif
+}
+
+static void CheckArcCache()
+{
+    CheckContext ctx;
+    ctx.Frame([]() {});
+
+    // Draw lists of the context shared data, with its arc cache, and of a copy without it
+    ImDrawListSharedData cached_data = *ImGui::GetDrawListSharedData();
+    ImDrawListSharedData uncached_data = cached_data;
+    uncached_data.ArcCache = nullptr;
+    CHECK(cached_data.ArcCache != nullptr);
+    ImDrawList cached{ &cached_data }, uncached{ &uncached_data };
+    for (ImDrawList* draw_list : { &cached, &uncached })
+    {
+        draw_list->_ResetForNewFrame();
+        draw_list->PushClipRectFullScreen();
+        draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    }
+
+    // Random arcs, more than the cache holds, drawn again at other radii and positions: same vertices with and without the cache
+    struct Arc { float AMin, AMax; int Segments; };
+    std::vector<Arc> arcs;
+    for (int n = 0; n < IM_DRAWLIST_ARC_CACHE_SIZE * 2; n++)
+    {
+        const float a_min = (float)(CheckRandom() % 628) * 0.01f;
+        arcs.push_back({ a_min, a_min + (float)(CheckRandom() % 628 + 1) * 0.01f, 3 + (int)(CheckRandom() % 60) });
+    }
+    for (int n = 0; n < 2000; n++)
+    {
+        const Arc& arc = arcs[CheckRandom() % arcs.size()];
+        const ImVec2 center{ (float)(CheckRandom() % 1000), (float)(CheckRandom() % 1000) };
+        const float radius = 1.f + (float)(CheckRandom() % 4000) * 0.1f;
+        const ImU32 col = IM_COL32(255, 255, 255, 255);
+        for (ImDrawList* draw_list : { &cached, &uncached })
+        {
+            switch (n % 4)
+            {
+            case 0: draw_list->PathArcTo(center, radius, arc.AMin, arc.AMax, arc.Segments); draw_list->PathStroke(col, ImDrawFlags_None, 2.f); break;
+            case 1: draw_list->AddCircle(center, radius, col, arc.Segments, 1.5f); break;
+            case 2: draw_list->AddNgon(center, radius, col, arc.Segments); break;
+            case 3: draw_list->AddCircleFilled(center, radius, col); break;
+            }
+        }
+    }
+    CHECK(cached.VtxBuffer.Size > 100000);
+    CHECK_EQ(cached.VtxBuffer.Size, uncached.VtxBuffer.Size);
+    CHECK(cached.VtxBuffer.Size == uncached.VtxBuffer.Size && memcmp(cached.VtxBuffer.Data, uncached.VtxBuffer.Data, cached.VtxBuffer.size_in_bytes()) == 0);
+    CHECK(cached.IdxBuffer.Size == uncached.IdxBuffer.Size && memcmp(cached.IdxBuffer.Data, uncached.IdxBuffer.Data, cached.IdxBuffer.size_in_bytes()) == 0);
+
+    // Recently used arcs are found again, arcs with too many segments aren't cached
+    ImDrawListArcCache& cache = *cached_data.ArcCache;
+    const ImVec2* points = cache.GetUnitArc(0.5f, 2.5f, 40);
+    CHECK(points != nullptr && cache.GetUnitArc(0.5f, 2.5f, 40) == points);
+    CHECK(points != nullptr && points[0].x == ImCos(0.5f) && points[0].y == ImSin(0.5f) && points[40].x == ImCos(2.5f) && points[40].y == ImSin(2.5f));
+    CHECK(cache.GetUnitArc(0.f, 1.f, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX + 1) == nullptr);
+}
+
+static void CheckBatchedPrimitives()
+{
+    CheckContext ctx;
+    ctx.Frame([]() {});
+
+    // Random shapes around a clip rect, some of them outside of it or transparent
+    constexpr int count = 1000;
+    std::vector<float> x1(count), y1(count), x2(count), y2(count);
+    std::vector<ImU32> cols(count);
+    for (int n = 0; n < count; n++)
+    {
+        x1[n] = (float)(CheckRandom() % 1400) - 200.f;
+        y1[n] = (float)(CheckRandom() % 1000) - 200.f;
+        x2[n] = x1[n] + (float)(CheckRandom() % 200) - 100.f;
+        y2[n] = y1[n] + (float)(CheckRandom() % 200) - 100.f;
+        cols[n] = (CheckRandom() % 8 == 0) ? IM_COL32(255, 0, 0, 0) : IM_COL32(CheckRandom() % 256, 128, 64, 1 + CheckRandom() % 255);
+    }
+
+    // Triangles overlapping the clip rect: the batched calls skip the shapes outside of it, the single shape calls draw them
+    const ImVec4 clip{ 100.f, 100.f, 900.f, 600.f };
+    const auto visible_triangles = [&clip](const ImDrawList& draw_list)
+    {
+        std::vector<DrawnVertex> drawn, visible;
+        FlattenDrawList(&draw_list, drawn);
+        for (size_t n = 0; n + 3 <= drawn.size(); n += 3)
+        {
+            const ImVec2 min = ImMin(drawn[n].Pos, ImMin(drawn[n + 1].Pos, drawn[n + 2].Pos));
+            const ImVec2 max = ImMax(drawn[n].Pos, ImMax(drawn[n + 1].Pos, drawn[n + 2].Pos));
+            if (min.x < clip.z && max.x > clip.x && min.y < clip.w && max.y > clip.y)
+                visible.insert(visible.end(), drawn.begin() + n, drawn.begin() + n + 3);
+        }
+        return visible;
+    };
+    const auto compare = [&](ImDrawListFlags flags, const std::function<void(ImDrawList&)>& batched, const std::function<void(ImDrawList&, int)>& single)
+    {
+        ImDrawList batched_list{ ImGui::GetDrawListSharedData() }, single_list{ ImGui::GetDrawListSharedData() };
+        for (ImDrawList* draw_list : { &batched_list, &single_list })
+        {
+            draw_list->_ResetForNewFrame();
+            draw_list->Flags = flags | ImDrawListFlags_AllowVtxOffset;
+            draw_list->PushClipRect({ clip.x, clip.y }, { clip.z, clip.w });
+            draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+        }
+        batched(batched_list);
+        for (int n = 0; n < count; n++)
+            single(single_list, n);
+        const std::vector<DrawnVertex> visible = visible_triangles(batched_list);
+        CHECK(visible.size() > 1000);
+        CHECK(SameDrawnVertices(visible, visible_triangles(single_list), 0.001f));
+        CHECK(batched_list.VtxBuffer.Size < single_list.VtxBuffer.Size);
+    };
+
+    // Rects, circles (fringe computed once, translated to each center) and lines, anti-aliased or not, with per shape colors or one color
+    const ImDrawListFlags anti_aliased = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill;
+    for (ImDrawListFlags flags : { anti_aliased, (ImDrawListFlags)ImDrawListFlags_None })
+    {
+        compare(flags,
+            [&](ImDrawList& draw_list) { draw_list.AddRectsFilled(x1.data(), y1.data(), x2.data(), y2.data(), cols.data(), count); },
+            [&](ImDrawList& draw_list, int n) { draw_list.AddRectFilled({ x1[n], y1[n] }, { x1[n] + x2[n], y1[n] + y2[n] }, cols[n]); }
+        );
+        compare(flags,
+            [&](ImDrawList& draw_list) { draw_list.AddCirclesFilled(x1.data(), y1.data(), 6.f, cols.data(), count); },
+            [&](ImDrawList& draw_list, int n) { draw_list.AddCircleFilled({ x1[n], y1[n] }, 6.f, cols[n]); }
+        );
+        compare(flags,
+            [&](ImDrawList& draw_list) { draw_list.AddCirclesFilled(x1.data(), y1.data(), 20.f, IM_COL32(0, 255, 0, 255), count, 12); },
+            [&](ImDrawList& draw_list, int n) { draw_list.AddCircleFilled({ x1[n], y1[n] }, 20.f, IM_COL32(0, 255, 0, 255), 12); }
+        );
+        for (float thickness : { 1.f, 3.f, 1.5f })
+        {
+            compare(flags,
+                [&](ImDrawList& draw_list) { draw_list.AddLines(x1.data(), y1.data(), x2.data(), y2.data(), cols.data(), count, thickness); },
+                [&](ImDrawList& draw_list, int n) { draw_list.AddLine({ x1[n], y1[n] }, { x2[n], y2[n] }, cols[n], thickness); }
+            );
+        }
+    }
+}
+
+static void CheckLinePlot()
+{
+    CheckContext ctx;
+    static imcxx::misc::line_plot plot;
+    std::vector<float> samples(1000000, 0.f);
+    samples[123457] = 1.f;
+    samples[777777] = -1.f;
+    plot.assign(samples.data(), samples.size());
+
+    // The view is clamped to the series without changing it
+    plot.set_view(-10., 5.);
+    CHECK_EQ(plot.view_first(), 0.);
+    CHECK_EQ(plot.view_last(), 15.);
+    plot.fit();
+    CHECK_EQ(plot.view_last(), 1000000.);
+
+    // 2 points per column, both spikes reach the edges of the plot
+    static ImRect frame_bb;
+    static int vertices;
+    ctx.Frame(
+        []()
+        {
+            if (BeginFullscreenWindow("Plot"))
+            {
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                const ImVec2 pos = ImGui::GetCursorScreenPos();
+                const int vtx_begin = draw_list->VtxBuffer.Size;
+                plot.render("##plot", { 1000.f, 200.f });
+                vertices = draw_list->VtxBuffer.Size - vtx_begin;
+                frame_bb = ImRect(pos, { pos.x + 1000.f, pos.y + 200.f });
+            }
+            ImGui::End();
+        }
+    );
+    const ImVec2 padding = ImGui::GetStyle().FramePadding;
+    const ImRect inner_bb(frame_bb.Min.x + padding.x, frame_bb.Min.y + padding.y, frame_bb.Max.x - padding.x, frame_bb.Max.y - padding.y);
+    const int width = (int)inner_bb.GetWidth();
+    CHECK(vertices > 2 * width);
+    CHECK(vertices <= 2 * 3 * width + 8);
+
+    const ImU32 color = ImGui::GetColorU32(ImGuiCol_PlotLines) & ~IM_COL32_A_MASK;
+    float y_min = FLT_MAX, y_max = -FLT_MAX;
+    const ImDrawList* draw_list = ImGui::FindWindowByName("Plot")->DrawList;
+    for (const ImDrawVert& vtx : draw_list->VtxBuffer)
+    {
+        if ((vtx.col & ~IM_COL32_A_MASK) != color)
+            continue;
+        y_min = ImMin(y_min, draw_list->GetVtxPos(vtx).y);
+        y_max = ImMax(y_max, draw_list->GetVtxPos(vtx).y);
+    }
+    CHECK(ImFabs(y_min - inner_bb.Min.y) < 2.f);
+    CHECK(ImFabs(y_max - inner_bb.Max.y) < 2.f);
+}
+
+static void CheckScrollingPlot()
+{
+    CheckContext ctx;
+    static imcxx::misc::scrolling_plot plot{ 10.0 };
+
+    // A full ring drops the samples and counts them, draining makes room again
+    auto& small = plot.add_series("small", IM_COL32(0, 255, 0, 255), 10);
+    int pushed = 0;
+    for (int n = 0; n < 20; n++)
+        pushed += small.push(n * 0.01, 0.f) ? 1 : 0;
+    CHECK_EQ(pushed, 16);
+    CHECK_EQ(small.dropped(), 4);
+    plot.drain();
+    CHECK_EQ(plot.latest(), 0.15);
+    CHECK(small.push(0.16, 0.f));
+
+    // A flat series with two spikes in the last 10 seconds and one before, pushed by a thread while frames are rendered
+    static const ImU32 color = IM_COL32(255, 0, 0, 255);
+    auto& spiky = plot.add_series("spiky", color, 1024);
+    std::atomic<bool> done{ false };
+    size_t full = 0;
+    std::thread producer(
+        [&spiky, &done, &full]()
+        {
+            for (int n = 0; n <= 20000; n++)
+            {
+                const float value = n == 3000 ? 5.f : n == 15000 ? 1.f : n == 17000 ? -1.f : 0.f;
+                while (!spiky.push(n * 0.001, value))
+                {
+                    full++;
+                    std::this_thread::yield();
+                }
+            }
+            done = true;
+        }
+    );
+    static ImRect inner_bb;
+    static int vtx_begin, vtx_end;
+    const auto draw = []()
+    {
+        if (BeginFullscreenWindow("Plot"))
+        {
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            const ImVec2 pos = ImGui::GetCursorScreenPos();
+            const ImVec2 padding = ImGui::GetStyle().FramePadding;
+            vtx_begin = draw_list->VtxBuffer.Size;
+            plot.render("##plot", { 1000.f, 200.f });
+            vtx_end = draw_list->VtxBuffer.Size;
+            inner_bb = ImRect(pos.x + padding.x, pos.y + padding.y, pos.x + 1000.f - padding.x, pos.y + 200.f - padding.y);
+        }
+        ImGui::End();
+    };
+    while (!done)
+        ctx.Frame(draw);
+    producer.join();
+    ctx.Frame(draw);
+    CHECK_EQ(spiky.dropped(), full);
+    CHECK_EQ(plot.latest(), 20.0);
+
+    // Both spikes of the history reach the edges of the plot, the older one is out of the scale
+    float y_min = FLT_MAX, y_max = -FLT_MAX;
+    int vertices = 0;
+    const ImDrawList* draw_list = ImGui::FindWindowByName("Plot")->DrawList;
+    for (int n = vtx_begin; n < vtx_end; n++)
+    {
+        const ImDrawVert& vtx = draw_list->VtxBuffer[n];
+        if (vtx.col != color)
+            continue;
+        y_min = ImMin(y_min, draw_list->GetVtxPos(vtx).y);
+        y_max = ImMax(y_max, draw_list->GetVtxPos(vtx).y);
+        vertices++;
+    }
+    CHECK(ImFabs(y_min - inner_bb.Min.y) < 2.f);
+    CHECK(ImFabs(y_max - inner_bb.Max.y) < 2.f);
+
+    // Most columns are a single segment of 4 vertices
+    CHECK(vertices > 0 && vertices <= 4 * ((int)inner_bb.GetWidth() + 8));
+
+    // A new history drops the drained samples
+    plot.set_history(5.0);
+    CHECK_EQ(plot.history(), 5.0);
+    vtx_begin = vtx_end = 0;
+    ctx.Frame(draw);
+    CHECK(vtx_end - vtx_begin <= 8);
+}
+
+static void CheckFontLoader()
+{
+    CheckContext ctx;
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigTextSizeCacheMaxEntries = 100;
+    static int uploads;
+    imcxx::misc::font_loader loader{ []() { uploads++; ImGui_ImplNull_InvalidateDeviceObjects(); } };
+    const auto draw = []()
+    {
+        if (BeginFullscreenWindow("Fonts"))
+            ImGui::TextUnformatted("Measured with the current atlas, and cached");
+        ImGui::End();
+    };
+    ctx.Frame(draw);
+    ctx.Frame(draw);
+    const int build_count = io.Fonts->BuildCount;
+    io.FontDefault = io.Fonts->Fonts[0];
+    CHECK(GImGui->TextSizeCache.Count > 0);
+
+    // A build replaced while it runs is dropped: the first one waits until the second one is queued
+    std::atomic<bool> second_queued{ false };
+    loader.build(
+        [&second_queued](ImFontAtlas& atlas)
+        {
+            while (!second_queued)
+                std::this_thread::yield();
+            atlas.AddFontDefault();
+        }
+    );
+    loader.build(
+        [](ImFontAtlas& atlas)
+        {
+            ImFontConfig config;
+            config.SizePixels = 20.f;
+            atlas.AddFontDefault(&config);
+        }
+    );
+    second_queued = true;
+    CHECK(loader.is_pending());
+
+    // Frames go on with the previous atlas until the built one is applied between two frames
+    CHECK(WaitFor(
+        [&]()
+        {
+            if (loader.apply())
+                return true;
+            ctx.Frame(draw);
+            return false;
+        }
+    ));
+    CHECK_EQ(uploads, 1);
+    CHECK(io.Fonts->Fonts.Size == 1 && io.Fonts->Fonts[0]->FontSize == 20.f);
+    CHECK(io.Fonts->TexPixelsRGBA32 != nullptr);
+    CHECK(io.Fonts->BuildCount > build_count);
+    CHECK(io.FontDefault == nullptr);
+    CHECK_EQ(GImGui->TextSizeCache.Count, 0);
+    CHECK(!loader.is_pending());
+    CHECK(!loader.apply());
+
+    // The next frames use the new atlas
+    ctx.Frame(draw);
+    ctx.Frame(draw);
+    CHECK(ImGui::GetFont() == io.Fonts->Fonts[0]);
+    CHECK_EQ(uploads, 1);
+
+    // The UI thread adds compressed fonts to its own atlases while the worker builds the same ones: both decompress them
+    const auto add_fonts = [](ImFontAtlas& atlas)
+    {
+        ImFontConfig config;
+        for (const float size : { 13.f, 20.f, 32.f, 48.f })
+        {
+            config.SizePixels = size;
+            atlas.AddFontDefault(&config);
+        }
+    };
+    const auto same_texture = [](ImFontAtlas& a, ImFontAtlas& b)
+    {
+        unsigned char *a_pixels, *b_pixels;
+        int a_width, a_height, b_width, b_height;
+        a.GetTexDataAsRGBA32(&a_pixels, &a_width, &a_height);
+        b.GetTexDataAsRGBA32(&b_pixels, &b_width, &b_height);
+        return a_width == b_width && a_height == b_height && memcmp(a_pixels, b_pixels, (size_t)a_width * a_height * 4) == 0;
+    };
+    ImFontAtlas reference;
+    add_fonts(reference);
+    std::atomic<bool> ui_adding{ false };
+    loader.build(
+        [&ui_adding, &add_fonts](ImFontAtlas& atlas)
+        {
+            while (!ui_adding)
+                std::this_thread::yield();
+            for (int i = 0; i < 64; i++)
+            {
+                atlas.Clear();
+                add_fonts(atlas);
+            }
+        }
+    );
+    ui_adding = true;
+    int ui_builds = 0, ui_mismatches = 0;
+    CHECK(WaitFor(
+        [&]()
+        {
+            if (loader.apply())
+                return true;
+            ImFontAtlas atlas;
+            for (int i = 0; i < 16; i++)
+            {
+                atlas.Clear();
+                add_fonts(atlas);
+            }
+            ui_builds++;
+            ui_mismatches += !same_texture(atlas, reference);
+            return false;
+        }
+    ));
+    CHECK(ui_builds > 0);
+    CHECK_EQ(ui_mismatches, 0);
+    CHECK(same_texture(*io.Fonts, reference));
+    CHECK_EQ(uploads, 2);
+}
+
+// The default font at 32 px, its Latin-1 glyphs rasterized on demand or built with the atlas
+static ImFont* AddCheckFont(ImFontAtlas& atlas, bool dynamic_glyphs)
+{
+    ImFontConfig config;
+    config.SizePixels = 32.f;
+    config.DynamicGlyphs = dynamic_glyphs;
+    ImFont* font = atlas.AddFontDefault(&config);
+    unsigned char* pixels;
+    int width, height;
+    atlas.GetTexDataAsRGBA32(&pixels, &width, &height);
+    return font;
+}
+
+// Same metrics and texels for a glyph of two atlases
+static bool SameGlyph(const ImFontAtlas& a_atlas, const ImFontGlyph& a, const ImFontAtlas& b_atlas, const ImFontGlyph& b)
+{
+    if (a.X0 != b.X0 || a.Y0 != b.Y0 || a.X1 != b.X1 || a.Y1 != b.Y1 || a.AdvanceX != b.AdvanceX)
+        return false;
+    const int a_x = (int)(a.U0 * a_atlas.TexWidth + 0.5f), a_y = (int)(a.V0 * a_atlas.TexHeight + 0.5f);
+    const int b_x = (int)(b.U0 * b_atlas.TexWidth + 0.5f), b_y = (int)(b.V0 * b_atlas.TexHeight + 0.5f);
+    const int width = (int)((a.U1 - a.U0) * a_atlas.TexWidth + 0.5f), height = (int)((a.V1 - a.V0) * a_atlas.TexHeight + 0.5f);
+    if (width != (int)((b.U1 - b.U0) * b_atlas.TexWidth + 0.5f) || height != (int)((b.V1 - b.V0) * b_atlas.TexHeight + 0.5f))
+        return false;
+    for (int y = 0; y < height; y++)
+        if (memcmp(a_atlas.TexPixelsRGBA32 + (size_t)(a_y + y) * a_atlas.TexWidth + a_x, b_atlas.TexPixelsRGBA32 + (size_t)(b_y + y) * b_atlas.TexWidth + b_x, width * sizeof(unsigned int)) != 0)
+            return false;
+    return true;
+}
+
+// MetricsTotalSurface of the glyphs a font holds (see ImFontAtlasCalcGlyphSurface()): evicted glyphs don't count
+static int GlyphsSurface(const ImFont* font)
+{
+    const ImFontAtlas* atlas = font->ContainerAtlas;
+    const float pad = atlas->TexGlyphPadding + 0.99f;
+    int surface = 0;
+    for (int n = 0; n < font->Glyphs.Size; n++)
+    {
+        if (font->DynamicGlyphs && font->DynamicGlyphs->Slots[n].LastUsedFrame == -2)
+            continue;
+        const ImFontGlyph& glyph = font->Glyphs[n];
+        surface += (int)((glyph.U1 - glyph.U0) * atlas->TexWidth + pad) * (int)((glyph.V1 - glyph.V0) * atlas->TexHeight + pad);
+    }
+    return surface;
+}
+
+static void CheckDynamicGlyphs()
+{
+    // Glyphs built with the atlas, the reference
+    ImFontAtlas baked_atlas;
+    const ImFont* baked = AddCheckFont(baked_atlas, false);
+
+    // Glyphs the atlas adds without ImFont::AddGlyph() (TAB) aren't part of MetricsTotalSurface, whether they are rasterized on demand or not
+    const int surface_offset = baked->MetricsTotalSurface - GlyphsSurface(baked);
+
+    // A third of the Latin-1 characters (0xA0-0xFF)
+    static char third_text[3][32 * 2 + 1];
+    for (int third = 0; third < 3; third++)
+    {
+        ImWchar chars[32];
+        for (int n = 0; n < 32; n++)
+            chars[n] = (ImWchar)(0xA0 + third * 32 + n);
+        ImTextStrToUtf8(third_text[third], IM_ARRAYSIZE(third_text[third]), chars, chars + 32);
+    }
+    static int third;
+    const auto draw = []()
+    {
+        if (BeginFullscreenWindow("Glyphs"))
+            ImGui::TextUnformatted(third_text[third]);
+        ImGui::End();
+    };
+    const auto same_as_baked = [&baked_atlas, baked](const ImFont* font)
+    {
+        bool same = true;
+        for (int n = 0; n < 32; n++)
+        {
+            const ImWchar c = (ImWchar)(0xA0 + third * 32 + n);
+            const ImFontGlyph* glyph = font->FindGlyphNoFallback(c);
+            same &= glyph != nullptr && SameGlyph(*font->ContainerAtlas, *glyph, baked_atlas, *baked->FindGlyphNoFallback(c));
+        }
+        return same;
+    };
+
+    // Drawn with the fallback glyph and requested on the first frame, rasterized by the next NewFrame() like the baked ones
+    {
+        CheckContext ctx;
+        ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+        atlas.Clear();
+        ImFont* font = AddCheckFont(atlas, true);
+        ImGui_ImplNull_InvalidateDeviceObjects();
+        const int build_count = atlas.BuildCount;
+        third = 0;
+        ctx.Frame(draw);
+        CHECK(atlas.HasDynamicGlyphRequests());
+        CHECK(font->FindGlyphNoFallback(0xE9) == nullptr);
+        ctx.Frame(draw);
+        CHECK(!atlas.HasDynamicGlyphRequests());
+        CHECK(ImGui_ImplNull_GetRenderStats().TexRectsUploaded > 0);
+        CHECK(same_as_baked(font));
+        CHECK_EQ(atlas.BuildCount, build_count);
+        CHECK_EQ(font->MetricsTotalSurface, GlyphsSurface(font) + surface_offset);
+
+        // Glyphs drawn without updating the font are logged once each, the ones built with the atlas aren't
+        ImFontGlyphUses uses;
+        ImDrawListSharedData shared = *ImGui::GetDrawListSharedData();
+        shared.GlyphUses = &uses;
+        ImDrawList draw_list{ &shared };
+        draw_list._ResetForNewFrame();
+        draw_list.PushClipRectFullScreen();
+        draw_list.PushTextureID(atlas.TexID);
+        for (int n = 0; n < 2; n++)
+            draw_list.AddText(font, 32.f, { 0.f, 0.f }, IM_COL32_WHITE, "ASCII \xC3\xA9t\xC3\xA9 \xC3\xBF \xC3\xBF");
+        CHECK_EQ(uses.Uses.Size, 2);
+        CHECK(!atlas.HasDynamicGlyphRequests());
+
+        // Marked as used on the UI thread, the glyph not rasterized yet is requested
+        CHECK(ImFontMarkGlyphsUsed(ImGui::GetDrawListSharedData(), uses));
+        CHECK(atlas.HasDynamicGlyphRequests());
+        ctx.Frame([]() {});
+        CHECK(font->FindGlyphNoFallback(0xFF) != nullptr);
+        CHECK(!ImFontMarkGlyphsUsed(ImGui::GetDrawListSharedData(), uses));
+    }
+
+    // Rows too small for all of them: glyphs of the previous thirds are evicted and their entries reused, the font holds no more
+    // glyphs once each third was drawn twice
+    {
+        CheckContext ctx;
+        ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+        atlas.Clear();
+        atlas.Flags |= ImFontAtlasFlags_NoPowerOfTwoHeight;
+        atlas.TexDynamicGlyphsHeight = 80;
+        ImFont* font = AddCheckFont(atlas, true);
+        ImGui_ImplNull_InvalidateDeviceObjects();
+        const int build_count = atlas.BuildCount;
+        int glyphs_count = 0;
+        for (int cycle = 0; cycle < 9; cycle++)
+        {
+            third = cycle % 3;
+            ctx.Frame(draw);
+            ctx.Frame(draw);
+            CHECK(same_as_baked(font));
+            CHECK_EQ(font->MetricsTotalSurface, GlyphsSurface(font) + surface_offset);
+            if (cycle == 5)
+                glyphs_count = font->Glyphs.Size;
+
+        }
+        CHECK(atlas.BuildCount > build_count);
+        CHECK_EQ(font->Glyphs.Size, glyphs_count);
+    }
+}
+
+static const Check g_Checks[] =
+{
+    { "null_backend",       "display size, time step and render stats of the null backend", CheckNullBackend },
+    { "software_renderer",  "imgui_impl_software pixels, and the same pixels with 1, 4 and 7 threads", CheckSoftwareRenderer },
+    { "label_id",           "imcxx::label_id and imcxx::hash_str against ImHashStr() and GetID()", CheckLabelId },
+    { "table_view",         "imcxx::table_view submits the visible rows, in the order of a table_sorter", CheckTableView },
+    { "table_sorter",       "imcxx::table_sorter discards the sorts of previous specs", CheckTableSorter },
+    { "variable_clipper",   "imcxx::variable_clipper measures the visible items and seeks with their heights", CheckVariableClipper },
+    { "log_viewer",         "imcxx::misc::log_viewer indexes, follows and re-indexes a file", CheckLogViewer },
+    { "console",            "imcxx::misc::console splits messages into lines of one line height", CheckConsole },
+    { "text_size_cache",    "CalcTextSize() with the text size cache against the uncached sizes", CheckTextSizeCache },
+    { "ascii_fast_path",    "ImTextFindNonPrintableAscii() and ASCII runs of CalcTextSizeA() against byte at a time", CheckAsciiFastPath },
+    { "retained_text",      "imcxx::retained_text draws the quads of AddText(), wrapped like TextWrapped()", CheckRetainedText },
+    { "wrapped_text_cache", "TextWrapped() drawn from cached line breaks against uncached, under eviction too", CheckWrappedTextCache },
+    { "text_editor",        "imcxx::misc::text_editor edits, selection and cursor positions", CheckTextEditor },
+    { "string_input",       "imcxx::input grows strings by the growth policy, edits a std::pmr::string in a fixed buffer", CheckStringInput },
+    { "draw_recorder",      "imcxx::misc::draw_recorder draws the triangles drawn on the UI thread, with 0, 1 and 4 workers", CheckDrawRecorder },
+    { "cached_child",       "imcxx::window::child with a child_cache draws the recorded contents until they change or are hovered", CheckCachedChild },
+    { "frame_scheduler",    "imcxx::frame_scheduler waits after input events settled, until requested redraws and cursor blinks", CheckFrameScheduler },
+    { "draw_list_reuse",    "ContentChanged and ContentHash of unchanged draw lists, uploads of the null renderer reusing them", CheckDrawListReuse },
+    { "compact_vertices",   "ImDrawVert positions and texture coordinates round trip, far shapes are cut", CheckCompactVertices },
+    { "arc_cache",          "arcs drawn from the unit arc cache against trigonometry, with eviction", CheckArcCache },
+    { "batched_primitives", "AddRectsFilled(), AddCirclesFilled() and AddLines() against the single shape calls", CheckBatchedPrimitives },
+    { "line_plot",          "imcxx::misc::line_plot draws every spike with 2 points per column", CheckLinePlot },
+    { "scrolling_plot",     "imcxx::misc::scrolling_plot rings fed by a thread, spikes drawn, history changes", CheckScrollingPlot },
+    { "font_loader",        "imcxx::misc::font_loader builds an atlas on its worker, applies the latest build between frames", CheckFontLoader },
+    { "dynamic_glyphs",     "glyphs rasterized on demand against the baked ones, eviction, surface metrics and logged glyphs", CheckDynamicGlyphs },
+};
+
+
+static void PrintUsage()
+{
+    printf("usage: imcxx_checks [--list] [NAME...]\n");
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<const char*> names;
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--list"))
+        {
+            for (const Check& check : g_Checks)
+                printf("%-20s %s\n", check.Name, check.Description);
+            return 0;
+        }
+        if (argv[i][0] == '-')
+        {
+            PrintUsage();
+            return 1;
+        }
+        names.push_back(argv[i]);
+    }
+    for (const char* name : names)
+    {
+        bool found = false;
+        for (const Check& check : g_Checks)
+            found |= !strcmp(check.Name, name);
+        if (!found)
+        {
+            fprintf(stderr, "unknown check '%s', use --list\n", name);
+            return 1;
+        }
+    }
+
+    int failed = 0, run = 0;
+    for (const Check& check : g_Checks)
+    {
+        bool selected = names.empty();
+        for (const char* name : names)
+            selected |= !strcmp(check.Name, name);
+        if (!selected)
+            continue;
+
+        g_CheckFailures = 0;
+        check.Run();
+        printf("%-20s %s\n", check.Name, g_CheckFailures ? "FAILED" : "ok");
+        failed += g_CheckFailures ? 1 : 0;
+        run++;
+    }
+    printf("%d/%d checks passed\n", run - failed, run);
+    return failed;
+}
@@ -0,0 +1,351 @@
+// dear imgui: Headless Platform + Renderer Backend
+// This backend has no window and no GPU: it feeds Dear ImGui a fixed display size and time step,
+// and consumes ImDrawData the same way imgui_impl_dx9.cpp does, copying vertices and indices into a
+// staging buffer and walking every ImDrawCmd, so frames can be driven and measured on any host.
+
+// Implemented features:
+//  [X] Platform: Fixed display size and fixed (or real) delta time for reproducible frames.
+//  [X] Renderer: Font atlas is built as RGBA32 and kept in memory. ImTextureID is a pointer to the pixels.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Per-frame statistics (vertices, indices, draw calls, bytes copied).
+//  [X] Renderer: Optional buffers kept per ImDrawList, only changed draw lists are copied (ImGuiBackendFlags_RendererReusesDrawLists).
+//  [X] Renderer: Compact vertices (IMGUI_USE_COMPACT_DRAWVERT) are copied as they are, for a vertex shader to decode them.
+//  [X] Renderer: Glyphs rasterized on demand (ImGuiBackendFlags_RendererHasTexUpdates), the texture being the atlas pixels there is nothing to upload.
+
+#include "imgui_impl_null.h"
+
+#include <chrono>
+#include <string.h>
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Compact vertices are uploaded as they are: a vertex shader decodes them, with ImDrawList::VtxOrigin as a constant per draw list.
+typedef ImDrawVert ImGui_ImplNull_Vertex;
+#else
+// Same layout as the DX9 backend's FVF vertex, so the copy below costs what a real upload would.
+struct ImGui_ImplNull_Vertex
+{
+    float    pos[3];
+    ImU32    col;
+    float    uv[2];
+};
+#endif
+
+// Copy of a draw list kept between frames, as a renderer would keep a vertex/index buffer pair per draw list
+struct ImGui_ImplNull_ListBuffers
+{
+    const ImDrawList*               DrawList;
+    ImU64                           ContentHash;
+    bool                            Uploaded;
+    int                             LastFrame;
+    ImVector<ImGui_ImplNull_Vertex> Vtx;
+    ImVector<ImDrawIdx>             Idx;
+};
+
+struct ImGui_ImplNull_Data
+{
+    ImVec2                          DisplaySize;
+    float                           FixedDeltaTime;
+    std::chrono::steady_clock::time_point LastTime;
+    bool                            HasLastTime;
+    bool                            HasRenderer;
+
+    unsigned char*                  FontPixels;
+    int                             FontWidth;
+    int                             FontHeight;
+
+    ImVector<ImGui_ImplNull_Vertex> VtxStaging;
+    ImVector<ImDrawIdx>             IdxStaging;
+    ImVector<ImGui_ImplNull_ListBuffers*> ListBuffers;  // Sorted by ImDrawList pointer
+    int                             FrameCount;
+    ImGui_ImplNull_RenderStats      Stats;
+
+    ImGui_ImplNull_Data()           { DisplaySize = ImVec2(0.0f, 0.0f); FixedDeltaTime = 0.0f; HasLastTime = false; HasRenderer = false; FontPixels = NULL; FontWidth = FontHeight = 0; FrameCount = 0; memset(&Stats, 0, sizeof(Stats)); }
+};
+
+// Backend data stored in io.BackendPlatformUserData (and io.BackendRendererUserData when installed as renderer) to allow support for multiple Dear ImGui contexts
+static ImGui_ImplNull_Data* ImGui_ImplNull_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplNull_Data*)ImGui::GetIO().BackendPlatformUserData : NULL;
+}
+
+bool ImGui_ImplNull_Init(const ImVec2& display_size, float fixed_delta_time, bool install_renderer)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendPlatformUserData == NULL && "Already initialized a platform backend!");
+    IM_ASSERT((!install_renderer || io.BackendRendererUserData == NULL) && "Already initialized a renderer backend!");
+
+    ImGui_ImplNull_Data* bd = IM_NEW(ImGui_ImplNull_Data)();
+    bd->DisplaySize = display_size;
+    bd->FixedDeltaTime = fixed_delta_time;
+    bd->HasRenderer = install_renderer;
+
+    io.BackendPlatformUserData = (void*)bd;
+    io.BackendPlatformName = "imgui_impl_null";
+    if (install_renderer)
+    {
+        io.BackendRendererUserData = (void*)bd;
+        io.BackendRendererName = "imgui_impl_null";
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can honor io.Fonts->TexDirtyRects, allowing for ImFontConfig::DynamicGlyphs.
+    }
+
+    return true;
+}
+
+void ImGui_ImplNull_Shutdown()
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    IM_ASSERT(bd != NULL && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (bd->HasRenderer)
+    {
+        ImGui_ImplNull_InvalidateDeviceObjects();
+        io.BackendRendererName = NULL;
+        io.BackendRendererUserData = NULL;
+    }
+    io.BackendPlatformName = NULL;
+    io.BackendPlatformUserData = NULL;
+    IM_DELETE(bd);
+}
+
+bool ImGui_ImplNull_CreateDeviceObjects()
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Build texture atlas. The pixels are owned by the atlas, we only keep a pointer to them as our "texture".
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontPixels = pixels;
+    bd->FontWidth = width;
+    bd->FontHeight = height;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)bd->FontPixels);
+    return true;
+}
+
+void ImGui_ImplNull_InvalidateDeviceObjects()
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    if (!bd)
+        return;
+    if (bd->FontPixels)
+    {
+        bd->FontPixels = NULL;
+        ImGui::GetIO().Fonts->SetTexID(NULL);
+    }
+    bd->VtxStaging.clear();
+    bd->IdxStaging.clear();
+    for (int n = 0; n < bd->ListBuffers.Size; n++)
+        IM_DELETE(bd->ListBuffers[n]);
+    bd->ListBuffers.clear();
+}
+
+void ImGui_ImplNull_SetDisplaySize(const ImVec2& display_size)
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplNull_Init()?");
+    bd->DisplaySize = display_size;
+}
+
+void ImGui_ImplNull_SetReuseDrawLists(bool reuse)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    if (reuse)
+        io.BackendFlags |= ImGuiBackendFlags_RendererReusesDrawLists;
+    else
+        io.BackendFlags &= ~ImGuiBackendFlags_RendererReusesDrawLists;
+}
+
+const ImGui_ImplNull_RenderStats& ImGui_ImplNull_GetRenderStats()
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplNull_Init()?");
+    return bd->Stats;
+}
+
+void ImGui_ImplNull_NewFrame()
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplNull_Init()?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    if (bd->HasRenderer && (!bd->FontPixels || !io.Fonts->IsBuilt()))
+        ImGui_ImplNull_CreateDeviceObjects();
+
+    io.DisplaySize = bd->DisplaySize;
+
+    // Setup time step
+    std::chrono::steady_clock::time_point current_time = std::chrono::steady_clock::now();
+    if (bd->FixedDeltaTime > 0.0f)
+        io.DeltaTime = bd->FixedDeltaTime;
+    else if (bd->HasLastTime)
+    {
+        float delta_time = std::chrono::duration<float>(current_time - bd->LastTime).count();
+        io.DeltaTime = delta_time > 0.0f ? delta_time : 1e-6f;
+    }
+    else
+        io.DeltaTime = 1.0f / 60.0f;
+    bd->LastTime = current_time;
+    bd->HasLastTime = true;
+}
+
+static void ImGui_ImplNull_CopyVertices(ImGui_ImplNull_Vertex* vtx_dst, const ImDrawList* cmd_list)
+{
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.size_in_bytes());
+#else
+    const ImDrawVert* vtx_src = cmd_list->VtxBuffer.Data;
+    for (int i = 0; i < cmd_list->VtxBuffer.Size; i++)
+    {
+        vtx_dst->pos[0] = vtx_src->pos.x;
+        vtx_dst->pos[1] = vtx_src->pos.y;
+        vtx_dst->pos[2] = 0.0f;
+        vtx_dst->col = vtx_src->col;
+        vtx_dst->uv[0] = vtx_src->uv.x;
+        vtx_dst->uv[1] = vtx_src->uv.y;
+        vtx_dst++;
+        vtx_src++;
+    }
+#endif
+}
+
+// Index of the first buffers whose draw list pointer is not less than 'draw_list' (binary search, ListBuffers is sorted by pointer)
+static int ImGui_ImplNull_ListBuffersLowerBound(ImGui_ImplNull_Data* bd, const ImDrawList* draw_list)
+{
+    int first = 0, count = bd->ListBuffers.Size;
+    while (count > 0)
+    {
+        const int half = count >> 1;
+        if ((size_t)bd->ListBuffers[first + half]->DrawList < (size_t)draw_list)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+            count = half;
+    }
+    return first;
+}
+
+// Copy the draw lists whose content hash changed into their own buffers, free the buffers of draw lists unused for a while
+static void ImGui_ImplNull_UploadChangedLists(ImGui_ImplNull_Data* bd, ImDrawData* draw_data)
+{
+    ImGui_ImplNull_RenderStats& stats = bd->Stats;
+    const int frame_count = ++bd->FrameCount;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const int insert_n = ImGui_ImplNull_ListBuffersLowerBound(bd, cmd_list);
+        ImGui_ImplNull_ListBuffers* buffers = (insert_n < bd->ListBuffers.Size && bd->ListBuffers[insert_n]->DrawList == cmd_list) ? bd->ListBuffers[insert_n] : NULL;
+        if (buffers == NULL)
+        {
+            buffers = IM_NEW(ImGui_ImplNull_ListBuffers)();
+            buffers->DrawList = cmd_list;
+            buffers->Uploaded = false;
+            bd->ListBuffers.insert(bd->ListBuffers.Data + insert_n, buffers);
+        }
+        buffers->LastFrame = frame_count;
+        if (buffers->Uploaded && buffers->ContentHash == cmd_list->ContentHash)
+            continue;
+
+        buffers->ContentHash = cmd_list->ContentHash;
+        buffers->Uploaded = true;
+        buffers->Vtx.resize(cmd_list->VtxBuffer.Size);
+        buffers->Idx.resize(cmd_list->IdxBuffer.Size);
+        ImGui_ImplNull_CopyVertices(buffers->Vtx.Data, cmd_list);
+        memcpy(buffers->Idx.Data, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+        stats.CmdListsUploaded++;
+        stats.BytesUploaded += (size_t)cmd_list->VtxBuffer.Size * sizeof(ImGui_ImplNull_Vertex) + (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+    }
+
+    for (int n = 0; n < bd->ListBuffers.Size; n++)
+    {
+        ImGui_ImplNull_ListBuffers* buffers = bd->ListBuffers[n];
+        if (frame_count - buffers->LastFrame < 60)
+            continue;
+        IM_DELETE(buffers);
+        bd->ListBuffers.erase(bd->ListBuffers.Data + n--);
+    }
+}
+
+// Render function.
+void ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplNull_Data* bd = ImGui_ImplNull_GetBackendData();
+    ImGui_ImplNull_RenderStats& stats = bd->Stats;
+    memset(&stats, 0, sizeof(stats));
+
+    // Avoid rendering when minimized
+    if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f)
+        return;
+
+    // Our texture points at the atlas pixels: the glyphs rasterized on demand are already in it
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    stats.TexRectsUploaded = atlas->TexDirtyRects.Size;
+    atlas->TexDirtyRects.resize(0);
+
+    stats.CmdListsCount = draw_data->CmdListsCount;
+    stats.TotalVtxCount = draw_data->TotalVtxCount;
+    stats.TotalIdxCount = draw_data->TotalIdxCount;
+    if (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererReusesDrawLists)
+    {
+        ImGui_ImplNull_UploadChangedLists(bd, draw_data);
+    }
+    else
+    {
+        // Create and grow buffers if needed
+        if (bd->VtxStaging.Size < draw_data->TotalVtxCount)
+            bd->VtxStaging.resize(draw_data->TotalVtxCount + 5000);
+        if (bd->IdxStaging.Size < draw_data->TotalIdxCount)
+            bd->IdxStaging.resize(draw_data->TotalIdxCount + 10000);
+
+        // Copy and convert all vertices into a single contiguous buffer
+        ImGui_ImplNull_Vertex* vtx_dst = bd->VtxStaging.Data;
+        ImDrawIdx* idx_dst = bd->IdxStaging.Data;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            ImGui_ImplNull_CopyVertices(vtx_dst, cmd_list);
+            vtx_dst += cmd_list->VtxBuffer.Size;
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            idx_dst += cmd_list->IdxBuffer.Size;
+        }
+        stats.CmdListsUploaded = draw_data->CmdListsCount;
+        stats.BytesUploaded = (size_t)draw_data->TotalVtxCount * sizeof(ImGui_ImplNull_Vertex) + (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+    }
+
+    // Walk command lists
+    ImVec2 clip_off = draw_data->DisplayPos;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                stats.UserCallbacks++;
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+            }
+            else
+            {
+                // Project scissor/clipping rectangles into framebuffer space
+                ImVec2 clip_min(pcmd->ClipRect.x - clip_off.x, pcmd->ClipRect.y - clip_off.y);
+                ImVec2 clip_max(pcmd->ClipRect.z - clip_off.x, pcmd->ClipRect.w - clip_off.y);
+                if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                {
+                    stats.ClippedCmds++;
+                    continue;
+                }
+                stats.DrawCalls++;
+            }
+        }
+    }
+}
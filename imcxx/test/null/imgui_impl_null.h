@@ -0,0 +1,43 @@
+// dear imgui: Headless Platform + Renderer Backend
+// This backend has no window and no GPU: it feeds Dear ImGui a fixed display size and time step,
+// and consumes ImDrawData the same way imgui_impl_dx9.cpp does, copying vertices and indices into a
+// staging buffer and walking every ImDrawCmd, so frames can be driven and measured on any host.
+
+// Implemented features:
+//  [X] Platform: Fixed display size and fixed (or real) delta time for reproducible frames.
+//  [X] Renderer: Font atlas is built as RGBA32 and kept in memory. ImTextureID is a pointer to the pixels.
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Per-frame statistics (vertices, indices, draw calls, bytes copied).
+//  [X] Renderer: Optional buffers kept per ImDrawList, only changed draw lists are copied (ImGuiBackendFlags_RendererReusesDrawLists).
+//  [X] Renderer: Compact vertices (IMGUI_USE_COMPACT_DRAWVERT) are copied as they are, for a vertex shader to decode them.
+
+#pragma once
+#include "imgui/imgui.h"      // IMGUI_IMPL_API
+
+struct ImGui_ImplNull_RenderStats
+{
+    int         CmdListsCount;      // Number of ImDrawList submitted
+    int         CmdListsUploaded;   // Number of ImDrawList copied, less than CmdListsCount when unchanged draw lists are reused
+    int         TotalVtxCount;      // Number of vertices copied into the staging buffer
+    int         TotalIdxCount;      // Number of indices copied into the staging buffer
+    int         DrawCalls;          // Number of ImDrawCmd that would have reached the GPU
+    int         ClippedCmds;        // Number of ImDrawCmd skipped because of an empty clip rectangle
+    int         UserCallbacks;      // Number of ImDrawCmd with a user callback
+    size_t      BytesUploaded;      // Bytes copied into the staging vertex/index buffers
+    int         TexRectsUploaded;   // Number of io.Fonts->TexDirtyRects consumed
+};
+
+// 'fixed_delta_time' <= 0.0f: use the real elapsed time between two NewFrame() calls.
+// 'install_renderer' == false: only act as a platform backend, so another renderer backend (e.g. imgui_impl_software) can be paired with it.
+IMGUI_IMPL_API bool     ImGui_ImplNull_Init(const ImVec2& display_size = ImVec2(1920.0f, 1080.0f), float fixed_delta_time = 1.0f / 60.0f, bool install_renderer = true);
+IMGUI_IMPL_API void     ImGui_ImplNull_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplNull_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data);
+
+IMGUI_IMPL_API void     ImGui_ImplNull_SetDisplaySize(const ImVec2& display_size);
+IMGUI_IMPL_API void     ImGui_ImplNull_SetReuseDrawLists(bool reuse);    // Keep a buffer per ImDrawList and only copy the lists whose ImDrawList::ContentHash changed
+IMGUI_IMPL_API const ImGui_ImplNull_RenderStats& ImGui_ImplNull_GetRenderStats();
+
+// Use if you want to rebuild the font texture (e.g. after adding fonts).
+IMGUI_IMPL_API bool     ImGui_ImplNull_CreateDeviceObjects();
+IMGUI_IMPL_API void     ImGui_ImplNull_InvalidateDeviceObjects();
@@ -0,0 +1,1645 @@
+// imcxx: headless frame-time benchmark
+// Drives scripted scenes through the null backend for N frames and reports per-phase timings,
+// vertex/index/draw-call counts and allocation counts.
+//
+// usage: imcxx_bench [--frames N] [--warmup N] [--scene NAME|all] [--size WxH] [--list]
+//                    [--renderer null|software] [--threads N] [--dump PREFIX] [--text-cache N] [--reuse-lists]
+//
+// --renderer software rasterizes every frame on the CPU (see ../software/imgui_impl_software.cpp),
+// --dump writes the last software-rendered frame of each scene to PREFIX_<scene>.tga.
+// --reuse-lists keeps a buffer per draw list in the null renderer and only copies the draw lists that changed.
+
+
+#include <chrono>
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <memory_resource>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "imgui/imcxx/all_in_one.hpp"
+#include "imgui/imcxx/misc/console.hpp"
+#include "imgui/imcxx/misc/draw_recorder.hpp"
+#include "imgui/imcxx/misc/font_loader.hpp"
+#include "imgui/imcxx/misc/line_plot.hpp"
+#include "imgui/imcxx/misc/log_viewer.hpp"
+#include "imgui/imcxx/misc/notification.hpp"
+#include "imgui/imcxx/misc/scrolling_plot.hpp"
+#include "imgui/imcxx/misc/shortcut.hpp"
+#include "imgui/imcxx/misc/text_editor.hpp"
+
+#include "imgui_impl_null.h"
+#include "../software/imgui_impl_software.h"
+
+
+// The replaced operator new/delete below are malloc/free based, GCC flags them once inlined into std containers
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpragmas"                  // warning: unknown option after '#pragma GCC diagnostic' kind
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"    // warning: 'void free(void*)' called on pointer returned from a mismatched allocation function
+#endif
+
+// Allocation counters
+// ImGui allocations go through SetAllocatorFunctions(), everything else (std containers in imcxx::misc) through operator new.
+static std::atomic<size_t> g_ImGuiAllocs{ 0 };
+static std::atomic<size_t> g_NewAllocs{ 0 };
+
+static void* CountingMalloc(size_t sz, void*)
+{
+    g_ImGuiAllocs.fetch_add(1, std::memory_order_relaxed);
+    return malloc(sz);
+}
+
+static void CountingFree(void* ptr, void*)
+{
+    free(ptr);
+}
+
+void* operator new(size_t sz)
+{
+    g_NewAllocs.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = malloc(sz ? sz : 1))
+        return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+
+// Scenes
+struct BenchScene
+{
+    const char* Name;
+    const char* Description;
+    void        (*Setup)();
+    void        (*Submit)(int frame);
+    void        (*BeforeNewFrame)(int frame) = nullptr;   // Between two frames, before the backends' NewFrame()
+    void        (*Shutdown)() = nullptr;                  // After the last frame, before the context is destroyed
+};
+
+static void SceneDemo_Submit(int)
+{
+    ImGui::ShowDemoWindow();
+    ImGui::ShowMetricsWindow();
+}
+
+static void SceneTable_Submit(int)
+{
+    constexpr int rows_count = 10000;
+    constexpr int columns_count = 8;
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window table_window{ "Table", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!table_window)
+        return;
+
+    imcxx::table big_table{ "##BigTable", columns_count, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable };
+    if (!big_table)
+        return;
+
+    big_table.setup(0, 1, "Id", "Name", "Price", "Quantity", "Side", "Status", "Venue", "Time");
+    for (int row = 0; row < rows_count; row++)
+    {
+        big_table.next_row();
+        big_table.next_column();
+        imcxx::text::call("%d", row);
+        big_table.next_column();
+        imcxx::text::call("Order #%d", row);
+        big_table.next_column();
+        imcxx::text::call("%.2f", 100.0 + row * 0.01);
+        big_table.next_column();
+        imcxx::text::call("%d", (row * 7) % 1000);
+        big_table.next_column();
+        imcxx::text::call(row & 1 ? "Buy" : "Sell");
+        big_table.next_column();
+        imcxx::text::call("Filled");
+        big_table.next_column();
+        imcxx::text::call("XNAS");
+        big_table.next_column();
+        imcxx::text::call("%02d:%02d:%02d", (row / 3600) % 24, (row / 60) % 60, row % 60);
+    }
+}
+
+struct BenchOrder
+{
+    int     Id;
+    float   Price;
+    int     Quantity;
+    bool    Buy;
+};
+
+static std::vector<BenchOrder> g_Orders;
+static int g_SelectedOrder = -1;
+
+static void SceneTableView_Setup()
+{
+    constexpr int rows_count = 2000000;
+
+    g_Orders.resize(rows_count);
+    for (int row = 0; row < rows_count; row++)
+        g_Orders[row] = { row, 100.f + row * 0.01f, (row * 7) % 1000, (row & 1) != 0 };
+}
+
+static void SceneTableView_Submit(int frame)
+{
+    using view_type = imcxx::table_view<std::vector<BenchOrder>>;
+    static const view_type::column_info columns[] =
+    {
+        { { "Id" },       [](const BenchOrder& order, size_t) { if (ImGui::Selectable("##select", g_SelectedOrder == order.Id, ImGuiSelectableFlags_SpanAllColumns)) g_SelectedOrder = order.Id; ImGui::SameLine(); imcxx::text::call("%d", order.Id); } },
+        { { "Name" },     [](const BenchOrder& order, size_t) { imcxx::text::call("Order #%d", order.Id); } },
+        { { "Price" },    [](const BenchOrder& order, size_t) { imcxx::text::call("%.2f", order.Price); } },
+        { { "Quantity" }, [](const BenchOrder& order, size_t) { imcxx::text::call("%d", order.Quantity); } },
+        { { "Side" },     [](const BenchOrder& order, size_t) { imcxx::text::call(order.Buy ? "Buy" : "Sell"); } },
+        { { "Status" },   [](const BenchOrder&, size_t) { imcxx::text::call("Filled"); } },
+        { { "Venue" },    [](const BenchOrder&, size_t) { imcxx::text::call("XNAS"); } },
+        { { "Time" },     [](const BenchOrder& order, size_t) { imcxx::text::call("%02d:%02d:%02d", (order.Id / 3600) % 24, (order.Id / 60) % 60, order.Id % 60); } },
+    };
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window table_window{ "TableView", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!table_window)
+        return;
+
+    view_type view{ "##OrdersView", g_Orders, columns, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable };
+    if (!view)
+        return;
+
+    // Scroll through the whole range so the clipper never sees the same window twice in a row
+    ImGui::SetScrollY(ImGui::GetScrollMaxY() * static_cast<float>(frame % 97) / 96.f);
+    view.setup(0, 1);
+    view.render([](const BenchOrder& order, size_t) { return static_cast<size_t>(order.Id); });
+}
+
+static std::vector<BenchOrder> g_SortedOrders;
+
+static int CompareOrders(int a, int b)
+{
+    return (a > b) - (a < b);
+}
+
+static void SceneTableSort_Setup()
+{
+    constexpr int rows_count = 1000000;
+
+    g_SortedOrders.resize(rows_count);
+    for (int row = 0; row < rows_count; row++)
+        g_SortedOrders[row] = { row, 100.f + static_cast<float>((static_cast<long long>(row) * 7919) % 100000) * 0.01f, (row * 7) % 1000, (row & 1) != 0 };
+}
+
+static void SceneTableSort_Submit(int frame)
+{
+    using view_type = imcxx::table_view<std::vector<BenchOrder>>;
+    using sorter_type = imcxx::table_sorter<std::vector<BenchOrder>>;
+    static const view_type::column_info columns[] =
+    {
+        { { "Id" },       [](const BenchOrder& order, size_t) { imcxx::text::call("%d", order.Id); } },
+        { { "Price" },    [](const BenchOrder& order, size_t) { imcxx::text::call("%.2f", order.Price); } },
+        { { "Quantity" }, [](const BenchOrder& order, size_t) { imcxx::text::call("%d", order.Quantity); } },
+        { { "Side" },     [](const BenchOrder& order, size_t) { imcxx::text::call(order.Buy ? "Buy" : "Sell"); } },
+    };
+    static sorter_type sorter{
+        {
+            [](const BenchOrder& a, const BenchOrder& b) { return CompareOrders(a.Id, b.Id); },
+            [](const BenchOrder& a, const BenchOrder& b) { return (a.Price > b.Price) - (a.Price < b.Price); },
+            [](const BenchOrder& a, const BenchOrder& b) { return CompareOrders(a.Quantity, b.Quantity); },
+            [](const BenchOrder& a, const BenchOrder& b) { return CompareOrders(a.Buy, b.Buy); },
+        },
+        100000
+    };
+
+    // Live feed: new orders and fills, only while no background sort reads the vector
+    if (!sorter.is_sorting())
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            const int id = static_cast<int>(g_SortedOrders.size());
+            g_SortedOrders.push_back({ id, 100.f + static_cast<float>((static_cast<long long>(id) * 7919) % 100000) * 0.01f, (id * 7) % 1000, (id & 1) != 0 });
+        }
+        for (int i = 0; i < 20; i++)
+        {
+            const size_t index = (static_cast<size_t>(frame) * 7919 + i * 104729) % g_SortedOrders.size();
+            g_SortedOrders[index].Quantity = (g_SortedOrders[index].Quantity + 1) % 1000;
+            sorter.invalidate(index);
+        }
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window table_window{ "TableSort", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!table_window)
+        return;
+
+    view_type view{ "##SortedOrders", g_SortedOrders, columns, ImGuiTableFlags_ScrollY | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders };
+    if (!view)
+        return;
+
+    view.setup(0, 1);
+    // Click on another header every 600 frames
+    if (frame % 600 == 0)
+        ImGui::TableSetColumnSortDirection((frame / 600) % 4, (frame / 2400) & 1 ? ImGuiSortDirection_Descending : ImGuiSortDirection_Ascending, false);
+    view.sort(sorter);
+    view.render();
+}
+
+static std::vector<std::string> g_Alerts;
+
+static void SceneAlerts_Setup()
+{
+    constexpr int alerts_count = 200000;
+
+    static const char* const words[] = { "price", "limit", "breached", "on", "venue", "XNAS", "order", "rejected", "by", "risk", "check", "position", "exceeds", "threshold" };
+    g_Alerts.resize(alerts_count);
+    for (int i = 0; i < alerts_count; i++)
+    {
+        std::string& alert = g_Alerts[i];
+        alert = "Alert #" + std::to_string(i) + ":";
+        const int words_count = 4 + (i * 37) % 90;
+        for (int w = 0; w < words_count; w++)
+        {
+            alert += ' ';
+            alert += words[(i + w * 5) % IM_ARRAYSIZE(words)];
+        }
+    }
+}
+
+static void SceneAlerts_Submit(int frame)
+{
+    static imcxx::variable_clipper clipper;
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window alerts_window{ "Alerts", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!alerts_window)
+        return;
+
+    // Scroll through the whole feed, heights get measured on the way
+    ImGui::SetScrollY(ImGui::GetScrollMaxY() * static_cast<float>(frame % 97) / 96.f);
+    clipper.render(
+        g_Alerts.size(),
+        [](size_t i)
+        {
+            // Every 16th alert is an expandable entry with details, open one out of two
+            if (i % 16 == 0)
+            {
+                ImGui::SetNextItemOpen(i % 32 == 0, ImGuiCond_Once);
+                imcxx::tree_node{ reinterpret_cast<void*>(i), 0, "Alert group #%zu", i / 16 } <<
+                    [i]()
+                {
+                    imcxx::text::call("Acknowledged by: operator %zu", i % 7);
+                    imcxx::text::call("Desk: equities");
+                    imcxx::text::call("Escalation: none");
+                };
+            }
+            imcxx::text{ imcxx::text::wrapped{}, std::string_view{ g_Alerts[i] } };
+        }
+    );
+}
+
+static imcxx::misc::log_viewer g_LogViewer;
+static std::string g_LogPath;
+static FILE* g_LogWriter = nullptr;
+
+static void SceneLog_Setup()
+{
+    constexpr int lines_count = 2000000;
+
+    static const char* const levels[] = { "INFO ", "DEBUG", "WARN ", "ERROR" };
+    g_LogPath = (std::filesystem::temp_directory_path() / "imcxx_bench.log").string();
+    g_LogWriter = fopen(g_LogPath.c_str(), "wb");
+    if (!g_LogWriter)
+        return;
+    std::atexit([]
+    {
+        g_LogViewer.close();
+        fclose(g_LogWriter);
+        std::remove(g_LogPath.c_str());
+    });
+    for (int i = 0; i < lines_count; i++)
+        fprintf(g_LogWriter, "2022-03-01 12:%02d:%02d.%03d [%s] order-gateway: session %d heartbeat, %d messages queued\n", (i / 60000) % 60, (i / 1000) % 60, i % 1000, levels[(i * 7) % 4], i % 97, (i * 13) % 1000);
+    fflush(g_LogWriter);
+
+    const auto start = std::chrono::steady_clock::now();
+    g_LogViewer.open(g_LogPath.c_str());
+    const auto opened = std::chrono::steady_clock::now();
+    while (g_LogViewer.is_indexing())
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    const auto indexed = std::chrono::steady_clock::now();
+    printf("log_viewer: %.1f MB opened in %.0f us, %zu lines indexed in %.1f ms\n",
+        static_cast<double>(g_LogViewer.indexed_size()) / (1024.0 * 1024.0),
+        std::chrono::duration<double, std::micro>(opened - start).count(),
+        g_LogViewer.lines_count(),
+        std::chrono::duration<double, std::milli>(indexed - opened).count());
+}
+
+static void SceneLog_Submit(int frame)
+{
+    // Keep the file growing, the viewer follows the tail as the indexer catches up
+    if (g_LogWriter)
+    {
+        for (int i = 0; i < 10; i++)
+            fprintf(g_LogWriter, "2022-03-01 13:00:00.000 [INFO ] order-gateway: frame %d, appended line %d\n", frame, i);
+        fflush(g_LogWriter);
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window log_window{ "Log", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!log_window)
+        return;
+
+    imcxx::text::call("%s: %zu lines", g_LogPath.c_str(), g_LogViewer.lines_count());
+    g_LogViewer.render("##log");
+}
+
+static imcxx::misc::console g_Console;
+static std::atomic<bool> g_ConsoleQuit{ false };
+static std::vector<std::thread> g_ConsoleWorkers;
+
+static void SceneConsole_Setup()
+{
+    constexpr int workers_count = 4;
+
+    for (int w = 0; w < workers_count; w++)
+    {
+        g_ConsoleWorkers.emplace_back(
+            [w]()
+            {
+                // Bursts of lines, like workers reporting progress
+                for (int i = 0; !g_ConsoleQuit.load(std::memory_order_relaxed); i++)
+                {
+                    if (i % 16 == 0)
+                        g_Console.push({ { "[WARN] ", 0xFF'00'C0'FF }, { "worker " }, { std::string_view{ "0123" + w, 1 }, 0xFF'FF'C0'40 }, { ": queue above threshold" } });
+                    else
+                        g_Console.pushf(imcxx::misc::console::text_color, "[INFO] worker %d: processed batch %d", w, i);
+                    if (i % 64 == 63)
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        );
+    }
+    std::atexit([]
+    {
+        g_ConsoleQuit = true;
+        for (std::thread& worker : g_ConsoleWorkers)
+            worker.join();
+    });
+}
+
+static void SceneConsole_Submit(int)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window console_window{ "Console", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!console_window)
+        return;
+
+    imcxx::text::call("%zu lines, %zu dropped", g_Console.lines_count(), g_Console.dropped());
+    g_Console.render("##console");
+}
+
+static imcxx::misc::text_editor g_Editor;
+
+static void SceneEditor_Setup()
+{
+    constexpr int lines_count = 100000;
+
+    std::string text;
+    char line[128];
+    for (int i = 0; i < lines_count; i++)
+        text.append(line, ImFormatString(line, sizeof(line), "gateway.session[%d].endpoint = \"tcp://10.0.%d.%d:%d\"  # heartbeat %d ms\n", i, (i / 256) % 256, i % 256, 9000 + i % 1000, 100 + i % 900));
+
+    const auto start = std::chrono::steady_clock::now();
+    g_Editor.set_text(text);
+    const auto loaded = std::chrono::steady_clock::now();
+    g_Editor.set_cursor(g_Editor.line_offset(lines_count / 2));
+    printf("text_editor: %.1f MB, %zu lines loaded in %.1f ms\n",
+        static_cast<double>(g_Editor.size()) / (1024.0 * 1024.0),
+        g_Editor.lines_count(),
+        std::chrono::duration<double, std::milli>(loaded - start).count());
+}
+
+static void SceneEditor_Submit(int frame)
+{
+    // Type in the middle of the document, with a line return and an undo from time to time
+    ImGuiIO& io = ImGui::GetIO();
+    switch (frame % 60)
+    {
+    case 20: io.AddKeyEvent(ImGuiKey_Enter, true); break;
+    case 21: io.AddKeyEvent(ImGuiKey_Enter, false); break;
+    case 40: io.AddKeyModsEvent(ImGuiKeyModFlags_Ctrl); io.AddKeyEvent(ImGuiKey_LeftCtrl, true); io.AddKeyEvent(ImGuiKey_Z, true); break;
+    case 41: io.AddKeyEvent(ImGuiKey_Z, false); io.AddKeyModsEvent(ImGuiKeyModFlags_None); io.AddKeyEvent(ImGuiKey_LeftCtrl, false); break;
+    default: io.AddInputCharacter('a' + frame % 26); break;
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    imcxx::window editor_window{ "Editor", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!editor_window)
+        return;
+
+    imcxx::text::call("%zu bytes, %zu lines", g_Editor.size(), g_Editor.lines_count());
+    if (frame == 0)
+        ImGui::SetNextWindowFocus();
+    g_Editor.render("##editor");
+}
+
+// Strings loaded from a settings file, capacity == size until they are edited
+static std::vector<std::string> g_Fields;
+
+// Fixed caller-owned arena, no heap fallback: released when the fields are loaded again
+alignas(std::max_align_t) static std::byte g_ArenaBuffer[1 << 20];
+static std::pmr::monotonic_buffer_resource g_Arena{ g_ArenaBuffer, sizeof(g_ArenaBuffer), std::pmr::null_memory_resource() };
+static std::pmr::vector<std::pmr::string> g_ArenaFields{ &g_Arena };
+
+static constexpr int g_FieldsCount = 16;
+static constexpr int g_FramesPerField = 64;
+
+static void SceneInputFields_Setup()
+{
+    // The arena only grows: the strings using it are destroyed before it is released
+    g_Fields.clear();
+    g_ArenaFields = std::pmr::vector<std::pmr::string>{ &g_Arena };
+    g_Arena.release();
+
+    char value[64];
+    for (int i = 0; i < g_FieldsCount; i++)
+    {
+        ImFormatString(value, sizeof(value), "tcp://gateway-%02d.example.net:9000/session", i);
+        g_Fields.emplace_back(value).shrink_to_fit();
+        g_ArenaFields.emplace_back(value);
+    }
+}
+
+template<bool _Arena>
+static void SceneInputFields_Submit(int frame)
+{
+    // One key per frame: focus a field, move to its end and type 60 characters, then the next field.
+    // Once every field was edited they are loaded again, so long runs don't grow them (and the arena) forever.
+    constexpr int frames_per_field = g_FramesPerField;
+    if (frame != 0 && frame % (g_FieldsCount * frames_per_field) == 0)
+        SceneInputFields_Setup();
+    ImGuiIO& io = ImGui::GetIO();
+    const int field = (frame / frames_per_field) % g_FieldsCount;
+    switch (frame % frames_per_field)
+    {
+    case 0: case 1: break;
+    case 2: io.AddKeyEvent(ImGuiKey_End, true); break;
+    case 3: io.AddKeyEvent(ImGuiKey_End, false); break;
+    default: io.AddInputCharacter('a' + frame % 26); break;
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(io.DisplaySize);
+    imcxx::window fields_window{ "Fields", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!fields_window)
+        return;
+
+    char label[32];
+    for (size_t i = 0; i < g_Fields.size(); i++)
+    {
+        ImFormatString(label, sizeof(label), "Endpoint #%d", static_cast<int>(i));
+        if (frame % frames_per_field == 0 && static_cast<int>(i) == field)
+            ImGui::SetKeyboardFocusHere();
+        if constexpr (_Arena)
+            imcxx::input{ imcxx::input::text{}, label, g_ArenaFields[i] };
+        else
+            imcxx::input{ imcxx::input::text{}, label, g_Fields[i] };
+    }
+}
+
+static std::vector<std::string> g_Instruments;
+
+static void SceneTextSizes_Setup()
+{
+    constexpr int instruments_count = 3000;
+
+    static const char* const issuers[] = { "Northwind Traders", "Contoso Pharmaceuticals", "Fabrikam Industries", "Tailspin Aeronautics", "Litware Semiconductors", "Adventure Works Cycles" };
+    static const char* const kinds[] = { "common stock", "preferred shares", "senior notes 2031", "convertible bonds 2027", "call warrant", "depositary receipts" };
+    g_Instruments.resize(instruments_count);
+    for (int i = 0; i < instruments_count; i++)
+        g_Instruments[i] = std::string(issuers[i % IM_ARRAYSIZE(issuers)]) + " " + kinds[(i / IM_ARRAYSIZE(issuers)) % IM_ARRAYSIZE(kinds)] + " #" + std::to_string(i);
+}
+
+static void SceneTextSizes_Submit(int)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window instruments_window{ "Instruments", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!instruments_window)
+        return;
+
+    // Fixed-fit columns measure every cell, the same labels every frame
+    imcxx::table instruments{ "##instruments", 3, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders };
+    if (!instruments)
+        return;
+
+    instruments.setup(0, 1, "Instrument", "Issuer", "Action");
+    for (size_t i = 0; i < g_Instruments.size(); i++)
+    {
+        const std::string& name = g_Instruments[i];
+        imcxx::shared_item_id row_id{ static_cast<int>(i) };
+        instruments.next_row();
+        instruments.next_column();
+        imcxx::text{ std::string_view{ name } };
+        instruments.next_column();
+        imcxx::text{ std::string_view{ name }.substr(0, name.find(' ', name.find(' ') + 1)) };
+        instruments.next_column();
+        imcxx::button{ "Request for quote##rfq" };
+    }
+}
+
+static void SceneWindows_Submit(int)
+{
+    constexpr int windows_count = 200;
+
+    char name[32];
+    const ImVec2 display_size = ImGui::GetIO().DisplaySize;
+    for (int i = 0; i < windows_count; i++)
+    {
+        ImFormatString(name, sizeof(name), "Window #%d", i);
+        ImGui::SetNextWindowPos({ (i % 20) * (display_size.x / 20.f), (i / 20) * (display_size.y / 10.f) }, ImGuiCond_Once);
+        ImGui::SetNextWindowSize({ 240.f, 160.f }, ImGuiCond_Once);
+        imcxx::window{ name } <<
+            [i]()
+        {
+            static float value = 0.5f;
+            static bool checked = false;
+
+            imcxx::text::call("Window index: %d", i);
+            imcxx::button::call("Button");
+            imcxx::checkbox::call("Checkbox", &checked);
+            imcxx::slider::call("Slider", &value, 0.f, 1.f);
+        };
+    }
+}
+
+static void SceneNotifications_Submit(int frame)
+{
+    // Keep the pending queue busy: a new notification every few frames, each living for one second.
+    if (frame % 4 == 0)
+    {
+        imcxx::misc::notification::reg_info cfg;
+        cfg.Title.emplace_back("Benchmark", imcxx::misc::notification::color_to_u32({ 1.f, 0.5f, 0.f, 1.f }));
+        cfg.Texts.emplace_back("Notification body line #1");
+        cfg.Texts.emplace_back("Notification body line #2", imcxx::misc::notification::color_to_u32({ 0.f, 1.f, 0.f, 1.f }));
+        cfg.Duration = 1.f;
+        imcxx::misc::notification::call(std::move(cfg));
+    }
+    imcxx::misc::notification::render();
+}
+
+static void SceneShortcuts_Setup()
+{
+    constexpr int shortcuts_count = 500;
+
+    char name[32];
+    for (int i = 0; i < shortcuts_count; i++)
+    {
+        ImFormatString(name, sizeof(name), "Shortcut #%d", i);
+        imcxx::misc::shortcuts::bind(
+            name,
+            { ImGuiKey_LeftCtrl, ImGuiKey_LeftShift, static_cast<uint16_t>(ImGuiKey_A + i % 26) },
+            i & 1 ? imcxx::misc::shortcuts_type::bind_persist : imcxx::misc::shortcuts_type::bind_default,
+            [](bool* p_open)
+            {
+                imcxx::window{ "Shortcut window", p_open } <<
+                    []()
+                {
+                    imcxx::text::call("Triggered by a shortcut");
+                };
+            }
+        );
+    }
+}
+
+static void SceneShortcuts_Submit(int frame)
+{
+    // Press and release Ctrl+Shift+<letter> on a fixed schedule, the events are consumed by the next NewFrame().
+    ImGuiIO& io = ImGui::GetIO();
+    const ImGuiKey letter = static_cast<ImGuiKey>(ImGuiKey_A + (frame / 8) % 26);
+    switch (frame % 8)
+    {
+    case 0: io.AddKeyModsEvent(ImGuiKeyModFlags_Ctrl); io.AddKeyEvent(ImGuiKey_LeftCtrl, true); break;
+    case 1: io.AddKeyModsEvent(ImGuiKeyModFlags_Ctrl | ImGuiKeyModFlags_Shift); io.AddKeyEvent(ImGuiKey_LeftShift, true); break;
+    case 2: io.AddKeyEvent(letter, true); break;
+    case 4: io.AddKeyEvent(letter, false); break;
+    case 5: io.AddKeyModsEvent(ImGuiKeyModFlags_Ctrl); io.AddKeyEvent(ImGuiKey_LeftShift, false); break;
+    case 6: io.AddKeyModsEvent(ImGuiKeyModFlags_None); io.AddKeyEvent(ImGuiKey_LeftCtrl, false); break;
+    }
+    imcxx::misc::shortcuts::handle_callbacks();
+}
+
+// Same tree with string labels (hashed every frame) or precomputed imcxx::label_id
+template<bool _UseLabelId>
+static void SceneLabels_Submit(int)
+{
+    using namespace imcxx::literals;
+    constexpr int groups_count = 2000;
+    static constexpr imcxx::label_id group_id = "Instrument group###group"_id;
+    static constexpr imcxx::label_id details_id = "Order book and trade details##details"_id;
+    static constexpr imcxx::label_id history_id = "Execution history##history"_id;
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window labels_window{ "Labels", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!labels_window)
+        return;
+
+    for (int i = 0; i < groups_count; i++)
+    {
+        imcxx::shared_item_id group_scope{ i };
+        if constexpr (_UseLabelId)
+        {
+            imcxx::tree_node group{ group_id, ImGuiTreeNodeFlags_DefaultOpen };
+            if (!group)
+                continue;
+            imcxx::tree_node details{ details_id };
+            imcxx::collapsing_header history{ history_id };
+        }
+        else
+        {
+            imcxx::tree_node group{ "Instrument group###group", ImGuiTreeNodeFlags_DefaultOpen };
+            if (!group)
+                continue;
+            imcxx::tree_node details{ "Order book and trade details##details" };
+            imcxx::collapsing_header history{ "Execution history##history" };
+        }
+    }
+}
+
+// Charts: thick anti-aliased polylines with markers, tessellated on the UI thread or by imcxx::misc::draw_recorder
+static constexpr int g_ChartsCount = 8;
+static std::vector<ImVec2> g_ChartPoints[g_ChartsCount];
+static std::vector<ImVec2> g_ChartScratch[g_ChartsCount];
+static ImRect g_ChartRects[g_ChartsCount];
+
+static void SceneCharts_Setup()
+{
+    constexpr int points_count = 20000;
+
+    for (int c = 0; c < g_ChartsCount; c++)
+    {
+        g_ChartPoints[c].resize(points_count);
+        for (int i = 0; i < points_count; i++)
+        {
+            const float x = static_cast<float>(i) / (points_count - 1);
+            const float y = 0.5f + 0.35f * sinf(x * (6.0f + c) * IM_PI) + 0.1f * sinf(x * 173.0f * (c + 1));
+            g_ChartPoints[c][i] = { x, y };
+        }
+    }
+}
+
+static void DrawChart(ImDrawList& draw_list, int c)
+{
+    const ImVec2 min = g_ChartRects[c].Min;
+    const ImVec2 max = g_ChartRects[c].Max;
+    const std::vector<ImVec2>& points = g_ChartPoints[c];
+    std::vector<ImVec2>& scratch = g_ChartScratch[c];
+    scratch.resize(points.size());
+    for (size_t i = 0; i < points.size(); i++)
+        scratch[i] = { min.x + points[i].x * (max.x - min.x), max.y - points[i].y * (max.y - min.y) };
+
+    draw_list.AddRect(min, max, IM_COL32(90, 90, 90, 255));
+    draw_list.AddPolyline(scratch.data(), static_cast<int>(scratch.size()), IM_COL32(80, 200, 255, 255), 0, 2.0f);
+    for (size_t i = 0; i < scratch.size(); i += 100)
+        draw_list.AddCircleFilled(scratch[i], 3.0f, IM_COL32(255, 180, 60, 255));
+}
+
+template<bool _Recorded>
+static void SceneCharts_Submit(int)
+{
+    static imcxx::misc::draw_recorder recorder;
+
+    char name[32];
+    const ImVec2 display_size = ImGui::GetIO().DisplaySize;
+    const ImVec2 window_size{ display_size.x / 4, display_size.y / 2 };
+    for (int c = 0; c < g_ChartsCount; c++)
+    {
+        ImFormatString(name, sizeof(name), "Chart #%d", c);
+        ImGui::SetNextWindowPos({ window_size.x * (c % 4), window_size.y * (c / 4) });
+        ImGui::SetNextWindowSize(window_size);
+        imcxx::window chart_window{ name, nullptr, ImGuiWindowFlags_NoDecoration };
+        if (!chart_window)
+            continue;
+
+        const ImVec2 cursor = ImGui::GetCursorScreenPos();
+        const ImVec2 window_pos = ImGui::GetWindowPos();
+        const ImVec2 region_max = ImGui::GetWindowContentRegionMax();
+        g_ChartRects[c] = { cursor.x, cursor.y + ImGui::GetTextLineHeightWithSpacing(), window_pos.x + region_max.x, window_pos.y + region_max.y };
+        size_t ticket = 0;
+        if constexpr (_Recorded)
+            ticket = recorder.record([c](ImDrawList& draw_list) { DrawChart(draw_list, c); });
+
+        imcxx::text::call("Session %d, %zu samples", c, g_ChartPoints[c].size());
+        if constexpr (_Recorded)
+            recorder.splice(ticket);
+        else
+            DrawChart(*ImGui::GetWindowDrawList(), c);
+    }
+}
+
+// Help panels: the same wrapped paragraphs every frame, laid out by ImGui::TextWrapped() or copied from imcxx::retained_text
+static std::vector<std::string> g_HelpParagraphs;
+
+static void SceneHelpText_Setup()
+{
+    if (!g_HelpParagraphs.empty())
+        return;
+
+    static const char* const sentences[] =
+    {
+        "Drag a node by its title bar to move it, hold Shift to move the whole selection.",
+        "Right-click on an empty area to open the context menu and create a new node.",
+        "Links are created by dragging from an output pin to a compatible input pin.",
+        "Press Ctrl+Z to undo the last change, Ctrl+Y to redo it.",
+        "Values shown in orange are overridden by the selected profile.",
+        "Double-click on a value to edit it, Enter to validate and Escape to cancel.",
+    };
+    for (int i = 0; i < 160; i++)
+    {
+        std::string paragraph;
+        for (int j = 0; j < 2 + i % 4; j++)
+            paragraph.append(sentences[(i + j) % std::size(sentences)]).append(" ");
+        g_HelpParagraphs.push_back(std::move(paragraph));
+    }
+}
+
+template<bool _Retained>
+static void SceneHelpText_Submit(int frame)
+{
+    static std::vector<imcxx::retained_text> retained;
+    if (_Retained && retained.empty())
+        for (const std::string& paragraph : g_HelpParagraphs)
+            retained.emplace_back(paragraph);
+
+    constexpr int panels_count = 4;
+    char name[32];
+    const ImVec2 display_size = ImGui::GetIO().DisplaySize;
+    const size_t paragraphs_per_panel = g_HelpParagraphs.size() / panels_count;
+    for (int p = 0; p < panels_count; p++)
+    {
+        ImFormatString(name, sizeof(name), "Help #%d", p);
+        ImGui::SetNextWindowPos({ display_size.x * p / panels_count, 0.f });
+        ImGui::SetNextWindowSize({ display_size.x / panels_count, display_size.y });
+        imcxx::window panel{ name, nullptr, ImGuiWindowFlags_NoDecoration };
+        if (!panel)
+            continue;
+
+        // One paragraph per panel with an animated color, as a hovered or highlighted text would be
+        const size_t highlighted = p * paragraphs_per_panel + frame % 8;
+        for (size_t i = p * paragraphs_per_panel; i < (p + 1) * paragraphs_per_panel; i++)
+        {
+            imcxx::shared_color color;
+            if (i == highlighted)
+                color.push(ImGuiCol_Text, ImColor::HSV((frame % 120) / 120.f, 0.6f, 1.f).Value);
+            if constexpr (_Retained)
+                retained[i].render(imcxx::text::wrapped{});
+            else
+                imcxx::text{ imcxx::text::wrapped{}, g_HelpParagraphs[i] };
+        }
+    }
+}
+
+// Dashboard: 12 panels of statistics, one of them updated every 30 frames, submitted every frame or replayed from imcxx::child_cache
+struct DashboardPanel
+{
+    float       Values[64];
+    uint64_t    Version;
+};
+
+static DashboardPanel g_DashboardPanels[12];
+
+static void SceneDashboard_Setup()
+{
+    for (int p = 0; p < IM_ARRAYSIZE(g_DashboardPanels); p++)
+        for (int i = 0; i < IM_ARRAYSIZE(g_DashboardPanels[p].Values); i++)
+            g_DashboardPanels[p].Values[i] = 0.5f + 0.4f * sinf(p + i * 0.2f);
+}
+
+static void DrawDashboardPanel(const DashboardPanel& panel, int p)
+{
+    imcxx::text::call("Service #%d", p);
+    ImGui::Separator();
+    for (int row = 0; row < 8; row++)
+    {
+        const float value = panel.Values[row * 8];
+        imcxx::text::call("Node %02d: %5.1f%% load, %d requests", row, value * 100.f, static_cast<int>(value * 1000.f));
+        ImGui::ProgressBar(value, { -FLT_MIN, 0.f });
+    }
+    ImGui::PlotLines("##history", panel.Values, IM_ARRAYSIZE(panel.Values), 0, nullptr, 0.f, 1.f, { -FLT_MIN, 60.f });
+}
+
+template<bool _Cached>
+static void SceneDashboard_Submit(int frame)
+{
+    static imcxx::child_cache caches[IM_ARRAYSIZE(g_DashboardPanels)];
+
+    if (frame % 30 == 0)
+    {
+        DashboardPanel& panel = g_DashboardPanels[(frame / 30) % IM_ARRAYSIZE(g_DashboardPanels)];
+        for (float& value : panel.Values)
+            value = fmodf(value + 0.173f, 1.f);
+        panel.Version++;
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window dashboard{ "Dashboard", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!dashboard)
+        return;
+
+    char name[32];
+    const ImVec2 panel_size{ ImGui::GetContentRegionAvail().x / 4.f - ImGui::GetStyle().ItemSpacing.x, 360.f };
+    for (int p = 0; p < IM_ARRAYSIZE(g_DashboardPanels); p++)
+    {
+        if (p % 4)
+            ImGui::SameLine();
+        ImFormatString(name, sizeof(name), "##panel%d", p);
+        const DashboardPanel& panel = g_DashboardPanels[p];
+        if constexpr (_Cached)
+            imcxx::window::child{ imcxx::window::child::cached{ caches[p], panel.Version }, name, panel_size, true } << [&]() { DrawDashboardPanel(panel, p); };
+        else
+            imcxx::window::child{ name, panel_size, true } << [&]() { DrawDashboardPanel(panel, p); };
+    }
+}
+
+// Gauges: dials drawn with explicit segment counts (AddCircle(), AddNgon(), PathArcTo()) and large arcs, tessellated with trigonometry unless cached
+static void SceneGauges_Submit(int frame)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window gauges{ "Gauges", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!gauges)
+        return;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    constexpr float radius = 30.f;
+    constexpr float a_min = IM_PI * 0.75f;
+    constexpr float a_max = IM_PI * 2.25f;
+    for (int g = 0; g < 240; g++)
+    {
+        const ImVec2 center{ origin.x + (g % 20) * radius * 2.3f + radius, origin.y + (g / 20) * radius * 2.3f + radius };
+        const float value = 0.5f + 0.45f * sinf(g * 0.7f + frame * 0.05f);
+        draw_list->AddCircleFilled(center, radius, IM_COL32(40, 40, 48, 255), 48);
+        draw_list->AddCircle(center, radius, IM_COL32(90, 90, 110, 255), 48, 2.f);
+        draw_list->PathArcTo(center, radius * 0.8f, a_min, a_max, 36);
+        draw_list->PathStroke(IM_COL32(70, 70, 80, 255), 0, 5.f);
+        draw_list->PathArcTo(center, radius * 0.8f, a_min, a_min + (a_max - a_min) * value, 36);
+        draw_list->PathStroke(IM_COL32(80, 200, 120, 255), 0, 5.f);
+        draw_list->AddNgonFilled(center, 5.f, IM_COL32(220, 220, 220, 255), 6);
+    }
+
+    // Large rings are past ArcFastRadiusCutoff: their segment count is computed and their points come from trigonometry
+    const ImVec2 center{ origin.x + 1640.f, origin.y + 400.f };
+    for (int r = 0; r < 8; r++)
+        draw_list->AddCircle(center, 160.f + r * 12.f, IM_COL32(120, 160, 255, 255), 0, 3.f);
+}
+
+// Market view: heatmap cells, scatter plot markers and order book depth lines, one ImDrawList call per shape or imcxx::draw_batch
+struct MarketShapes
+{
+    std::vector<float>  X, Y, W, H;
+    std::vector<ImU32>  Colors;
+};
+
+static MarketShapes g_MarketCells;      // 192x108 cells of 5x5 pixels
+static MarketShapes g_MarketPoints;     // 30k markers, a third of them out of the window
+static MarketShapes g_MarketLevels;     // 8k depth lines: (X, Y) to (W, H)
+
+static void SceneMarket_Setup()
+{
+    for (int row = 0; row < 108; row++)
+        for (int col = 0; col < 192; col++)
+        {
+            g_MarketCells.X.push_back(col * 5.f);
+            g_MarketCells.Y.push_back(row * 5.f);
+            g_MarketCells.W.push_back(4.f);
+            g_MarketCells.H.push_back(4.f);
+            g_MarketCells.Colors.push_back(IM_COL32(0, 0, 0, 255));
+        }
+    for (int i = 0; i < 30000; i++)
+    {
+        g_MarketPoints.X.push_back(960.f + static_cast<float>(i % 617) * 2.3f);
+        g_MarketPoints.Y.push_back(40.f + static_cast<float>((i * 7919) % 1000) * 0.5f);
+        g_MarketPoints.Colors.push_back(i % 3 ? IM_COL32(255, 200, 60, 200) : IM_COL32(90, 170, 255, 200));
+    }
+    for (int i = 0; i < 8000; i++)
+    {
+        const float y = 560.f + static_cast<float>(i % 500);
+        g_MarketLevels.X.push_back(i % 2 ? 960.f : 0.f);
+        g_MarketLevels.Y.push_back(y);
+        g_MarketLevels.W.push_back(i % 2 ? 960.f + static_cast<float>((i * 31) % 900) : static_cast<float>((i * 37) % 900));
+        g_MarketLevels.H.push_back(y);
+        g_MarketLevels.Colors.push_back(i % 2 ? IM_COL32(230, 80, 80, 255) : IM_COL32(80, 220, 120, 255));
+    }
+}
+
+template<bool _Batched>
+static void SceneMarket_Submit(int frame)
+{
+    for (size_t i = 0; i < g_MarketCells.Colors.size(); i++)
+    {
+        const int heat = static_cast<int>(127.5f + 127.5f * sinf(i * 0.037f + frame * 0.1f));
+        g_MarketCells.Colors[i] = IM_COL32(heat, 64, 255 - heat, 255);
+    }
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window market{ "Market", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!market)
+        return;
+
+    if constexpr (_Batched)
+    {
+        imcxx::draw_batch{}
+            .rects_filled(g_MarketCells.X.data(), g_MarketCells.Y.data(), g_MarketCells.W.data(), g_MarketCells.H.data(), g_MarketCells.Colors.data(), g_MarketCells.X.size())
+            .circles_filled(g_MarketPoints.X.data(), g_MarketPoints.Y.data(), 2.f, g_MarketPoints.Colors.data(), g_MarketPoints.X.size())
+            .lines(g_MarketLevels.X.data(), g_MarketLevels.Y.data(), g_MarketLevels.W.data(), g_MarketLevels.H.data(), g_MarketLevels.Colors.data(), g_MarketLevels.X.size());
+    }
+    else
+    {
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const MarketShapes& cells = g_MarketCells;
+        for (size_t i = 0; i < cells.X.size(); i++)
+            draw_list->AddRectFilled({ cells.X[i], cells.Y[i] }, { cells.X[i] + cells.W[i], cells.Y[i] + cells.H[i] }, cells.Colors[i]);
+        const MarketShapes& points = g_MarketPoints;
+        for (size_t i = 0; i < points.X.size(); i++)
+            draw_list->AddCircleFilled({ points.X[i], points.Y[i] }, 2.f, points.Colors[i]);
+        const MarketShapes& levels = g_MarketLevels;
+        for (size_t i = 0; i < levels.X.size(); i++)
+            draw_list->AddLine({ levels.X[i], levels.Y[i] }, { levels.W[i], levels.H[i] }, levels.Colors[i]);
+    }
+}
+
+// Telemetry: 10M samples growing by 2000 per frame, drawn by ImGui::PlotLines() or imcxx::misc::line_plot zooming in and out
+static std::vector<float> g_Telemetry;
+
+static float TelemetrySample(size_t i)
+{
+    const float t = static_cast<float>(i);
+    return sinf(t * 1e-5f) + 0.3f * sinf(t * 3.7e-3f) + ((i * 2654435761u) % 1000 == 0 ? 1.5f : 0.f);
+}
+
+static void SceneTelemetry_Setup()
+{
+    g_Telemetry.resize(10000000);
+    for (size_t i = 0; i < g_Telemetry.size(); i++)
+        g_Telemetry[i] = TelemetrySample(i);
+}
+
+template<bool _Decimated>
+static void SceneTelemetry_Submit(int frame)
+{
+    static imcxx::misc::line_plot plot;
+    if (frame == 0)
+        plot.assign(g_Telemetry.data(), g_Telemetry.size());
+
+    float appended[2000];
+    for (size_t i = 0; i < IM_ARRAYSIZE(appended); i++)
+        appended[i] = TelemetrySample(g_Telemetry.size() + i);
+    g_Telemetry.insert(g_Telemetry.end(), appended, appended + IM_ARRAYSIZE(appended));
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window telemetry{ "Telemetry", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!telemetry)
+        return;
+
+    if constexpr (_Decimated)
+    {
+        plot.append(appended, IM_ARRAYSIZE(appended));
+        // From the whole series down to 10k samples and back, every 120 frames
+        const double count = static_cast<double>(plot.size());
+        const double span = count * std::pow(1e4 / count, 0.5 - 0.5 * std::cos(frame * IM_PI / 60.));
+        const double center = count * (0.5 + 0.4 * std::sin(frame * 0.01));
+        plot.set_view(center - span * 0.5, center + span * 0.5);
+        plot.render("##telemetry", ImGui::GetContentRegionAvail());
+    }
+    else
+        ImGui::PlotLines("##telemetry", g_Telemetry.data(), static_cast<int>(g_Telemetry.size()), 0, nullptr, FLT_MAX, FLT_MAX, ImGui::GetContentRegionAvail());
+}
+
+// Metrics: 200 series sampled at 1 kHz by 4 worker threads, the last 2 seconds in imcxx::misc::scrolling_plot
+// Samples are timed by a clock of 60 frames per second: each frame wakes the workers to push the next 16 samples of their series,
+// and waits for them so that every frame draws the same amount of data whatever the frame rate
+static imcxx::misc::scrolling_plot g_Metrics{ 2.0 };
+static std::mutex g_MetricsMutex;
+static std::condition_variable g_MetricsTick;
+static int g_MetricsClock{ 0 };     // Guarded by 'g_MetricsMutex', samples to push
+static std::atomic<int> g_MetricsPushed[4];
+static bool g_MetricsQuit{ false };
+static std::vector<std::thread> g_MetricsWorkers;
+
+static void SceneMetrics_Setup()
+{
+    constexpr int workers_count = IM_ARRAYSIZE(g_MetricsPushed);
+    constexpr int series_per_worker = 50;
+
+    std::vector<imcxx::misc::scrolling_plot::series*> series;
+    for (int i = 0; i < workers_count * series_per_worker; i++)
+    {
+        char name[32];
+        ImFormatString(name, sizeof(name), "sensor %d", i);
+        series.push_back(&g_Metrics.add_series(name));
+    }
+
+    for (int w = 0; w < workers_count; w++)
+    {
+        std::vector<imcxx::misc::scrolling_plot::series*> owned(series.begin() + w * series_per_worker, series.begin() + (w + 1) * series_per_worker);
+        g_MetricsWorkers.emplace_back(
+            [w, owned]()
+            {
+                // Each series has a single producer: this thread
+                for (int n = 0;;)
+                {
+                    int clock;
+                    {
+                        std::unique_lock lock(g_MetricsMutex);
+                        g_MetricsTick.wait(lock, [&]() { return g_MetricsQuit || g_MetricsClock > n; });
+                        if (g_MetricsQuit)
+                            return;
+                        clock = g_MetricsClock;
+                    }
+
+                    for (; n < clock; n++)
+                    {
+                        const float t = static_cast<float>(n) * 0.001f;
+                        for (size_t i = 0; i < owned.size(); i++)
+                        {
+                            const float s = static_cast<float>(w * series_per_worker + static_cast<int>(i));
+                            owned[i]->push(n * 0.001, s * 0.05f + 0.4f * sinf(t * (3.f + s * 0.07f)) + 0.1f * sinf(t * 190.f + s));
+                        }
+                    }
+                    g_MetricsPushed[w].store(n, std::memory_order_release);
+                }
+            }
+        );
+    }
+    std::atexit([]
+    {
+        {
+            std::lock_guard lock(g_MetricsMutex);
+            g_MetricsQuit = true;
+        }
+        g_MetricsTick.notify_all();
+        for (std::thread& worker : g_MetricsWorkers)
+            worker.join();
+    });
+}
+
+static void SceneMetrics_Submit(int)
+{
+    int clock;
+    {
+        std::lock_guard lock(g_MetricsMutex);
+        clock = g_MetricsClock += 1000 / 60;
+    }
+    g_MetricsTick.notify_all();
+    for (std::atomic<int>& pushed : g_MetricsPushed)
+        while (pushed.load(std::memory_order_acquire) < clock)
+            std::this_thread::yield();
+
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window metrics{ "Metrics", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!metrics)
+        return;
+
+    g_Metrics.render("##metrics", ImGui::GetContentRegionAvail());
+}
+
+// Fonts: the atlas is rebuilt for another DPI scale every 60 frames (8 sizes of the default font, oversampled),
+// on the UI thread between two frames, or on a worker by imcxx::misc::font_loader while the previous atlas keeps rendering
+static std::unique_ptr<imcxx::misc::font_loader> g_FontLoader;
+
+static void SceneFonts_Build(ImFontAtlas& atlas, float scale)
+{
+    ImFontConfig config;
+    config.OversampleH = 3;
+    config.OversampleV = 2;
+    for (const float size : { 13.f, 16.f, 20.f, 24.f, 32.f, 40.f, 48.f, 64.f })
+    {
+        config.SizePixels = size * scale;
+        atlas.AddFontDefault(&config);
+    }
+}
+
+static float SceneFonts_Scale(int frame)
+{
+    return (frame / 60) % 2 ? 1.25f : 1.f;
+}
+
+// The renderer backend creates the texture of the new atlas in its NewFrame()
+static void SceneFonts_ReloadTexture()
+{
+    const char* renderer = ImGui::GetIO().BackendRendererName;
+    if (renderer && !strcmp(renderer, "imgui_impl_software"))
+        ImGui_ImplSoftware_InvalidateDeviceObjects();
+    else
+        ImGui_ImplNull_InvalidateDeviceObjects();
+}
+
+static void SceneFonts_Setup()
+{
+    ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+    atlas.Clear();
+    SceneFonts_Build(atlas, SceneFonts_Scale(0));
+    g_FontLoader = std::make_unique<imcxx::misc::font_loader>(SceneFonts_ReloadTexture);
+}
+
+// Waits for a build still running, so that it neither runs into the next scene nor outlives the context
+static void SceneFonts_Shutdown()
+{
+    g_FontLoader.reset();
+}
+
+template<bool _Async>
+static void SceneFonts_BeforeNewFrame(int frame)
+{
+    const bool rebuild = frame % 60 == 0 && frame != 0;
+    if constexpr (_Async)
+    {
+        if (rebuild)
+            g_FontLoader->build([scale = SceneFonts_Scale(frame)](ImFontAtlas& atlas) { SceneFonts_Build(atlas, scale); });
+        g_FontLoader->apply();
+    }
+    else if (rebuild)
+    {
+        ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+        atlas.Clear();
+        SceneFonts_Build(atlas, SceneFonts_Scale(frame));
+        unsigned char* pixels;
+        int width, height;
+        atlas.GetTexDataAsRGBA32(&pixels, &width, &height);
+        SceneFonts_ReloadTexture();
+        ImGui::ClearTextSizeCache();
+    }
+}
+
+static void SceneFonts_Submit(int)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window fonts{ "Fonts", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!fonts)
+        return;
+
+    const ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+    imcxx::text::call("%dx%d atlas, built %d times", atlas.TexWidth, atlas.TexHeight, atlas.BuildCount);
+    for (ImFont* font : atlas.Fonts)
+    {
+        ImGui::PushFont(font);
+        imcxx::text::call("%.0f px: The quick brown fox jumps over the lazy dog", font->FontSize);
+        ImGui::PopFont();
+    }
+}
+
+// Glyphs
+enum SceneGlyphsMode
+{
+    SceneGlyphsMode_Baked,
+    SceneGlyphsMode_Dynamic,
+    SceneGlyphsMode_Evict,      // Dynamic glyphs in rows holding about one third of them
+};
+
+template<SceneGlyphsMode _Mode>
+static void SceneGlyphs_Setup()
+{
+    ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+    atlas.Clear();
+    if constexpr (_Mode == SceneGlyphsMode_Evict)
+    {
+        atlas.Flags |= ImFontAtlasFlags_NoPowerOfTwoHeight;
+        atlas.TexDynamicGlyphsHeight = 768;
+    }
+
+    ImFontConfig config;
+    config.OversampleH = 3;
+    config.OversampleV = 2;
+    config.DynamicGlyphs = _Mode != SceneGlyphsMode_Baked;
+    for (const float size : { 13.f, 16.f, 20.f, 24.f, 32.f, 40.f, 48.f, 64.f })
+    {
+        config.SizePixels = size;
+        atlas.AddFontDefault(&config);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    unsigned char* pixels;
+    int width, height;
+    atlas.GetTexDataAsRGBA32(&pixels, &width, &height);
+    printf("glyphs: %dx%d atlas built in %.2f ms\n", width, height, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+}
+
+static void SceneGlyphs_Submit(int frame)
+{
+    ImGui::SetNextWindowPos({ 0.f, 0.f });
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    imcxx::window glyphs{ "Glyphs", nullptr, ImGuiWindowFlags_NoDecoration };
+    if (!glyphs)
+        return;
+
+    const ImFontAtlas& atlas = *ImGui::GetIO().Fonts;
+    int glyphs_count = 0;
+    for (const ImFont* font : atlas.Fonts)
+        glyphs_count += font->Glyphs.Size;
+    imcxx::text::call("%dx%d atlas, %d glyphs, built %d times", atlas.TexWidth, atlas.TexHeight, glyphs_count, atlas.BuildCount);
+
+    // 32 of the 96 Latin-1 characters, a different third every 30 frames
+    ImWchar chars[32];
+    for (int i = 0; i < 32; i++)
+        chars[i] = static_cast<ImWchar>(0xA0 + (frame / 30) % 3 * 32 + i);
+    char line[32 * 2 + 1];
+    ImTextStrToUtf8(line, IM_ARRAYSIZE(line), chars, chars + 32);
+    for (ImFont* font : atlas.Fonts)
+    {
+        ImGui::PushFont(font);
+        imcxx::text::call("%.0f px: %s", font->FontSize, line);
+        ImGui::PopFont();
+    }
+}
+
+static const BenchScene g_Scenes[] =
+{
+    { "demo",           "imgui_demo.cpp windows + metrics window",          nullptr,                SceneDemo_Submit },
+    { "table",          "10000x8 imcxx::table, every row submitted",        nullptr,                SceneTable_Submit },
+    { "table_view",     "2M rows imcxx::table_view, visible rows only",     SceneTableView_Setup,   SceneTableView_Submit },
+    { "table_sort",     "1M rows live feed, sorted by imcxx::table_sorter", SceneTableSort_Setup,   SceneTableSort_Submit },
+    { "alerts",         "200k wrapped alerts with imcxx::variable_clipper", SceneAlerts_Setup,      SceneAlerts_Submit },
+    { "log_viewer",     "2M lines memory-mapped log, growing every frame",  SceneLog_Setup,         SceneLog_Submit },
+    { "console",        "console fed by 4 worker threads",                  SceneConsole_Setup,     SceneConsole_Submit },
+    { "text_editor",    "100k lines in imcxx::misc::text_editor, typing",  SceneEditor_Setup,      SceneEditor_Submit },
+    { "input_fields",   "typing in 16 std::string inputs",                 SceneInputFields_Setup, SceneInputFields_Submit<false> },
+    { "input_fields_arena", "same inputs on std::pmr::string in a fixed arena", SceneInputFields_Setup, SceneInputFields_Submit<true> },
+    { "text_sizes",     "3000 fixed-fit table rows, see --text-cache",     SceneTextSizes_Setup,   SceneTextSizes_Submit },
+    { "windows",        "200 imcxx::window with a few widgets each",        nullptr,                SceneWindows_Submit },
+    { "notifications",  "notification queue stress",                       nullptr,                SceneNotifications_Submit },
+    { "shortcuts",      "500 bound shortcuts with scripted key events",     SceneShortcuts_Setup,   SceneShortcuts_Submit },
+    { "charts",         "8 charts of 20k points drawn on the UI thread",   SceneCharts_Setup,      SceneCharts_Submit<false> },
+    { "charts_recorded", "same charts recorded by imcxx::misc::draw_recorder", SceneCharts_Setup,  SceneCharts_Submit<true> },
+    { "help_text",      "4 help panels of wrapped paragraphs",              SceneHelpText_Setup,    SceneHelpText_Submit<false> },
+    { "help_text_retained", "same panels with imcxx::retained_text",        SceneHelpText_Setup,    SceneHelpText_Submit<true> },
+    { "dashboard",      "12 child panels of statistics, one updated every 30 frames", SceneDashboard_Setup, SceneDashboard_Submit<false> },
+    { "dashboard_cached", "same panels in cached children (imcxx::child_cache)", SceneDashboard_Setup, SceneDashboard_Submit<true> },
+    { "labels",         "2000 tree nodes with string labels",               nullptr,                SceneLabels_Submit<false> },
+    { "labels_id",      "same tree with precomputed imcxx::label_id",       nullptr,                SceneLabels_Submit<true> },
+    { "gauges",         "240 dials and large rings, arcs with explicit segments", nullptr,           SceneGauges_Submit },
+    { "market",         "20k heatmap cells, 30k markers, 8k lines, one call per shape", SceneMarket_Setup, SceneMarket_Submit<false> },
+    { "market_batched", "same shapes drawn by imcxx::draw_batch",           SceneMarket_Setup,      SceneMarket_Submit<true> },
+    { "telemetry",      "ImGui::PlotLines() of 10M samples, 2000 more per frame", SceneTelemetry_Setup, SceneTelemetry_Submit<false> },
+    { "telemetry_lod",  "same series in imcxx::misc::line_plot, zooming",   SceneTelemetry_Setup,   SceneTelemetry_Submit<true> },
+    { "metrics",        "200 series at 1 kHz from 4 threads in imcxx::misc::scrolling_plot", SceneMetrics_Setup, SceneMetrics_Submit },
+    { "fonts",          "atlas of 8 oversampled fonts rebuilt every 60 frames", SceneFonts_Setup,  SceneFonts_Submit, SceneFonts_BeforeNewFrame<false>, SceneFonts_Shutdown },
+    { "fonts_async",    "same atlas built by imcxx::misc::font_loader",     SceneFonts_Setup,       SceneFonts_Submit, SceneFonts_BeforeNewFrame<true>,  SceneFonts_Shutdown },
+    { "glyphs",         "8 fonts showing Latin-1 text, every glyph built",  SceneGlyphs_Setup<SceneGlyphsMode_Baked>,   SceneGlyphs_Submit },
+    { "glyphs_dynamic", "same fonts with glyphs rasterized on demand",     SceneGlyphs_Setup<SceneGlyphsMode_Dynamic>, SceneGlyphs_Submit },
+    { "glyphs_evict",   "same dynamic glyphs in 768 rows, evicted when full", SceneGlyphs_Setup<SceneGlyphsMode_Evict>, SceneGlyphs_Submit },
+};
+
+
+// Measurements
+enum BenchPhase
+{
+    BenchPhase_NewFrame,
+    BenchPhase_Submit,
+    BenchPhase_EndFrame,
+    BenchPhase_Render,
+    BenchPhase_Backend,
+    BenchPhase_Total,
+    BenchPhase_COUNT
+};
+
+static const char* g_PhaseNames[BenchPhase_COUNT] = { "new_frame", "submit", "end_frame", "render", "backend", "total" };
+
+struct BenchFrame
+{
+    double  Phases[BenchPhase_COUNT];   // microseconds
+    ImGui_ImplNull_RenderStats Stats;
+    ImGui_ImplSoftware_RenderStats SoftwareStats;
+    size_t  ImGuiAllocs;
+    size_t  NewAllocs;
+    int     TextSizeCacheHits;          // previous frame, as reported by NewFrame()
+    int     TextSizeCacheMisses;
+};
+
+struct BenchOptions
+{
+    int     Frames = 600;
+    int     Warmup = 60;
+    ImVec2  DisplaySize{ 1920.f, 1080.f };
+    std::string Scene = "all";
+    bool    Software = false;
+    int     Threads = 0;
+    std::string DumpPrefix;
+    int     TextSizeCache = 0;
+    bool    ReuseLists = false;
+};
+
+using bench_clock = std::chrono::steady_clock;
+
+static double ElapsedUs(bench_clock::time_point from, bench_clock::time_point to)
+{
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+static BenchFrame RunFrame(const BenchScene& scene, int frame_idx, bool software)
+{
+    BenchFrame frame{};
+    const size_t imgui_allocs = g_ImGuiAllocs.load(std::memory_order_relaxed);
+    const size_t new_allocs = g_NewAllocs.load(std::memory_order_relaxed);
+
+    bench_clock::time_point t_begin = bench_clock::now(), t_newframe, t_submit, t_endframe, t_render, t_backend;
+    {
+        imcxx::frame frame_scope(
+            [&scene, frame_idx, software]()
+            {
+                if (scene.BeforeNewFrame)
+                    scene.BeforeNewFrame(frame_idx);
+                if (software)
+                    ImGui_ImplSoftware_NewFrame();
+                ImGui_ImplNull_NewFrame();
+            }
+        );
+        t_newframe = bench_clock::now();
+        frame.TextSizeCacheHits = ImGui::GetIO().MetricsTextSizeCacheHits;
+        frame.TextSizeCacheMisses = ImGui::GetIO().MetricsTextSizeCacheMisses;
+
+        scene.Submit(frame_idx);
+        t_submit = bench_clock::now();
+    }
+    t_endframe = bench_clock::now();
+
+    imcxx::render(
+        [&](ImDrawData* draw_data)
+        {
+            t_render = bench_clock::now();
+            if (software)
+                ImGui_ImplSoftware_RenderDrawData(draw_data);
+            else
+                ImGui_ImplNull_RenderDrawData(draw_data);
+            t_backend = bench_clock::now();
+        }
+    );
+
+    frame.Phases[BenchPhase_NewFrame] = ElapsedUs(t_begin, t_newframe);
+    frame.Phases[BenchPhase_Submit] = ElapsedUs(t_newframe, t_submit);
+    frame.Phases[BenchPhase_EndFrame] = ElapsedUs(t_submit, t_endframe);
+    frame.Phases[BenchPhase_Render] = ElapsedUs(t_endframe, t_render);
+    frame.Phases[BenchPhase_Backend] = ElapsedUs(t_render, t_backend);
+    frame.Phases[BenchPhase_Total] = ElapsedUs(t_begin, t_backend);
+    if (software)
+    {
+        frame.SoftwareStats = ImGui_ImplSoftware_GetRenderStats();
+        frame.Stats.CmdListsCount = frame.Stats.CmdListsUploaded = ImGui::GetDrawData()->CmdListsCount;
+        frame.Stats.TotalVtxCount = ImGui::GetDrawData()->TotalVtxCount;
+        frame.Stats.TotalIdxCount = ImGui::GetDrawData()->TotalIdxCount;
+    }
+    else
+        frame.Stats = ImGui_ImplNull_GetRenderStats();
+    frame.ImGuiAllocs = g_ImGuiAllocs.load(std::memory_order_relaxed) - imgui_allocs;
+    frame.NewAllocs = g_NewAllocs.load(std::memory_order_relaxed) - new_allocs;
+    return frame;
+}
+
+static double Percentile(std::vector<double>& values, double pct)
+{
+    const size_t idx = std::min(values.size() - 1, static_cast<size_t>(pct * (values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
+
+static void Report(const BenchScene& scene, const std::vector<BenchFrame>& frames)
+{
+    printf("\n== %s (%s), %d frames\n", scene.Name, scene.Description, static_cast<int>(frames.size()));
+    printf("  %-10s %10s %10s %10s %10s %10s   (us)\n", "phase", "min", "avg", "p50", "p95", "max");
+
+    std::vector<double> values(frames.size());
+    for (int phase = 0; phase < BenchPhase_COUNT; phase++)
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < frames.size(); i++)
+            sum += values[i] = frames[i].Phases[phase];
+
+        const auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+        const double min = *min_it, max = *max_it;
+        const double p50 = Percentile(values, 0.50);
+        const double p95 = Percentile(values, 0.95);
+        printf("  %-10s %10.1f %10.1f %10.1f %10.1f %10.1f\n", g_PhaseNames[phase], min, sum / frames.size(), p50, p95, max);
+    }
+
+    double cmd_lists = 0, cmd_lists_uploaded = 0, vtx = 0, idx = 0, draw_calls = 0, bytes = 0, imgui_allocs = 0, new_allocs = 0, text_hits = 0, text_misses = 0;
+    for (const BenchFrame& frame : frames)
+    {
+        cmd_lists += frame.Stats.CmdListsCount;
+        cmd_lists_uploaded += frame.Stats.CmdListsUploaded;
+        vtx += frame.Stats.TotalVtxCount;
+        idx += frame.Stats.TotalIdxCount;
+        draw_calls += frame.Stats.DrawCalls;
+        bytes += static_cast<double>(frame.Stats.BytesUploaded);
+        imgui_allocs += static_cast<double>(frame.ImGuiAllocs);
+        new_allocs += static_cast<double>(frame.NewAllocs);
+        text_hits += frame.TextSizeCacheHits;
+        text_misses += frame.TextSizeCacheMisses;
+    }
+    const double n = static_cast<double>(frames.size());
+    printf("  per frame: %.0f draw lists, %.0f vertices, %.0f indices, %.0f draw calls, %.1f KiB uploaded\n", cmd_lists / n, vtx / n, idx / n, draw_calls / n, bytes / n / 1024.0);
+    if (cmd_lists_uploaded != cmd_lists)
+        printf("  per frame: %.1f of %.0f draw lists uploaded\n", cmd_lists_uploaded / n, cmd_lists / n);
+    printf("  per frame: %.1f KiB of vertices written (%d bytes per ImDrawVert), %.1f KiB of indices\n", vtx * sizeof(ImDrawVert) / n / 1024.0, static_cast<int>(sizeof(ImDrawVert)), idx * sizeof(ImDrawIdx) / n / 1024.0);
+    printf("  per frame: %.2f ImGui allocations, %.2f operator new\n", imgui_allocs / n, new_allocs / n);
+    if (text_hits + text_misses > 0)
+        printf("  per frame: %.0f text size cache hits, %.0f misses\n", text_hits / n, text_misses / n);
+
+    if (frames[0].SoftwareStats.ThreadsUsed == 0)
+        return;
+
+    double tris = 0, tiles = 0, tile_bins = 0, pixels = 0, setup = 0, raster = 0;
+    for (const BenchFrame& frame : frames)
+    {
+        tris += frame.SoftwareStats.TrianglesBinned;
+        tiles += frame.SoftwareStats.TilesTouched;
+        tile_bins += frame.SoftwareStats.TileBins;
+        pixels += static_cast<double>(frame.SoftwareStats.PixelsShaded);
+        setup += frame.SoftwareStats.SetupTime;
+        raster += frame.SoftwareStats.RasterTime;
+    }
+    printf("  software: %d threads, %.0f triangles, %.0f/%d tiles, %.0f tile bins, %.0f pixels per frame\n",
+        frames[0].SoftwareStats.ThreadsUsed, tris / n, tiles / n, frames[0].SoftwareStats.TilesTotal, tile_bins / n, pixels / n);
+    printf("  software: setup %.1f us, raster %.1f us, %.2f Mtriangles/s\n",
+        setup / n * 1e6, raster / n * 1e6, setup + raster > 0.0 ? tris / (setup + raster) / 1e6 : 0.0);
+}
+
+// Uncompressed 32-bit TGA, bottom-up rows
+static bool WriteTGA(const char* path, const ImU32* pixels, int width, int height)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    const unsigned char header[18] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        static_cast<unsigned char>(width & 0xFF), static_cast<unsigned char>(width >> 8),
+        static_cast<unsigned char>(height & 0xFF), static_cast<unsigned char>(height >> 8), 32, 8 };
+    fwrite(header, 1, sizeof(header), f);
+
+    std::vector<unsigned char> row(static_cast<size_t>(width) * 4);
+    for (int y = height - 1; y >= 0; y--)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const ImU32 col = pixels[static_cast<size_t>(y) * width + x];
+            row[x * 4 + 0] = static_cast<unsigned char>(col >> IM_COL32_B_SHIFT);
+            row[x * 4 + 1] = static_cast<unsigned char>(col >> IM_COL32_G_SHIFT);
+            row[x * 4 + 2] = static_cast<unsigned char>(col >> IM_COL32_R_SHIFT);
+            row[x * 4 + 3] = static_cast<unsigned char>(col >> IM_COL32_A_SHIFT);
+        }
+        fwrite(row.data(), 1, row.size(), f);
+    }
+    return fclose(f) == 0;
+}
+
+static void RunScene(const BenchScene& scene, const BenchOptions& options)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(CountingMalloc, CountingFree);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    io.ConfigTextSizeCacheMaxEntries = options.TextSizeCache;
+    ImGui::StyleColorsDark();
+
+    ImGui_ImplNull_Init(options.DisplaySize, 1.0f / 60.0f, !options.Software);
+    if (options.ReuseLists && !options.Software)
+        ImGui_ImplNull_SetReuseDrawLists(true);
+    if (options.Software)
+        ImGui_ImplSoftware_Init(options.Threads);
+    if (scene.Setup)
+        scene.Setup();
+
+    int frame_idx = 0;
+    for (int i = 0; i < options.Warmup; i++)
+        RunFrame(scene, frame_idx++, options.Software);
+
+    std::vector<BenchFrame> frames;
+    frames.reserve(options.Frames);
+    for (int i = 0; i < options.Frames; i++)
+        frames.push_back(RunFrame(scene, frame_idx++, options.Software));
+    if (scene.Shutdown)
+        scene.Shutdown();
+
+    if (options.Software)
+    {
+        const ImU32* pixels;
+        int width, height;
+        if (!options.DumpPrefix.empty() && ImGui_ImplSoftware_GetFramebuffer(&pixels, &width, &height))
+        {
+            const std::string path = options.DumpPrefix + "_" + scene.Name + ".tga";
+            if (!WriteTGA(path.c_str(), pixels, width, height))
+                fprintf(stderr, "failed to write '%s'\n", path.c_str());
+        }
+        ImGui_ImplSoftware_Shutdown();
+    }
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext();
+
+    Report(scene, frames);
+}
+
+static void PrintUsage()
+{
+    printf("usage: imcxx_bench [--frames N] [--warmup N] [--scene NAME|all] [--size WxH] [--list]\n");
+    printf("                   [--renderer null|software] [--threads N] [--dump PREFIX] [--text-cache N] [--reuse-lists]\n");
+}
+
+int main(int argc, char** argv)
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (!strcmp(arg, "--frames") && has_value)
+            options.Frames = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(arg, "--warmup") && has_value)
+            options.Warmup = std::max(0, atoi(argv[++i]));
+        else if (!strcmp(arg, "--scene") && has_value)
+            options.Scene = argv[++i];
+        else if (!strcmp(arg, "--renderer") && has_value)
+        {
+            const char* renderer = argv[++i];
+            if (strcmp(renderer, "null") && strcmp(renderer, "software"))
+            {
+                PrintUsage();
+                return 1;
+            }
+            options.Software = !strcmp(renderer, "software");
+        }
+        else if (!strcmp(arg, "--threads") && has_value)
+            options.Threads = std::max(0, atoi(argv[++i]));
+        else if (!strcmp(arg, "--dump") && has_value)
+            options.DumpPrefix = argv[++i];
+        else if (!strcmp(arg, "--text-cache") && has_value)
+            options.TextSizeCache = std::max(0, atoi(argv[++i]));
+        else if (!strcmp(arg, "--reuse-lists"))
+            options.ReuseLists = true;
+        else if (!strcmp(arg, "--size") && has_value)
+        {
+            int w, h;
+            if (sscanf(argv[++i], "%dx%d", &w, &h) != 2 || w <= 0 || h <= 0)
+            {
+                PrintUsage();
+                return 1;
+            }
+            options.DisplaySize = { static_cast<float>(w), static_cast<float>(h) };
+        }
+        else if (!strcmp(arg, "--list"))
+        {
+            for (const BenchScene& scene : g_Scenes)
+                printf("%-16s %s\n", scene.Name, scene.Description);
+            return 0;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    printf("imcxx benchmark, Dear ImGui %s, %s renderer, %dx%d, %d warmup + %d measured frames per scene\n",
+        IMGUI_VERSION, options.Software ? "software" : "null", static_cast<int>(options.DisplaySize.x), static_cast<int>(options.DisplaySize.y), options.Warmup, options.Frames);
+
+    bool found = false;
+    for (const BenchScene& scene : g_Scenes)
+    {
+        if (options.Scene == "all" || options.Scene == scene.Name)
+        {
+            found = true;
+            RunScene(scene, options);
+        }
+    }
+
+    if (!found)
+    {
+        fprintf(stderr, "unknown scene '%s', use --list\n", options.Scene.c_str());
+        return 1;
+    }
+    return 0;
+}
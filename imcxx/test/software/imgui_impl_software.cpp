@@ -0,0 +1,656 @@
+// dear imgui: Renderer Backend for a CPU framebuffer
+// This needs to be used along with a Platform Backend (e.g. imgui_impl_null with 'install_renderer = false')
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftware_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Clip rectangles, alpha blending and RGBA32 textures (point sampled).
+//  [X] Renderer: Tile binning, tiles are rasterized in parallel by a pool of worker threads.
+//  [X] Renderer: Compact vertices (IMGUI_USE_COMPACT_DRAWVERT), decoded with ImDrawList::GetVtxPos()/GetVtxUV().
+//  [X] Renderer: Glyphs rasterized on demand (ImGuiBackendFlags_RendererHasTexUpdates), the font texture samples the atlas pixels directly.
+//  [ ] Renderer: Multi-viewport support.
+
+// The frame is rendered in two steps:
+//  1) Setup: every triangle of every ImDrawCmd is snapped to 1/16 pixel, clipped against its clip rect and
+//     appended, in submission order, to the bin of each tile its bounding box overlaps.
+//  2) Raster: worker threads grab tiles one at a time, clear them and rasterize their bin in order.
+//     A tile is only ever written by one thread, so no synchronization is needed on the framebuffer and
+//     the output is identical for any number of threads.
+// User callbacks are invoked during setup, in order, since drawing happens after all commands were seen.
+
+#include "imgui_impl_software.h"
+#include "imgui/imgui_internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <math.h>
+#include <string.h>
+
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_IMPL_SOFTWARE_SSE2
+#include <emmintrin.h>
+#endif
+
+static const int    TILE_SIZE       = 64;           // Tile width/height in pixels
+static const int    SUBPIXEL_BITS   = 4;            // Vertices are snapped to 1/16 of a pixel
+static const float  GUARD_BAND      = 16384.0f;     // Vertices are clamped to +/- this many pixels so edge steps fit in 32-bit
+static const int    EDGE_CLAMP      = 1 << 30;      // Edge values beyond this keep their sign over a whole tile row
+
+struct ImGui_ImplSoftware_Triangle
+{
+    int                                 MinX, MinY, MaxX, MaxY;     // Covered pixels [Min, Max), already intersected with clip rect and framebuffer
+    ImS64                               EdgeA[3], EdgeB[3], EdgeC[3];// E(x, y) = A * x + B * y + C in subpixels, >= 0 inside (top-left bias folded in C)
+    float                               RefX, RefY;                 // Attribute planes are evaluated relative to this point
+    float                               Attr[6][3];                 // u, v, then the 4 color bytes: value at Ref, d/dx, d/dy
+    const ImGui_ImplSoftware_Texture*   Texture;
+    ImU32                               FlatColor;                  // IsFlat: final source color, IsFlatTexel: texel
+    bool                                IsFlat;                     // Constant texel and constant vertex color
+    bool                                IsFlatTexel;                // Constant texel, interpolated vertex color
+};
+
+struct ImGui_ImplSoftware_Data
+{
+    ImGui_ImplSoftware_Texture                  FontTexture;
+    ImU32                                       ClearColor;
+
+    ImVector<ImU32>                             Framebuffer;
+    int                                         FramebufferWidth;
+    int                                         FramebufferHeight;
+    int                                         TilesX;
+    int                                         TilesY;
+
+    ImVector<ImGui_ImplSoftware_Triangle>       Triangles;
+    std::vector<std::vector<int>>               Bins;
+
+    std::vector<std::thread>                    Workers;
+    std::mutex                                  Mutex;
+    std::condition_variable                     WorkCv;
+    std::condition_variable                     DoneCv;
+    ImU64                                       Generation;
+    int                                         Pending;
+    bool                                        Quit;
+    std::atomic<int>                            NextTile;
+    std::atomic<ImU64>                          PixelsShaded;
+
+    ImGui_ImplSoftware_RenderStats              Stats;
+
+    ImGui_ImplSoftware_Data() : NextTile(0), PixelsShaded(0)
+    {
+        memset(&FontTexture, 0, sizeof(FontTexture));
+        ClearColor = IM_COL32(0, 0, 0, 255);
+        FramebufferWidth = FramebufferHeight = TilesX = TilesY = 0;
+        Generation = 0;
+        Pending = 0;
+        Quit = false;
+        memset(&Stats, 0, sizeof(Stats));
+    }
+};
+
+// Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
+static ImGui_ImplSoftware_Data* ImGui_ImplSoftware_GetBackendData()
+{
+    return ImGui::GetCurrentContext() ? (ImGui_ImplSoftware_Data*)ImGui::GetIO().BackendRendererUserData : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Pixel helpers
+//-----------------------------------------------------------------------------
+
+// Exact round(x / 255) for x in [0, 65535 - 128]
+static inline ImU32 ImGui_ImplSoftware_Div255(ImU32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline ImU32 ImGui_ImplSoftware_Modulate(ImU32 a, ImU32 b)
+{
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ImGui_ImplSoftware_Div255(((a >> shift) & 0xFF) * ((b >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+// Same equation as the DX9 backend: rgb = src * a + dst * (1 - a), alpha = src_a + dst_a * (1 - src_a)
+static inline ImU32 ImGui_ImplSoftware_Blend(ImU32 dst, ImU32 src)
+{
+    const ImU32 a = src >> IM_COL32_A_SHIFT;
+    if (a == 0)
+        return dst;
+    if (a == 255)
+        return src;
+    const ImU32 ia = 255 - a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 24; shift += 8)
+        out |= ImGui_ImplSoftware_Div255(((src >> shift) & 0xFF) * a + ((dst >> shift) & 0xFF) * ia) << shift;
+    out |= ImGui_ImplSoftware_Div255(a * 255 + (dst >> IM_COL32_A_SHIFT) * ia) << IM_COL32_A_SHIFT;
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoftware_Sample(const ImGui_ImplSoftware_Texture* tex, float u, float v)
+{
+    if (!tex || !tex->Pixels)
+        return IM_COL32_WHITE;
+    int x = (int)floorf(u * tex->Width);
+    int y = (int)floorf(v * tex->Height);
+    x = x < 0 ? 0 : x >= tex->Width ? tex->Width - 1 : x;
+    y = y < 0 ? 0 : y >= tex->Height ? tex->Height - 1 : y;
+    return tex->Pixels[y * tex->Width + x];
+}
+
+static inline ImU32 ImGui_ImplSoftware_PackChannel(float v)
+{
+    return v <= 0.0f ? 0 : v >= 255.0f ? 255 : (ImU32)(v + 0.5f);
+}
+
+static inline ImU32 ImGui_ImplSoftware_Shade(const ImGui_ImplSoftware_Triangle& tri, int x, int y)
+{
+    if (tri.IsFlat)
+        return tri.FlatColor;
+
+    const float px = (float)x + 0.5f - tri.RefX;
+    const float py = (float)y + 0.5f - tri.RefY;
+    float values[6];
+    for (int i = 0; i < 6; i++)
+        values[i] = tri.Attr[i][0] + tri.Attr[i][1] * px + tri.Attr[i][2] * py;
+
+    const ImU32 texel = tri.IsFlatTexel ? tri.FlatColor : ImGui_ImplSoftware_Sample(tri.Texture, values[0], values[1]);
+    const ImU32 col =
+        ImGui_ImplSoftware_PackChannel(values[2]) |
+        ImGui_ImplSoftware_PackChannel(values[3]) << 8 |
+        ImGui_ImplSoftware_PackChannel(values[4]) << 16 |
+        ImGui_ImplSoftware_PackChannel(values[5]) << 24;
+    return ImGui_ImplSoftware_Modulate(texel, col);
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization
+//-----------------------------------------------------------------------------
+
+// Rasterize the part of 'tri' inside the tile [x0, x1) x [y0, y1), returns the number of pixels covered.
+static ImU64 ImGui_ImplSoftware_RasterizeTriangle(ImGui_ImplSoftware_Data* bd, const ImGui_ImplSoftware_Triangle& tri, int x0, int y0, int x1, int y1)
+{
+    const int xb = ImMax(tri.MinX, x0), xe = ImMin(tri.MaxX, x1);
+    const int yb = ImMax(tri.MinY, y0), ye = ImMin(tri.MaxY, y1);
+    if (xb >= xe || yb >= ye)
+        return 0;
+
+    const int half = 1 << (SUBPIXEL_BITS - 1);
+    int step[3];
+    for (int k = 0; k < 3; k++)
+        step[k] = (int)(tri.EdgeA[k] * (1 << SUBPIXEL_BITS));
+
+#ifdef IMGUI_IMPL_SOFTWARE_SSE2
+    static const int popcount4[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+    __m128i step4[3];
+    for (int k = 0; k < 3; k++)
+        step4[k] = _mm_set1_epi32(step[k] * 4);
+
+    // Flat triangles are blended 4 pixels at a time: dst * (255 - a) + src_weighted, in 16-bit lanes
+    const ImU32 src_a = tri.FlatColor >> IM_COL32_A_SHIFT;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_opaque = _mm_set1_epi32((int)tri.FlatColor);
+    const __m128i inv_alpha = _mm_set1_epi16((short)(255 - src_a));
+    const __m128i src_weighted = _mm_set_epi16(
+        (short)(src_a * 255), (short)(((tri.FlatColor >> 16) & 0xFF) * src_a), (short)(((tri.FlatColor >> 8) & 0xFF) * src_a), (short)((tri.FlatColor & 0xFF) * src_a),
+        (short)(src_a * 255), (short)(((tri.FlatColor >> 16) & 0xFF) * src_a), (short)(((tri.FlatColor >> 8) & 0xFF) * src_a), (short)((tri.FlatColor & 0xFF) * src_a));
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i minus_one = _mm_set1_epi32(-1);
+#endif
+
+    ImU64 covered = 0;
+    for (int y = yb; y < ye; y++)
+    {
+        const ImS64 px = ((ImS64)xb << SUBPIXEL_BITS) + half;
+        const ImS64 py = ((ImS64)y << SUBPIXEL_BITS) + half;
+        int e[3];
+        for (int k = 0; k < 3; k++)
+        {
+            ImS64 v = tri.EdgeA[k] * px + tri.EdgeB[k] * py + tri.EdgeC[k];
+            e[k] = (int)(v < -EDGE_CLAMP ? -EDGE_CLAMP : v > EDGE_CLAMP ? EDGE_CLAMP : v);
+        }
+
+        ImU32* row = bd->Framebuffer.Data + (size_t)y * bd->FramebufferWidth;
+        int x = xb;
+
+#ifdef IMGUI_IMPL_SOFTWARE_SSE2
+        if (x + 4 <= xe)
+        {
+            __m128i ev[3];
+            for (int k = 0; k < 3; k++)
+                ev[k] = _mm_add_epi32(_mm_set1_epi32(e[k]), _mm_set_epi32(step[k] * 3, step[k] * 2, step[k], 0));
+
+            for (; x + 4 <= xe; x += 4)
+            {
+                const __m128i inside = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(ev[0], ev[1]), ev[2]), minus_one);
+                const int mask = _mm_movemask_ps(_mm_castsi128_ps(inside));
+                if (mask != 0)
+                {
+                    covered += popcount4[mask];
+                    if (tri.IsFlat)
+                    {
+                        __m128i* dst = (__m128i*)(row + x);
+                        __m128i result;
+                        if (src_a == 255)
+                            result = src_opaque;
+                        else
+                        {
+                            const __m128i d = _mm_loadu_si128(dst);
+                            __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), inv_alpha), src_weighted), round);
+                            __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), inv_alpha), src_weighted), round);
+                            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+                            result = _mm_packus_epi16(lo, hi);
+                        }
+                        if (mask != 0xF)
+                        {
+                            const __m128i d = _mm_loadu_si128(dst);
+                            result = _mm_or_si128(_mm_and_si128(inside, result), _mm_andnot_si128(inside, d));
+                        }
+                        _mm_storeu_si128(dst, result);
+                    }
+                    else
+                    {
+                        for (int i = 0; i < 4; i++)
+                            if (mask & (1 << i))
+                                row[x + i] = ImGui_ImplSoftware_Blend(row[x + i], ImGui_ImplSoftware_Shade(tri, x + i, y));
+                    }
+                }
+                for (int k = 0; k < 3; k++)
+                    ev[k] = _mm_add_epi32(ev[k], step4[k]);
+            }
+            for (int k = 0; k < 3; k++)
+                e[k] = _mm_cvtsi128_si32(ev[k]);
+        }
+#endif
+
+        for (; x < xe; x++)
+        {
+            if ((e[0] | e[1] | e[2]) >= 0)
+            {
+                row[x] = ImGui_ImplSoftware_Blend(row[x], ImGui_ImplSoftware_Shade(tri, x, y));
+                covered++;
+            }
+            for (int k = 0; k < 3; k++)
+                e[k] += step[k];
+        }
+    }
+    return covered;
+}
+
+static void ImGui_ImplSoftware_RasterizeTiles(ImGui_ImplSoftware_Data* bd)
+{
+    const int tiles_count = bd->TilesX * bd->TilesY;
+    ImU64 covered = 0;
+    for (int tile = bd->NextTile.fetch_add(1); tile < tiles_count; tile = bd->NextTile.fetch_add(1))
+    {
+        const int x0 = (tile % bd->TilesX) * TILE_SIZE;
+        const int y0 = (tile / bd->TilesX) * TILE_SIZE;
+        const int x1 = ImMin(x0 + TILE_SIZE, bd->FramebufferWidth);
+        const int y1 = ImMin(y0 + TILE_SIZE, bd->FramebufferHeight);
+
+        for (int y = y0; y < y1; y++)
+        {
+            ImU32* row = bd->Framebuffer.Data + (size_t)y * bd->FramebufferWidth;
+            for (int x = x0; x < x1; x++)
+                row[x] = bd->ClearColor;
+        }
+
+        for (int tri_idx : bd->Bins[tile])
+            covered += ImGui_ImplSoftware_RasterizeTriangle(bd, bd->Triangles[tri_idx], x0, y0, x1, y1);
+    }
+    bd->PixelsShaded.fetch_add(covered);
+}
+
+static void ImGui_ImplSoftware_WorkerMain(ImGui_ImplSoftware_Data* bd)
+{
+    ImU64 seen_generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(bd->Mutex);
+            bd->WorkCv.wait(lock, [&]() { return bd->Quit || bd->Generation != seen_generation; });
+            if (bd->Quit)
+                return;
+            seen_generation = bd->Generation;
+        }
+
+        ImGui_ImplSoftware_RasterizeTiles(bd);
+
+        {
+            std::lock_guard<std::mutex> lock(bd->Mutex);
+            if (--bd->Pending == 0)
+                bd->DoneCv.notify_one();
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Triangle setup
+//-----------------------------------------------------------------------------
+
+static void ImGui_ImplSoftware_SetupPlane(float out[3], const float x[3], const float y[3], const float a[3], float det)
+{
+    const float da1 = a[1] - a[0], da2 = a[2] - a[0];
+    out[0] = a[0];
+    out[1] = det != 0.0f ? (da1 * (y[2] - y[0]) - da2 * (y[1] - y[0])) / det : 0.0f;
+    out[2] = det != 0.0f ? (da2 * (x[1] - x[0]) - da1 * (x[2] - x[0])) / det : 0.0f;
+}
+
+static void ImGui_ImplSoftware_SetupTriangle(ImGui_ImplSoftware_Data* bd, const ImDrawList* cmd_list, const ImDrawVert* verts[3], const ImGui_ImplSoftware_Texture* texture, const ImVec2& offset, const ImVec2& scale, const int clip[4])
+{
+    float x[3], y[3];
+    ImS64 sx[3], sy[3];
+    ImVec2 uv[3];
+    for (int i = 0; i < 3; i++)
+    {
+        const ImVec2 pos = cmd_list->GetVtxPos(*verts[i]);
+        uv[i] = cmd_list->GetVtxUV(*verts[i]);
+        x[i] = ImClamp((pos.x - offset.x) * scale.x, -GUARD_BAND, GUARD_BAND);
+        y[i] = ImClamp((pos.y - offset.y) * scale.y, -GUARD_BAND, GUARD_BAND);
+        sx[i] = (ImS64)floorf(x[i] * (1 << SUBPIXEL_BITS) + 0.5f);
+        sy[i] = (ImS64)floorf(y[i] * (1 << SUBPIXEL_BITS) + 0.5f);
+    }
+
+    // Make the winding positive so that inside is E >= 0 for all edges
+    ImS64 area = (sx[1] - sx[0]) * (sy[2] - sy[0]) - (sy[1] - sy[0]) * (sx[2] - sx[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImSwap(x[1], x[2]); ImSwap(y[1], y[2]);
+        ImSwap(sx[1], sx[2]); ImSwap(sy[1], sy[2]);
+        ImSwap(verts[1], verts[2]);
+        ImSwap(uv[1], uv[2]);
+    }
+
+    ImGui_ImplSoftware_Triangle tri;
+    tri.MinX = ImMax(clip[0], (int)(ImMin(sx[0], ImMin(sx[1], sx[2])) >> SUBPIXEL_BITS));
+    tri.MinY = ImMax(clip[1], (int)(ImMin(sy[0], ImMin(sy[1], sy[2])) >> SUBPIXEL_BITS));
+    tri.MaxX = ImMin(clip[2], (int)(ImMax(sx[0], ImMax(sx[1], sx[2])) >> SUBPIXEL_BITS) + 1);
+    tri.MaxY = ImMin(clip[3], (int)(ImMax(sy[0], ImMax(sy[1], sy[2])) >> SUBPIXEL_BITS) + 1);
+    if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+        return;
+
+    for (int k = 0; k < 3; k++)
+    {
+        const int n = (k + 1) % 3;
+        const ImS64 a = sy[k] - sy[n];
+        const ImS64 b = sx[n] - sx[k];
+        tri.EdgeA[k] = a;
+        tri.EdgeB[k] = b;
+        tri.EdgeC[k] = -(a * sx[k] + b * sy[k]);
+
+        // Top-left fill rule: pixels exactly on a right or bottom edge belong to the neighbour triangle
+        if (!(a > 0 || (a == 0 && b > 0)))
+            tri.EdgeC[k] -= 1;
+    }
+
+    const ImU32 c0 = verts[0]->col, c1 = verts[1]->col, c2 = verts[2]->col;
+    const bool flat_color = c0 == c1 && c0 == c2;
+    const bool flat_uv =
+        uv[0].x == uv[1].x && uv[0].x == uv[2].x &&
+        uv[0].y == uv[1].y && uv[0].y == uv[2].y;
+
+    tri.Texture = texture;
+    tri.IsFlat = flat_color && flat_uv;
+    tri.IsFlatTexel = !tri.IsFlat && flat_uv;
+    tri.FlatColor = 0;
+    if (flat_uv)
+    {
+        const ImU32 texel = ImGui_ImplSoftware_Sample(texture, uv[0].x, uv[0].y);
+        tri.FlatColor = tri.IsFlat ? ImGui_ImplSoftware_Modulate(texel, c0) : texel;
+    }
+
+    tri.RefX = x[0];
+    tri.RefY = y[0];
+    if (!tri.IsFlat)
+    {
+        const float det = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+        for (int i = 0; i < 6; i++)
+        {
+            float a[3];
+            for (int v = 0; v < 3; v++)
+                a[v] = i == 0 ? uv[v].x : i == 1 ? uv[v].y : (float)((verts[v]->col >> ((i - 2) * 8)) & 0xFF);
+            ImGui_ImplSoftware_SetupPlane(tri.Attr[i], x, y, a, det);
+        }
+    }
+
+    // Bin into every tile overlapped by the bounding box
+    const int tri_idx = bd->Triangles.Size;
+    bd->Triangles.push_back(tri);
+    for (int ty = tri.MinY / TILE_SIZE; ty <= (tri.MaxY - 1) / TILE_SIZE; ty++)
+        for (int tx = tri.MinX / TILE_SIZE; tx <= (tri.MaxX - 1) / TILE_SIZE; tx++)
+        {
+            bd->Bins[ty * bd->TilesX + tx].push_back(tri_idx);
+            bd->Stats.TileBins++;
+        }
+}
+
+//-----------------------------------------------------------------------------
+// Backend API
+//-----------------------------------------------------------------------------
+
+// Render function.
+void ImGui_ImplSoftware_RenderDrawData(ImDrawData* draw_data)
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    ImGui_ImplSoftware_RenderStats& stats = bd->Stats;
+    memset(&stats, 0, sizeof(stats));
+
+    // Avoid rendering when minimized
+    const int fb_width = (int)(draw_data->DisplaySize.x * draw_data->FramebufferScale.x);
+    const int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
+    if (fb_width <= 0 || fb_height <= 0)
+        return;
+
+    // The font texture points at the atlas pixels: the glyphs rasterized on demand are already in it
+    ImGui::GetIO().Fonts->TexDirtyRects.resize(0);
+
+    // Create and grow buffers if needed
+    if (bd->FramebufferWidth != fb_width || bd->FramebufferHeight != fb_height)
+    {
+        bd->Framebuffer.resize(fb_width * fb_height);
+        bd->FramebufferWidth = fb_width;
+        bd->FramebufferHeight = fb_height;
+        bd->TilesX = (fb_width + TILE_SIZE - 1) / TILE_SIZE;
+        bd->TilesY = (fb_height + TILE_SIZE - 1) / TILE_SIZE;
+        bd->Bins.resize((size_t)bd->TilesX * bd->TilesY);
+    }
+    for (std::vector<int>& bin : bd->Bins)
+        bin.clear();
+    bd->Triangles.resize(0);
+
+    using clock = std::chrono::steady_clock;
+    const clock::time_point t_setup = clock::now();
+
+    // Setup and bin every triangle
+    const ImVec2 clip_off = draw_data->DisplayPos;
+    const ImVec2 clip_scale = draw_data->FramebufferScale;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space
+            const int clip[4] =
+            {
+                ImMax(0, (int)((pcmd->ClipRect.x - clip_off.x) * clip_scale.x)),
+                ImMax(0, (int)((pcmd->ClipRect.y - clip_off.y) * clip_scale.y)),
+                ImMin(fb_width, (int)((pcmd->ClipRect.z - clip_off.x) * clip_scale.x)),
+                ImMin(fb_height, (int)((pcmd->ClipRect.w - clip_off.y) * clip_scale.y)),
+            };
+            stats.Triangles += (int)(pcmd->ElemCount / 3);
+            if (clip[2] <= clip[0] || clip[3] <= clip[1])
+                continue;
+
+            const ImGui_ImplSoftware_Texture* texture = (const ImGui_ImplSoftware_Texture*)pcmd->GetTexID();
+            const ImDrawIdx* idx = idx_buffer + pcmd->IdxOffset;
+            for (unsigned int i = 0; i + 2 < pcmd->ElemCount; i += 3)
+            {
+                const ImDrawVert* verts[3] =
+                {
+                    &vtx_buffer[pcmd->VtxOffset + idx[i + 0]],
+                    &vtx_buffer[pcmd->VtxOffset + idx[i + 1]],
+                    &vtx_buffer[pcmd->VtxOffset + idx[i + 2]],
+                };
+                ImGui_ImplSoftware_SetupTriangle(bd, cmd_list, verts, texture, clip_off, clip_scale, clip);
+            }
+        }
+    }
+
+    const clock::time_point t_raster = clock::now();
+
+    // Rasterize tiles on the worker threads and the calling thread
+    bd->NextTile.store(0);
+    bd->PixelsShaded.store(0);
+    if (!bd->Workers.empty())
+    {
+        {
+            std::lock_guard<std::mutex> lock(bd->Mutex);
+            bd->Pending = (int)bd->Workers.size();
+            bd->Generation++;
+        }
+        bd->WorkCv.notify_all();
+    }
+    ImGui_ImplSoftware_RasterizeTiles(bd);
+    if (!bd->Workers.empty())
+    {
+        std::unique_lock<std::mutex> lock(bd->Mutex);
+        bd->DoneCv.wait(lock, [bd]() { return bd->Pending == 0; });
+    }
+
+    const clock::time_point t_end = clock::now();
+
+    stats.TrianglesBinned = bd->Triangles.Size;
+    stats.TilesTotal = bd->TilesX * bd->TilesY;
+    for (const std::vector<int>& bin : bd->Bins)
+        stats.TilesTouched += bin.empty() ? 0 : 1;
+    stats.ThreadsUsed = (int)bd->Workers.size() + 1;
+    stats.PixelsShaded = bd->PixelsShaded.load();
+    stats.SetupTime = std::chrono::duration<double>(t_raster - t_setup).count();
+    stats.RasterTime = std::chrono::duration<double>(t_end - t_raster).count();
+    const double total_time = stats.SetupTime + stats.RasterTime;
+    stats.TrianglesPerSecond = total_time > 0.0 ? stats.TrianglesBinned / total_time : 0.0;
+}
+
+bool ImGui_ImplSoftware_Init(int threads_count)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IM_ASSERT(io.BackendRendererUserData == NULL && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    ImGui_ImplSoftware_Data* bd = IM_NEW(ImGui_ImplSoftware_Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_software";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // We can honor io.Fonts->TexDirtyRects, allowing for ImFontConfig::DynamicGlyphs.
+
+    if (threads_count <= 0)
+        threads_count = ImMax(1, (int)std::thread::hardware_concurrency());
+    for (int i = 1; i < threads_count; i++)
+        bd->Workers.emplace_back(ImGui_ImplSoftware_WorkerMain, bd);
+
+    return true;
+}
+
+void ImGui_ImplSoftware_Shutdown()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != NULL && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    {
+        std::lock_guard<std::mutex> lock(bd->Mutex);
+        bd->Quit = true;
+    }
+    bd->WorkCv.notify_all();
+    for (std::thread& worker : bd->Workers)
+        worker.join();
+
+    ImGui_ImplSoftware_InvalidateDeviceObjects();
+    io.BackendRendererName = NULL;
+    io.BackendRendererUserData = NULL;
+    IM_DELETE(bd);
+}
+
+bool ImGui_ImplSoftware_CreateDeviceObjects()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    ImGuiIO& io = ImGui::GetIO();
+
+    // Build texture atlas. The pixels are owned by the atlas, the texture only points to them.
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    bd->FontTexture.Pixels = (const ImU32*)pixels;
+    bd->FontTexture.Width = width;
+    bd->FontTexture.Height = height;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)&bd->FontTexture);
+    return true;
+}
+
+void ImGui_ImplSoftware_InvalidateDeviceObjects()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    if (!bd)
+        return;
+    if (bd->FontTexture.Pixels)
+    {
+        memset(&bd->FontTexture, 0, sizeof(bd->FontTexture));
+        ImGui::GetIO().Fonts->SetTexID(NULL);
+    }
+}
+
+void ImGui_ImplSoftware_NewFrame()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoftware_Init()?");
+
+    if (!bd->FontTexture.Pixels || !ImGui::GetIO().Fonts->IsBuilt())
+        ImGui_ImplSoftware_CreateDeviceObjects();
+}
+
+void ImGui_ImplSoftware_SetClearColor(ImU32 col)
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoftware_Init()?");
+    bd->ClearColor = col;
+}
+
+bool ImGui_ImplSoftware_GetFramebuffer(const ImU32** out_pixels, int* out_width, int* out_height)
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoftware_Init()?");
+    if (bd->Framebuffer.empty())
+        return false;
+    *out_pixels = bd->Framebuffer.Data;
+    *out_width = bd->FramebufferWidth;
+    *out_height = bd->FramebufferHeight;
+    return true;
+}
+
+const ImGui_ImplSoftware_RenderStats& ImGui_ImplSoftware_GetRenderStats()
+{
+    ImGui_ImplSoftware_Data* bd = ImGui_ImplSoftware_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplSoftware_Init()?");
+    return bd->Stats;
+}
@@ -0,0 +1,53 @@
+// dear imgui: Renderer Backend for a CPU framebuffer
+// This needs to be used along with a Platform Backend (e.g. imgui_impl_null with 'install_renderer = false')
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftware_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Clip rectangles, alpha blending and RGBA32 textures (point sampled).
+//  [X] Renderer: Tile binning, tiles are rasterized in parallel by a pool of worker threads.
+//  [X] Renderer: Compact vertices (IMGUI_USE_COMPACT_DRAWVERT), decoded with ImDrawList::GetVtxPos()/GetVtxUV().
+//  [ ] Renderer: Multi-viewport support.
+
+// Triangles are rasterized with integer edge functions (1/16 pixel precision, top-left fill rule),
+// evaluated 4 pixels at a time with SSE2 when available. Results do not depend on the number of threads,
+// which makes the framebuffer usable for golden-image tests.
+
+#pragma once
+#include "imgui/imgui.h"      // IMGUI_IMPL_API
+
+// Texture layout expected behind an ImTextureID. Pixels are IM_COL32 packed (R in the low byte).
+struct ImGui_ImplSoftware_Texture
+{
+    const ImU32*    Pixels;
+    int             Width;
+    int             Height;
+};
+
+struct ImGui_ImplSoftware_RenderStats
+{
+    int         Triangles;          // Triangles submitted through ImDrawData
+    int         TrianglesBinned;    // Triangles left after clip rect and degenerate culling
+    int         TileBins;           // Triangle/tile pairs produced by binning
+    int         TilesTouched;       // Tiles with at least one triangle
+    int         TilesTotal;         // Tiles covering the framebuffer
+    int         ThreadsUsed;        // Threads rasterizing (including the calling thread)
+    ImU64       PixelsShaded;       // Pixels which passed the coverage test
+    double      SetupTime;          // Seconds spent in triangle setup and binning
+    double      RasterTime;         // Seconds spent clearing and rasterizing tiles
+    double      TrianglesPerSecond; // TrianglesBinned / (SetupTime + RasterTime)
+};
+
+// 'threads_count' <= 0: use std::thread::hardware_concurrency().
+IMGUI_IMPL_API bool     ImGui_ImplSoftware_Init(int threads_count = 0);
+IMGUI_IMPL_API void     ImGui_ImplSoftware_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftware_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftware_RenderDrawData(ImDrawData* draw_data);
+
+IMGUI_IMPL_API void     ImGui_ImplSoftware_SetClearColor(ImU32 col);
+IMGUI_IMPL_API bool     ImGui_ImplSoftware_GetFramebuffer(const ImU32** out_pixels, int* out_width, int* out_height);
+IMGUI_IMPL_API const ImGui_ImplSoftware_RenderStats& ImGui_ImplSoftware_GetRenderStats();
+
+// Use if you want to rebuild the font texture (e.g. after adding fonts).
+IMGUI_IMPL_API bool     ImGui_ImplSoftware_CreateDeviceObjects();
+IMGUI_IMPL_API void     ImGui_ImplSoftware_InvalidateDeviceObjects();